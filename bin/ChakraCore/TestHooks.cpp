@@ -82,6 +82,12 @@ void __stdcall NotifyUnhandledException(PEXCEPTION_POINTERS exceptionInfo)
 #endif
 }
 
+// Whether value is a string still held one byte per character, i.e. created as a OneByteString and not widened since
+bool __stdcall IsOneByteString(void* value)
+{
+    return Js::VarIs<Js::OneByteString>(value) && Js::UnsafeVarTo<Js::OneByteString>(value)->GetOneByteBuffer() != nullptr;
+}
+
 #define FLAG(type, name, description, defaultValue, ...) FLAG_##type##(name)
 #define FLAG_String(name) \
     bool IsEnabled##name##Flag() \
@@ -170,6 +176,9 @@ HRESULT OnChakraCoreLoaded(OnChakraCoreLoadedPtr pfChakraCoreLoaded)
         Js::JavascriptBigInt::SubDigit,
         Js::JavascriptBigInt::MulDigit,
 
+        // One-byte string hooks
+        IsOneByteString,
+
 #define FLAG(type, name, description, defaultValue, ...) FLAG_##type##(name)
 #define FLAGINCLUDE(name) \
     IsEnabled##name##Flag, \
@@ -39,6 +39,10 @@ struct TestHooks
     SubDigit pfSubDigit;
     MulDigit pfMulDigit;
 
+    // One-byte string hooks
+    typedef bool(TESTHOOK_CALL *IsOneByteStringPtr)(void* value);
+    IsOneByteStringPtr pfIsOneByteString;
+
 #define FLAG(type, name, description, defaultValue, ...) FLAG_##type##(name)
 #define FLAG_String(name) \
     bool (TESTHOOK_CALL *pfIsEnabled##name##Flag)(); \
@@ -10,6 +10,15 @@
 #include <src/include/pal/utils.h>
 #endif
 
+// Hardware counters for the huge page benchmark, thread affinity for the NUMA benchmark
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 void DoVerify(bool value, const char * expr, const char * file, int line)
 {
     if (!value)
@@ -68,6 +77,26 @@ WeightedTable<Operation> operationTable;
 // Not used currently, but keep for now
 bool verbose = false;
 
+// Run the parallel mark scaling benchmark instead of the stress loop
+bool markBenchmarkMode = false;
+static const unsigned int markBenchmarkCollectCount = 10;
+
+// Run the medium block fragmentation scenario instead of the stress loop
+bool fragmentationBenchmarkMode = false;
+static const unsigned int fragmentationObjectCount = 20000;
+static const unsigned int fragmentationChurnRounds = 8;
+
+// Run one recycler per thread and compare collection times with and without NUMA aware page allocators
+bool numaBenchmarkMode = false;
+static const unsigned int numaBenchmarkObjectCount = 200000;
+static const unsigned int numaBenchmarkCollectCount = 10;
+static const unsigned int numaBenchmarkWalkCount = 10;
+
+// Compare collection time and dTLB misses with and without huge page backed recycler segments
+bool hugePageBenchmarkMode = false;
+static const unsigned int hugePageBenchmarkObjectCount = 2000000;
+static const unsigned int hugePageBenchmarkCollectCount = 10;
+
 
 RecyclerTestObject * CreateNewObject()
 {
@@ -347,6 +376,573 @@ void SimpleRecyclerTest()
     wprintf(_u("==== Test completed.\n"));
 }
 
+void MarkScalingBenchmark()
+{
+    BuildObjectCreationTable();
+    BuildOperationTable();
+
+    // Ask for the largest helper pool up front; the benchmark lowers the parallelism per run.
+    Js::Configuration::Global.flags.RecyclerParallelMarkThreads = 32;
+
+#if ENABLE_BACKGROUND_PAGE_FREEING
+    PageAllocator::BackgroundPageQueue backgroundPageQueue;
+#endif
+    IdleDecommitPageAllocator pageAllocator(nullptr,
+        PageAllocatorType::PageAllocatorType_Thread,
+        Js::Configuration::Global.flags,
+        0 /* maxFreePageCount */, PageAllocator::DefaultMaxFreePageCount /* maxIdleFreePageCount */,
+        false /* zero pages */
+#if ENABLE_BACKGROUND_PAGE_FREEING
+        , &backgroundPageQueue
+#endif
+        );
+
+    try
+    {
+#ifdef EXCEPTION_CHECK
+        AUTO_NESTED_HANDLED_EXCEPTION_TYPE(ExceptionType_DisableCheck);
+#endif
+
+        recyclerInstance = HeapNewZ(Recycler, nullptr, &pageAllocator, Js::Throw::OutOfMemory, Js::Configuration::Global.flags, nullptr);
+        recyclerInstance->Initialize(false /* forceInThread */, nullptr /* threadService */);
+
+        // Same heap shape for every run
+        srand(0);
+
+        RecyclerTestObject * stackRoots[stackRootCount];
+        for (unsigned int i = 0; i < stackRootCount; i++)
+        {
+            stackRoots[i] = nullptr;
+            roots.AddWeightedEntry(Location::Scanned(&stackRoots[i]), 1);
+        }
+
+        for (unsigned int i = 0; i < globalRootCount; i++)
+        {
+            globalRoots[i] = nullptr;
+            roots.AddWeightedEntry(Location::Rooted(&globalRoots[i]), 1);
+        }
+
+        for (unsigned int i = 0; i < initializeCount * 10; i++)
+        {
+            InsertObject();
+        }
+
+        WalkHeap();
+        const size_t liveBytes = RecyclerTestObject::GetWalkTotalByteCount();
+
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+
+        wprintf(_u("-------------------------------------------\n"));
+        wprintf(_u("Threads   ms/collect    live MB/s\n"));
+        for (uint threadCount = 1; threadCount <= 32; threadCount *= 2)
+        {
+            recyclerInstance->SetMaxParallelism(threadCount);
+
+            // Warm up: creates the helper threads and settles the heap.
+            recyclerInstance->CollectNow<CollectNowForceInThread>();
+
+            LARGE_INTEGER start, end;
+            QueryPerformanceCounter(&start);
+            for (unsigned int i = 0; i < markBenchmarkCollectCount; i++)
+            {
+                recyclerInstance->CollectNow<CollectNowForceInThread>();
+            }
+            QueryPerformanceCounter(&end);
+
+            double seconds = (double)(end.QuadPart - start.QuadPart) / (double)frequency.QuadPart / markBenchmarkCollectCount;
+            wprintf(_u("%7u   %10.3f   %10.1f\n"), threadCount, seconds * 1000.0, ((double)liveBytes / (1024.0 * 1024.0)) / seconds);
+        }
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        printf("Error: OOM\n");
+    }
+
+    wprintf(_u("==== Benchmark completed.\n"));
+}
+
+static size_t GetFragmentationObjectSize()
+{
+    // Medium objects only: above the small object limit, up to 8K
+    return HeapConstants::MaxSmallObjectSize + 1 + (rand() % (8192 - HeapConstants::MaxSmallObjectSize));
+}
+
+static void PrintFragmentation(const char16 * phase, size_t liveBytes)
+{
+    const size_t usedBytes = recyclerInstance->GetUsedBytes();
+    wprintf(_u("%-12s %10u KB %10u KB   %5.2f\n"), phase,
+        (uint)(liveBytes / 1024), (uint)(usedBytes / 1024), liveBytes ? (double)usedBytes / (double)liveBytes : 0.0);
+}
+
+void FragmentationBenchmark()
+{
+    wprintf(_u("-------------------------------------------\n"));
+    wprintf(_u("Phase              live           used   used/live\n"));
+
+    for (uint pass = 0; pass < 2; pass++)
+    {
+        const bool defragment = (pass != 0);
+        Js::Configuration::Global.flags.RecyclerDefragmentMediumBlocks = defragment;
+
+#if ENABLE_BACKGROUND_PAGE_FREEING
+        PageAllocator::BackgroundPageQueue backgroundPageQueue;
+#endif
+        IdleDecommitPageAllocator pageAllocator(nullptr,
+            PageAllocatorType::PageAllocatorType_Thread,
+            Js::Configuration::Global.flags,
+            0 /* maxFreePageCount */, 0 /* maxIdleFreePageCount */,
+            false /* zero pages */
+#if ENABLE_BACKGROUND_PAGE_FREEING
+            , &backgroundPageQueue
+#endif
+            );
+
+        char ** objects = nullptr;
+        size_t * objectSizes = nullptr;
+        try
+        {
+#ifdef EXCEPTION_CHECK
+            AUTO_NESTED_HANDLED_EXCEPTION_TYPE(ExceptionType_DisableCheck);
+#endif
+
+            recyclerInstance = HeapNewZ(Recycler, nullptr, &pageAllocator, Js::Throw::OutOfMemory, Js::Configuration::Global.flags, nullptr);
+            recyclerInstance->Initialize(false /* forceInThread */, nullptr /* threadService */);
+
+            // Same allocation sequence for both passes
+            srand(0);
+            wprintf(_u("defragment: %s\n"), defragment ? _u("on") : _u("off"));
+
+            objects = HeapNewArrayZ(char *, fragmentationObjectCount);
+            objectSizes = HeapNewArrayZ(size_t, fragmentationObjectCount);
+            size_t liveBytes = 0;
+            for (unsigned int i = 0; i < fragmentationObjectCount; i++)
+            {
+                const size_t size = GetFragmentationObjectSize();
+                objects[i] = RecyclerNewArrayLeaf(recyclerInstance, char, size);
+                objectSizes[i] = size;
+                recyclerInstance->RootAddRef(objects[i]);
+                liveBytes += size;
+            }
+
+            // Drop most of the objects at random, leaving every medium block sparsely populated
+            for (unsigned int i = 0; i < fragmentationObjectCount; i++)
+            {
+                if (rand() % 8 != 0)
+                {
+                    liveBytes -= objectSizes[i];
+                    recyclerInstance->RootRelease(objects[i]);
+                    objects[i] = nullptr;
+                }
+            }
+            recyclerInstance->CollectNow<CollectNowForceInThread>();
+            PrintFragmentation(_u("fragmented"), liveBytes);
+
+            // Steady state churn of short lived objects of the same sizes
+            for (unsigned int round = 0; round < fragmentationChurnRounds; round++)
+            {
+                for (unsigned int i = 0; i < fragmentationObjectCount / 4; i++)
+                {
+                    RecyclerNewArrayLeaf(recyclerInstance, char, GetFragmentationObjectSize());
+                }
+                recyclerInstance->CollectNow<CollectNowForceInThread>();
+            }
+            PrintFragmentation(_u("after churn"), liveBytes);
+        }
+        catch (Js::OutOfMemoryException)
+        {
+            printf("Error: OOM\n");
+        }
+
+        if (objects != nullptr)
+        {
+            for (unsigned int i = 0; i < fragmentationObjectCount; i++)
+            {
+                if (objects[i] != nullptr)
+                {
+                    recyclerInstance->RootRelease(objects[i]);
+                }
+            }
+            HeapDeleteArray(fragmentationObjectCount, objects);
+        }
+
+        if (objectSizes != nullptr)
+        {
+            HeapDeleteArray(fragmentationObjectCount, objectSizes);
+        }
+
+        if (recyclerInstance != nullptr)
+        {
+            HeapDelete(recyclerInstance);
+            recyclerInstance = nullptr;
+        }
+    }
+
+    wprintf(_u("==== Benchmark completed.\n"));
+}
+
+struct NumaBenchmarkRuntime
+{
+    HANDLE thread;
+    DWORD numaNode;
+    DWORD remoteNumaNode;
+    bool pinned;
+    double msPerCollect;
+    double localNsPerNode;
+    double remoteNsPerNode;
+    size_t nodeCommittedBytes;
+};
+
+// Restricts the calling thread to the processors of a NUMA node, so that the node the runtime's pages are
+// bound to is known to be local (or, after pinning to another node, remote)
+static bool PinThreadToNumaNode(DWORD numaNode)
+{
+#if defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (UCHAR processor = 0; processor < sizeof(DWORD_PTR) * 8; processor++)
+    {
+        UCHAR processorNode;
+        if (GetNumaProcessorNode(processor, &processorNode) && processorNode == numaNode)
+        {
+            mask |= (DWORD_PTR)1 << processor;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    bool any = false;
+    for (uint processor = 0; processor <= 0xFF && processor < CPU_SETSIZE; processor++)
+    {
+        UCHAR processorNode;
+        if (GetNumaProcessorNode((UCHAR)processor, &processorNode) && processorNode == numaNode)
+        {
+            CPU_SET(processor, &set);
+            any = true;
+        }
+    }
+    return any && sched_setaffinity(0 /* this thread */, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// Chases the list built by BuildPointerChasingHeap and returns the time per node in nanoseconds
+static double WalkPointerChasingHeap(void ** head, unsigned int objectCount)
+{
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency(&frequency);
+    void * volatile sink = nullptr;
+    QueryPerformanceCounter(&start);
+    for (unsigned int i = 0; i < numaBenchmarkWalkCount; i++)
+    {
+        for (void ** node = head; node != nullptr; node = (void **)node[0])
+        {
+            sink = node[1];
+        }
+    }
+    QueryPerformanceCounter(&end);
+    return (double)(end.QuadPart - start.QuadPart) * 1e9 / (double)frequency.QuadPart / ((double)objectCount * numaBenchmarkWalkCount);
+}
+
+// A singly linked list with a few random back edges, so marking chases pointers across the heap.
+// The returned head is rooted.
+static void ** BuildPointerChasingHeap(Recycler * recycler, unsigned int objectCount)
+{
+    void ** head = nullptr;
+    void ** nodes[64] = { nullptr };
+    for (unsigned int i = 0; i < objectCount; i++)
+    {
+        void ** node = RecyclerNewArrayZ(recycler, void *, 4);
+        node[0] = head;
+        node[1] = nodes[rand() % _countof(nodes)];
+        node[2] = nodes[rand() % _countof(nodes)];
+        nodes[i % _countof(nodes)] = node;
+        head = node;
+    }
+    recycler->RootAddRef(head);
+    memset(nodes, 0, sizeof(nodes));
+    return head;
+}
+
+static DWORD WINAPI NumaBenchmarkThread(LPVOID param)
+{
+    NumaBenchmarkRuntime * runtime = (NumaBenchmarkRuntime *)param;
+    runtime->pinned = PinThreadToNumaNode(runtime->numaNode);
+
+#if ENABLE_BACKGROUND_PAGE_FREEING
+    PageAllocator::BackgroundPageQueue backgroundPageQueue;
+#endif
+    IdleDecommitPageAllocator pageAllocator(nullptr,
+        PageAllocatorType::PageAllocatorType_Thread,
+        Js::Configuration::Global.flags,
+        0 /* maxFreePageCount */, PageAllocator::DefaultMaxFreePageCount /* maxIdleFreePageCount */,
+        false /* zero pages */
+#if ENABLE_BACKGROUND_PAGE_FREEING
+        , &backgroundPageQueue
+#endif
+        );
+
+    Recycler * recycler = nullptr;
+    try
+    {
+#ifdef EXCEPTION_CHECK
+        AUTO_NESTED_HANDLED_EXCEPTION_TYPE(ExceptionType_DisableCheck);
+#endif
+
+        // Mark in-thread so that all heap traffic comes from the runtime's own thread
+        recycler = HeapNewZ(Recycler, nullptr, &pageAllocator, Js::Throw::OutOfMemory, Js::Configuration::Global.flags, nullptr);
+        recycler->Initialize(true /* forceInThread */, nullptr /* threadService */);
+
+        void ** head = BuildPointerChasingHeap(recycler, numaBenchmarkObjectCount);
+
+        recycler->CollectNow<CollectNowForceInThread>();
+
+        LARGE_INTEGER frequency, start, end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+        for (unsigned int i = 0; i < numaBenchmarkCollectCount; i++)
+        {
+            recycler->CollectNow<CollectNowForceInThread>();
+        }
+        QueryPerformanceCounter(&end);
+
+        runtime->msPerCollect = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart / numaBenchmarkCollectCount;
+        runtime->nodeCommittedBytes = PageAllocator::GetProcessCommittedBytesOnNumaNode(runtime->numaNode);
+
+        // Read the same heap from the owning node, then from another one
+        runtime->localNsPerNode = WalkPointerChasingHeap(head, numaBenchmarkObjectCount);
+        if (runtime->pinned && runtime->remoteNumaNode != runtime->numaNode && PinThreadToNumaNode(runtime->remoteNumaNode))
+        {
+            runtime->remoteNsPerNode = WalkPointerChasingHeap(head, numaBenchmarkObjectCount);
+        }
+
+        recycler->RootRelease(head);
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        printf("Error: OOM\n");
+    }
+
+    if (recycler != nullptr)
+    {
+        HeapDelete(recycler);
+    }
+    return 0;
+}
+
+void NumaBenchmark()
+{
+    ULONG highestNode = 0;
+    GetNumaHighestNodeNumber(&highestNode);
+    const uint nodeCount = highestNode + 1;
+    const uint runtimeCount = nodeCount * 2 < 64 ? nodeCount * 2 : 64;
+
+    wprintf(_u("-------------------------------------------\n"));
+    wprintf(_u("NUMA nodes: %u, runtimes: %u\n"), (uint)(highestNode + 1), runtimeCount);
+
+    for (uint pass = 0; pass < 2; pass++)
+    {
+        const bool numaAware = (pass != 0);
+        Js::Configuration::Global.flags.NumaAwarePageAllocator = numaAware;
+        wprintf(_u("NUMA aware page allocator: %s\n"), numaAware ? _u("on") : _u("off"));
+        wprintf(_u("Runtime   node   ms/collect   node committed MB   local ns/node   remote ns/node\n"));
+
+        NumaBenchmarkRuntime runtimes[64];
+        memset(runtimes, 0, sizeof(runtimes));
+        for (uint i = 0; i < runtimeCount; i++)
+        {
+            runtimes[i].numaNode = i % nodeCount;
+            runtimes[i].remoteNumaNode = (i + 1) % nodeCount;
+            runtimes[i].thread = CreateThread(nullptr, 0, NumaBenchmarkThread, &runtimes[i], 0, nullptr);
+        }
+
+        double totalMs = 0;
+        for (uint i = 0; i < runtimeCount; i++)
+        {
+            if (runtimes[i].thread == nullptr)
+            {
+                continue;
+            }
+            WaitForSingleObject(runtimes[i].thread, INFINITE);
+            CloseHandle(runtimes[i].thread);
+
+            totalMs += runtimes[i].msPerCollect;
+            wprintf(_u("%7u   %4d   %10.3f   %17.1f   %13.2f   "), i, (int)runtimes[i].numaNode, runtimes[i].msPerCollect,
+                numaAware ? (double)runtimes[i].nodeCommittedBytes / (1024.0 * 1024.0) : 0.0, runtimes[i].localNsPerNode);
+            if (runtimes[i].remoteNsPerNode != 0)
+            {
+                wprintf(_u("%14.2f\n"), runtimes[i].remoteNsPerNode);
+            }
+            else
+            {
+                // Single node machine, or the thread could not be pinned
+                wprintf(_u("%14s\n"), _u("n/a"));
+            }
+        }
+        wprintf(_u("Average   %17.3f\n"), totalMs / runtimeCount);
+    }
+
+    wprintf(_u("==== Benchmark completed.\n"));
+}
+
+// Counts the calling thread's data TLB read misses where the OS exposes them
+class DTLBMissCounter
+{
+public:
+    DTLBMissCounter() : fd(-1)
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0 /* this thread */, -1 /* any cpu */, -1, 0);
+#endif
+    }
+
+    ~DTLBMissCounter()
+    {
+#if defined(__linux__)
+        if (fd != -1)
+        {
+            close(fd);
+        }
+#endif
+    }
+
+    bool IsAvailable() const { return fd != -1; }
+
+    void Start()
+    {
+#if defined(__linux__)
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64 Stop()
+    {
+        uint64 count = 0;
+#if defined(__linux__)
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+void HugePageBenchmark()
+{
+    double msPerCollect[2] = { 0, 0 };
+    uint64 missesPerCollect[2] = { 0, 0 };
+    bool countersAvailable = false;
+
+    for (uint pass = 0; pass < 2; pass++)
+    {
+        const bool hugePages = (pass != 0);
+        Js::Configuration::Global.flags.RecyclerHugePages = hugePages;
+
+#if ENABLE_BACKGROUND_PAGE_FREEING
+        PageAllocator::BackgroundPageQueue backgroundPageQueue;
+#endif
+        IdleDecommitPageAllocator pageAllocator(nullptr,
+            PageAllocatorType::PageAllocatorType_Thread,
+            Js::Configuration::Global.flags,
+            0 /* maxFreePageCount */, PageAllocator::DefaultMaxFreePageCount /* maxIdleFreePageCount */,
+            false /* zero pages */
+#if ENABLE_BACKGROUND_PAGE_FREEING
+            , &backgroundPageQueue
+#endif
+            );
+
+        Recycler * recycler = nullptr;
+        try
+        {
+#ifdef EXCEPTION_CHECK
+            AUTO_NESTED_HANDLED_EXCEPTION_TYPE(ExceptionType_DisableCheck);
+#endif
+
+            // Mark in-thread so the counter sees all of the mark traffic
+            recycler = HeapNewZ(Recycler, nullptr, &pageAllocator, Js::Throw::OutOfMemory, Js::Configuration::Global.flags, nullptr);
+            recycler->Initialize(true /* forceInThread */, nullptr /* threadService */);
+
+            // Same heap shape for both passes
+            srand(0);
+            void ** head = BuildPointerChasingHeap(recycler, hugePageBenchmarkObjectCount);
+            recycler->CollectNow<CollectNowForceInThread>();
+
+            DTLBMissCounter missCounter;
+            countersAvailable = missCounter.IsAvailable();
+
+            LARGE_INTEGER frequency, start, end;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&start);
+            missCounter.Start();
+            for (unsigned int i = 0; i < hugePageBenchmarkCollectCount; i++)
+            {
+                recycler->CollectNow<CollectNowForceInThread>();
+            }
+            uint64 misses = missCounter.Stop();
+            QueryPerformanceCounter(&end);
+
+            msPerCollect[pass] = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart / hugePageBenchmarkCollectCount;
+            missesPerCollect[pass] = misses / hugePageBenchmarkCollectCount;
+
+            recycler->RootRelease(head);
+        }
+        catch (Js::OutOfMemoryException)
+        {
+            printf("Error: OOM\n");
+        }
+
+        if (recycler != nullptr)
+        {
+            HeapDelete(recycler);
+        }
+    }
+
+    wprintf(_u("-------------------------------------------\n"));
+    wprintf(_u("Huge pages   ms/collect   dTLB misses/collect\n"));
+    for (uint pass = 0; pass < 2; pass++)
+    {
+        if (countersAvailable)
+        {
+            wprintf(_u("%10s   %10.3f   %19llu\n"), pass ? _u("on") : _u("off"), msPerCollect[pass], (unsigned long long)missesPerCollect[pass]);
+        }
+        else
+        {
+            wprintf(_u("%10s   %10.3f   %19s\n"), pass ? _u("on") : _u("off"), msPerCollect[pass], _u("n/a"));
+        }
+    }
+    if (msPerCollect[0] != 0)
+    {
+        wprintf(_u("Mark time delta: %+.1f%%\n"), (msPerCollect[1] - msPerCollect[0]) * 100.0 / msPerCollect[0]);
+    }
+    if (countersAvailable && missesPerCollect[0] != 0)
+    {
+        wprintf(_u("dTLB miss delta: %+.1f%%\n"), ((double)missesPerCollect[1] - (double)missesPerCollect[0]) * 100.0 / (double)missesPerCollect[0]);
+    }
+
+    wprintf(_u("==== Benchmark completed.\n"));
+}
+
 //////////////////// End test implementations ////////////////////
 
 //////////////////// Begin test stubs ////////////////////
@@ -369,8 +965,12 @@ bool GetDeviceFamilyInfo(
 void usage(const WCHAR* self)
 {
     wprintf(
-        _u("usage: %s [-?|-v] [-js <jscript options from here on>]\n")
-        _u("  -v\n\tverbose logging\n"),
+        _u("usage: %s [-?|-v|-markbench|-fragbench|-numabench|-hugepagebench] [-js <jscript options from here on>]\n")
+        _u("  -v\n\tverbose logging\n")
+        _u("  -markbench\n\treport full in-thread collection time for 1-32 parallel mark threads\n")
+        _u("  -fragbench\n\treport medium block fragmentation with and without -RecyclerDefragmentMediumBlocks\n")
+        _u("  -numabench\n\treport per-thread recycler collection time with and without -NumaAwarePageAllocator,\n\tand the time to read a runtime's heap from its own node and from another one\n")
+        _u("  -hugepagebench\n\treport collection time and dTLB misses with and without -RecyclerHugePages\n"),
         self);
 }
 
@@ -391,6 +991,22 @@ int __cdecl wmain(int argc, __in_ecount(argc) WCHAR* argv[])
             {
                 verbose = true;
             }
+            else if (wcscmp(argv[i], _u("-markbench")) == 0)
+            {
+                markBenchmarkMode = true;
+            }
+            else if (wcscmp(argv[i], _u("-fragbench")) == 0)
+            {
+                fragmentationBenchmarkMode = true;
+            }
+            else if (wcscmp(argv[i], _u("-numabench")) == 0)
+            {
+                numaBenchmarkMode = true;
+            }
+            else if (wcscmp(argv[i], _u("-hugepagebench")) == 0)
+            {
+                hugePageBenchmarkMode = true;
+            }
             else if (wcscmp(argv[i], _u("-js")) == 0 || wcscmp(argv[i], _u("-JS")) == 0)
             {
                 jscriptOptions = i;
@@ -419,7 +1035,26 @@ int __cdecl wmain(int argc, __in_ecount(argc) WCHAR* argv[])
     }
 
     // Run the actual test
-    SimpleRecyclerTest();
+    if (markBenchmarkMode)
+    {
+        MarkScalingBenchmark();
+    }
+    else if (fragmentationBenchmarkMode)
+    {
+        FragmentationBenchmark();
+    }
+    else if (numaBenchmarkMode)
+    {
+        NumaBenchmark();
+    }
+    else if (hugePageBenchmarkMode)
+    {
+        HugePageBenchmark();
+    }
+    else
+    {
+        SimpleRecyclerTest();
+    }
 
     return 0;
 }
@@ -87,6 +87,11 @@ class RecyclerTestObject : public IRecyclerVisitedObject
         wprintf(_u("Max Depth:              %12llu\n"), (unsigned long long) maxWalkDepth);
     }
 
+    static size_t GetWalkTotalByteCount()
+    {
+        return walkScannedByteCount + walkBarrierByteCount + walkTrackedByteCount + walkFinalizedByteCount + walkLeafByteCount + walkRecyclerVisitedByteCount;
+    }
+
     // Virtual methods
     virtual bool TryGetRandomLocation(Location * location)
     {
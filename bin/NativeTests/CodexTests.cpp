@@ -9,6 +9,8 @@
 #pragma warning(disable:26495) // Uninitialized member variable
 #include "catch.hpp"
 #include <process.h>
+#include <chrono>
+#include <vector>
 #include "Codex\Utf8Codex.h"
 
 #pragma warning(disable:4100) // unreferenced formal parameter
@@ -287,4 +289,194 @@ namespace CodexTest
         
         RunUtf8DecodeTestCase(testCases, utf8::DecodeUnitsIntoAndNullTerminateNoAdvance);
     }
+
+    //
+    // The following tests cover the block-at-a-time ASCII paths, which take sixteen units at a time on x64.
+    // Each one places the interesting sequence at every offset around a block boundary.
+    //
+
+    TEST_CASE("CodexTest_DecodeUnitsInto_AsciiRunBoundaries", "[CodexTest]")
+    {
+        struct TestCase
+        {
+            size_t byteCount;
+            utf8char_t utf8Encoding[4];
+            size_t charCount;
+            char16 result[3];
+        };
+
+        TestCase testCases[] = {
+            { 2, { 0xC3, 0xA9 }, 1, { 0x00E9 } },                   // Valid 2-byte sequence
+            { 3, { 0xE2, 0x82, 0xAC }, 1, { 0x20AC } },             // Valid 3-byte sequence
+            { 4, { 0xF0, 0x9F, 0x98, 0x80 }, 2, { 0xD83D, 0xDE00 } }, // Valid 4-byte sequence
+            { 1, { 0x80 }, 1, { 0xFFFD } },                         // Trail byte in lead position
+            { 2, { 0xC0, 0x80 }, 2, { 0xFFFD, 0xFFFD } },           // Overlong 2-byte sequence
+            { 3, { 0xE0, 0x80, 0x80 }, 3, { 0xFFFD, 0xFFFD, 0xFFFD } }, // Overlong 3-byte sequence
+            { 3, { 0xED, 0xA0, 0x80 }, 3, { 0xFFFD, 0xFFFD, 0xFFFD } }, // Encoded surrogate
+            { 3, { 0xEF, 0xB7, 0x90 }, 1, { 0xFFFD } },             // U+FDD0 noncharacter
+        };
+
+        utf8char_t input[64];
+        char16 decoded[64];
+        for (int i = 0; i < _countof(testCases); i++)
+        {
+            for (size_t prefix = 0; prefix <= 36; prefix++)
+            {
+                for (size_t suffix = 0; suffix <= 17; suffix += 17)
+                {
+                    const size_t byteCount = prefix + testCases[i].byteCount + suffix;
+                    for (size_t j = 0; j < byteCount; j++)
+                    {
+                        input[j] = 'a' + (j % 26);
+                    }
+                    memcpy(input + prefix, testCases[i].utf8Encoding, testCases[i].byteCount);
+
+                    LPCUTF8 current = input;
+                    size_t decodedCount = utf8::DecodeUnitsInto(decoded, current, input + byteCount, utf8::doDefault);
+                    CHECK(current == input + byteCount);
+                    REQUIRE(decodedCount == prefix + testCases[i].charCount + suffix);
+                    for (size_t j = 0; j < prefix; j++)
+                    {
+                        CHECK(decoded[j] == input[j]);
+                    }
+                    for (size_t j = 0; j < testCases[i].charCount; j++)
+                    {
+                        CHECK(decoded[prefix + j] == testCases[i].result[j]);
+                    }
+                    for (size_t j = 0; j < suffix; j++)
+                    {
+                        CHECK(decoded[prefix + testCases[i].charCount + j] == input[prefix + testCases[i].byteCount + j]);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_CASE("CodexTest_EncodeInto_AsciiRunBoundaries", "[CodexTest]")
+    {
+        struct TestCase
+        {
+            charcount_t charCount;
+            char16 source[2];
+            size_t byteCount;
+            utf8char_t trueUtf8Encoding[4];
+            utf8char_t cesu8Encoding[6];
+        };
+
+        TestCase testCases[] = {
+            { 1, { 0x00E9 }, 2, { 0xC3, 0xA9 }, { 0xC3, 0xA9 } },
+            { 1, { 0x20AC }, 3, { 0xE2, 0x82, 0xAC }, { 0xE2, 0x82, 0xAC } },
+            { 1, { 0xFF80 }, 3, { 0xEF, 0xBE, 0x80 }, { 0xEF, 0xBE, 0x80 } },
+        };
+
+        char16 source[64];
+        utf8char_t encoded[64];
+        for (int i = 0; i < _countof(testCases); i++)
+        {
+            for (charcount_t prefix = 0; prefix <= 36; prefix++)
+            {
+                const charcount_t charCount = prefix + testCases[i].charCount + 17;
+                for (charcount_t j = 0; j < charCount; j++)
+                {
+                    source[j] = 'a' + (j % 26);
+                }
+                memcpy(source + prefix, testCases[i].source, testCases[i].charCount * sizeof(char16));
+
+                // The buffer is exactly large enough, so a store past the encoded bytes fails fast
+                const size_t byteCount = charCount - testCases[i].charCount + testCases[i].byteCount;
+                size_t encodedCount = utf8::EncodeInto<utf8::Utf8EncodingKind::TrueUtf8>(encoded, byteCount, source, charCount);
+                REQUIRE(encodedCount == byteCount);
+                CHECK(utf8::CountTrueUtf8(source, charCount) == byteCount);
+                CHECK(memcmp(encoded + prefix, testCases[i].trueUtf8Encoding, testCases[i].byteCount) == 0);
+                for (charcount_t j = 0; j < prefix; j++)
+                {
+                    CHECK(encoded[j] == source[j]);
+                }
+                CHECK(encoded[byteCount - 1] == source[charCount - 1]);
+
+                encodedCount = utf8::EncodeInto<utf8::Utf8EncodingKind::Cesu8>(encoded, byteCount, source, charCount);
+                REQUIRE(encodedCount == byteCount);
+                CHECK(memcmp(encoded + prefix, testCases[i].cesu8Encoding, testCases[i].byteCount) == 0);
+            }
+        }
+
+        // A surrogate pair straddling a block boundary
+        for (charcount_t prefix = 14; prefix <= 17; prefix++)
+        {
+            for (charcount_t j = 0; j < prefix; j++)
+            {
+                source[j] = 'x';
+            }
+            source[prefix] = 0xD83D;
+            source[prefix + 1] = 0xDE00;
+            size_t encodedCount = utf8::EncodeInto<utf8::Utf8EncodingKind::TrueUtf8>(encoded, prefix + 4, source, prefix + 2);
+            REQUIRE(encodedCount == prefix + 4);
+            CHECK(encoded[prefix - 1] == 'x');
+            CHECK(memcmp(encoded + prefix, "\xF0\x9F\x98\x80", 4) == 0);
+        }
+    }
+
+    TEST_CASE("CodexTest_RoundTrip_MixedText", "[CodexTest]")
+    {
+        // Runs of ASCII of every length up to a few blocks, separated by characters of each encoded length
+        const char16 separators[] = { 0x00E9, 0x0416, 0x20AC, 0xD83D, 0xDE00 };
+        std::vector<char16> source;
+        for (size_t run = 0; run < 50; run++)
+        {
+            for (size_t j = 0; j < run; j++)
+            {
+                source.push_back((char16)('A' + (j % 26)));
+            }
+            source.push_back(separators[run % 4]);
+            if (run % 4 == 3)
+            {
+                source.push_back(separators[4]);
+            }
+        }
+
+        const charcount_t charCount = (charcount_t)source.size();
+        const size_t byteCount = utf8::CountTrueUtf8(source.data(), charCount);
+        std::vector<utf8char_t> encoded(byteCount);
+        REQUIRE(utf8::EncodeInto<utf8::Utf8EncodingKind::TrueUtf8>(encoded.data(), byteCount, source.data(), charCount) == byteCount);
+
+        std::vector<char16> decoded(charCount);
+        LPCUTF8 current = encoded.data();
+        REQUIRE(utf8::DecodeUnitsInto(decoded.data(), current, encoded.data() + byteCount, utf8::doDefault) == charCount);
+        CHECK(decoded == source);
+        CHECK(utf8::ByteIndexIntoCharacterIndex(encoded.data(), byteCount) == charCount);
+    }
+
+    // Not run by default; run with "[CodexPerf]" to print the transcoding throughput of a mostly ASCII payload
+    TEST_CASE("CodexTest_Throughput", "[.][CodexPerf]")
+    {
+        const size_t charCount = 16 * 1024 * 1024;
+        const int iterations = 10;
+        std::vector<char16> source(charCount);
+        for (size_t i = 0; i < charCount; i++)
+        {
+            source[i] = (i % 64 == 63) ? 0x00E9 : (char16)('a' + (i % 26));
+        }
+
+        const size_t byteCount = utf8::CountTrueUtf8(source.data(), (charcount_t)charCount);
+        std::vector<utf8char_t> encoded(byteCount);
+        std::vector<char16> decoded(charCount);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            utf8::EncodeInto<utf8::Utf8EncodingKind::TrueUtf8>(encoded.data(), byteCount, source.data(), (charcount_t)charCount);
+        }
+        auto encodeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            LPCUTF8 current = encoded.data();
+            utf8::DecodeUnitsInto(decoded.data(), current, encoded.data() + byteCount, utf8::doDefault);
+        }
+        auto decodeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(decoded == source);
+        WARN("EncodeInto: " << encodeTime / iterations << " ms, DecodeUnitsInto: " << decodeTime / iterations << " ms for " << byteCount << " bytes");
+    }
 };
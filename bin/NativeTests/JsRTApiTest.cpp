@@ -9,6 +9,8 @@
 #pragma warning(disable:26495) // Uninitialized member variable
 #include "catch.hpp"
 #include <array>
+#include <string>
+#include <vector>
 #include <process.h>
 #include <suppress.h>
 
@@ -2684,10 +2686,33 @@ namespace JsRTApiTest
         // Specifying -1 as the length should result in using strlen as the length
         const char validUtf8Input[] = {'T', 'e', 's', 't', ' ', -30 /* 0xe2 */, -104 /* 0x98 */, -125 /* 0x83 */, 0};
         REQUIRE(JsCreateString(validUtf8Input, static_cast<size_t>(-1), &result) == JsNoError);
+        REQUIRE(g_testHooksLoaded);
+        CHECK(!g_testHooks.pfIsOneByteString(result));
         char utf8Result[10];
         REQUIRE(JsCopyString(result,utf8Result, 10, &written) == JsNoError);
         CHECK(written == strlen(validUtf8Input));
         CHECK(memcmp(utf8Result, validUtf8Input, written) == 0);
+
+        // Latin-1 content is stored one byte per character and should read back the same through every copy
+        const char latin1Utf8Input[] = {'c', 'a', 'f', -61 /* 0xc3 */, -87 /* 0xa9 */, 0};
+        REQUIRE(JsCreateString(latin1Utf8Input, static_cast<size_t>(-1), &result) == JsNoError);
+        CHECK(g_testHooks.pfIsOneByteString(result));
+        char oneByteResult[4];
+        REQUIRE(JsCopyStringOneByte(result, 1, 10, oneByteResult, &written) == JsNoError);
+        CHECK(written == 3);
+        CHECK(memcmp(oneByteResult, "af\xe9", 3) == 0);
+        // Copying out one byte per character reads the narrow buffer, so the string is still not widened
+        CHECK(g_testHooks.pfIsOneByteString(result));
+        uint16_t latin1Utf16Result[4];
+        REQUIRE(JsCopyStringUtf16(result, 0, 4, latin1Utf16Result, &written) == JsNoError);
+        CHECK(written == 4);
+        CHECK(latin1Utf16Result[0] == 'c');
+        CHECK(latin1Utf16Result[3] == 0xE9);
+        // Reading it as UTF-16 widens it and drops the narrow buffer
+        CHECK(!g_testHooks.pfIsOneByteString(result));
+        REQUIRE(JsCopyString(result, utf8Result, 10, &written) == JsNoError);
+        CHECK(written == strlen(latin1Utf8Input));
+        CHECK(memcmp(utf8Result, latin1Utf8Input, written) == 0);
     }
 
     TEST_CASE("ApiTest_JsCreateStringTest", "[ApiTest]")
@@ -2695,6 +2720,131 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::JsCreateStringTest);
     }
 
+    void JsParseJsonUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // The content is not null terminated past the given length, and the string value is long enough to take the
+        // sixteen byte path through the scanner before reaching the escape and the multi-byte characters
+        const char json[] = "{\"name\": \"caf\xc3\xa9 au lait, \\\"hot\\\" \xe2\x82\xac\xf0\x9f\x98\x80\", \"values\": [1, -2.5, true, null]}trailing";
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8(json, strlen(json) - strlen("trailing"), &result) == JsNoError);
+
+        JsPropertyIdRef nameId = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreatePropertyId("name", strlen("name"), &nameId) == JsNoError);
+        JsValueRef name = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetProperty(result, nameId, &name) == JsNoError);
+        uint16_t nameResult[32];
+        size_t written;
+        REQUIRE(JsCopyStringUtf16(name, 0, 32, nameResult, &written) == JsNoError);
+        CHECK(written == 23);
+        CHECK(nameResult[3] == 0xE9);
+        CHECK(nameResult[14] == '"');
+        CHECK(nameResult[20] == 0x20AC);
+        CHECK(nameResult[21] == 0xD83D);
+        CHECK(nameResult[22] == 0xDE00);
+
+        JsPropertyIdRef valuesId = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreatePropertyId("values", strlen("values"), &valuesId) == JsNoError);
+        JsValueRef values = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetProperty(result, valuesId, &values) == JsNoError);
+        JsValueRef index = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(1, &index) == JsNoError);
+        JsValueRef second = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetIndexedProperty(values, index, &second) == JsNoError);
+        double secondValue;
+        REQUIRE(JsNumberToDouble(second, &secondValue) == JsNoError);
+        CHECK(secondValue == -2.5);
+
+        // Malformed JSON throws a SyntaxError, as JSON.parse does
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        CHECK(JsParseJsonUtf8(json, strlen(json), &result) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_JsParseJsonUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsParseJsonUtf8Test);
+    }
+
+    struct JsonChunks
+    {
+        std::string text;
+        size_t chunkCount;
+        size_t maxChunkLength;
+        size_t stopAfter;
+    };
+
+    bool CALLBACK JsonWriteCallback(const char* chunk, size_t length, void* callbackState)
+    {
+        JsonChunks* chunks = static_cast<JsonChunks*>(callbackState);
+        chunks->text.append(chunk, length);
+        chunks->chunkCount++;
+        if (length > chunks->maxChunkLength)
+        {
+            chunks->maxChunkLength = length;
+        }
+        return chunks->chunkCount != chunks->stopAfter;
+    }
+
+    void JsStringifyJsonUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Surrogate pairs at every offset, so that some of them are split between the pieces of a small chunk size
+        JsValueRef value = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var value = { name: 'caf\\u00e9 \\u20ac', pairs: [], lone: '\\ud800', gap: undefined };")
+            _u("for (var i = 0; i < 40; i++) { value.pairs.push('x'.repeat(i % 4) + '\\ud83d\\ude00'); } value;"),
+            JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        JsValueRef expectedValue = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("JSON.stringify(value)"), JS_SOURCE_CONTEXT_NONE, _u(""), &expectedValue) == JsNoError);
+        size_t expectedLength = 0;
+        REQUIRE(JsCopyString(expectedValue, nullptr, 0, &expectedLength) == JsNoError);
+        std::string expected(expectedLength, '\0');
+        REQUIRE(JsCopyString(expectedValue, &expected[0], expectedLength, nullptr) == JsNoError);
+        CHECK(expected.find("\\ud800") != std::string::npos);
+
+        const size_t chunkSizes[] = { 16, 17, 18, 100, 0 };
+        for (size_t chunkSize : chunkSizes)
+        {
+            JsonChunks chunks = { std::string(), 0, 0, 0 };
+            size_t length = 0;
+            REQUIRE(JsStringifyJsonUtf8(value, JsonWriteCallback, &chunks, chunkSize, &length) == JsNoError);
+            CHECK(length == expectedLength);
+            CHECK(chunks.text == expected);
+            CHECK((chunkSize == 0 || chunks.maxChunkLength <= chunkSize));
+        }
+
+        // Returning false from the callback stops the conversion; length covers only the chunks written
+        JsonChunks cancelled = { std::string(), 0, 0, 2 };
+        size_t length = 0;
+        REQUIRE(JsStringifyJsonUtf8(value, JsonWriteCallback, &cancelled, 16, &length) == JsErrorOperationCancelled);
+        CHECK(cancelled.chunkCount == 2);
+        CHECK(length == cancelled.text.size());
+        CHECK(length < expectedLength);
+        CHECK(expected.compare(0, length, cancelled.text) == 0);
+
+        // Values that JSON.stringify turns into undefined produce no output
+        JsValueRef undefinedValue = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetUndefinedValue(&undefinedValue) == JsNoError);
+        JsonChunks empty = { std::string(), 0, 0, 0 };
+        REQUIRE(JsStringifyJsonUtf8(undefinedValue, JsonWriteCallback, &empty, 0, &length) == JsNoError);
+        CHECK(length == 0);
+        CHECK(empty.chunkCount == 0);
+
+        CHECK(JsStringifyJsonUtf8(value, JsonWriteCallback, &empty, 15, &length) == JsErrorInvalidArgument);
+        CHECK(JsStringifyJsonUtf8(value, nullptr, &empty, 0, &length) == JsErrorNullArgument);
+
+        // Exceptions from toJSON are reported before any output
+        JsValueRef throwing = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("({ toJSON: function () { throw new Error('no'); } })"), JS_SOURCE_CONTEXT_NONE, _u(""), &throwing) == JsNoError);
+        CHECK(JsStringifyJsonUtf8(throwing, JsonWriteCallback, &empty, 0, &length) == JsErrorScriptException);
+        CHECK(empty.chunkCount == 0);
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_JsStringifyJsonUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::JsStringifyJsonUtf8Test);
+    }
+
     void ApiTest_JsSerializeArrayTest(JsRuntimeAttributes /*attributes*/, JsRuntimeHandle /*runtime*/)
     {
         LPCSTR raw_script = "(function (){return true;})();";
@@ -2778,6 +2928,546 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsSerializeParseErrorTest);
     }
 
+    void ApiTest_JsSerializedFileBufferTest(JsRuntimeAttributes /*attributes*/, JsRuntimeHandle /*runtime*/)
+    {
+        LPCSTR raw_script = "(function (){return 42;})();";
+        LPCSTR fileName = "JsSerializedFileBufferTest.bin";
+
+        JsValueRef script = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(raw_script, static_cast<size_t>(-1), &script) == JsNoError);
+
+        JsValueRef buffer = JS_INVALID_REFERENCE;
+        REQUIRE(JsSerialize(script, &buffer, JsParseScriptAttributeNone) == JsNoError);
+
+        BYTE *bcBuffer = nullptr;
+        unsigned int bcBufferSize = 0;
+        REQUIRE(JsGetArrayBufferStorage(buffer, &bcBuffer, &bcBufferSize) == JsNoError);
+
+        FILE *file = nullptr;
+        REQUIRE(fopen_s(&file, fileName, "wb") == 0);
+        REQUIRE(fwrite(bcBuffer, 1, bcBufferSize, file) == bcBufferSize);
+        fclose(file);
+
+        // Run from the mapped file
+        JsValueRef mappedBuffer = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateSerializedFileBuffer(fileName, &mappedBuffer) == JsNoError);
+
+        BYTE *mappedStorage = nullptr;
+        unsigned int mappedSize = 0;
+        REQUIRE(JsGetArrayBufferStorage(mappedBuffer, &mappedStorage, &mappedSize) == JsNoError);
+        REQUIRE(mappedSize == bcBufferSize);
+        CHECK(memcmp(mappedStorage, bcBuffer, bcBufferSize) == 0);
+
+        JsValueRef sourceUrl = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString("mapped.js", strlen("mapped.js"), &sourceUrl) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunSerialized(mappedBuffer,
+            [](JsSourceContext sourceContext, JsValueRef* value, JsParseScriptAttributes* parseAttributes)
+            {
+                *parseAttributes = JsParseScriptAttributeNone;
+                return JsCreateString((LPCSTR)sourceContext, static_cast<size_t>(-1), value) == JsNoError;
+            }, (JsSourceContext)raw_script, sourceUrl, &result) == JsNoError);
+
+        int intValue = 0;
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 42);
+
+        CHECK(JsCreateSerializedFileBuffer("JsSerializedFileBufferTest.missing", &mappedBuffer) == JsErrorInvalidArgument);
+
+        // Best effort: the file stays mapped until the buffer is collected
+        remove(fileName);
+    }
+
+    TEST_CASE("ApiTest_JsSerializedFileBuffer", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsSerializedFileBufferTest);
+    }
+
+    void ApiTest_JsBackgroundParseTest(JsRuntimeAttributes /*attributes*/, JsRuntimeHandle /*runtime*/)
+    {
+        // The buffer is released as soon as the parse is queued
+        const char* source = "var bgParsed = (function (){ function inner(x) { return x * 2; } return inner(21); })(); bgParsed;";
+        size_t length = strlen(source);
+        char* script = new char[length];
+        memcpy(script, source, length);
+        JsBackgroundParseCookie cookie = 0;
+        JsErrorCode error = JsQueueBackgroundParse(script, length, "bgparse.js", &cookie);
+        delete[] script;
+        if (error == JsErrorNotImplemented)
+        {
+            return;
+        }
+        REQUIRE(error == JsNoError);
+        CHECK(cookie != 0);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunBackgroundParseResult(cookie, JS_SOURCE_CONTEXT_NONE, &result) == JsNoError);
+        int intValue = 0;
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 42);
+
+        // The cookie can only be used once
+        CHECK(JsRunBackgroundParseResult(cookie, JS_SOURCE_CONTEXT_NONE, &result) == JsErrorInvalidArgument);
+        CHECK(JsDiscardBackgroundParse(cookie) == JsErrorInvalidArgument);
+
+        // Syntax errors are reported when the result is run
+        const char* badScript = "(function (){return true;})(;";
+        REQUIRE(JsQueueBackgroundParse(badScript, strlen(badScript), "bad.js", &cookie) == JsNoError);
+        CHECK(JsRunBackgroundParseResult(cookie, JS_SOURCE_CONTEXT_NONE, &result) == JsErrorScriptCompile);
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+
+        // A discarded parse can't be run
+        const char* unusedScript = "1 + 1;";
+        REQUIRE(JsQueueBackgroundParse(unusedScript, strlen(unusedScript), "unused.js", &cookie) == JsNoError);
+        REQUIRE(JsDiscardBackgroundParse(cookie) == JsNoError);
+        CHECK(JsRunBackgroundParseResult(cookie, JS_SOURCE_CONTEXT_NONE, &result) == JsErrorInvalidArgument);
+
+        CHECK(JsQueueBackgroundParse(unusedScript, 0, "empty.js", &cookie) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_JsBackgroundParse", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsBackgroundParseTest);
+    }
+
+    // Returns the path of the only code cache entry in directory, or an empty string if there is not exactly one
+    std::string FindCodeCacheEntry(const std::string& directory)
+    {
+        std::string entryPath;
+        int entryCount = 0;
+        WIN32_FIND_DATAA findData;
+        HANDLE find = FindFirstFileA((directory + "\\*.jsc").c_str(), &findData);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                entryPath = directory + "\\" + findData.cFileName;
+                entryCount++;
+            } while (FindNextFileA(find, &findData));
+            FindClose(find);
+        }
+        return entryCount == 1 ? entryPath : std::string();
+    }
+
+    bool GetCodeCacheEntryInfo(const std::string& entryPath, BY_HANDLE_FILE_INFORMATION* info)
+    {
+        HANDLE file = CreateFileA(entryPath.c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        BOOL succeeded = GetFileInformationByHandle(file, info);
+        CloseHandle(file);
+        return succeeded != FALSE;
+    }
+
+    bool SetCodeCacheEntryTime(const std::string& entryPath, const FILETIME& lastWriteTime)
+    {
+        HANDLE file = CreateFileA(entryPath.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        BOOL succeeded = SetFileTime(file, nullptr, nullptr, &lastWriteTime);
+        CloseHandle(file);
+        return succeeded != FALSE;
+    }
+
+    bool DeleteCodeCacheDirectory(const std::string& directory)
+    {
+        WIN32_FIND_DATAA findData;
+        HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &findData);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+                {
+                    DeleteFileA((directory + "\\" + findData.cFileName).c_str());
+                }
+            } while (FindNextFileA(find, &findData));
+            FindClose(find);
+        }
+        return RemoveDirectoryA(directory.c_str()) != FALSE;
+    }
+
+    void ApiTest_JsCodeCacheTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // A directory of our own, so that entries left by earlier runs are not found
+        char tempPath[MAX_PATH];
+        REQUIRE(GetTempPathA(MAX_PATH, tempPath) != 0);
+        const std::string directoryPath = std::string(tempPath) + "JsCodeCacheTest-" + std::to_string(GetCurrentProcessId());
+        const char* directory = directoryPath.c_str();
+        DeleteCodeCacheDirectory(directoryPath);
+
+        JsErrorCode error = JsSetRuntimeCodeCacheDirectory(runtime, directory, 1024 * 1024);
+        if (error == JsErrorNotImplemented)
+        {
+            return;
+        }
+        REQUIRE(error == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, nullptr, 0) == JsNoError);
+        CHECK(FindCodeCacheEntry(directoryPath).empty());
+
+        const char* source = "function add(a, b) { return a + b; } add(40, 2);";
+        const char* url = "codecache.js";
+        JsValueRef script = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(source, strlen(source), &script) == JsNoError);
+        JsValueRef sourceUrl = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(url, strlen(url), &sourceUrl) == JsNoError);
+
+        // The first run, in another runtime, writes the entry; disposing the runtime waits for the write
+        JsContextRef fixtureContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&fixtureContext) == JsNoError);
+        JsRuntimeHandle writerRuntime = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef writerContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &writerRuntime) == JsNoError);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(writerRuntime, directory, 1024 * 1024) == JsNoError);
+        REQUIRE(JsCreateContext(writerRuntime, &writerContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(writerContext) == JsNoError);
+        {
+            JsValueRef writerScript = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(source, strlen(source), &writerScript) == JsNoError);
+            JsValueRef writerUrl = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(url, strlen(url), &writerUrl) == JsNoError);
+            JsValueRef result = JS_INVALID_REFERENCE;
+            REQUIRE(JsRun(writerScript, JS_SOURCE_CONTEXT_NONE, writerUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+        }
+        REQUIRE(JsSetCurrentContext(JS_INVALID_REFERENCE) == JsNoError);
+        REQUIRE(JsDisposeRuntime(writerRuntime) == JsNoError);
+        REQUIRE(JsSetCurrentContext(fixtureContext) == JsNoError);
+
+        const std::string entryPath = FindCodeCacheEntry(directoryPath);
+        REQUIRE(!entryPath.empty());
+        BY_HANDLE_FILE_INFORMATION writtenInfo;
+        REQUIRE(GetCodeCacheEntryInfo(entryPath, &writtenInfo));
+
+        // Date the entry back, so that the touch of a cache hit shows in its last write time
+        FILETIME oldTime;
+        SYSTEMTIME oldSystemTime = { 2000, 1, 0, 1, 0, 0, 0, 0 };
+        REQUIRE(SystemTimeToFileTime(&oldSystemTime, &oldTime));
+        REQUIRE(SetCodeCacheEntryTime(entryPath, oldTime));
+
+        // The second run is deserialized from the entry and must behave the same
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, directory, 1024 * 1024) == JsNoError);
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRun(script, JS_SOURCE_CONTEXT_NONE, sourceUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+        int intValue = 0;
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 42);
+
+        // A hit touches the entry in place. A miss would have queued a write that replaces the file instead;
+        // turning the cache off waits for any such write.
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, nullptr, 0) == JsNoError);
+        BY_HANDLE_FILE_INFORMATION usedInfo;
+        REQUIRE(GetCodeCacheEntryInfo(entryPath, &usedInfo));
+        CHECK(usedInfo.nFileIndexHigh == writtenInfo.nFileIndexHigh);
+        CHECK(usedInfo.nFileIndexLow == writtenInfo.nFileIndexLow);
+        CHECK(CompareFileTime(&usedInfo.ftLastWriteTime, &oldTime) > 0);
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, directory, 1024 * 1024) == JsNoError);
+
+        // Function source comes from the script, not from the entry
+        const char* toStringSource = "add.toString()";
+        JsValueRef toStringScript = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(toStringSource, strlen(toStringSource), &toStringScript) == JsNoError);
+        REQUIRE(JsRun(toStringScript, JS_SOURCE_CONTEXT_NONE, sourceUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+        char text[64] = { 0 };
+        size_t written = 0;
+        REQUIRE(JsCopyString(result, text, sizeof(text) - 1, &written) == JsNoError);
+        CHECK(strcmp(text, "function add(a, b) { return a + b; }") == 0);
+
+        // UTF8 buffers are cached too, and compile errors are reported as usual
+        const char* utf8Source = "var fromBuffer = 'caf\xc3\xa9'; fromBuffer.length;";
+        JsValueRef utf8Script = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalArrayBuffer((void*)utf8Source, (unsigned int)strlen(utf8Source), nullptr, nullptr, &utf8Script) == JsNoError);
+        REQUIRE(JsRun(utf8Script, JS_SOURCE_CONTEXT_NONE, sourceUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 4);
+
+        const char* badSource = "(function (){return true;})(;";
+        JsValueRef badScript = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(badSource, strlen(badSource), &badScript) == JsNoError);
+        CHECK(JsRun(badScript, JS_SOURCE_CONTEXT_NONE, sourceUrl, JsParseScriptAttributeNone, &result) == JsErrorScriptCompile);
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+
+        CHECK(JsSetRuntimeCodeCacheDirectory(runtime, "", 1024 * 1024) == JsErrorInvalidArgument);
+        CHECK(JsSetRuntimeCodeCacheDirectory(runtime, directory, 0) == JsErrorInvalidArgument);
+
+        // Turning the cache off waits for the pending writes, after which the directory can be removed
+        REQUIRE(JsSetRuntimeCodeCacheDirectory(runtime, nullptr, 0) == JsNoError);
+        CHECK(DeleteCodeCacheDirectory(directoryPath));
+    }
+
+    TEST_CASE("ApiTest_JsCodeCache", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsCodeCacheTest);
+    }
+
+    void ApiTest_JsScriptProfileTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        const char* source = "function add(a, b) { return a + b; } var sum = 0; for (var i = 0; i < 100; i++) { sum = add(sum, i); } sum;";
+        const char* otherSource = "function add(a, b) { return a - b; } add(0, 0);";
+        const char* url = "profile.js";
+        const JsSourceContext sourceContext = 1;
+        JsValueRef script = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(source, strlen(source), &script) == JsNoError);
+        JsValueRef sourceUrl = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString(url, strlen(url), &sourceUrl) == JsNoError);
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRun(script, sourceContext, sourceUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+
+        // The fixture runtime doesn't collect profiles
+        JsValueRef profile = JS_INVALID_REFERENCE;
+        JsErrorCode error = JsSerializeScriptProfile(script, sourceContext, &profile);
+        if (error == JsErrorNotImplemented)
+        {
+            return;
+        }
+        CHECK(error == JsErrorInvalidArgument);
+
+        // Nothing is profiled when native code generation is off
+        if (attributes & (JsRuntimeAttributeDisableNativeCodeGeneration | JsRuntimeAttributeDisableExecutablePageAllocation))
+        {
+            return;
+        }
+
+        JsContextRef fixtureContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&fixtureContext) == JsNoError);
+        const JsRuntimeAttributes profileAttributes = (JsRuntimeAttributes)(attributes | JsRuntimeAttributeEnableProfilePersistence);
+
+        // The first process runs the script and serializes its profile
+        BYTE* profileBytes = nullptr;
+        unsigned int profileLength = 0;
+        JsRuntimeHandle writerRuntime = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef writerContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateRuntime(profileAttributes, nullptr, &writerRuntime) == JsNoError);
+        REQUIRE(JsCreateContext(writerRuntime, &writerContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(writerContext) == JsNoError);
+        {
+            JsValueRef writerScript = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(source, strlen(source), &writerScript) == JsNoError);
+            JsValueRef writerUrl = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(url, strlen(url), &writerUrl) == JsNoError);
+
+            // Nothing ran with the source context yet
+            CHECK(JsSerializeScriptProfile(writerScript, sourceContext, &profile) == JsErrorInvalidArgument);
+
+            REQUIRE(JsRun(writerScript, sourceContext, writerUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+            REQUIRE(JsSerializeScriptProfile(writerScript, sourceContext, &profile) == JsNoError);
+
+            BYTE* buffer = nullptr;
+            REQUIRE(JsGetArrayBufferStorage(profile, &buffer, &profileLength) == JsNoError);
+            REQUIRE(profileLength > 0);
+            profileBytes = new BYTE[profileLength];
+            memcpy(profileBytes, buffer, profileLength);
+
+            CHECK(JsSerializeScriptProfile(writerScript, JS_SOURCE_CONTEXT_NONE, &profile) == JsErrorInvalidArgument);
+        }
+        REQUIRE(JsSetCurrentContext(JS_INVALID_REFERENCE) == JsNoError);
+        REQUIRE(JsDisposeRuntime(writerRuntime) == JsNoError);
+
+        // The second process loads it before running the same script
+        JsRuntimeHandle readerRuntime = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef readerContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateRuntime(profileAttributes, nullptr, &readerRuntime) == JsNoError);
+        REQUIRE(JsCreateContext(readerRuntime, &readerContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(readerContext) == JsNoError);
+        {
+            JsValueRef readerScript = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(source, strlen(source), &readerScript) == JsNoError);
+            JsValueRef otherScript = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(otherSource, strlen(otherSource), &otherScript) == JsNoError);
+            JsValueRef readerUrl = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateString(url, strlen(url), &readerUrl) == JsNoError);
+            JsValueRef readerProfile = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateExternalArrayBuffer(profileBytes, profileLength, nullptr, nullptr, &readerProfile) == JsNoError);
+
+            // Profiles of other scripts and corrupt profiles are rejected
+            CHECK(JsLoadScriptProfile(otherScript, sourceContext, readerUrl, readerProfile) == JsErrorInvalidArgument);
+            profileBytes[profileLength - 1] ^= 0xff;
+            CHECK(JsLoadScriptProfile(readerScript, sourceContext, readerUrl, readerProfile) == JsErrorInvalidArgument);
+            profileBytes[profileLength - 1] ^= 0xff;
+
+            REQUIRE(JsLoadScriptProfile(readerScript, sourceContext, readerUrl, readerProfile) == JsNoError);
+            CHECK(JsLoadScriptProfile(readerScript, sourceContext, readerUrl, readerProfile) == JsErrorInvalidArgument);
+
+            REQUIRE(JsRun(readerScript, sourceContext, readerUrl, JsParseScriptAttributeNone, &result) == JsNoError);
+            int intValue = 0;
+            REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+            CHECK(intValue == 4950);
+
+            // The profile can be serialized again for the next process
+            REQUIRE(JsSerializeScriptProfile(readerScript, sourceContext, &profile) == JsNoError);
+        }
+        REQUIRE(JsSetCurrentContext(JS_INVALID_REFERENCE) == JsNoError);
+        REQUIRE(JsDisposeRuntime(readerRuntime) == JsNoError);
+        REQUIRE(JsSetCurrentContext(fixtureContext) == JsNoError);
+
+        delete[] profileBytes;
+    }
+
+    TEST_CASE("ApiTest_JsScriptProfile", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsScriptProfileTest);
+    }
+
+    namespace StartupSnapshotStreams
+    {
+        // Startup snapshot resources are kept in memory by name (the uri is ignored)
+        std::map<std::string, std::vector<byte>> resources;
+
+        struct Stream
+        {
+            std::vector<byte>* bytes;
+            size_t cursor;
+        };
+
+        JsTTDStreamHandle CHAKRA_CALLBACK OpenResourceStream(size_t uriLength, const char* uri, size_t asciiNameLength, const char* asciiResourceName, bool read, bool write)
+        {
+            std::string name(asciiResourceName, asciiNameLength);
+            if (read && resources.find(name) == resources.end())
+            {
+                return nullptr;
+            }
+
+            if (write)
+            {
+                resources[name].clear();
+            }
+
+            return new Stream{ &resources[name], 0 };
+        }
+
+        bool CHAKRA_CALLBACK ReadBytesFromStream(JsTTDStreamHandle handle, byte* buff, size_t size, size_t* readCount)
+        {
+            Stream* stream = static_cast<Stream*>(handle);
+            size_t available = stream->bytes->size() - stream->cursor;
+            *readCount = (size < available) ? size : available;
+            memcpy(buff, stream->bytes->data() + stream->cursor, *readCount);
+            stream->cursor += *readCount;
+            return true;
+        }
+
+        bool CHAKRA_CALLBACK WriteBytesToStream(JsTTDStreamHandle handle, const byte* buff, size_t size, size_t* writtenCount)
+        {
+            Stream* stream = static_cast<Stream*>(handle);
+            stream->bytes->insert(stream->bytes->end(), buff, buff + size);
+            *writtenCount = size;
+            return true;
+        }
+
+        void CHAKRA_CALLBACK FlushAndCloseStream(JsTTDStreamHandle handle, bool read, bool write)
+        {
+            delete static_cast<Stream*>(handle);
+        }
+
+        JsErrorCode CreateRecordRuntime(JsRuntimeAttributes attributes, JsRuntimeHandle* runtime)
+        {
+            return JsTTDCreateRecordRuntime(attributes, false, UINT32_MAX, UINT32_MAX, &OpenResourceStream, &WriteBytesToStream, &FlushAndCloseStream, nullptr, runtime);
+        }
+
+        JsErrorCode RunScript(const char* source, const char* url, JsValueRef* result)
+        {
+            JsValueRef script = JS_INVALID_REFERENCE;
+            JsValueRef sourceUrl = JS_INVALID_REFERENCE;
+            if (JsCreateString(source, strlen(source), &script) != JsNoError || JsCreateString(url, strlen(url), &sourceUrl) != JsNoError)
+            {
+                return JsErrorFatal;
+            }
+
+            return JsRun(script, JS_SOURCE_CONTEXT_NONE, sourceUrl, JsParseScriptAttributeNone, result);
+        }
+    }
+
+    void ApiTest_JsTTDStartupSnapshotTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        const char* bootstrap = "var answer = 42; var greeting = 'hello'; function twice(x) { return 2 * x; } var config = { depth: twice(3) };";
+        const char* check = "answer + greeting.length + twice(config.depth)";
+        const char* uri = "startup";
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int intValue = 0;
+
+        JsContextRef fixtureContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&fixtureContext) == JsNoError);
+        StartupSnapshotStreams::resources.clear();
+
+        // The first process runs the bootstrap script and writes the snapshot
+        JsRuntimeHandle writerRuntime = JS_INVALID_RUNTIME_HANDLE;
+        JsErrorCode error = StartupSnapshotStreams::CreateRecordRuntime(attributes, &writerRuntime);
+        if (error == JsErrorCategoryUsage)
+        {
+            // Time travel (and so startup snapshots) isn't part of this build
+            return;
+        }
+        REQUIRE(error == JsNoError);
+
+        JsContextRef writerContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsTTDCreateContext(writerRuntime, true, &writerContext) == JsNoError);
+        REQUIRE(JsSetCurrentContext(writerContext) == JsNoError);
+        REQUIRE(StartupSnapshotStreams::RunScript(bootstrap, "bootstrap.js", &result) == JsNoError);
+        REQUIRE(JsTTDWriteStartupSnapshot_Experimental(uri, strlen(uri)) == JsNoError);
+
+        // A snapshot holds a single context
+        JsContextRef otherContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsTTDCreateContext(writerRuntime, true, &otherContext) == JsNoError);
+        CHECK(JsTTDWriteStartupSnapshot_Experimental(uri, strlen(uri)) == JsErrorInvalidArgument);
+
+        REQUIRE(JsSetCurrentContext(JS_INVALID_REFERENCE) == JsNoError);
+        REQUIRE(JsDisposeRuntime(writerRuntime) == JsNoError);
+        REQUIRE(StartupSnapshotStreams::resources.count("snap_0.snp") == 1);
+
+        // The second process inflates it without running the bootstrap script
+        JsRuntimeHandle readerRuntime = JS_INVALID_RUNTIME_HANDLE;
+        REQUIRE(StartupSnapshotStreams::CreateRecordRuntime(attributes, &readerRuntime) == JsNoError);
+
+        JsContextRef readerContext = JS_INVALID_REFERENCE;
+        std::map<std::string, std::vector<byte>> savedResources = StartupSnapshotStreams::resources;
+
+        // Missing, damaged, and truncated snapshots are rejected and leave the runtime as it was
+        StartupSnapshotStreams::resources.erase("ttdstartup.dig");
+        CHECK(JsTTDCreateContextFromStartupSnapshot_Experimental(readerRuntime, uri, strlen(uri), &StartupSnapshotStreams::ReadBytesFromStream, &readerContext) == JsErrorBadSerializedScript);
+        StartupSnapshotStreams::resources = savedResources;
+
+        std::vector<byte>& snapBytes = StartupSnapshotStreams::resources["snap_0.snp"];
+        snapBytes[snapBytes.size() / 2] ^= 0xff;
+        CHECK(JsTTDCreateContextFromStartupSnapshot_Experimental(readerRuntime, uri, strlen(uri), &StartupSnapshotStreams::ReadBytesFromStream, &readerContext) == JsErrorBadSerializedScript);
+        CHECK(readerContext == JS_INVALID_REFERENCE);
+        snapBytes[snapBytes.size() / 2] ^= 0xff;
+
+        snapBytes.pop_back();
+        CHECK(JsTTDCreateContextFromStartupSnapshot_Experimental(readerRuntime, uri, strlen(uri), &StartupSnapshotStreams::ReadBytesFromStream, &readerContext) == JsErrorBadSerializedScript);
+        StartupSnapshotStreams::resources = savedResources;
+
+        REQUIRE(JsTTDCreateContextFromStartupSnapshot_Experimental(readerRuntime, uri, strlen(uri), &StartupSnapshotStreams::ReadBytesFromStream, &readerContext) == JsNoError);
+        REQUIRE(readerContext != JS_INVALID_REFERENCE);
+        REQUIRE(JsSetCurrentContext(readerContext) == JsNoError);
+
+        // The globals the bootstrap script set up are back
+        REQUIRE(StartupSnapshotStreams::RunScript(check, "check.js", &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &intValue) == JsNoError);
+        CHECK(intValue == 59);
+
+        // Only one snapshot goes into a runtime
+        JsContextRef secondContext = JS_INVALID_REFERENCE;
+        CHECK(JsTTDCreateContextFromStartupSnapshot_Experimental(readerRuntime, uri, strlen(uri), &StartupSnapshotStreams::ReadBytesFromStream, &secondContext) == JsErrorInvalidArgument);
+
+        REQUIRE(JsSetCurrentContext(JS_INVALID_REFERENCE) == JsNoError);
+        REQUIRE(JsDisposeRuntime(readerRuntime) == JsNoError);
+        REQUIRE(JsSetCurrentContext(fixtureContext) == JsNoError);
+
+        StartupSnapshotStreams::resources.clear();
+    }
+
+    TEST_CASE("ApiTest_JsTTDStartupSnapshot", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ApiTest_JsTTDStartupSnapshotTest);
+    }
+
     void JsCreatePromiseTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
     {
         JsValueRef result = JS_INVALID_REFERENCE;
@@ -173,6 +173,9 @@ bool ChakraRTInterface::LoadChakraDll(ArgInfo* argInfo, HINSTANCE *outLibrary)
     m_jsApiHooks.pfJsrtQueueBackgroundParse_Experimental = (JsAPIHooks::JsrtQueueBackgroundParse_Experimental)GetChakraCoreSymbol(library, "JsQueueBackgroundParse_Experimental");
     m_jsApiHooks.pfJsrtDiscardBackgroundParse_Experimental = (JsAPIHooks::JsrtDiscardBackgroundParse_Experimental)GetChakraCoreSymbol(library, "JsDiscardBackgroundParse_Experimental");
     m_jsApiHooks.pfJsrtExecuteBackgroundParse_Experimental = (JsAPIHooks::JsrtExecuteBackgroundParse_Experimental)GetChakraCoreSymbol(library, "JsExecuteBackgroundParse_Experimental");
+    m_jsApiHooks.pfJsrtQueueBackgroundParse = (JsAPIHooks::JsrtQueueBackgroundParse)GetChakraCoreSymbol(library, "JsQueueBackgroundParse");
+    m_jsApiHooks.pfJsrtRunBackgroundParseResult = (JsAPIHooks::JsrtRunBackgroundParseResult)GetChakraCoreSymbol(library, "JsRunBackgroundParseResult");
+    m_jsApiHooks.pfJsrtSetRuntimeCodeCacheDirectory = (JsAPIHooks::JsrtSetRuntimeCodeCacheDirectory)GetChakraCoreSymbol(library, "JsSetRuntimeCodeCacheDirectory");
 
     m_jsApiHooks.pfJsrtTTDCreateRecordRuntime = (JsAPIHooks::JsrtTTDCreateRecordRuntimePtr)GetChakraCoreSymbol(library, "JsTTDCreateRecordRuntime");
     m_jsApiHooks.pfJsrtTTDCreateReplayRuntime = (JsAPIHooks::JsrtTTDCreateReplayRuntimePtr)GetChakraCoreSymbol(library, "JsTTDCreateReplayRuntime");
@@ -106,6 +106,9 @@ struct JsAPIHooks
     typedef JsErrorCode(WINAPI *JsrtQueueBackgroundParse_Experimental)(JsScriptContents* contents, DWORD* dwBgParseCookie);
     typedef JsErrorCode(WINAPI *JsrtDiscardBackgroundParse_Experimental)(DWORD dwBgParseCookie, void* buffer, bool* callerOwnsBuffer);
     typedef JsErrorCode(WINAPI *JsrtExecuteBackgroundParse_Experimental)(DWORD dwBgParseCookie, JsValueRef script, JsSourceContext sourceContext, WCHAR *url, JsParseScriptAttributes parseAttributes, JsValueRef parserState, JsValueRef *result);
+    typedef JsErrorCode(WINAPI *JsrtQueueBackgroundParse)(const char* script, size_t length, const char* sourceUrl, JsBackgroundParseCookie* cookie);
+    typedef JsErrorCode(WINAPI *JsrtRunBackgroundParseResult)(JsBackgroundParseCookie cookie, JsSourceContext sourceContext, JsValueRef* result);
+    typedef JsErrorCode(WINAPI *JsrtSetRuntimeCodeCacheDirectory)(JsRuntimeHandle runtime, const char* directory, size_t maxSizeInBytes);
 
     typedef JsErrorCode(WINAPI *JsrtTTDCreateRecordRuntimePtr)(JsRuntimeAttributes attributes, bool enableDebugging, size_t snapInterval, size_t snapHistoryLength, TTDOpenResourceStreamCallback openResourceStream, JsTTDWriteBytesToStreamCallback writeBytesToStream, JsTTDFlushAndCloseStreamCallback flushAndCloseStream, JsThreadServiceCallback threadService, JsRuntimeHandle *runtime);
     typedef JsErrorCode(WINAPI *JsrtTTDCreateReplayRuntimePtr)(JsRuntimeAttributes attributes, const char* infoUri, size_t infoUriCount, bool enableDebugging, TTDOpenResourceStreamCallback openResourceStream, JsTTDReadBytesFromStreamCallback readBytesFromStream, JsTTDFlushAndCloseStreamCallback flushAndCloseStream, JsThreadServiceCallback threadService, JsRuntimeHandle *runtime);
@@ -242,6 +245,9 @@ struct JsAPIHooks
     JsrtQueueBackgroundParse_Experimental pfJsrtQueueBackgroundParse_Experimental;
     JsrtDiscardBackgroundParse_Experimental pfJsrtDiscardBackgroundParse_Experimental;
     JsrtExecuteBackgroundParse_Experimental pfJsrtExecuteBackgroundParse_Experimental;
+    JsrtQueueBackgroundParse pfJsrtQueueBackgroundParse;
+    JsrtRunBackgroundParseResult pfJsrtRunBackgroundParseResult;
+    JsrtSetRuntimeCodeCacheDirectory pfJsrtSetRuntimeCodeCacheDirectory;
 
     JsrtTTDCreateRecordRuntimePtr pfJsrtTTDCreateRecordRuntime;
     JsrtTTDCreateReplayRuntimePtr pfJsrtTTDCreateReplayRuntime;
@@ -510,6 +516,9 @@ class ChakraRTInterface
     static JsErrorCode WINAPI JsQueueBackgroundParse_Experimental(JsScriptContents* contents, DWORD* dwBgParseCookie) { return HOOK_JS_API(QueueBackgroundParse_Experimental)(contents, dwBgParseCookie);  }
     static JsErrorCode WINAPI JsDiscardBackgroundParse_Experimental(DWORD dwBgParseCookie, void* buffer, bool* callerOwnsBuffer) { return HOOK_JS_API(DiscardBackgroundParse_Experimental(dwBgParseCookie, buffer, callerOwnsBuffer)); }
     static JsErrorCode WINAPI JsExecuteBackgroundParse_Experimental(DWORD dwBgParseCookie, JsValueRef script, JsSourceContext sourceContext, WCHAR *url, JsParseScriptAttributes parseAttributes, JsValueRef parserState, JsValueRef *result) { return HOOK_JS_API(ExecuteBackgroundParse_Experimental(dwBgParseCookie, script, sourceContext, url, parseAttributes, parserState, result)); }
+    static JsErrorCode WINAPI JsQueueBackgroundParse(const char* script, size_t length, const char* sourceUrl, JsBackgroundParseCookie* cookie) { return HOOK_JS_API(QueueBackgroundParse(script, length, sourceUrl, cookie)); }
+    static JsErrorCode WINAPI JsRunBackgroundParseResult(JsBackgroundParseCookie cookie, JsSourceContext sourceContext, JsValueRef* result) { return HOOK_JS_API(RunBackgroundParseResult(cookie, sourceContext, result)); }
+    static JsErrorCode WINAPI JsSetRuntimeCodeCacheDirectory(JsRuntimeHandle runtime, const char* directory, size_t maxSizeInBytes) { return HOOK_JS_API(SetRuntimeCodeCacheDirectory(runtime, directory, maxSizeInBytes)); }
 #ifdef _WIN32
     static JsErrorCode WINAPI JsConnectJITProcess(HANDLE processHandle, void* serverSecurityDescriptor, UUID connectionId) { return HOOK_JS_API(ConnectJITProcess(processHandle, serverSecurityDescriptor, connectionId)); }
 #endif
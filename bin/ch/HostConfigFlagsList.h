@@ -21,5 +21,7 @@ FLAG(bool, Module,                          "load the script as a module", false
 FLAG(bool, TrackRejectedPromises,           "Enable tracking of unhandled promise rejections", false)
 FLAG(BSTR, CustomConfigFile,                "Custom config file to be used to pass in additional flags to Chakra", NULL)
 FLAG(bool, ExecuteWithBgParse,              "Load script with bgparse (note: requires bgparse and parserstatecache be on as well)", false)
+FLAG(bool, BackgroundParse,                 "Parse the script on a background thread with JsQueueBackgroundParse before running it", false)
+FLAG(BSTR, CodeCacheDirectory,              "Cache the byte code of the scripts run in the given directory (JsSetRuntimeCodeCacheDirectory)", NULL)
 #undef FLAG
 #endif
@@ -463,6 +463,23 @@ HRESULT RunScript(const char* fileName, LPCSTR fileContents, size_t fileLength,
             unsigned int lengthBytes = (unsigned int) fileLength;
             runScript = (JsErrorCode)RunBgParseSync(fileContents, lengthBytes, fileName);
         }
+        else if (HostConfigFlags::flags.BackgroundParse && !HostConfigFlags::flags.DebugLaunch)
+        {
+            // The script is copied when it is queued, so it can be freed right away
+            JsBackgroundParseCookie cookie = 0;
+            runScript = ChakraRTInterface::JsQueueBackgroundParse(fileContents, fileLength, fullPath, &cookie);
+            if (fileContentsFinalizeCallback != nullptr)
+            {
+                fileContentsFinalizeCallback((void*)fileContents);
+            }
+
+            if (runScript == JsNoError)
+            {
+                auto sourceContext = WScriptJsrt::GetNextSourceContext();
+                WScriptJsrt::RegisterScriptDir(sourceContext, fullPath);
+                runScript = ChakraRTInterface::JsRunBackgroundParseResult(cookie, sourceContext, nullptr /*result*/);
+            }
+        }
         else // bufferValue == nullptr && parserStateCache == nullptr
         {
             JsValueRef scriptSource;
@@ -606,6 +623,15 @@ static HRESULT CreateRuntime(JsRuntimeHandle *runtime)
     IfJsErrorFailLog(ChakraRTInterface::JsSetRuntimeMemoryLimit(*runtime, memoryLimit));
 #endif
 
+    if (HostConfigFlags::flags.CodeCacheDirectoryIsEnabled)
+    {
+        char* codeCacheDirectory = nullptr;
+        IfFailGo(WideStringToNarrowDynamic(HostConfigFlags::flags.CodeCacheDirectory, &codeCacheDirectory));
+        JsErrorCode errorCode = ChakraRTInterface::JsSetRuntimeCodeCacheDirectory(*runtime, codeCacheDirectory, 64 * 1024 * 1024);
+        free(codeCacheDirectory);
+        IfJsErrorFailLog(errorCode);
+    }
+
     hr = S_OK;
 Error:
     return hr;
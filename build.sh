@@ -71,6 +71,8 @@ PRINT_USAGE() {
     echo "                       Disable FEATUREs from JSRT experimental features."
     echo "     --valgrind        Enable Valgrind support"
     echo "                       !!! Disables Concurrent GC (lower performance)"
+    echo "     --huge-pages      Enable -RecyclerHugePages support (64-bit Linux only)"
+    echo "                       Uses 2MB page segments for every page allocator"
     echo "     --ccache[=NAME]   Enable ccache, optionally with a custom binary name."
     echo "                       Default: ccache"
     echo " -v, --verbose         Display verbose output including all options"
@@ -122,6 +124,7 @@ WB_ANALYZE=
 WB_ARGS=
 TARGET_PATH=0
 VALGRIND=0
+HUGE_PAGES=""
 # -DCMAKE_EXPORT_COMPILE_COMMANDS=ON useful for clang-query tool
 CMAKE_EXPORT_COMPILE_COMMANDS="-DCMAKE_EXPORT_COMPILE_COMMANDS=ON"
 LIBS_ONLY_BUILD=
@@ -391,6 +394,10 @@ while [[ $# -gt 0 ]]; do
         VALGRIND="-DENABLE_VALGRIND_SH=1"
         ;;
 
+    --huge-pages)
+        HUGE_PAGES="-DENABLE_RECYCLER_HUGE_PAGES_SH=1"
+        ;;
+
     -y | -Y)
         ALWAYS_YES=-y
         ;;
@@ -674,7 +681,7 @@ echo $EXTRA_DEFINES
 cmake $CMAKE_GEN $CC_PREFIX $CMAKE_ICU $LTO $LTTNG $STATIC_LIBRARY $ARCH $TARGET_OS \
     $ENABLE_CC_XPLAT_TRACE $EXTRA_DEFINES -DCMAKE_BUILD_TYPE=$BUILD_TYPE $SANITIZE $NO_JIT $CMAKE_INTL \
     $WITHOUT_FEATURES $WB_FLAG $WB_ARGS $CMAKE_EXPORT_COMPILE_COMMANDS $LIBS_ONLY_BUILD\
-    $VALGRIND $BUILD_RELATIVE_DIRECTORY $CCACHE_NAME
+    $VALGRIND $HUGE_PAGES $BUILD_RELATIVE_DIRECTORY $CCACHE_NAME
 
 _RET=$?
 if [[ $? == 0 ]]; then
@@ -54,6 +54,35 @@ Js::JavascriptNumber *
 CodeGenNumberThreadAllocator::AllocNumber()
 {
     AutoCriticalSection autocs(&cs);
+    return AllocNumberLocked();
+}
+
+CodeGenNumberChunk *
+CodeGenNumberThreadAllocator::AllocChunk()
+{
+    AutoCriticalSection autocs(&cs);
+    return AllocChunkLocked();
+}
+
+CodeGenNumberChunk *
+CodeGenNumberThreadAllocator::AllocChunkWithNumbers(Js::JavascriptNumber * (&numbers)[CodeGenNumberChunk::MaxNumberCount])
+{
+    AutoCriticalSection autocs(&cs);
+
+    // The chunk has to come first. See AllocNewChunkBlock for how the number blocks
+    // pending reference are released when the chunk block fills up.
+    CodeGenNumberChunk * newChunk = AllocChunkLocked();
+    for (int i = 0; i < CodeGenNumberChunk::MaxNumberCount; i++)
+    {
+        numbers[i] = AllocNumberLocked();
+    }
+    return newChunk;
+}
+
+Js::JavascriptNumber *
+CodeGenNumberThreadAllocator::AllocNumberLocked()
+{
+    Assert(cs.IsLocked());
     size_t sizeCat = GetNumberAllocSize();
     if (nextNumber + sizeCat > currentNumberBlockEnd)
     {
@@ -69,9 +98,9 @@ CodeGenNumberThreadAllocator::AllocNumber()
 }
 
 CodeGenNumberChunk *
-CodeGenNumberThreadAllocator::AllocChunk()
+CodeGenNumberThreadAllocator::AllocChunkLocked()
 {
-    AutoCriticalSection autocs(&cs);
+    Assert(cs.IsLocked());
     size_t sizeCat = GetChunkAllocSize();
     if (nextChunk + sizeCat > currentChunkBlockEnd)
     {
@@ -235,17 +264,10 @@ CodeGenNumberThreadAllocator::Integrate()
 #endif
 }
 
-void
-CodeGenNumberThreadAllocator::FlushAllocations()
-{
-    AutoCriticalSection autocs(&cs);
-    pendingFlushNumberBlock.MoveTo(&pendingIntegrationNumberBlock);
-    pendingFlushChunkBlock.MoveTo(&pendingIntegrationChunkBlock);
-}
-
 CodeGenNumberAllocator::CodeGenNumberAllocator(CodeGenNumberThreadAllocator * threadAlloc, Recycler * recycler) :
     threadAlloc(threadAlloc), recycler(recycler), chunk(nullptr), chunkTail(nullptr), currentChunkNumberCount(CodeGenNumberChunk::MaxNumberCount)
 {
+    memset(reservedNumbers, 0, sizeof(reservedNumbers));
 #if DBG
     finalized = false;
 #endif
@@ -258,7 +280,7 @@ CodeGenNumberAllocator::Alloc()
     Assert(!finalized);
     if (currentChunkNumberCount == CodeGenNumberChunk::MaxNumberCount)
     {
-        CodeGenNumberChunk * newChunk = threadAlloc? threadAlloc->AllocChunk()
+        CodeGenNumberChunk * newChunk = threadAlloc? threadAlloc->AllocChunkWithNumbers(this->reservedNumbers)
             : RecyclerNewStructZ(recycler, CodeGenNumberChunk);
         // Need to always put the new chunk last, as when we flush
         // pages, new chunk's page might not be full yet, and won't
@@ -275,7 +297,7 @@ CodeGenNumberAllocator::Alloc()
         this->chunkTail = newChunk;
         this->currentChunkNumberCount = 0;
     }
-    Js::JavascriptNumber * newNumber = threadAlloc? threadAlloc->AllocNumber()
+    Js::JavascriptNumber * newNumber = threadAlloc? this->reservedNumbers[this->currentChunkNumberCount]
         : Js::JavascriptNumber::NewUninitialized(recycler);
     this->chunkTail->numbers[this->currentChunkNumberCount++] = newNumber;
     return newNumber;
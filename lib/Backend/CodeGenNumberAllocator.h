@@ -73,13 +73,23 @@ class CodeGenNumberThreadAllocator
     // Multiple jit threads access this.
     Js::JavascriptNumber * AllocNumber();
     CodeGenNumberChunk * AllocChunk();
+    // Allocates a chunk together with the numbers it will reference under a single lock.
+    // The chunk is carved before its numbers, so a number block never gets flushed ahead
+    // of the chunk block that keeps it alive.
+    // Until the JIT stores them into the chunk, the reserved numbers are only referenced from
+    // the CodeGenNumberAllocator, which the recycler doesn't scan. That is safe for the same
+    // reason the chunk itself is: another JIT thread filling a block only moves it between the
+    // pending lists, and Integrate only turns the blocks on pendingIntegration*Block into heap
+    // blocks the recycler sweeps.
+    CodeGenNumberChunk * AllocChunkWithNumbers(Js::JavascriptNumber * (&numbers)[CodeGenNumberChunk::MaxNumberCount]);
     void Integrate();
-    void FlushAllocations();
 
 private:
     // All allocations are small allocations
     const size_t BlockSize = SmallAllocationBlockAttributes::PageCount * AutoSystemInfo::PageSize;
 
+    Js::JavascriptNumber * AllocNumberLocked();
+    CodeGenNumberChunk * AllocChunkLocked();
     void AllocNewNumberBlock();
     void AllocNewChunkBlock();
     size_t GetNumberAllocSize();
@@ -145,6 +155,8 @@ class CodeGenNumberAllocator
     CodeGenNumberChunk * chunk;
     CodeGenNumberChunk * chunkTail;
     uint currentChunkNumberCount;
+    // Numbers carved out along with chunkTail by the thread allocator, handed out without locking
+    Js::JavascriptNumber * reservedNumbers[CodeGenNumberChunk::MaxNumberCount];
 #if DBG
     bool finalized;
 #endif
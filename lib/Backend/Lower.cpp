@@ -20613,6 +20613,217 @@ Lowerer::GenerateFastInlineStringSplitMatch(IR::Instr * instr)
     RelocateCallDirectToHelperPath(tmpInstr, labelHelper);
 }
 
+void
+Lowerer::GenerateFastInlineRegExpExecSyncToCharPrefilter(IR::RegOpnd * opndRegex, IR::RegOpnd * opndString, IR::RegOpnd * opndStartOffset, IR::Opnd * callDst, IR::LabelInstr * doneLabel, IR::Instr * instr)
+{
+    // This is a prefilter, not a regex compiler. When the regex program starts by syncing to a character that a match
+    // must consume, the matcher hard fails on any input that doesn't contain the character. Scan for it here and only go
+    // to the helper when it is present, telling the helper where the earliest match could start:
+    //
+    //      MOV  startOffset, 0
+    //      MOV  program, [[regex + pattern] + program]
+    //      CMP  [program + tag], InstructionsTag
+    //      JNE  $helper
+    //      TEST [program + flags], GlobalRegexFlag
+    //      JNE  $helper
+    //      MOV  inst, [program + insts]
+    //      MOV  instTag, [inst + tag]
+    //      MOV  backup, 0
+    //      CMP  instTag, SyncToCharAndConsume
+    //      JEQ  $scan
+    //      CMP  instTag, SyncToCharAndBackup
+    //      JNE  $helper
+    //      MOV  backup, [inst + backup.upper]          ; CharCountFlag if unbounded
+    // $scan:
+    //      MOVZX syncChar, [inst + c]
+    //      MOV  buffer, [string + m_pszValue]          ; String_GetSz if null
+    //      MOV  cursor, buffer
+    //      LEA  end, [buffer + length * 2]
+    // $loopTop:
+    //      CMP  cursor, end
+    //      JAE  $noMatch
+    //      MOVZX inputChar, [cursor]
+    //      CMP  inputChar, syncChar
+    //      JEQ  $found
+    //      ADD  cursor, 2
+    //      JMP  $loopTop
+    // $noMatch:
+    //      lastIndex = 0, dst = null
+    //      JMP  $done
+    // $found:
+    //      SUB  cursor, buffer
+    //      SHR  cursor, 1
+    //      CMP  cursor, backup
+    //      JB   $helper                            ; a match could start anywhere before the character
+    //      SUB  startOffset, cursor, backup
+    // $helper:
+
+    Assert(UnifiedRegex::SyncToCharAndConsumeInst::GetOffsetOfChar() == UnifiedRegex::SyncToCharAndBackupInst::GetOffsetOfChar());
+
+    IR::LabelInstr *labelHelper = IR::LabelInstr::New(Js::OpCode::Label, m_func);
+
+    Lowerer::InsertMove(opndStartOffset, IR::IntConstOpnd::New(0, TyUint32, m_func), instr);
+
+    IR::RegOpnd *opndPattern = IR::RegOpnd::New(TyMachPtr, m_func);
+    Lowerer::InsertMove(
+        opndPattern,
+        IR::IndirOpnd::New(opndRegex, Js::JavascriptRegExp::GetOffsetOfPattern(), TyMachPtr, m_func),
+        instr);
+
+    IR::RegOpnd *opndProgram = IR::RegOpnd::New(TyMachPtr, m_func);
+    Lowerer::InsertMove(
+        opndProgram,
+        IR::IndirOpnd::New(opndPattern, offsetof(UnifiedRegex::RegexPattern, rep) + offsetof(UnifiedRegex::RegexPattern::UnifiedRep, program), TyMachPtr, m_func),
+        instr);
+
+    InsertCompareBranch(
+        IR::IndirOpnd::New(opndProgram, (int32)UnifiedRegex::Program::GetOffsetOfTag(), TyUint8, m_func),
+        IR::IntConstOpnd::New((IntConstType)UnifiedRegex::Program::GetInstructionsTag(), TyUint8, m_func),
+        Js::OpCode::BrNeq_A,
+        labelHelper,
+        instr);
+
+    // Global regexes start matching at lastIndex
+    InsertTestBranch(
+        IR::IndirOpnd::New(opndProgram, offsetof(UnifiedRegex::Program, flags), TyUint8, m_func),
+        IR::IntConstOpnd::New(UnifiedRegex::GlobalRegexFlag, TyUint8, m_func),
+        Js::OpCode::BrNeq_A,
+        labelHelper,
+        instr);
+
+    IR::RegOpnd *opndInst = IR::RegOpnd::New(TyMachPtr, m_func);
+    Lowerer::InsertMove(
+        opndInst,
+        IR::IndirOpnd::New(opndProgram, (int32)(UnifiedRegex::Program::GetOffsetOfRep() + UnifiedRegex::Program::GetOffsetOfInstructionsInsts()), TyMachPtr, m_func),
+        instr);
+
+    IR::RegOpnd *opndInstTag = IR::RegOpnd::New(TyUint8, m_func);
+    Lowerer::InsertMove(
+        opndInstTag,
+        IR::IndirOpnd::New(opndInst, (int32)UnifiedRegex::Inst::GetOffsetOfTag(), TyUint8, m_func),
+        instr);
+
+    // The match starts at the character for SyncToCharAndConsume and up to backup.upper characters before it for
+    // SyncToCharAndBackup
+    IR::RegOpnd *opndBackup = IR::RegOpnd::New(TyUint32, m_func);
+    Lowerer::InsertMove(opndBackup, IR::IntConstOpnd::New(0, TyUint32, m_func), instr);
+
+    IR::LabelInstr *labelScan = IR::LabelInstr::New(Js::OpCode::Label, m_func);
+    InsertCompareBranch(
+        opndInstTag,
+        IR::IntConstOpnd::New((IntConstType)UnifiedRegex::Inst::InstTag::SyncToCharAndConsume, TyUint8, m_func),
+        Js::OpCode::BrEq_A,
+        labelScan,
+        instr);
+    InsertCompareBranch(
+        opndInstTag,
+        IR::IntConstOpnd::New((IntConstType)UnifiedRegex::Inst::InstTag::SyncToCharAndBackup, TyUint8, m_func),
+        Js::OpCode::BrNeq_A,
+        labelHelper,
+        instr);
+
+    Lowerer::InsertMove(
+        opndBackup,
+        IR::IndirOpnd::New(opndInst, (int32)UnifiedRegex::SyncToCharAndBackupInst::GetOffsetOfBackupUpper(), TyUint32, m_func),
+        instr);
+
+    instr->InsertBefore(labelScan);
+
+    IR::RegOpnd *opndSyncChar = IR::RegOpnd::New(TyUint32, m_func);
+    Lowerer::InsertMove(
+        opndSyncChar,
+        IR::IndirOpnd::New(opndInst, (int32)UnifiedRegex::SyncToCharAndConsumeInst::GetOffsetOfChar(), TyUint16, m_func),
+        instr);
+
+    IR::RegOpnd *opndBuffer = IR::RegOpnd::New(TyMachReg, m_func);
+    Lowerer::InsertMove(
+        opndBuffer,
+        IR::IndirOpnd::New(opndString, Js::JavascriptString::GetOffsetOfpszValue(), TyMachPtr, m_func),
+        instr);
+
+    IR::LabelInstr *labelGotString = IR::LabelInstr::New(Js::OpCode::Label, m_func);
+    InsertTestBranch(opndBuffer, opndBuffer, Js::OpCode::BrNeq_A, labelGotString, instr);
+
+    m_lowererMD.LoadHelperArgument(instr, opndString);
+    IR::Instr *instrCall = IR::Instr::New(Js::OpCode::Call, opndBuffer, IR::HelperCallOpnd::New(IR::HelperString_GetSz, m_func), m_func);
+    instr->InsertBefore(instrCall);
+    m_lowererMD.LowerCall(instrCall, 0);
+
+    instr->InsertBefore(labelGotString);
+
+    IR::RegOpnd *opndLength = IR::RegOpnd::New(TyUint32, m_func);
+    Lowerer::InsertMove(
+        opndLength,
+        IR::IndirOpnd::New(opndString, offsetof(Js::JavascriptString, m_charLength), TyUint32, m_func),
+        instr);
+    if (opndLength->GetSize() != MachPtr)
+    {
+        opndLength = opndLength->UseWithNewType(TyMachPtr, m_func)->AsRegOpnd();
+    }
+
+    IR::RegOpnd *opndEnd = IR::RegOpnd::New(TyMachPtr, m_func);
+    InsertLea(opndEnd, IR::IndirOpnd::New(opndBuffer, opndLength, 1, TyUint16, m_func), instr);
+
+    IR::RegOpnd *opndCursor = IR::RegOpnd::New(TyMachReg, m_func);
+    Lowerer::InsertMove(opndCursor, opndBuffer, instr);
+
+    IR::LabelInstr *labelNoMatch = IR::LabelInstr::New(Js::OpCode::Label, m_func);
+    IR::LabelInstr *labelFound = IR::LabelInstr::New(Js::OpCode::Label, m_func);
+    IR::LabelInstr *loopTop = InsertLoopTopLabel(instr);
+    Loop *loop = loopTop->GetLoop();
+
+    InsertCompareBranch(opndCursor, opndEnd, Js::OpCode::BrGe_A, true, labelNoMatch, instr);
+
+    IR::RegOpnd *opndInputChar = IR::RegOpnd::New(TyUint32, m_func);
+    Lowerer::InsertMove(opndInputChar, IR::IndirOpnd::New(opndCursor, 0, TyUint16, m_func), instr);
+    InsertCompareBranch(opndInputChar, opndSyncChar, Js::OpCode::BrEq_A, labelFound, instr);
+
+    InsertAdd(false, opndCursor, opndCursor, IR::IntConstOpnd::New(sizeof(char16), TyMachReg, m_func), instr);
+    InsertBranch(Js::OpCode::Br, loopTop, instr);
+
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndCursor->m_sym->m_id);
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndBuffer->m_sym->m_id);
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndEnd->m_sym->m_id);
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndSyncChar->m_sym->m_id);
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndBackup->m_sym->m_id);
+    loop->regAlloc.liveOnBackEdgeSyms->Set(opndStartOffset->m_sym->m_id);
+
+    // The character isn't in the input, so there is no match
+    instr->InsertBefore(labelNoMatch);
+
+    Lowerer::InsertMove(
+        IR::IndirOpnd::New(opndRegex, Js::JavascriptRegExp::GetOffsetOfLastIndexVar(), TyVar, m_func),
+        IR::AddrOpnd::NewNull(m_func),
+        instr);
+
+    Lowerer::InsertMove(
+        IR::IndirOpnd::New(opndRegex, Js::JavascriptRegExp::GetOffsetOfLastIndexOrFlag(), TyUint32, m_func),
+        IR::IntConstOpnd::New(0, TyUint32, m_func),
+        instr);
+
+    if (callDst)
+    {
+        Lowerer::InsertMove(
+            callDst,
+            LoadLibraryValueOpnd(instr, LibraryValue::ValueNull),
+            instr);
+    }
+
+    InsertBranch(Js::OpCode::Br, doneLabel, instr);
+
+    // No match can start before the first occurrence of the character less the backup
+    instr->InsertBefore(labelFound);
+
+    InsertSub(false, opndCursor, opndCursor, opndBuffer, instr);
+    InsertShift(Js::OpCode::ShrU_A, false, opndCursor, opndCursor, IR::IntConstOpnd::New(1, TyInt8, m_func), instr);
+
+    IR::RegOpnd *opndFoundOffset = opndCursor->UseWithNewType(TyUint32, m_func)->AsRegOpnd();
+    InsertCompareBranch(opndFoundOffset, opndBackup, Js::OpCode::BrLt_A, true, labelHelper, instr);
+    InsertSub(false, opndStartOffset, opndFoundOffset, opndBackup, instr);
+
+    instr->InsertBefore(labelHelper);
+}
+
 void
 Lowerer::GenerateFastInlineRegExpExec(IR::Instr * instr)
 {
@@ -20767,6 +20978,16 @@ Lowerer::GenerateFastInlineRegExpExec(IR::Instr * instr)
         instr->InsertBefore(labelFastHelper);
     }
 
+    // Where the helper starts matching (non-global regexes only)
+    IR::Opnd *opndStartOffset = IR::IntConstOpnd::New(0, TyUint32, m_func);
+    if (!PHASE_OFF(Js::ExecSyncToCharPrefilterPhase, m_func))
+    {
+        opndStartOffset = IR::RegOpnd::New(TyUint32, m_func);
+        GenerateFastInlineRegExpExecSyncToCharPrefilter(opndRegex->AsRegOpnd(), opndString->AsRegOpnd(), opndStartOffset->AsRegOpnd(), callDst, doneLabel, instr);
+
+        PHASE_PRINT_TRACE(Js::ExecSyncToCharPrefilterPhase, m_func, _u("ExecSyncToCharPrefilter: emitted in %s\n"), m_func->GetJITFunctionBody()->GetDisplayName());
+    }
+
     IR::Instr * helperCallInstr = IR::Instr::New(LowererMD::MDCallOpcode, instr->m_func);
     if (callDst)
     {
@@ -20777,9 +20998,10 @@ Lowerer::GenerateFastInlineRegExpExec(IR::Instr * instr)
     {
         helperCallInstr = AddBailoutToHelperCallInstr(helperCallInstr, instr->GetBailOutInfo(), instr->GetBailOutKind(), instr);
     }
-    // [stackAllocationPointer, ]scriptcontext, regexp, string (to be pushed in reverse order)
+    // [stackAllocationPointer, ]scriptcontext, regexp, string, startOffset (to be pushed in reverse order)
 
-    //string, regexp
+    //startOffset, string, regexp
+    this->m_lowererMD.LoadHelperArgument(helperCallInstr, opndStartOffset);
     this->m_lowererMD.LoadHelperArgument(helperCallInstr, opndString);
     this->m_lowererMD.LoadHelperArgument(helperCallInstr, opndRegex);
 
@@ -549,6 +549,7 @@ class Lowerer
     template <bool Saturate> void GenerateTruncWithCheck(_In_ IR::Instr* instr);
     void            GenerateFastInlineMathFround(IR::Instr* instr);
     void            GenerateFastInlineRegExpExec(IR::Instr * instr);
+    void            GenerateFastInlineRegExpExecSyncToCharPrefilter(IR::RegOpnd * opndRegex, IR::RegOpnd * opndString, IR::RegOpnd * opndStartOffset, IR::Opnd * callDst, IR::LabelInstr * doneLabel, IR::Instr * instr);
     bool            GenerateFastPush(IR::Opnd *baseOpndParam, IR::Opnd *src, IR::Instr *callInstr, IR::Instr *insertInstr, IR::LabelInstr *labelHelper, IR::LabelInstr *doneLabel, IR::LabelInstr * bailOutLabelHelper, bool returnLength = false);
     bool            GenerateFastReplace(IR::Opnd* strOpnd, IR::Opnd* src1, IR::Opnd* src2, IR::Instr *callInstr, IR::Instr *insertInstr, IR::LabelInstr *labelHelper, IR::LabelInstr *doneLabel);
     bool            ShouldGenerateStringReplaceFastPath(IR::Instr * instr, IntConstType argCount);
@@ -232,6 +232,7 @@ enum VTableValue {
     VtablePropertyString,
     VtableLazyJSONString,
     VtableLiteralStringWithPropertyStringPtr,
+    VtableOneByteString,
     VtableJavascriptBoolean,
     VtableJavascriptArray,
     VtableInt8Array,
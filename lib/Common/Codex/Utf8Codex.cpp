@@ -4,6 +4,12 @@
 //-------------------------------------------------------------------------------------------------------
 #include "Utf8Codex.h"
 
+// The codex is built on its own for ch, without lib/Common on the include path, so it checks for x64 directly
+// rather than using ENABLE_SSE2_FAST_PATHS from CommonDefines.h
+#if defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #ifndef _WIN32
 #undef _Analysis_assume_
 #define _Analysis_assume_(expr)
@@ -334,6 +340,94 @@ namespace utf8
             return ptr;
     }
     
+    // Widens the run of ASCII bytes at the start of [pb, pbEnd) into dest and returns its length.
+    _At_(dest, _Out_writes_to_(pbEnd - pb, return))
+    inline size_t DecodeAsciiRun(char16 *dest, LPCUTF8 pb, LPCUTF8 pbEnd)
+    {
+        size_t count = 0;
+        const size_t cb = pbEnd - pb;
+
+#if defined(_M_X64)
+        // Sixteen bytes at a time. Only blocks that are all ASCII are stored whole, as dest may have no room
+        // beyond the characters the input decodes to.
+        const __m128i zero = _mm_setzero_si128();
+        while (cb - count >= 16)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb + count));
+            const int mask = _mm_movemask_epi8(bytes);
+            if (mask != 0)
+            {
+                DWORD asciiCount;
+                _BitScanForward(&asciiCount, (DWORD)mask);
+                for (DWORD i = 0; i < asciiCount; i++)
+                {
+                    dest[count + i] = pb[count + i];
+                }
+                return count + asciiCount;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + count), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + count + 8), _mm_unpackhi_epi8(bytes, zero));
+            count += 16;
+        }
+#else
+        if (ShouldFastPath(pb, dest))
+        {
+            while (cb - count >= 4)
+            {
+                unsigned bytes = *(const unsigned *)(pb + count);
+                if ((bytes & 0x80808080) != 0) break;
+                ((uint32 *)(dest + count))[0] = (char16(bytes) & 0x00FF) | ((char16(bytes) & 0xFF00) << 8);
+                ((uint32 *)(dest + count))[1] = (char16(bytes >> 16) & 0x00FF) | ((char16(bytes >> 16) & 0xFF00) << 8);
+                count += 4;
+            }
+        }
+#endif
+
+        while (count < cb && pb[count] < 0x80)
+        {
+            dest[count] = pb[count];
+            count++;
+        }
+        return count;
+    }
+
+    // Decodes a well-formed two or three byte sequence at ptr without going through DecodeTail. Anything else,
+    // including truncated sequences, surrogates and noncharacters, is left to Decode so that the options apply.
+    _At_(ptr, _In_reads_(end - ptr))
+    inline bool TryDecodeTwoOrThreeBytes(LPCUTF8& ptr, LPCUTF8 end, char16& ch)
+    {
+        const utf8char_t c1 = ptr[0];
+        if (InRange(c1, 0xC2, 0xDF))
+        {
+            if (end - ptr < 2 || (ptr[1] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            ch = char16(((c1 & 0x1F) << 6) | (ptr[1] & 0x3F));
+            ptr += 2;
+            return true;
+        }
+
+        if (InRange(c1, 0xE0, 0xEF))
+        {
+            if (end - ptr < 3 || (ptr[1] & 0xC0) != 0x80 || (ptr[2] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            const char16 decoded = char16(((c1 & 0x0F) << 12) | ((ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F));
+            if (decoded < 0x0800 || InRange(decoded, WCH_UTF16_HIGH_FIRST, WCH_UTF16_LOW_LAST) || !IsValidWideChar(decoded))
+            {
+                // Overlong encoding, surrogate or noncharacter
+                return false;
+            }
+            ch = decoded;
+            ptr += 3;
+            return true;
+        }
+
+        return false;
+    }
+
     _Use_decl_annotations_
     size_t DecodeUnitsInto(char16 *buffer, LPCUTF8& pbUtf8, LPCUTF8 pbEnd, DecodeOptions options, bool *chunkEndsAtTruncatedSequence)
     {
@@ -347,37 +441,32 @@ namespace utf8
         LPCUTF8 p = pbUtf8;
         char16 *dest = buffer;
 
-        if (!ShouldFastPath(p, dest)) goto LSlowPath;
-
-LFastPath:
-        while (p + 3 < pbEnd)
-        {
-            unsigned bytes = *(unsigned *)p;
-            if ((bytes & 0x80808080) != 0) goto LSlowPath;
-            ((uint32 *)dest)[0] = (char16(bytes) & 0x00FF) | ((char16(bytes) & 0xFF00) << 8);
-            ((uint32 *)dest)[1] = (char16(bytes >> 16) & 0x00FF) | ((char16(bytes >> 16) & 0xFF00) << 8);
-            p += 4;
-            dest += 4;
-        }
-
-LSlowPath:
         while (p < pbEnd)
         {
-            LPCUTF8 s = p;
-            char16 chDest = Decode(p, pbEnd, localOptions, chunkEndsAtTruncatedSequence);
-
-            if (s < p)
+            // The second half of a surrogate pair always starts on a continuation byte, so neither of the fast
+            // paths takes it from Decode
+            const size_t asciiCount = DecodeAsciiRun(dest, p, pbEnd);
+            p += asciiCount;
+            dest += asciiCount;
+            if (p == pbEnd)
             {
-                // We decoded the character, store it
-                *dest++ = chDest;
+                break;
             }
-            else
+
+            char16 chDest;
+            if (!TryDecodeTwoOrThreeBytes(p, pbEnd, chDest))
             {
-                // Nothing was converted. This might happen at the end of a buffer with doChunkedEncoding.
-                break;
+                LPCUTF8 s = p;
+                chDest = Decode(p, pbEnd, localOptions, chunkEndsAtTruncatedSequence);
+
+                if (s == p)
+                {
+                    // Nothing was converted. This might happen at the end of a buffer with doChunkedEncoding.
+                    break;
+                }
             }
 
-            if (ShouldFastPath(p, dest)) goto LFastPath;
+            *dest++ = chDest;
         }
 
         pbUtf8 = p;
@@ -412,6 +501,82 @@ namespace utf8
         return true;
     }
 
+    // Narrows the run of ASCII characters at the start of source into dest and returns its length.
+    template <bool countBytesOnly>
+    inline charcount_t EncodeAsciiRun(
+        _When_(!countBytesOnly, _Out_writes_(bufferEnd - dest)) utf8char_t *dest,
+        const utf8char_t *bufferEnd,
+        _In_reads_(cch) const char16 *source,
+        charcount_t cch)
+    {
+        charcount_t count = 0;
+
+#if defined(_M_X64)
+        const __m128i nonAsciiBits = _mm_set1_epi16((short)~0x7F);
+        const __m128i zero = _mm_setzero_si128();
+        while (cch - count >= 16)
+        {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + count));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + count + 8));
+            const DWORD asciiMask =
+                (DWORD)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(low, nonAsciiBits), zero)) |
+                ((DWORD)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(high, nonAsciiBits), zero)) << 16);
+            if (asciiMask != 0xFFFFFFFF)
+            {
+                // Two mask bits per character
+                DWORD nonAsciiBit;
+                _BitScanForward(&nonAsciiBit, ~asciiMask);
+                const charcount_t asciiCount = nonAsciiBit / 2;
+                if (!countBytesOnly)
+                {
+                    CodexAssertOrFailFast(dest + count + asciiCount <= bufferEnd);
+                    for (charcount_t i = 0; i < asciiCount; i++)
+                    {
+                        dest[count + i] = (utf8char_t)source[count + i];
+                    }
+                }
+                return count + asciiCount;
+            }
+
+            if (!countBytesOnly)
+            {
+                CodexAssertOrFailFast(dest + count + 16 <= bufferEnd);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + count), _mm_packus_epi16(low, high));
+            }
+            count += 16;
+        }
+#else
+        if (ShouldFastPath(dest, source))
+        {
+            while (cch - count >= 4)
+            {
+                uint32 first = ((const uint32 *)(source + count))[0];
+                if ((first & 0xFF80FF80) != 0) break;
+                uint32 second = ((const uint32 *)(source + count))[1];
+                if ((second & 0xFF80FF80) != 0) break;
+
+                if (!countBytesOnly)
+                {
+                    CodexAssertOrFailFast(dest + count + 4 <= bufferEnd);
+                    *(uint32 *)(dest + count) = (first & 0x0000007F) | ((first & 0x007F0000) >> 8) | ((second & 0x0000007f) << 16) | ((second & 0x007F0000) << 8);
+                }
+                count += 4;
+            }
+        }
+#endif
+
+        while (count < cch && source[count] < 0x80)
+        {
+            if (!countBytesOnly)
+            {
+                CodexAssertOrFailFast(dest + count < bufferEnd);
+                dest[count] = (utf8char_t)source[count];
+            }
+            count++;
+        }
+        return count;
+    }
+
     template <Utf8EncodingKind encoding, bool countBytesOnly = false>
     __range(0, cbDest)
     size_t EncodeIntoImpl(
@@ -426,45 +591,29 @@ namespace utf8
 
         CodexAssertOrFailFast(dest <= bufferEnd);
 
-        if (!ShouldFastPath(dest, source)) goto LSlowPath;
-
-LFastPath:
-        while (cch >= 4)
+        while (cch > 0)
         {
-            uint32 first = ((const uint32 *)source)[0];
-            if ( (first & 0xFF80FF80) != 0) goto LSlowPath;
-            uint32 second = ((const uint32 *)source)[1];
-            if ( (second & 0xFF80FF80) != 0) goto LSlowPath;
-
-            if (!countBytesOnly)
+            const charcount_t asciiCount = EncodeAsciiRun<countBytesOnly>(dest, bufferEnd, source, cch);
+            dest += asciiCount;
+            source += asciiCount;
+            cch -= asciiCount;
+            if (cch == 0)
             {
-                CodexAssertOrFailFast(dest + 4 <= bufferEnd);
-                *(uint32 *)dest = (first & 0x0000007F) | ((first & 0x007F0000) >> 8) | ((second & 0x0000007f) << 16) | ((second & 0x007F0000) << 8);
+                break;
             }
-            dest += 4;
-            source += 4;
-            cch -= 4;
-        }
 
-LSlowPath:
-        if (encoding == Utf8EncodingKind::Cesu8)
-        {
-            while (cch-- > 0)
+            cch--;
+            if (encoding == Utf8EncodingKind::Cesu8)
             {
                 dest = Encode<countBytesOnly>(*source++, dest, bufferEnd);
-                if (ShouldFastPath(dest, source)) goto LFastPath;
             }
-        }
-        else
-        {
-            while (cch-- > 0)
+            else
             {
                 // We increment the source pointer here since at least one utf16 code unit is read here
                 // If the code unit turns out to be the high surrogate in a surrogate pair, then
                 // EncodeTrueUtf8 will consume the low surrogate code unit too by decrementing cch
                 // and incrementing source
                 dest = EncodeTrueUtf8<countBytesOnly>(*source++, &source, &cch, dest, bufferEnd);
-                if (ShouldFastPath(dest, source)) goto LFastPath;
             }
         }
 
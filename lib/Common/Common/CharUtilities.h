@@ -0,0 +1,290 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// Searching, comparing and ASCII case mapping over char16 buffers. On x64 these process eight characters
+// at a time with SSE2 and finish with a scalar loop. -SimdStringPrimitives- selects the scalar loops
+// everywhere, for comparing the two in benchmarks.
+
+namespace Js
+{
+    class CharUtilities
+    {
+    private:
+#if ENABLE_SSE2_FAST_PATHS
+        static const charcount_t SimdChars = sizeof(__m128i) / sizeof(char16);
+
+        static inline __m128i Load(const char16* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        // Index of the first/last char16 lane set in a _mm_movemask_epi8 of a 16-bit compare
+        static inline charcount_t FirstLane(int mask)
+        {
+            DWORD index;
+            _BitScanForward(&index, (DWORD)mask);
+            return (charcount_t)(index / sizeof(char16));
+        }
+
+        static inline charcount_t LastLane(int mask)
+        {
+            DWORD index;
+            _BitScanReverse(&index, (DWORD)mask);
+            return (charcount_t)(index / sizeof(char16));
+        }
+
+        static inline int ClearLane(int mask, charcount_t lane)
+        {
+            return mask & ~(3 << (lane * sizeof(char16)));
+        }
+#endif
+
+    public:
+        // Longer needles are better served by the callers' Boyer-Moore searches, which skip ahead by up to the needle's
+        // length at each step instead of checking every position
+        static const charcount_t MaxSimdSearchLength = 16;
+
+        static inline bool UseSimd()
+        {
+#if ENABLE_SSE2_FAST_PATHS
+            // Read once, as this is on the path of every property record and dictionary key comparison
+            static const bool useSimd = CONFIG_FLAG(SimdStringPrimitives);
+            return useSimd;
+#else
+            return false;
+#endif
+        }
+
+        static inline bool UseSimdSearch(charcount_t searchLength)
+        {
+            return searchLength <= MaxSimdSearchLength && UseSimd();
+        }
+
+        // Returns the index of the first c at or after position, or -1
+        static int IndexOfChar(__in_ecount(length) const char16* input, charcount_t length, char16 c, charcount_t position)
+        {
+            charcount_t i = position;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                const __m128i pattern = _mm_set1_epi16((short)c);
+                for (; i + SimdChars <= length; i += SimdChars)
+                {
+                    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(Load(input + i), pattern));
+                    if (mask != 0)
+                    {
+                        return (int)(i + FirstLane(mask));
+                    }
+                }
+            }
+#endif
+            for (; i < length; i++)
+            {
+                if (input[i] == c)
+                {
+                    return (int)i;
+                }
+            }
+            return -1;
+        }
+
+        // Returns the index of the last c at or before position, or -1
+        static int LastIndexOfChar(__in_ecount(position + 1) const char16* input, char16 c, charcount_t position)
+        {
+            int i = (int)position;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                const __m128i pattern = _mm_set1_epi16((short)c);
+                for (; i + 1 >= (int)SimdChars; i -= (int)SimdChars)
+                {
+                    const int blockStart = i + 1 - (int)SimdChars;
+                    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(Load(input + blockStart), pattern));
+                    if (mask != 0)
+                    {
+                        return blockStart + (int)LastLane(mask);
+                    }
+                }
+            }
+#endif
+            for (; i >= 0; i--)
+            {
+                if (input[i] == c)
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        // Returns the index of the first occurrence of search at or after position, or -1. Candidates are found by
+        // matching the first and last characters of search in parallel, and only those are compared in full.
+        static int IndexOf(__in_ecount(length) const char16* input, charcount_t length, __in_ecount(searchLength) const char16* search, charcount_t searchLength, charcount_t position)
+        {
+            Assert(searchLength >= 2);
+            if (position > length || length - position < searchLength)
+            {
+                return -1;
+            }
+
+            const charcount_t last = searchLength - 1;
+            charcount_t i = position;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                const __m128i firstPattern = _mm_set1_epi16((short)search[0]);
+                const __m128i lastPattern = _mm_set1_epi16((short)search[last]);
+                for (; i + last + SimdChars <= length; i += SimdChars)
+                {
+                    int mask = _mm_movemask_epi8(_mm_and_si128(
+                        _mm_cmpeq_epi16(Load(input + i), firstPattern),
+                        _mm_cmpeq_epi16(Load(input + i + last), lastPattern)));
+                    while (mask != 0)
+                    {
+                        const charcount_t lane = FirstLane(mask);
+                        if (wmemcmp(input + i + lane + 1, search + 1, last) == 0)
+                        {
+                            return (int)(i + lane);
+                        }
+                        mask = ClearLane(mask, lane);
+                    }
+                }
+            }
+#endif
+            for (; i + last < length; i++)
+            {
+                if (input[i] == search[0] && input[i + last] == search[last] && wmemcmp(input + i + 1, search + 1, last) == 0)
+                {
+                    return (int)i;
+                }
+            }
+            return -1;
+        }
+
+        // Returns the index of the last occurrence of search starting at or before position, or -1. The caller
+        // guarantees position + searchLength <= the input length.
+        static int LastIndexOf(__in_ecount(position + searchLength) const char16* input, __in_ecount(searchLength) const char16* search, charcount_t searchLength, charcount_t position)
+        {
+            Assert(searchLength >= 2);
+            const charcount_t last = searchLength - 1;
+            int i = (int)position;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                const __m128i firstPattern = _mm_set1_epi16((short)search[0]);
+                const __m128i lastPattern = _mm_set1_epi16((short)search[last]);
+                for (; i + 1 >= (int)SimdChars; i -= (int)SimdChars)
+                {
+                    const int blockStart = i + 1 - (int)SimdChars;
+                    int mask = _mm_movemask_epi8(_mm_and_si128(
+                        _mm_cmpeq_epi16(Load(input + blockStart), firstPattern),
+                        _mm_cmpeq_epi16(Load(input + blockStart + last), lastPattern)));
+                    while (mask != 0)
+                    {
+                        const charcount_t lane = LastLane(mask);
+                        if (wmemcmp(input + blockStart + lane + 1, search + 1, last) == 0)
+                        {
+                            return blockStart + (int)lane;
+                        }
+                        mask = ClearLane(mask, lane);
+                    }
+                }
+            }
+#endif
+            for (; i >= 0; i--)
+            {
+                if (input[i] == search[0] && input[i + last] == search[last] && wmemcmp(input + i + 1, search + 1, last) == 0)
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        static bool Equals(__in_ecount(length) const char16* s1, __in_ecount(length) const char16* s2, charcount_t length)
+        {
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                charcount_t i = 0;
+                for (; i + SimdChars <= length; i += SimdChars)
+                {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(Load(s1 + i), Load(s2 + i))) != 0xFFFF)
+                    {
+                        return false;
+                    }
+                }
+                for (; i < length; i++)
+                {
+                    if (s1[i] != s2[i])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+#endif
+            return wmemcmp(s1, s2, length) == 0;
+        }
+
+        static bool IsAscii(__in_ecount(length) const char16* s, charcount_t length)
+        {
+            charcount_t i = 0;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                const __m128i nonAsciiBits = _mm_set1_epi16((short)~0x7F);
+                const __m128i zero = _mm_setzero_si128();
+                for (; i + SimdChars <= length; i += SimdChars)
+                {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(Load(s + i), nonAsciiBits), zero)) != 0xFFFF)
+                    {
+                        return false;
+                    }
+                }
+            }
+#endif
+            for (; i < length; i++)
+            {
+                if (s[i] >= 0x80)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Maps A-Z to a-z (or a-z to A-Z when toUpper) and copies everything else unchanged
+        template <bool toUpper>
+        static void ToAsciiCase(__in_ecount(length) const char16* src, __out_ecount(length) char16* dst, charcount_t length)
+        {
+            const char16 rangeFirst = toUpper ? _u('a') : _u('A');
+            const char16 rangeLast = toUpper ? _u('z') : _u('Z');
+            const char16 diffBetweenCases = 32;
+            charcount_t i = 0;
+#if ENABLE_SSE2_FAST_PATHS
+            if (UseSimd())
+            {
+                // Signed compares are fine here: characters at or above 0x8000 compare as negative, so out of range
+                const __m128i belowRange = _mm_set1_epi16((short)(rangeFirst - 1));
+                const __m128i aboveRange = _mm_set1_epi16((short)(rangeLast + 1));
+                const __m128i caseBit = _mm_set1_epi16((short)diffBetweenCases);
+                for (; i + SimdChars <= length; i += SimdChars)
+                {
+                    const __m128i chars = Load(src + i);
+                    const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi16(chars, belowRange), _mm_cmplt_epi16(chars, aboveRange));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(chars, _mm_and_si128(inRange, caseBit)));
+                }
+            }
+#endif
+            for (; i < length; i++)
+            {
+                const char16 cur = src[i];
+                dst[i] = (cur >= rangeFirst && cur <= rangeLast) ? (char16)(cur ^ diffBetweenCases) : cur;
+            }
+        }
+    };
+}
@@ -133,6 +133,11 @@
 #define U_HIDE_INTERNAL_API 1
 #endif
 
+// SSE2 is part of the x64 baseline, so hand-vectorized scanner, regex and string loops use it without a CPU check
+#if defined(_M_X64)
+#define ENABLE_SSE2_FAST_PATHS 1
+#endif
+
 // Language features
 #if !defined(CHAKRACORE_LITE) && (defined(_WIN32) || defined(INTL_ICU))
 #define ENABLE_INTL_OBJECT                          // Intl support
@@ -188,6 +193,14 @@
 
 #define USE_FEWER_PAGES_PER_BLOCK 1
 
+// 2MB page segments backed by transparent huge pages (-RecyclerHugePages). Opt in with build.sh --huge-pages:
+// it doubles PageSegment::MaxDataPageCount, and with it the segment bit vectors, for every page allocator.
+#ifndef ENABLE_RECYCLER_HUGE_PAGES
+#define ENABLE_RECYCLER_HUGE_PAGES 0
+#elif ENABLE_RECYCLER_HUGE_PAGES && (defined(_WIN32) || !defined(TARGET_64))
+#error ENABLE_RECYCLER_HUGE_PAGES is only supported for 64-bit Linux builds
+#endif
+
 #ifndef ENABLE_VALGRIND
 #define ENABLE_CONCURRENT_GC 1
 #ifdef _WIN32
@@ -322,6 +335,11 @@
 #endif
 #endif
 
+#if ENABLE_PROFILE_INFO
+// Dynamic profiles can be serialized so that hosts can persist them across processes
+#define DYNAMIC_PROFILE_PERSISTENCE
+#endif
+
 // Other features
 #if defined(_CHAKRACOREBUILD)
 # define CHAKRA_CORE_DOWN_COMPAT 1
@@ -103,6 +103,7 @@ PHASE(All)
             PHASE(InlinerConstFold)
             PHASE_DEFAULT_ON(InlineCallbacks)
     PHASE(ExecBOIFastPath)
+    PHASE(ExecSyncToCharPrefilter)
         PHASE(FGBuild)
             PHASE(OptimizeTryFinally)
             PHASE(RemoveBreakBlock)
@@ -445,7 +446,8 @@ PHASE(All)
 #define DEFAULT_CONFIG_WasmSignExtends      (true)
 #define DEFAULT_CONFIG_WasmNontrapping      (true)
 #define DEFAULT_CONFIG_WasmExperimental     (false)
-#define DEFAULT_CONFIG_BgParse              (false)
+#define DEFAULT_CONFIG_BgParse              (true)
+#define DEFAULT_CONFIG_BgParseUndeferBudget (1024 * 1024) // Unit is bytes of source
 #define DEFAULT_CONFIG_BgJitDelayFgBuffer   (0)
 #define DEFAULT_CONFIG_BgJitPendingFuncCap  (31)
 #define DEFAULT_CONFIG_CurrentSourceInfo    (true)
@@ -574,6 +576,15 @@ PHASE(All)
 
 #define DEFAULT_CONFIG_LowMemoryCap         (0xB900000) // 185 MB - based on memory cap for process on low-capacity device
 #define DEFAULT_CONFIG_NewPagesCapDuringBGSweeping    (15000 * 4)
+#define DEFAULT_CONFIG_RecyclerParallelMarkThreads    (0)     // 0 means pick based on the number of physical processors
+#define DEFAULT_CONFIG_RecyclerParallelMarkWorkSharing (true)
+#define DEFAULT_CONFIG_RecyclerParallelConcurrentSweep (true)
+#define DEFAULT_CONFIG_RecyclerNurseryCollect   (false)
+#define DEFAULT_CONFIG_RecyclerNurserySize      (4)     // MB of new pages between minor collections
+#define DEFAULT_CONFIG_RecyclerNurseryMaxMinorCollects (16)
+#define DEFAULT_CONFIG_RecyclerDefragmentMediumBlocks (false)
+#define DEFAULT_CONFIG_NumaAwarePageAllocator (false)
+#define DEFAULT_CONFIG_RecyclerHugePages (false)
 #define DEFAULT_CONFIG_MaxSingleAllocSizeInMB  (2048)
 #define DEFAULT_CONFIG_AllocationPolicyLimit    (-1)
 
@@ -595,9 +606,16 @@ PHASE(All)
 #define DEFAULT_CONFIG_RegexBytecodeDebug   (false)
 #define DEFAULT_CONFIG_RegexOptimize        (true)
 #define DEFAULT_CONFIG_DynamicRegexMruListSize (16)
+#define DEFAULT_CONFIG_RegexLinearMatcher   (true)
+#define DEFAULT_CONFIG_RegexBacktrackLimit  (1000000)
 #define DEFAULT_CONFIG_GoptCleanupThreshold  (25)
 #define DEFAULT_CONFIG_AsmGoptCleanupThreshold  (500)
 #define DEFAULT_CONFIG_OptimizeForManyInstances (false)
+#define DEFAULT_CONFIG_OneByteStrings       (true)
+#define DEFAULT_CONFIG_SimdStringPrimitives (true)
+#define DEFAULT_CONFIG_LazyJSONParse        (false)
+#define DEFAULT_CONFIG_LazyJSONParseThreshold (64 * 1024) // Unit is number of characters
+#define DEFAULT_CONFIG_JSONStringifyPlans   (true)
 #define DEFAULT_CONFIG_EnableArrayTypeMutation (false)
 
 #define DEFAULT_CONFIG_DeferParseThreshold             (4 * 1024) // Unit is number of characters
@@ -1020,6 +1038,7 @@ FLAGR (NumberSet, BailOutByteCode     , "Byte code location to insert BailOut. U
 FLAGNR(Boolean, Benchmark             , "Disable security code which introduce variability in benchmarks", false)
 FLAGR (Boolean, BgJit                 , "Background JIT. Disable to force heuristic-based foreground JITting. (default: true)", true)
 FLAGR (Boolean, BgParse               , "Background Parse. Disable to force all parsing to occur on UI thread. (default: true)", DEFAULT_CONFIG_BgParse)
+FLAGR (Number,  BgParseUndeferBudget  , "Bytes of source in deferred functions that a background parse compiles ahead of their first call, picked breadth first without profile data (0 to disable)", DEFAULT_CONFIG_BgParseUndeferBudget)
 FLAGNR(Number,  BgJitDelay            , "Delay to wait for speculative jitting before starting script execution", DEFAULT_CONFIG_BgJitDelay)
 FLAGNR(Number,  BgJitDelayFgBuffer    , "When speculatively jitting in the foreground thread, do so for (BgJitDelay - BgJitDelayBuffer) milliseconds", DEFAULT_CONFIG_BgJitDelayFgBuffer)
 FLAGNR(Number,  BgJitPendingFuncCap   , "Disable delay if pending function count larger then cap", DEFAULT_CONFIG_BgJitPendingFuncCap)
@@ -1507,7 +1526,18 @@ FLAGNR(Boolean, RecyclerForceMarkInterior, "Force all the mark as interior", DEF
 FLAGNR(Number,  RecyclerPriorityBoostTimeout, "Adjust priority boost timeout", 5000)
 FLAGNR(Number,  RecyclerThreadCollectTimeout, "Adjust thread collect timeout", 1000)
 FLAGRA(Boolean, EnableConcurrentSweepAlloc, ecsa, "Turns off the feature to allow allocations during concurrent sweep.", true)
+FLAGR (Number,  RecyclerParallelMarkThreads, "Max number of threads taking part in parallel mark, including the main and concurrent GC threads (max 32; default: 0, which uses up to 4 based on processor count)", DEFAULT_CONFIG_RecyclerParallelMarkThreads)
+FLAGR (Boolean, RecyclerParallelMarkWorkSharing, "Let parallel mark threads that run out of work take chunks of the mark stack from busy threads", DEFAULT_CONFIG_RecyclerParallelMarkWorkSharing)
+FLAGR (Boolean, RecyclerParallelConcurrentSweep, "Let the parallel mark threads help the concurrent GC thread sweep pending heap blocks, one heap bucket at a time", DEFAULT_CONFIG_RecyclerParallelConcurrentSweep)
 #endif
+#if ENABLE_PARTIAL_GC
+FLAGR (Boolean, RecyclerNurseryCollect, "Use partial collections as minor (nursery) collections whenever possible: only the new pages and the pages written since the last GC are marked and swept", DEFAULT_CONFIG_RecyclerNurseryCollect)
+FLAGR (Number,  RecyclerNurserySize, "MB of new pages allocated between minor collections when RecyclerNurseryCollect is on (clamped to the partial collect limits)", DEFAULT_CONFIG_RecyclerNurserySize)
+FLAGR (Number,  RecyclerNurseryMaxMinorCollects, "Number of minor collections in a row before RecyclerNurseryCollect falls back to a full collection", DEFAULT_CONFIG_RecyclerNurseryMaxMinorCollects)
+#endif
+FLAGR (Boolean, RecyclerDefragmentMediumBlocks, "After a sweep, allocate from the fuller medium heap blocks first so that sparsely used ones drain and get released", DEFAULT_CONFIG_RecyclerDefragmentMediumBlocks)
+FLAGR (Boolean, NumaAwarePageAllocator, "Commit page allocator segments on the NUMA node of the thread that creates the allocator", DEFAULT_CONFIG_NumaAwarePageAllocator)
+FLAGR (Boolean, RecyclerHugePages, "Back recycler page segments with transparent huge pages and prefer decommitting them whole (64-bit Linux builds configured with --huge-pages only)", DEFAULT_CONFIG_RecyclerHugePages)
 #ifdef RECYCLER_PAGE_HEAP
 FLAGNR(Number,      PageHeap,             "Use full page for heap allocations", DEFAULT_CONFIG_PageHeap)
 FLAGNR(Boolean,     PageHeapAllocStack,   "Capture alloc stack under page heap mode", DEFAULT_CONFIG_PageHeapAllocStack)
@@ -1609,8 +1639,15 @@ FLAGR (Boolean, RegexBytecodeDebug    , "Display layout of UnifiedRegex bytecode
 FLAGR (Boolean, RegexOptimize         , "Optimize regular expressions in the unified Regex system (default: true)", DEFAULT_CONFIG_RegexOptimize)
 FLAGR (Number,  DynamicRegexMruListSize, "Size of the MRU list for dynamic regexes", DEFAULT_CONFIG_DynamicRegexMruListSize)
 #endif
+FLAGR (Boolean, RegexLinearMatcher    , "Use a linear-time NFA for eligible regexes once backtracking exceeds -RegexBacktrackLimit, building it on first use (default: true)", DEFAULT_CONFIG_RegexLinearMatcher)
+FLAGR (Number,  RegexBacktrackLimit   , "Number of backtracks allowed per match, across all the start offsets it tries, before switching to the linear-time matcher (0: always use it when available)", DEFAULT_CONFIG_RegexBacktrackLimit)
 
 FLAGR (Boolean, OptimizeForManyInstances, "Optimize script engine for many instances (low memory footprint per engine, assume low spare CPU cycles) (default: false)", DEFAULT_CONFIG_OptimizeForManyInstances)
+FLAGR (Boolean, OneByteStrings        , "Store Latin-1 strings created through the JSRT API one byte per character until they are widened (default: true)", DEFAULT_CONFIG_OneByteStrings)
+FLAGR (Boolean, SimdStringPrimitives  , "Use the SSE2 string search, comparison and ASCII case mapping loops where available (default: true)", DEFAULT_CONFIG_SimdStringPrimitives)
+FLAGR (Boolean, LazyJSONParse         , "Defer parsing the members of nested objects in large JSON.parse inputs until they are first accessed (default: false)", DEFAULT_CONFIG_LazyJSONParse)
+FLAGR (Number,  LazyJSONParseThreshold, "Minimum JSON.parse input length, in characters, for -LazyJSONParse to apply", DEFAULT_CONFIG_LazyJSONParseThreshold)
+FLAGR (Boolean, JSONStringifyPlans    , "Cache a per-type property list with slot indexes to serialize objects of the same shape in JSON.stringify (default: true)", DEFAULT_CONFIG_JSONStringifyPlans)
 FLAGNR(Boolean, EnableArrayTypeMutation, "Enable force array type mutation on re-entrant region", DEFAULT_CONFIG_EnableArrayTypeMutation)
 FLAGNR(Number, ArrayMutationTestSeed, "Seed used for the array mutation", 0)
 FLAGNR(Phases,  TestTrace             , "Test trace for the given phase", )
@@ -81,7 +81,7 @@ namespace JsUtil
     inline bool
     CharacterBuffer<WCHAR>::StaticEquals(__in_z WCHAR const * s1, __in_z WCHAR const * s2, __in charcount_t length)
     {
-        return (s1 == s2) || wmemcmp(s1, s2, length) == 0;
+        return (s1 == s2) || Js::CharUtilities::Equals(s1, s2, length);
     }
 
     template<>
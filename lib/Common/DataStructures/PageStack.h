@@ -30,6 +30,7 @@ class PageStack
     void Release();
 
     bool IsEmpty() const;
+    bool HasMultipleChunks() const;
 #if DBG
     bool HasChunk() const
     {
@@ -44,7 +45,7 @@ class PageStack
     }
 #endif
 
-    static const uint MaxSplitTargets = 3;     // Not counting original stack, so this supports 4-way parallel
+    static const uint MaxSplitTargets = 31;    // Not counting original stack, so this supports 32-way parallel
 
 private:
     Chunk * CreateChunk();
@@ -424,3 +425,11 @@ bool PageStack<T>::IsEmpty() const
     return false;
 }
 
+
+template <typename T>
+bool PageStack<T>::HasMultipleChunks() const
+{
+    // Every chunk other than the current one is full, so a stack with more than one chunk
+    // has at least a page worth of entries that can be handed off by Split.
+    return currentChunk != nullptr && currentChunk->nextChunk != nullptr;
+}
@@ -1515,12 +1515,17 @@ SmallHeapBlockT<TBlockAttributes>::SweepObjects(Recycler * recycler)
     const char* objectAddress = address;
     uint objectBitDelta = this->GetObjectBitDelta();
 
+#ifdef RECYCLER_STATS
+    if (!isForceSweeping)
+    {
+        RECYCLER_STATS_INTERLOCKED_ADD(recycler, objectSweepScanCount, localObjectCount);
+    }
+#endif
+
     for (uint objectIndex = 0, bitIndex = 0; objectIndex < localObjectCount; objectIndex++, bitIndex += objectBitDelta)
     {
         Assert(IsValidBitIndex(bitIndex));
 
-        RECYCLER_STATS_ADD(recycler, objectSweepScanCount, !isForceSweeping);
-
         if (!marked->Test(bitIndex))
         {
             if (!this->GetFreeBitVector()->Test(bitIndex))
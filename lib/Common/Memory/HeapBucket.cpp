@@ -1420,9 +1420,64 @@ HeapBucketT<TBlockType>::StartAllocationAfterSweep()
 {
     Assert(this->IsAllocationStopped());
     this->isAllocationStopped = false;
+
+    if (TBlockType::HeapBlockAttributes::IsMediumBlock && this->GetRecycler()->GetRecyclerFlagsTable().RecyclerDefragmentMediumBlocks)
+    {
+        this->OrderHeapBlockListForDefragmentation();
+    }
+
     this->nextAllocableBlockHead = this->heapBlockList;
 }
 
+// Objects never move, so the only way a bucket gives back memory held by scattered survivors is to stop
+// refilling the blocks they live in. Put the blocks that are at least half used first so that allocations
+// fill them, and leave the sparse ones at the end of the list to drain to empty and be released by a later sweep.
+template <typename TBlockType>
+void
+HeapBucketT<TBlockType>::OrderHeapBlockListForDefragmentation()
+{
+    Assert(this->nextAllocableBlockHead == nullptr);
+
+    TBlockType * denseList = nullptr;
+    TBlockType * denseTail = nullptr;
+    TBlockType * sparseList = nullptr;
+    TBlockType * sparseTail = nullptr;
+
+    HeapBlockList::ForEachEditing(this->heapBlockList, [&](TBlockType * heapBlock)
+    {
+        heapBlock->SetNextBlock(nullptr);
+        const bool isSparse = (size_t)heapBlock->GetExpectedFreeBytes() * 2 > (size_t)heapBlock->GetPageCount() * AutoSystemInfo::PageSize;
+        TBlockType *& list = isSparse ? sparseList : denseList;
+        TBlockType *& tail = isSparse ? sparseTail : denseTail;
+        if (tail == nullptr)
+        {
+            list = heapBlock;
+        }
+        else
+        {
+            tail->SetNextBlock(heapBlock);
+        }
+        tail = heapBlock;
+#ifdef RECYCLER_STATS
+        if (isSparse)
+        {
+            // Buckets may be swept by several threads at once
+            RECYCLER_STATS_INTERLOCKED_INC(this->GetRecycler(), heapBlockDefragmentDeferredCount);
+        }
+#endif
+    });
+
+    if (denseTail != nullptr)
+    {
+        denseTail->SetNextBlock(sparseList);
+        this->heapBlockList = denseList;
+    }
+    else
+    {
+        this->heapBlockList = sparseList;
+    }
+}
+
 #if ENABLE_ALLOCATIONS_DURING_CONCURRENT_SWEEP
 template <typename TBlockType>
 void
@@ -2319,6 +2374,24 @@ HeapBucketGroup<TBlockAttributes>::SweepPendingObjects(RecyclerSweep& recyclerSw
 #endif
 }
 
+#ifdef RECYCLER_STATS
+template <class TBlockAttributes>
+size_t
+HeapBucketGroup<TBlockAttributes>::GetPendingSweepBlockCount(RecyclerSweep& recyclerSweep)
+{
+    size_t count = HeapBlockList::Count(recyclerSweep.GetPendingSweepBlockList(&heapBucket));
+#ifdef RECYCLER_WRITE_BARRIER
+    count += HeapBlockList::Count(recyclerSweep.GetPendingSweepBlockList(&smallNormalWithBarrierHeapBucket));
+    count += HeapBlockList::Count(recyclerSweep.GetPendingSweepBlockList(&smallFinalizableWithBarrierHeapBucket));
+#endif
+    count += HeapBlockList::Count(recyclerSweep.GetPendingSweepBlockList(&finalizableHeapBucket));
+#ifdef RECYCLER_VISITED_HOST
+    count += HeapBlockList::Count(recyclerSweep.GetPendingSweepBlockList(&recyclerVisitedHostHeapBucket));
+#endif
+    return count;
+}
+#endif
+
 template <class TBlockAttributes>
 void
 HeapBucketGroup<TBlockAttributes>::TransferPendingEmptyHeapBlocks(RecyclerSweep& recyclerSweep)
@@ -265,6 +265,7 @@ class HeapBucketT : public HeapBucket
     bool AllowAllocationsDuringConcurrentSweep();
     void StopAllocationBeforeSweep();
     void StartAllocationAfterSweep();
+    void OrderHeapBlockListForDefragmentation();
     bool IsAllocationStopped() const;
 
     void SweepHeapBlockList(RecyclerSweep& recyclerSweep, TBlockType * heapBlockList, bool allocable);
@@ -484,6 +484,15 @@ HeapInfo::HeapInfo(AllocationPolicyManager * policyManager, Js::ConfigFlagsTable
 #endif
     hasPendingTransferDisposedObjects(false)
 {
+    // Leaf pages are never scanned, so only the pages that mark walks get huge page backing
+    if (configFlagsTable.RecyclerHugePages)
+    {
+        recyclerPageAllocator.EnableHugePages();
+#ifdef RECYCLER_WRITE_BARRIER_ALLOC_SEPARATE_PAGE
+        recyclerWithBarrierPageAllocator.EnableHugePages();
+#endif
+    }
+
 #if DBG_DUMP
     recyclerPageAllocator.debugName = _u("Recycler");
     recyclerLargeBlockPageAllocator.debugName = _u("RecyclerLargeBlock");
@@ -1317,17 +1326,14 @@ HeapInfo::SweepPendingObjects(RecyclerSweep& recyclerSweep)
 {
     if (recyclerSweep.HasPendingSweepSmallHeapBlocks())
     {
-        for (uint i = 0; i < HeapConstants::BucketCount; i++)
-        {
-            heapBuckets[i].SweepPendingObjects(recyclerSweep);
-        }
-
-#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
-        for (uint i = 0; i < HeapConstants::MediumBucketCount; i++)
+        // Buckets don't share any sweep state, so in the background we can spread them over the parallel helpers.
+        if (!recyclerSweep.IsBackground() || !recycler->ParallelSweepPendingObjects(this, recyclerSweep))
         {
-            mediumHeapBuckets[i].SweepPendingObjects(recyclerSweep);
+            for (uint i = 0; i < PendingSweepBucketCount; i++)
+            {
+                this->SweepPendingObjects(recyclerSweep, i);
+            }
         }
-#endif
     }
 
 #if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && !SMALLBLOCK_MEDIUM_ALLOC
@@ -1339,6 +1345,39 @@ HeapInfo::SweepPendingObjects(RecyclerSweep& recyclerSweep)
 
     largeObjectBucket.SweepPendingObjects(recyclerSweep);
 }
+
+void
+HeapInfo::SweepPendingObjects(RecyclerSweep& recyclerSweep, uint bucketIndex)
+{
+    Assert(bucketIndex < PendingSweepBucketCount);
+
+#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
+    if (bucketIndex >= HeapConstants::BucketCount)
+    {
+        mediumHeapBuckets[bucketIndex - HeapConstants::BucketCount].SweepPendingObjects(recyclerSweep);
+        return;
+    }
+#endif
+
+    heapBuckets[bucketIndex].SweepPendingObjects(recyclerSweep);
+}
+
+#ifdef RECYCLER_STATS
+size_t
+HeapInfo::GetPendingSweepBlockCount(RecyclerSweep& recyclerSweep, uint bucketIndex)
+{
+    Assert(bucketIndex < PendingSweepBucketCount);
+
+#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
+    if (bucketIndex >= HeapConstants::BucketCount)
+    {
+        return mediumHeapBuckets[bucketIndex - HeapConstants::BucketCount].GetPendingSweepBlockCount(recyclerSweep);
+    }
+#endif
+
+    return heapBuckets[bucketIndex].GetPendingSweepBlockCount(recyclerSweep);
+}
+#endif
 #endif
 
 #if ENABLE_ALLOCATIONS_DURING_CONCURRENT_SWEEP
@@ -102,6 +102,19 @@ class HeapInfo
     size_t Rescan(RescanFlags flags);
 #if ENABLE_PARTIAL_GC || ENABLE_CONCURRENT_GC
     void SweepPendingObjects(RecyclerSweep& recyclerSweep);
+#endif
+#if ENABLE_CONCURRENT_GC
+    // The small (and medium, when they are swept along with the small) buckets that have pending sweep blocks,
+    // indexed so that the concurrent thread and the parallel helpers can each claim whole buckets.
+#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
+    static const uint PendingSweepBucketCount = HeapConstants::BucketCount + HeapConstants::MediumBucketCount;
+#else
+    static const uint PendingSweepBucketCount = HeapConstants::BucketCount;
+#endif
+    void SweepPendingObjects(RecyclerSweep& recyclerSweep, uint bucketIndex);
+#ifdef RECYCLER_STATS
+    size_t GetPendingSweepBlockCount(RecyclerSweep& recyclerSweep, uint bucketIndex);
+#endif
 #endif
     void Finalize(RecyclerSweep& recyclerSweep);
     void Sweep(RecyclerSweep& recyclerSweep, bool concurrent);
@@ -17,7 +17,8 @@ MarkContext::MarkContext(Recycler * recycler, PagePool * pagePool) :
 #ifdef RECYCLER_VISITED_HOST
     preciseStack(pagePool),
 #endif
-    trackStack(pagePool)
+    trackStack(pagePool),
+    popsSinceShareWorkCheck(0)
 {
 }
 
@@ -114,6 +115,140 @@ uint MarkContext::Split(uint targetCount, __in_ecount(targetCount) MarkContext *
 }
 
 
+bool MarkContext::DonateWork(MarkContext * targetContext)
+{
+    // Hand half of our pending chunks to an idle context. Only stacks with more than one chunk are split;
+    // the current chunk stays with this context, so the entries it is actively popping are never moved.
+    bool sharedWork = false;
+
+    if (this->markStack.HasMultipleChunks())
+    {
+        PageStack<MarkCandidate> * targetMarkStack = &targetContext->markStack;
+        sharedWork = (this->markStack.Split(1, &targetMarkStack) != 0);
+    }
+
+#ifdef RECYCLER_VISITED_HOST
+    if (this->preciseStack.HasMultipleChunks())
+    {
+        PageStack<IRecyclerVisitedObject*> * targetPreciseStack = &targetContext->preciseStack;
+        sharedWork = (this->preciseStack.Split(1, &targetPreciseStack) != 0) || sharedWork;
+    }
+#endif
+
+    return sharedWork;
+}
+
+#if ENABLE_CONCURRENT_GC
+ParallelMarkWorkQueue::ParallelMarkWorkQueue() :
+    idleWorkerCount(0),
+    workerCount(0),
+    isDone(true)
+{
+}
+
+void ParallelMarkWorkQueue::Start(uint workerCount)
+{
+    Assert(workerCount > 0 && workerCount <= MaxWorkers);
+
+    AutoCriticalSection autoCS(&this->lock);
+    this->workerCount = workerCount;
+    this->idleWorkerCount = 0;
+    this->isDone = false;
+}
+
+void ParallelMarkWorkQueue::AddWorker()
+{
+    AutoCriticalSection autoCS(&this->lock);
+    Assert(!this->isDone);
+    Assert(this->workerCount < MaxWorkers);
+    this->workerCount++;
+}
+
+void ParallelMarkWorkQueue::RemoveWorker()
+{
+    // Called when a worker registered with AddWorker failed to start.
+    // The caller is itself a busy worker, so this can never complete the mark.
+    AutoCriticalSection autoCS(&this->lock);
+    Assert(!this->isDone);
+    Assert(this->workerCount > this->idleWorkerCount + 1);
+    this->workerCount--;
+}
+
+void ParallelMarkWorkQueue::ShareWork(MarkContext * markContext)
+{
+    AutoCriticalSection autoCS(&this->lock);
+
+    while (this->idleWorkerCount != 0)
+    {
+        IdleWorker * idleWorker = this->idleWorkers[this->idleWorkerCount - 1];
+        if (!markContext->DonateWork(idleWorker->markContext))
+        {
+            // Not enough pending work left to split; keep the remaining workers parked.
+            break;
+        }
+
+        this->idleWorkerCount--;
+
+        // Publish the donated chunks before waking up the idle worker.
+        MemoryBarrier();
+        ::InterlockedExchange(&idleWorker->hasWork, TRUE);
+    }
+}
+
+bool ParallelMarkWorkQueue::WaitForWork(MarkContext * markContext)
+{
+    Assert(!markContext->HasPendingMarkObjects());
+
+    IdleWorker idleWorker;
+    idleWorker.markContext = markContext;
+    idleWorker.hasWork = FALSE;
+
+    {
+        AutoCriticalSection autoCS(&this->lock);
+
+        if (this->isDone)
+        {
+            return false;
+        }
+
+        Assert(this->idleWorkerCount < this->workerCount);
+        if (this->idleWorkerCount + 1 == this->workerCount)
+        {
+            // Every other worker is already parked, so nobody can produce more work.
+            this->idleWorkerCount = 0;
+            this->isDone = true;
+            return false;
+        }
+
+        this->idleWorkers[this->idleWorkerCount] = &idleWorker;
+        this->idleWorkerCount++;
+    }
+
+    uint spinCount = 0;
+    while (!idleWorker.hasWork)
+    {
+        if (this->isDone)
+        {
+            return false;
+        }
+
+        if (spinCount < SpinCountBeforeYield)
+        {
+            spinCount++;
+            YieldProcessor();
+        }
+        else
+        {
+            SwitchToThread();
+        }
+    }
+
+    // Pair with the barrier in ShareWork so the donated chunks are visible to us.
+    MemoryBarrier();
+    return true;
+}
+#endif
+
 void MarkContext::ProcessTracked()
 {
     if (trackStack.IsEmpty())
@@ -60,6 +60,15 @@ class MarkContext
     void ProcessTracked();
 
     uint Split(uint targetCount, __in_ecount(targetCount) MarkContext ** targetContexts);
+    bool DonateWork(MarkContext * targetContext);
+    bool CanDonateWork() const
+    {
+        return markStack.HasMultipleChunks()
+#ifdef RECYCLER_VISITED_HOST
+            || preciseStack.HasMultipleChunks()
+#endif
+            ;
+    }
 
     void Abort();
     void Release();
@@ -134,6 +143,13 @@ class MarkContext
 #endif
     PageStack<FinalizableObject *> trackStack;
 
+    // Checking for idle workers reads the shared work queue, so only do it every few pops.
+    static const uint ShareWorkCheckInterval = 64;
+    uint popsSinceShareWorkCheck;
+
+    template <bool parallel>
+    void ShareWorkIfIdleWorkers();
+
 #ifdef RECYCLER_MARK_TRACK
     MarkMap* markMap;
 
@@ -146,5 +162,41 @@ class MarkContext
 #endif
 };
 
+#if ENABLE_CONCURRENT_GC
+// Work sharing between the mark contexts taking part in a parallel mark.
+// A worker that drains its own mark stack parks itself here instead of exiting; busy workers
+// notice the parked worker from their mark loop and hand it half of their pending chunks.
+// The parallel mark is over once every participating worker is parked.
+class ParallelMarkWorkQueue
+{
+public:
+    ParallelMarkWorkQueue();
+
+    void Start(uint workerCount);
+    void AddWorker();
+    void RemoveWorker();
+
+    bool HasIdleWorkers() const { return this->idleWorkerCount != 0; }
+    void ShareWork(MarkContext * markContext);
+    bool WaitForWork(MarkContext * markContext);
+
+private:
+    struct IdleWorker
+    {
+        MarkContext * markContext;
+        volatile LONG hasWork;
+    };
+
+    static const uint MaxWorkers = PageStack<void *>::MaxSplitTargets + 1;
+    static const uint SpinCountBeforeYield = 1000;
+
+    CriticalSection lock;
+    IdleWorker * idleWorkers[MaxWorkers];
+    volatile uint idleWorkerCount;
+    uint workerCount;
+    volatile bool isDone;
+};
+#endif
+
 
 }
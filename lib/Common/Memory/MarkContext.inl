@@ -215,6 +215,22 @@ void MarkContext::MarkTrackedObject(FinalizableObject * trackedObject)
     END_NO_EXCEPTION
 }
 
+template <bool parallel>
+inline
+void MarkContext::ShareWorkIfIdleWorkers()
+{
+#if ENABLE_CONCURRENT_GC
+    CompileAssert((ShareWorkCheckInterval & (ShareWorkCheckInterval - 1)) == 0);
+    if (parallel
+        && (++this->popsSinceShareWorkCheck & (ShareWorkCheckInterval - 1)) == 0
+        && this->CanDonateWork()
+        && recycler->parallelMarkWorkQueue.HasIdleWorkers())
+    {
+        recycler->parallelMarkWorkQueue.ShareWork(this);
+    }
+#endif
+}
+
 template <bool parallel, bool interior>
 inline
 void MarkContext::ProcessMark()
@@ -250,6 +266,8 @@ void MarkContext::ProcessMark()
                 // Process entries and prefetch as we go.
                 while (markStack.Pop(&next))
                 {
+                    ShareWorkIfIdleWorkers<parallel>();
+
                     // Prefetch the next entry so it's ready when we need it.
                     _mm_prefetch((char *)next.obj, _MM_HINT_T0);
 
@@ -274,6 +292,7 @@ void MarkContext::ProcessMark()
 
             while (markStack.Pop(&current))
             {
+                ShareWorkIfIdleWorkers<parallel>();
                 ScanObject<parallel, interior>(current.obj, current.byteCount);
             }
 #endif
@@ -288,6 +307,7 @@ void MarkContext::ProcessMark()
             IRecyclerVisitedObject* tracedObject;
             while (preciseStack.Pop(&tracedObject))
             {
+                ShareWorkIfIdleWorkers<parallel>();
                 tracedObject->Trace(&markContextWrapper);
             }
         }
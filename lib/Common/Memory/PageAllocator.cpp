@@ -101,7 +101,8 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
         if (addGuardPages)
         {
             unsigned int randomNumber = static_cast<unsigned int>(Math::Rand());
-            this->leadingGuardPageCount = randomNumber % maxGuardPages + minGuardPages;
+            // Leading guard pages would shift the segment off its huge page alignment
+            this->leadingGuardPageCount = GetAllocator()->IsHugePagesEnabled() ? 0 : randomNumber % maxGuardPages + minGuardPages;
             this->trailingGuardPageCount = minGuardPages;
         }
     }
@@ -123,7 +124,34 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
         return false;
     }
 
-    this->address = (char *)GetAllocator()->GetVirtualAllocator()->AllocPages(NULL, totalPages, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
+#ifndef _WIN32
+    if (GetAllocator()->IsHugePagesEnabled())
+    {
+        this->address = (char *)PAL_VirtualReserveAligned(totalPages * AutoSystemInfo::PageSize, PageAllocatorBase<T>::HugePageSize);
+        if (this->address != nullptr && (allocFlags & MEM_COMMIT) != 0 &&
+            GetAllocator()->GetVirtualAllocator()->AllocPages(this->address, totalPages, allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator()) == nullptr)
+        {
+            GetAllocator()->GetVirtualAllocator()->Free(this->address, totalPages * AutoSystemInfo::PageSize, MEM_RELEASE);
+            this->address = nullptr;
+        }
+    }
+    else
+#else
+    if (GetAllocator()->GetNumaNode() != NUMA_NO_PREFERRED_NODE)
+    {
+        // Only in-process, non-executable allocators have a node, so this is what VirtualAllocWrapper would do, plus the node.
+        // Pages committed in the reservation later prefer the same node.
+        this->address = (char *)::VirtualAllocExNuma(GetCurrentProcess(), NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, GetAllocator()->GetNumaNode());
+        if (this->address == nullptr)
+        {
+            MemoryOperationLastError::RecordLastError();
+        }
+    }
+    else
+#endif
+    {
+        this->address = (char *)GetAllocator()->GetVirtualAllocator()->AllocPages(NULL, totalPages, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
+    }
 
     if (this->address == nullptr)
     {
@@ -157,6 +185,12 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
         this->address = this->address + (leadingGuardPageCount*AutoSystemInfo::PageSize);
     }
 
+    if (committed)
+    {
+        GetAllocator()->BindPagesToNumaNode(this->address, this->segmentPageCount);
+        GetAllocator()->AdviseHugePages(this->address, this->segmentPageCount);
+    }
+
     if (!GetAllocator()->CreateSecondaryAllocator(this, committed, &this->secondaryAllocator))
     {
         GetAllocator()->GetVirtualAllocator()->Free(originalAddress,
@@ -444,6 +478,8 @@ PageSegmentBase<TVirtualAlloc>::AllocDecommitPages(uint pageCount, T freePages,
             if (ret != nullptr)
             {
                 Assert(ret == pages);
+                this->GetAllocator()->BindPagesToNumaNode(pages, pageCount);
+                this->GetAllocator()->AdviseHugePages(pages, pageCount);
 
                 this->ClearRangeInFreePagesBitVector(index, pageCount);
                 this->ClearRangeInDecommitPagesBitVector(index, pageCount);
@@ -640,6 +676,22 @@ PageSegmentBase<T>::DecommitFreePages(size_t pageToDecommit)
 static size_t totalUsedBytes = 0;
 static size_t maxUsedBytes = 0;
 
+/*
+ * Committed bytes per NUMA node, for the page allocators that bind their pages to a node.
+ */
+static size_t totalCommittedBytesPerNumaNode[PageAllocator::MaxNumaNodeCount] = { 0 };
+
+static DWORD GetCurrentThreadNumaNode()
+{
+    DWORD processor = GetCurrentProcessorNumber();
+    UCHAR numaNode;
+    if (processor > 0xFF || !GetNumaProcessorNode((UCHAR)processor, &numaNode) || numaNode >= PageAllocator::MaxNumaNodeCount)
+    {
+        return NUMA_NO_PREFERRED_NODE;
+    }
+    return numaNode;
+}
+
 
 template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
 size_t PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::GetAndResetMaxUsedBytes()
@@ -656,6 +708,13 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::GetProcessUsedBytes()
     return totalUsedBytes;
 }
 
+template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
+size_t
+PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::GetProcessCommittedBytesOnNumaNode(DWORD numaNode)
+{
+    return numaNode < MaxNumaNodeCount ? totalCommittedBytesPerNumaNode[numaNode] : 0;
+}
+
 template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
 uint
 PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::GetMaxAllocPageCount()
@@ -683,6 +742,7 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::PageAllocatorBase(Allo
     maxFreePageCount(maxFreePageCount),
     freePageCount(0),
     allocFlags(0),
+    hugePages(false),
     zeroPages(zeroPages),
 #if ENABLE_BACKGROUND_PAGE_ZEROING
     queueZeroPages(false),
@@ -706,6 +766,7 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::PageAllocatorBase(Allo
     , committedBytes(0)
     , usedBytes(0)
     , numberOfSegments(0)
+    , numaNode(NUMA_NO_PREFERRED_NODE)
     , processHandle(processHandle)
     , enableWriteBarrier(enableWriteBarrier)
 #ifdef ENABLE_BASIC_TELEMETRY
@@ -716,6 +777,13 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::PageAllocatorBase(Allo
 
     this->maxAllocPageCount = maxAllocPageCount;
 
+    // Executable pages and pages of another process stay unbound. The node is fixed for the
+    // lifetime of the allocator so the per node commit counters stay balanced.
+    if (flagTable.NumaAwarePageAllocator && type != PageAllocatorType_CustomHeap && processHandle == GetCurrentProcess())
+    {
+        this->numaNode = GetCurrentThreadNumaNode();
+    }
+
 #if DBG
     // By default, a page allocator is not associated with any thread context
     // Any host which wishes to associate it with a thread context must do so explicitly
@@ -1623,7 +1691,12 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::ReleasePages(__in void
      *  Now that we've either decommitted or freed the pages in the segment,
      *  move the segment to the right segment list
      */
-    if (this->freePageCount + pageCount > maxFreePageCount)
+    // With huge pages, decommitting part of a segment would split its huge page, so keep the
+    // pages free unless a whole empty segment can be released instead, or the free pages have
+    // grown past the huge page free limit.
+    if (this->freePageCount + pageCount > maxFreePageCount &&
+        (!this->hugePages || (!ZeroPages() && !emptySegments.Empty()) ||
+            this->freePageCount + pageCount > this->GetHugePageFreePageLimit()))
     {
         // Release a whole segment if possible to reduce the number of VirtualFree and fragmentation
         if (!ZeroPages() && !emptySegments.Empty())
@@ -2085,6 +2158,9 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::DecommitNow(bool all)
 
     size_t decommitCount = 0;
 
+    // Partial decommits split huge pages. Idle decommit only releases whole empty segments
+    // unless the free pages have grown past the huge page free limit.
+    const bool decommitWholeSegmentsOnly = this->hugePages && !all && this->freePageCount <= this->GetHugePageFreePageLimit();
 
     // decommit from page that already has other decommitted page already
     {
@@ -2133,6 +2209,11 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::DecommitNow(bool all)
         }
         else
         {
+            if (decommitWholeSegmentsOnly)
+            {
+                break;
+            }
+
             size_t pageDecommitted = emptySegments.Head().DecommitFreePages(pageToDecommit);
             LogDecommitPages(pageDecommitted);
 
@@ -2144,7 +2225,7 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::DecommitNow(bool all)
         }
     }
 
-    if(!this->waitingToEnterIdleDecommit)
+    if(!this->waitingToEnterIdleDecommit && !decommitWholeSegmentsOnly)
     {
         typename DListBase<TPageSegment>::EditingIterator i(&segments);
 
@@ -2168,7 +2249,7 @@ PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::DecommitNow(bool all)
         }
     }
 
-    Assert(pageToDecommit == 0 || this->waitingToEnterIdleDecommit);
+    Assert(pageToDecommit == 0 || this->waitingToEnterIdleDecommit || decommitWholeSegmentsOnly);
 #if DBG
     if (pageToDecommit != 0 && this->waitingToEnterIdleDecommit)
     {
@@ -2236,6 +2317,14 @@ void
 PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::AddCommittedBytes(size_t bytes)
 {
     committedBytes += bytes;
+    if (numaNode != NUMA_NO_PREFERRED_NODE)
+    {
+#if defined(TARGET_64)
+        ::InterlockedExchangeAdd64((volatile LONG64 *)&totalCommittedBytesPerNumaNode[numaNode], bytes);
+#else
+        ::InterlockedExchangeAdd((volatile LONG *)&totalCommittedBytesPerNumaNode[numaNode], (LONG)bytes);
+#endif
+    }
 #ifdef PERF_COUNTERS
     GetCommittedSizeCounter() += bytes;
     GetTotalCommittedSizeCounter() += bytes;
@@ -2247,12 +2336,48 @@ void
 PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::SubCommittedBytes(size_t bytes)
 {
     committedBytes -= bytes;
+    if (numaNode != NUMA_NO_PREFERRED_NODE)
+    {
+#if defined(TARGET_64)
+        ::InterlockedExchangeAdd64((volatile LONG64 *)&totalCommittedBytesPerNumaNode[numaNode], -(LONG64)bytes);
+#else
+        ::InterlockedExchangeAdd((volatile LONG *)&totalCommittedBytesPerNumaNode[numaNode], -(LONG)bytes);
+#endif
+    }
 #ifdef PERF_COUNTERS
     GetCommittedSizeCounter() -= bytes;
     GetTotalCommittedSizeCounter() -= bytes;
 #endif
 }
 
+template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
+void
+PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::BindPagesToNumaNode(__in void * address, size_t pageCount)
+{
+#ifndef _WIN32
+    if (numaNode != NUMA_NO_PREFERRED_NODE)
+    {
+        // The PAL commits by remapping, which drops the policy, so bind after every commit.
+        // This only records a preference for untouched pages; failing just loses the preference.
+        PAL_VirtualBindToNumaNode(address, pageCount * AutoSystemInfo::PageSize, numaNode);
+    }
+#endif
+    // On Windows the segment was reserved on the node (see SegmentBase::Initialize), and commits inherit it.
+}
+
+template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
+void
+PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::AdviseHugePages(__in void * address, size_t pageCount)
+{
+#ifndef _WIN32
+    if (hugePages)
+    {
+        // Best effort: without transparent huge page support the pages stay 4K
+        PAL_VirtualAdviseHugePages(address, pageCount * AutoSystemInfo::PageSize);
+    }
+#endif
+}
+
 template<typename TVirtualAlloc, typename TSegment, typename TPageSegment>
 void
 PageAllocatorBase<TVirtualAlloc, TSegment, TPageSegment>::AddUsedBytes(size_t bytes)
@@ -247,9 +247,13 @@ class PageSegmentBase : public SegmentBase<TVirtualAlloc>
     PageSegmentBase(PageAllocatorBase<TVirtualAlloc> * allocator, bool committed, bool allocated, bool enableWriteBarrier);
     PageSegmentBase(PageAllocatorBase<TVirtualAlloc> * allocator, void* address, uint pageCount, uint committedCount, bool enableWriteBarrier);
     // Maximum possible size of a PageSegment; may be smaller.
+#if ENABLE_RECYCLER_HUGE_PAGES
+    static const uint MaxDataPageCount = 512;     // 2 MB, so that a segment can cover one transparent huge page
+#else
     static const uint MaxDataPageCount = 256;     // 1 MB
+#endif
     static const uint MaxGuardPageCount = 16;
-    static const uint MaxPageCount = MaxDataPageCount + MaxGuardPageCount;  // 272 Pages
+    static const uint MaxPageCount = MaxDataPageCount + MaxGuardPageCount;  // 528 or 272 Pages
 
     typedef BVStatic<MaxPageCount> PageBitVector;
 
@@ -513,6 +517,10 @@ class PageAllocatorBase: public PageAllocatorBaseCommon
 
     static size_t GetAndResetMaxUsedBytes();
 
+    // Committed bytes per NUMA node, summed over the page allocators created with -NumaAwarePageAllocator
+    static uint const MaxNumaNodeCount = 64;
+    static size_t GetProcessCommittedBytesOnNumaNode(DWORD numaNode);
+
     // xplat TODO: implement a platform agnostic version of interlocked linked lists
 #if ENABLE_BACKGROUND_PAGE_FREEING
     struct FreePageEntry
@@ -747,6 +755,17 @@ class PageAllocatorBase: public PageAllocatorBaseCommon
         return (allocFlags & MEM_WRITE_WATCH) == MEM_WRITE_WATCH;
     }
 
+    static size_t const HugePageSize = 2 * 1024 * 1024;
+    bool IsHugePagesEnabled() const { return hugePages; }
+
+    // Decommitting part of a huge page segment splits its huge page, so with huge pages the free
+    // pages may exceed maxFreePageCount by this many huge pages before partial decommits resume.
+    static uint const HugePageFreeSlackCount = 4;
+    size_t GetHugePageFreePageLimit() const
+    {
+        return maxFreePageCount + HugePageFreeSlackCount * (HugePageSize / AutoSystemInfo::PageSize);
+    }
+
 #if DBG_DUMP
     char16 const * debugName;
 #endif
@@ -834,6 +853,8 @@ class PageAllocatorBase: public PageAllocatorBaseCommon
 
     uint maxAllocPageCount;
     DWORD allocFlags;
+    // Segments are huge page aligned and only decommitted whole
+    bool hugePages;
     uint maxFreePageCount;
     size_t freePageCount;
     uint secondaryAllocPageCount;
@@ -932,6 +953,11 @@ class PageAllocatorBase: public PageAllocatorBaseCommon
     size_t committedBytes;
     size_t numberOfSegments;
 
+    // Preferred node for committed pages, or NUMA_NO_PREFERRED_NODE
+    DWORD numaNode;
+    void BindPagesToNumaNode(__in void * address, size_t pageCount);
+    void AdviseHugePages(__in void * address, size_t pageCount);
+
 #ifdef PERF_COUNTERS
     PerfCounter::Counter& GetReservedSizeCounter() const
     {
@@ -972,6 +998,7 @@ class PageAllocatorBase: public PageAllocatorBaseCommon
     size_t GetCommittedBytes() const { return this->committedBytes; }
     size_t GetUsedBytes() const { return this->usedBytes; }
     size_t GetNumberOfSegments() const { return this->numberOfSegments; }
+    DWORD GetNumaNode() const { return this->numaNode; }
 
 private:
 
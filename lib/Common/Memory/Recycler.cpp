@@ -118,12 +118,8 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     threadService(nullptr),
     markPagePool(configFlagsTable),
     parallelMarkPagePool1(configFlagsTable),
-    parallelMarkPagePool2(configFlagsTable),
-    parallelMarkPagePool3(configFlagsTable),
     markContext(this, &this->markPagePool),
     parallelMarkContext1(this, &this->parallelMarkPagePool1),
-    parallelMarkContext2(this, &this->parallelMarkPagePool2),
-    parallelMarkContext3(this, &this->parallelMarkPagePool3),
 #if ENABLE_PARTIAL_GC
     clientTrackedObjectAllocator(_u("CTO-List"), pageAllocator, Js::Throw::OutOfMemory),
 #endif
@@ -154,8 +150,11 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     concurrentThread(NULL),
     concurrentWorkReadyEvent(NULL),
     concurrentWorkDoneEvent(NULL),
-    parallelThread1(this, &Recycler::ParallelWorkFunc<0>),
-    parallelThread2(this, &Recycler::ParallelWorkFunc<1>),
+    parallelMarkHelperCount(0),
+    parallelMarkWorkQueueEnabled(false),
+    parallelSweepHeapInfo(nullptr),
+    parallelSweepRecyclerSweep(nullptr),
+    parallelSweepBucketIndex(0),
     priorityBoost(false),
     isAborting(false),
 #if DBG
@@ -178,6 +177,10 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     scanPinnedObjectMap(false),
     partialUncollectedAllocBytes(0),
     uncollectedNewPageCountPartialCollect((size_t)-1),
+    nurseryMinorCollectCount(0),
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    nurseryMinorCollectTraced(false),
+#endif
 #if ENABLE_CONCURRENT_GC
     partialConcurrentNextCollection(false),
 #endif
@@ -279,8 +282,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     this->markMap = NoCheckHeapNew(MarkMap, &NoCheckHeapAllocator::Instance, 163, &markMapCriticalSection);
     markContext.SetMarkMap(markMap);
     parallelMarkContext1.SetMarkMap(markMap);
-    parallelMarkContext2.SetMarkMap(markMap);
-    parallelMarkContext3.SetMarkMap(markMap);
 #endif
 
 #ifdef RECYCLER_MEMORY_VERIFY
@@ -345,8 +346,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     // recycler requires at least Recycler::PrimaryMarkStackReservedPageCount to function properly for the main mark context
     this->markContext.SetMaxPageCount(max(static_cast<size_t>(GetRecyclerFlagsTable().MaxMarkStackPageCount), static_cast<size_t>(Recycler::PrimaryMarkStackReservedPageCount)));
     this->parallelMarkContext1.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext2.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext3.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
 
     if (GetRecyclerFlagsTable().IsEnabled(Js::GCMemoryThresholdFlag))
     {
@@ -518,9 +517,10 @@ Recycler::~Recycler()
     autoHeap.Close();
 
     markContext.Release();
-    parallelMarkContext1.Release();
-    parallelMarkContext2.Release();
-    parallelMarkContext3.Release();
+    ForEachParallelMarkContext([](MarkContext * context) { context->Release(); });
+#if ENABLE_CONCURRENT_GC
+    DeleteParallelMarkHelpers();
+#endif
 
     // Clean up the weak reference map so that
     // objects being finalized can safely refer to weak references
@@ -839,7 +839,15 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #if ENABLE_CONCURRENT_GC
     // Default to non-concurrent
     uint numProcs = (uint)AutoSystemInfo::Data.GetNumberOfPhysicalProcessors();
-    this->maxParallelism = (numProcs > 4) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? 4 : numProcs;
+    uint parallelMarkThreads = (uint)GetRecyclerFlagsTable().RecyclerParallelMarkThreads;
+    if (parallelMarkThreads != 0)
+    {
+        this->maxParallelism = parallelMarkThreads > MaxParallelism ? MaxParallelism : parallelMarkThreads;
+    }
+    else
+    {
+        this->maxParallelism = (numProcs > DefaultMaxParallelism) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? DefaultMaxParallelism : numProcs;
+    }
 
     if (forceInThread)
     {
@@ -981,9 +989,7 @@ Recycler::ClearNeedOOMRescan()
 {
     this->needOOMRescan = false;
     markContext.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-    parallelMarkContext1.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-    parallelMarkContext2.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-    parallelMarkContext3.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
+    ForEachParallelMarkContext([](MarkContext * context) { context->GetPageAllocator()->ResetDisableAllocationOutOfMemory(); });
 }
 
 bool
@@ -2267,13 +2273,24 @@ Recycler::ProcessParallelMark(bool background, MarkContext * markContext)
 
     RECYCLER_PROFILE_EXEC_THREAD_BEGIN(background, this, Js::MarkPhase);
 
-    if (this->enableScanInteriorPointers)
+    bool hasWork = true;
+    while (hasWork)
     {
-        this->ProcessMarkContext</* parallel */ true, /* interior */ true>(markContext);
-    }
-    else
-    {
-        this->ProcessMarkContext</* parallel */ true, /* interior */ false>(markContext);
+        if (this->enableScanInteriorPointers)
+        {
+            this->ProcessMarkContext</* parallel */ true, /* interior */ true>(markContext);
+        }
+        else
+        {
+            this->ProcessMarkContext</* parallel */ true, /* interior */ false>(markContext);
+        }
+
+#if ENABLE_CONCURRENT_GC
+        // Once our own share is drained, wait for the other threads to hand us more until the whole mark is done.
+        hasWork = this->parallelMarkWorkQueue.WaitForWork(markContext);
+#else
+        hasWork = false;
+#endif
     }
 
     RECYCLER_PROFILE_EXEC_THREAD_END(background, this, Js::MarkPhase);
@@ -2370,8 +2387,10 @@ Recycler::ResetMarkCollectionState()
     // If we aborted after doing a background parallel Mark, we wouldn't have cleaned up the
     // parallel markContexts yet. Clean these up now.
     // Note parallelMarkContext1 is not used in background parallel (see DoBackgroundParallelMark)
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        parallelMarkHelpers[i]->markContext.Cleanup();
+    }
 
     this->ClearNeedOOMRescan();
     DebugOnly(this->isProcessingRescan = false);
@@ -2536,14 +2555,19 @@ void
 Recycler::DoParallelMark()
 {
     Assert(this->enableParallelMark);
-    Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+    Assert(this->maxParallelism > 1 && this->maxParallelism <= this->parallelMarkHelperCount + 2);
 
     // Split the mark stack into [this->maxParallelism] equal pieces.
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    MarkContext * splitContexts[3] = { &parallelMarkContext1, &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelism - 1];
+    splitContexts[0] = &parallelMarkContext1;
+    for (uint i = 0; i < this->maxParallelism - 2; i++)
+    {
+        splitContexts[i + 1] = &parallelMarkHelpers[i]->markContext;
+    }
     uint actualSplitCount = markContext.Split(this->maxParallelism - 1, splitContexts);
 
-    Assert(actualSplitCount <= 3);
+    Assert(actualSplitCount <= this->maxParallelism - 1);
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2562,20 +2586,28 @@ Recycler::DoParallelMark()
         StartQueueTrackedObject();
     }
 
+    // This thread takes part in the work sharing; each thread we manage to start below joins it.
+    this->StartParallelMarkWorkQueue(1);
+
     // Kick off marking on the background thread
+    if (this->parallelMarkWorkQueueEnabled)
+    {
+        this->parallelMarkWorkQueue.AddWorker();
+    }
     bool concurrentSuccess = StartConcurrent(CollectionStateParallelMark);
+    if (!concurrentSuccess && this->parallelMarkWorkQueueEnabled)
+    {
+        this->parallelMarkWorkQueue.RemoveWorker();
+    }
 
     // If there's enough work to split, then kick off marking on parallel threads too.
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    if (concurrentSuccess && actualSplitCount >= 2)
+    // Helper [i] marks splitContexts[i + 1], so only the first [actualSplitCount - 1] helpers have work.
+    bool parallelSuccess[MaxParallelMarkHelpers] = { false };
+    const uint helperCount = actualSplitCount - 1;
+    if (concurrentSuccess)
     {
-        parallelSuccess1 = parallelThread1.StartConcurrent();
-        if (parallelSuccess1 && actualSplitCount == 3)
-        {
-            parallelSuccess2 = parallelThread2.StartConcurrent();
-        }
+        this->StartParallelMarkHelpers(helperCount, parallelSuccess);
     }
 
     // Process our portion of the split.
@@ -2592,29 +2624,7 @@ Recycler::DoParallelMark()
         this->ProcessParallelMark(false, &markContext);
     }
 
-    if (actualSplitCount >= 2)
-    {
-        if (parallelSuccess1)
-        {
-            parallelThread1.WaitForConcurrent();
-        }
-        else
-        {
-            this->ProcessParallelMark(false, &parallelMarkContext2);
-        }
-
-        if (actualSplitCount == 3)
-        {
-            if (parallelSuccess2)
-            {
-                parallelThread2.WaitForConcurrent();
-            }
-            else
-            {
-                this->ProcessParallelMark(false, &parallelMarkContext3);
-            }
-        }
-    }
+    this->WaitForParallelMarkHelpers(false, helperCount, parallelSuccess);
 
     this->SetCollectionState(CollectionStateMark);
 
@@ -2641,19 +2651,23 @@ Recycler::DoBackgroundParallelMark()
 {
     // Split the mark stack into [this->maxParallelism - 1] equal pieces (thus, "- 2" below).
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    // The parallel threads are hardwired to use parallelMarkContext2/3, so we split using those.
+    // The parallel threads are hardwired to use their own helper contexts, so we split using those.
     uint actualSplitCount = 0;
-    MarkContext * splitContexts[2] = { &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelMarkHelpers];
     if (this->enableParallelMark)
     {
-        Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+        Assert(this->maxParallelism > 0 && this->maxParallelism <= this->parallelMarkHelperCount + 2);
         if (this->maxParallelism > 2)
         {
+            for (uint i = 0; i < this->maxParallelism - 2; i++)
+            {
+                splitContexts[i] = &parallelMarkHelpers[i]->markContext;
+            }
             actualSplitCount = markContext.Split(this->maxParallelism - 2, splitContexts);
         }
     }
 
-    Assert(actualSplitCount <= 2);
+    Assert(actualSplitCount <= MaxParallelMarkHelpers);
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2671,45 +2685,219 @@ Recycler::DoBackgroundParallelMark()
 
     this->SetCollectionState(CollectionStateBackgroundParallelMark);
 
+    // This (concurrent) thread takes part in the work sharing along with every helper we manage to start.
+    this->StartParallelMarkWorkQueue(1);
+
     // Kick off marking on parallel threads too, if there is work for them
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    parallelSuccess1 = parallelThread1.StartConcurrent();
-    if (parallelSuccess1 && actualSplitCount == 2)
-    {
-        parallelSuccess2 = parallelThread2.StartConcurrent();
-    }
+    bool parallelSuccess[MaxParallelMarkHelpers] = { false };
+    this->StartParallelMarkHelpers(actualSplitCount, parallelSuccess);
 
     // Process our portion of the split.
     this->ProcessParallelMark(true, &markContext);
 
     // If we successfully launched parallel work, wait for it to complete.
     // If we failed, then process the work in-thread now.
-    if (parallelSuccess1)
+    this->WaitForParallelMarkHelpers(true, actualSplitCount, parallelSuccess);
+
+    this->SetCollectionState(CollectionStateConcurrentMark);
+}
+
+void
+Recycler::StartParallelMarkWorkQueue(uint workerCount)
+{
+    this->parallelMarkWorkQueueEnabled = GetRecyclerFlagsTable().RecyclerParallelMarkWorkSharing;
+    if (this->parallelMarkWorkQueueEnabled)
     {
-        parallelThread1.WaitForConcurrent();
+        this->parallelMarkWorkQueue.Start(workerCount);
     }
-    else
+}
+
+void
+Recycler::StartParallelMarkHelpers(uint helperCount, __out_ecount(helperCount) bool * parallelSuccess)
+{
+    Assert(helperCount <= this->parallelMarkHelperCount);
+
+    for (uint i = 0; i < helperCount; i++)
     {
-        this->ProcessParallelMark(true, &parallelMarkContext2);
+        if (this->parallelMarkWorkQueueEnabled)
+        {
+            this->parallelMarkWorkQueue.AddWorker();
+        }
+
+        parallelSuccess[i] = parallelMarkHelpers[i]->parallelThread.StartConcurrent();
+
+        if (!parallelSuccess[i])
+        {
+            if (this->parallelMarkWorkQueueEnabled)
+            {
+                this->parallelMarkWorkQueue.RemoveWorker();
+            }
+
+            // Helpers are started in order; if one fails, the rest are unlikely to do better.
+            break;
+        }
     }
+}
 
-    if (actualSplitCount == 2)
+void
+Recycler::WaitForParallelMarkHelpers(bool background, uint helperCount, __in_ecount(helperCount) bool * parallelSuccess)
+{
+    for (uint i = 0; i < helperCount; i++)
     {
-        if (parallelSuccess2)
+        if (parallelSuccess[i])
         {
-            parallelThread2.WaitForConcurrent();
+            parallelMarkHelpers[i]->parallelThread.WaitForConcurrent();
         }
         else
         {
-            this->ProcessParallelMark(true, &parallelMarkContext3);
+            this->ProcessParallelMark(background, &parallelMarkHelpers[i]->markContext);
         }
     }
 
-    this->SetCollectionState(CollectionStateConcurrentMark);
+    this->parallelMarkWorkQueueEnabled = false;
+}
+
+bool
+Recycler::CanParallelSweepPendingObjects()
+{
+    if (!GetRecyclerFlagsTable().RecyclerParallelConcurrentSweep || this->maxParallelism <= 2 || this->parallelMarkHelperCount == 0)
+    {
+        return false;
+    }
+
+    // NotifyFree reports each swept object to these single threaded consumers; keep the sweep on one thread for them.
+#ifdef RECYCLER_TEST_SUPPORT
+    if (BinaryFeatureControl::RecyclerTest() && checkFn != nullptr)
+    {
+        return false;
+    }
+#endif
+#ifdef PROFILE_RECYCLER_ALLOC
+    if (trackerDictionary != nullptr)
+    {
+        return false;
+    }
+#endif
+    if (RecyclerMemoryTracking::IsActive())
+    {
+        return false;
+    }
+#ifdef ENABLE_JS_ETW
+    if (EventEnabledJSCRIPT_RECYCLER_FREE_MEMORY())
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool
+Recycler::ParallelSweepPendingObjects(HeapInfo * heapInfo, RecyclerSweep& recyclerSweep)
+{
+    Assert(recyclerSweep.IsBackground());
+    Assert((this->collectionState & Collection_ConcurrentSweep) == Collection_ConcurrentSweep);
+
+    if (!this->CanParallelSweepPendingObjects())
+    {
+        return false;
+    }
+
+    this->parallelSweepHeapInfo = heapInfo;
+    this->parallelSweepRecyclerSweep = &recyclerSweep;
+    this->parallelSweepBucketIndex = -1;
+#ifdef RECYCLER_PERF_COUNTERS
+    memset(this->parallelSweepFreeCounts, 0, sizeof(this->parallelSweepFreeCounts));
+#endif
+    MemoryBarrier();
+
+    uint helperCount = min(this->maxParallelism - 2, this->parallelMarkHelperCount);
+    bool parallelSuccess[MaxParallelMarkHelpers] = { false };
+    for (uint i = 0; i < helperCount; i++)
+    {
+        parallelSuccess[i] = parallelMarkHelpers[i]->parallelThread.StartConcurrent();
+        if (!parallelSuccess[i])
+        {
+            break;
+        }
+    }
+
+#ifdef RECYCLER_STATS
+    collectionStats.parallelSweepWorkerCount = 1;
+    for (uint i = 0; i < helperCount && parallelSuccess[i]; i++)
+    {
+        collectionStats.parallelSweepWorkerCount++;
+    }
+#endif
+
+    // Buckets are claimed one at a time, so a helper that failed to start simply leaves more for the rest of us.
+    this->ProcessParallelSweep(0);
+
+    for (uint i = 0; i < helperCount; i++)
+    {
+        if (parallelSuccess[i])
+        {
+            parallelMarkHelpers[i]->parallelThread.WaitForConcurrent();
+        }
+    }
+
+    Assert(this->parallelSweepBucketIndex >= (LONG)HeapInfo::PendingSweepBucketCount);
+#ifdef RECYCLER_PERF_COUNTERS
+    this->ReportParallelSweepFreeCounts(helperCount + 1);
+#endif
+    this->parallelSweepHeapInfo = nullptr;
+    this->parallelSweepRecyclerSweep = nullptr;
+    return true;
+}
+
+void
+Recycler::ProcessParallelSweep(uint workerIndex)
+{
+    HeapInfo * heapInfo = this->parallelSweepHeapInfo;
+    RecyclerSweep& recyclerSweep = *this->parallelSweepRecyclerSweep;
+
+#ifdef RECYCLER_PERF_COUNTERS
+    Assert(currentParallelSweepFreeCounts == nullptr);
+    currentParallelSweepFreeCounts = &this->parallelSweepFreeCounts[workerIndex];
+#endif
+
+    uint bucketIndex;
+    while ((bucketIndex = (uint)InterlockedIncrement(&this->parallelSweepBucketIndex)) < HeapInfo::PendingSweepBucketCount)
+    {
+#ifdef RECYCLER_STATS
+        collectionStats.parallelSweepBlockCount[workerIndex] += heapInfo->GetPendingSweepBlockCount(recyclerSweep, bucketIndex);
+#endif
+        heapInfo->SweepPendingObjects(recyclerSweep, bucketIndex);
+    }
+
+#ifdef RECYCLER_PERF_COUNTERS
+    currentParallelSweepFreeCounts = nullptr;
+#endif
+}
+
+#ifdef RECYCLER_PERF_COUNTERS
+THREAD_LOCAL Recycler::ParallelSweepFreeCounts * Recycler::currentParallelSweepFreeCounts = nullptr;
+
+void
+Recycler::ReportParallelSweepFreeCounts(uint workerCount)
+{
+    // Called on the concurrent thread once every worker has been joined.
+    for (uint i = 0; i < workerCount; i++)
+    {
+        const ParallelSweepFreeCounts& counts = this->parallelSweepFreeCounts[i];
+        RECYCLER_PERF_COUNTER_SUB(LiveObject, counts.smallObjectCount + counts.largeObjectCount);
+        RECYCLER_PERF_COUNTER_SUB(LiveObjectSize, counts.smallObjectBytes + counts.largeObjectBytes);
+        RECYCLER_PERF_COUNTER_ADD(FreeObjectSize, counts.smallObjectBytes + counts.largeObjectBytes);
+        RECYCLER_PERF_COUNTER_SUB(SmallHeapBlockLiveObject, counts.smallObjectCount);
+        RECYCLER_PERF_COUNTER_SUB(SmallHeapBlockLiveObjectSize, counts.smallObjectBytes);
+        RECYCLER_PERF_COUNTER_ADD(SmallHeapBlockFreeObjectSize, counts.smallObjectBytes);
+        RECYCLER_PERF_COUNTER_SUB(LargeHeapBlockLiveObject, counts.largeObjectCount);
+        RECYCLER_PERF_COUNTER_SUB(LargeHeapBlockLiveObjectSize, counts.largeObjectBytes);
+        RECYCLER_PERF_COUNTER_ADD(LargeHeapBlockFreeObjectSize, counts.largeObjectBytes);
+    }
 }
 #endif
+#endif
 
 size_t
 Recycler::RootMark(CollectionState markState)
@@ -2743,7 +2931,7 @@ Recycler::RootMark(CollectionState markState)
     this->SetCollectionState(markState);
 
 #if ENABLE_CONCURRENT_GC
-    if (this->enableParallelMark)
+    if (this->enableParallelMark && this->maxParallelism > 1)
     {
         this->DoParallelMark();
     }
@@ -2848,15 +3036,11 @@ Recycler::EndMark()
     // Clean up mark contexts, which will release held free pages
     // Do this for all contexts before we decommit, to make sure all pages are freed
     markContext.Cleanup();
-    parallelMarkContext1.Cleanup();
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    ForEachParallelMarkContext([](MarkContext * context) { context->Cleanup(); });
 
     // Decommit all pages
     markContext.DecommitPages();
-    parallelMarkContext1.DecommitPages();
-    parallelMarkContext2.DecommitPages();
-    parallelMarkContext3.DecommitPages();
+    ForEachParallelMarkContext([](MarkContext * context) { context->DecommitPages(); });
 
     GCETW(GC_DECOMMIT_CONCURRENT_COLLECT_PAGE_ALLOCATOR_STOP, (this));
 
@@ -2950,9 +3134,9 @@ Recycler::EndMarkOnLowMemory()
     while (this->NeedOOMRescan());
 
     Assert(!markContext.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext1.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext2.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext3.GetPageAllocator()->DisableAllocationOutOfMemory());
+#if DBG
+    ForEachParallelMarkContext([](MarkContext * context) { Assert(!context->GetPageAllocator()->DisableAllocationOutOfMemory()); });
+#endif
     CUSTOM_PHASE_PRINT_TRACE1(GetRecyclerFlagsTable(), Js::RecyclerPhase, _u("EndMarkOnLowMemory iterations: %d\n"), iterations);
 
 #if ENABLE_PARTIAL_GC
@@ -2977,10 +3161,50 @@ Recycler::EndMarkOnLowMemory()
 bool
 Recycler::IsMarkStackEmpty()
 {
-    return (markContext.IsEmpty() && parallelMarkContext1.IsEmpty() && parallelMarkContext2.IsEmpty() && parallelMarkContext3.IsEmpty());
+    bool isEmpty = markContext.IsEmpty();
+    ForEachParallelMarkContext([&](MarkContext * context) { isEmpty = context->IsEmpty() && isEmpty; });
+    return isEmpty;
 }
 #endif
 
+bool
+Recycler::HasPendingMarkObjects() const
+{
+    if (markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects())
+    {
+        return true;
+    }
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        if (parallelMarkHelpers[i]->markContext.HasPendingMarkObjects())
+        {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+bool
+Recycler::HasPendingTrackObjects() const
+{
+    if (markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects())
+    {
+        return true;
+    }
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        if (parallelMarkHelpers[i]->markContext.HasPendingTrackObjects())
+        {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
 #ifdef HEAP_ENUMERATION_VALIDATION
 void
 Recycler::PostHeapEnumScan(PostHeapEnumScanCallback callback, void *data)
@@ -4075,6 +4299,17 @@ Recycler::DoCollect(CollectionFlags flags)
 #endif
             Assert(enablePartialCollect && inPartialCollectMode);
 
+            this->nurseryMinorCollectCount++;
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+            // Only the first one is reported; how many run depends on the heap layout
+            if (GetRecyclerFlagsTable().RecyclerNurseryCollect && !this->nurseryMinorCollectTraced &&
+                GetRecyclerFlagsTable().TestTrace.IsEnabled(Js::PartialCollectPhase))
+            {
+                this->nurseryMinorCollectTraced = true;
+                Output::Print(_u("[Nursery: minor collection]\n"));
+                Output::Flush();
+            }
+#endif
             if (!this->PartialCollect(concurrent))
             {
                 return collected;
@@ -4087,6 +4322,7 @@ Recycler::DoCollect(CollectionFlags flags)
 
         // Not doing partial collect, we should decommit on finish collect
         decommitOnFinish = true;
+        this->nurseryMinorCollectCount = 0;
 
         if (inPartialCollectMode)
         {
@@ -4528,9 +4764,7 @@ Recycler::ProcessTrackedObjects()
 
     // If we did a parallel mark, we need to process any queued tracked objects from the parallel mark stack as well.
     // If we didn't, this will do nothing.
-    parallelMarkContext1.ProcessTracked();
-    parallelMarkContext2.ProcessTracked();
-    parallelMarkContext3.ProcessTracked();
+    ForEachParallelMarkContext([](MarkContext * context) { context->ProcessTracked(); });
 
     DebugOnly(this->isProcessingTrackedObjects = false);
 
@@ -5081,8 +5315,7 @@ Recycler::FinalizeConcurrent(bool restoreState)
 
     // Shutdown parallel threads and return the handle for them so the caller can
     // close it.
-    parallelThread1.Shutdown();
-    parallelThread2.Shutdown();
+    ShutdownParallelMarkHelpers(this->parallelMarkHelperCount);
 
 #ifdef IDLE_DECOMMIT_ENABLED
     if (concurrentIdleDecommitEvent != nullptr)
@@ -5148,6 +5381,11 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
         this->enableParallelMark = false;
     }
 
+    if (this->enableParallelMark)
+    {
+        CreateParallelMarkHelpers();
+    }
+
     if (threadService->HasCallback())
     {
         this->threadService = threadService;
@@ -5156,31 +5394,20 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     else
     {
         bool startConcurrentThread = true;
-        bool startedParallelThread1 = false;
-        bool startedParallelThread2 = false;
+        uint startedParallelThreadCount = 0;
 
         if (startAllThreads)
         {
-            if (this->enableParallelMark && this->maxParallelism > 2)
+            if (this->enableParallelMark)
             {
-                if (!parallelThread1.EnableConcurrent(true))
+                for (uint i = 0; i < this->parallelMarkHelperCount; i++)
                 {
-                    startConcurrentThread = false;
-                }
-                else
-                {
-                    startedParallelThread1 = true;
-                    if (this->maxParallelism > 3)
+                    if (!parallelMarkHelpers[i]->parallelThread.EnableConcurrent(true))
                     {
-                        if (!parallelThread2.EnableConcurrent(true))
-                        {
-                            startConcurrentThread = false;
-                        }
-                        else
-                        {
-                            startedParallelThread2 = true;
-                        }
+                        startConcurrentThread = false;
+                        break;
                     }
+                    startedParallelThreadCount++;
                 }
             }
         }
@@ -5209,14 +5436,7 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
             }
         }
 
-        if (startedParallelThread1)
-        {
-            parallelThread1.Shutdown();
-            if (startedParallelThread2)
-            {
-                parallelThread2.Shutdown();
-            }
-        }
+        ShutdownParallelMarkHelpers(startedParallelThreadCount);
     }
 
     // We failed to start a concurrent thread so we set these back to false and clean up
@@ -6968,13 +7188,81 @@ RecyclerParallelThread::EnableConcurrent(bool waitForThread)
 }
 
 
-template <uint parallelId>
 void
-Recycler::ParallelWorkFunc()
+Recycler::CreateParallelMarkHelpers()
+{
+    Assert(this->maxParallelism > 1 && this->maxParallelism <= MaxParallelism);
+
+    // One helper per thread beyond the calling thread and the concurrent thread.
+    // If we can't allocate all of them, run with the parallelism we did get.
+    const uint helperCount = this->maxParallelism - 2;
+    for (uint i = this->parallelMarkHelperCount; i < helperCount; i++)
+    {
+        RecyclerParallelMarkHelper * helper = HeapNewNoThrow(RecyclerParallelMarkHelper, this, this->GetRecyclerFlagsTable(), &Recycler::ParallelWorkFunc, i);
+        if (helper == nullptr)
+        {
+            break;
+        }
+
+#ifdef RECYCLER_MARK_TRACK
+        helper->markContext.SetMarkMap(this->markMap);
+#endif
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+        helper->markContext.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
+#endif
+        this->parallelMarkHelpers[i] = helper;
+        this->parallelMarkHelperCount++;
+    }
+
+    this->maxParallelism = min(this->maxParallelism, this->parallelMarkHelperCount + 2);
+}
+
+void
+Recycler::ShutdownParallelMarkHelpers(uint helperCount)
+{
+    Assert(helperCount <= this->parallelMarkHelperCount);
+
+    for (uint i = 0; i < helperCount; i++)
+    {
+        parallelMarkHelpers[i]->parallelThread.Shutdown();
+    }
+}
+
+void
+Recycler::DeleteParallelMarkHelpers()
+{
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        Assert(!parallelMarkHelpers[i]->markContext.HasPendingObjects());
+        HeapDelete(parallelMarkHelpers[i]);
+        parallelMarkHelpers[i] = nullptr;
+    }
+    this->parallelMarkHelperCount = 0;
+}
+
+void
+Recycler::SetMaxParallelism(uint parallelism)
+{
+    // Used to measure mark scaling on one heap. Parallelism can only be lowered
+    // below what was configured at startup, since helpers are created in EnableConcurrent.
+    // A parallelism of 1 keeps parallel mark enabled but marks in thread without splitting.
+    Assert(!this->CollectionInProgress());
+    Assert(parallelism > 0);
+
+    if (!this->enableParallelMark)
+    {
+        return;
+    }
+
+    this->maxParallelism = min(parallelism, this->parallelMarkHelperCount + 2);
+}
+
+void
+Recycler::ParallelWorkFunc(uint parallelId)
 {
-    Assert(parallelId == 0 || parallelId == 1);
+    Assert(parallelId < this->parallelMarkHelperCount);
 
-    MarkContext * markContext = (parallelId == 0 ? &this->parallelMarkContext2 : &this->parallelMarkContext3);
+    MarkContext * markContext = &this->parallelMarkHelpers[parallelId]->markContext;
 
     switch (this->collectionState)
     {
@@ -6986,6 +7274,15 @@ Recycler::ParallelWorkFunc()
             this->ProcessParallelMark(true, markContext);
             break;
 
+        case CollectionStateConcurrentSweep:
+#if ENABLE_ALLOCATIONS_DURING_CONCURRENT_SWEEP
+        case CollectionStateConcurrentSweepPass1:
+        case CollectionStateConcurrentSweepPass2:
+#endif
+            // Worker 0 is the concurrent thread.
+            this->ProcessParallelSweep(parallelId + 1);
+            break;
+
         default:
             Assert(false);
     }
@@ -7055,6 +7352,7 @@ RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
         RecyclerParallelThread * parallelThread = (RecyclerParallelThread *)lpParameter;
         Recycler * recycler = parallelThread->recycler;
         RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
+        uint parallelId = parallelThread->parallelId;
 
         Assert(recycler->IsConcurrentEnabled());
 
@@ -7093,7 +7391,7 @@ RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
             }
 
             // Invoke the workFunc to do real work
-            (recycler->*workFunc)();
+            (recycler->*workFunc)(parallelId);
 
             // We always wait after the first time
             mustWait = true;
@@ -7132,7 +7430,7 @@ RecyclerParallelThread::StaticBackgroundWorkCallback(void * callbackData)
     Recycler * recycler = parallelThread->recycler;
     RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
 
-    (recycler->*workFunc)();
+    (recycler->*workFunc)(parallelThread->parallelId);
 
     SetEvent(parallelThread->concurrentWorkDoneEvent);
 }
@@ -7429,6 +7727,11 @@ Recycler::PrintHeuristicCollectionStats()
         Output::Print(_u(" New page    : %10d %10s %10d"), collectionStats.startCollectNewPageCount, _u(""), autoHeap.uncollectedNewPageCount);
         Output::Print(_u(" | Partial Uncollect New Page   : %10d %10d"), collectionStats.uncollectedNewPageCountPartialCollect * AutoSystemInfo::PageSize, this->uncollectedNewPageCountPartialCollect * AutoSystemInfo::PageSize);
         Output::Print(_u("\n"));
+        if (GetRecyclerFlagsTable().RecyclerNurseryCollect)
+        {
+            Output::Print(_u("                                                | Nursery Minor Collects       : %10d %10d\n"),
+                this->nurseryMinorCollectCount, GetRecyclerFlagsTable().RecyclerNurseryMaxMinorCollects);
+        }
     }
 #endif
 
@@ -7591,6 +7894,11 @@ Recycler::PrintMemoryStats()
         , collectionStats.numEmptySmallBlocks[HeapBlock::SmallLeafBlockType]
         + collectionStats.numEmptySmallBlocks[HeapBlock::MediumLeafBlockType],
         collectionStats.numZeroedOutSmallBlocks);
+
+    if (GetRecyclerFlagsTable().RecyclerDefragmentMediumBlocks)
+    {
+        Output::Print(_u("Number of sparse medium blocks left to drain: %d\n"), collectionStats.heapBlockDefragmentDeferredCount);
+    }
 }
 
 void
@@ -7795,6 +8103,19 @@ Recycler::PrintCollectStats()
 #endif
     Output::Print(_u("\n"));
 
+#if ENABLE_CONCURRENT_GC
+    if (collectionStats.parallelSweepWorkerCount != 0)
+    {
+        Output::Print(_u("---------------------------------------------------------------------------------------------------------------\n"));
+        Output::Print(_u("Parallel sweep: %d threads, pending blocks swept per thread:"), collectionStats.parallelSweepWorkerCount);
+        for (uint i = 0; i < collectionStats.parallelSweepWorkerCount; i++)
+        {
+            Output::Print(_u(" %5d"), collectionStats.parallelSweepBlockCount[i]);
+        }
+        Output::Print(_u("\n"));
+    }
+#endif
+
     PrintMemoryStats();
 
     Output::Flush();
@@ -9180,22 +9501,43 @@ Recycler::NotifyFree(__in char *address, size_t size)
     }
 #endif
 
+    // Parallel sweep is only used when memory tracking is inactive (see CanParallelSweepPendingObjects)
     RecyclerMemoryTracking::ReportFree(this, address, size);
-    RECYCLER_PERF_COUNTER_DEC(LiveObject);
-    RECYCLER_PERF_COUNTER_SUB(LiveObjectSize, size);
-    RECYCLER_PERF_COUNTER_ADD(FreeObjectSize, size);
 
-    if (HeapInfo::IsSmallBlockAllocation(HeapInfo::GetAlignedSizeNoCheck(size)))
+#if defined(RECYCLER_PERF_COUNTERS) && ENABLE_CONCURRENT_GC
+    if (currentParallelSweepFreeCounts != nullptr)
     {
-        RECYCLER_PERF_COUNTER_DEC(SmallHeapBlockLiveObject);
-        RECYCLER_PERF_COUNTER_SUB(SmallHeapBlockLiveObjectSize, size);
-        RECYCLER_PERF_COUNTER_ADD(SmallHeapBlockFreeObjectSize, size);
+        // On a parallel sweep worker; ReportParallelSweepFreeCounts updates the counters after the join.
+        if (HeapInfo::IsSmallBlockAllocation(HeapInfo::GetAlignedSizeNoCheck(size)))
+        {
+            currentParallelSweepFreeCounts->smallObjectCount++;
+            currentParallelSweepFreeCounts->smallObjectBytes += size;
+        }
+        else
+        {
+            currentParallelSweepFreeCounts->largeObjectCount++;
+            currentParallelSweepFreeCounts->largeObjectBytes += size;
+        }
     }
     else
+#endif
     {
-        RECYCLER_PERF_COUNTER_DEC(LargeHeapBlockLiveObject);
-        RECYCLER_PERF_COUNTER_SUB(LargeHeapBlockLiveObjectSize, size);
-        RECYCLER_PERF_COUNTER_ADD(LargeHeapBlockFreeObjectSize, size);
+        RECYCLER_PERF_COUNTER_DEC(LiveObject);
+        RECYCLER_PERF_COUNTER_SUB(LiveObjectSize, size);
+        RECYCLER_PERF_COUNTER_ADD(FreeObjectSize, size);
+
+        if (HeapInfo::IsSmallBlockAllocation(HeapInfo::GetAlignedSizeNoCheck(size)))
+        {
+            RECYCLER_PERF_COUNTER_DEC(SmallHeapBlockLiveObject);
+            RECYCLER_PERF_COUNTER_SUB(SmallHeapBlockLiveObjectSize, size);
+            RECYCLER_PERF_COUNTER_ADD(SmallHeapBlockFreeObjectSize, size);
+        }
+        else
+        {
+            RECYCLER_PERF_COUNTER_DEC(LargeHeapBlockLiveObject);
+            RECYCLER_PERF_COUNTER_SUB(LargeHeapBlockLiveObjectSize, size);
+            RECYCLER_PERF_COUNTER_ADD(LargeHeapBlockFreeObjectSize, size);
+        }
     }
 
 #ifdef RECYCLER_MEMORY_VERIFY
@@ -9213,13 +9555,14 @@ Recycler::NotifyFree(__in char *address, size_t size)
 #endif
 
 #ifdef RECYCLER_STATS
-    collectionStats.objectSweptCount++;
-    collectionStats.objectSweptBytes += size;
+    // Pending blocks may be swept by several threads at once (see ParallelSweepPendingObjects)
+    RECYCLER_STATS_INTERLOCKED_INC(this, objectSweptCount);
+    RECYCLER_STATS_INTERLOCKED_ADD(this, objectSweptBytes, size);
 
     if (!isForceSweeping)
     {
-        collectionStats.objectSweptFreeListCount++;
-        collectionStats.objectSweptFreeListBytes += size;
+        RECYCLER_STATS_INTERLOCKED_INC(this, objectSweptFreeListCount);
+        RECYCLER_STATS_INTERLOCKED_ADD(this, objectSweptFreeListBytes, size);
     }
 #endif
 }
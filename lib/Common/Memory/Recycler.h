@@ -525,6 +525,11 @@ struct RecyclerCollectionStats
     size_t heapBlockFreeCount[HeapBlock::BlockTypeCount];                   // number of heap blocks deleted
     size_t heapBlockConcurrentSweptCount[HeapBlock::SmallBlockTypeCount];
     size_t heapBlockSweptCount[HeapBlock::SmallBlockTypeCount];             // number of heap blocks swept
+    size_t heapBlockDefragmentDeferredCount;                                // sparse medium blocks moved to the end of the allocation order
+#if ENABLE_CONCURRENT_GC
+    uint parallelSweepWorkerCount;                                          // threads that swept pending blocks in parallel (0 if not parallel)
+    size_t parallelSweepBlockCount[PageStack<void *>::MaxSplitTargets + 1];  // pending blocks swept by each of those threads
+#endif
 
     size_t objectSweptCount;                // objects freed (free list + whole page freed)
     size_t objectSweptBytes;
@@ -596,11 +601,12 @@ class RecyclerParallelThread
     friend class ThreadContext;
 
 public:
-    typedef void (Recycler::* WorkFunc)();
+    typedef void (Recycler::* WorkFunc)(uint parallelId);
 
-    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc) :
+    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc, uint parallelId) :
         recycler(recycler),
         workFunc(workFunc),
+        parallelId(parallelId),
         concurrentWorkReadyEvent(NULL),
         concurrentWorkDoneEvent(NULL),
         concurrentThread(NULL)
@@ -629,11 +635,29 @@ class RecyclerParallelThread
 private:
     WorkFunc workFunc;
     Recycler * recycler;
+    uint parallelId;
     HANDLE concurrentWorkReadyEvent;// main thread uses this event to tell concurrent threads that the work is ready
     HANDLE concurrentWorkDoneEvent;// concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
     bool synchronizeOnStartup;
 };
+
+// State owned by one parallel mark helper thread: the mark context it drains,
+// the page pool backing that context's stacks, and the thread itself.
+class RecyclerParallelMarkHelper
+{
+public:
+    RecyclerParallelMarkHelper(Recycler * recycler, Js::ConfigFlagsTable& flagsTable, RecyclerParallelThread::WorkFunc workFunc, uint parallelId) :
+        pagePool(flagsTable),
+        markContext(recycler, &this->pagePool),
+        parallelThread(recycler, workFunc, parallelId)
+    {
+    }
+
+    PagePool pagePool;
+    MarkContext markContext;
+    RecyclerParallelThread parallelThread;
+};
 #endif
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
@@ -896,20 +920,29 @@ class Recycler
     MarkContext markContext;
 
     // Contexts for parallel marking.
-    // We support up to 4 way parallelism, main context + 3 additional parallel contexts.
+    // We support up to MaxParallelism way parallelism: the main context, parallelMarkContext1 (used by the
+    // calling thread during in-thread parallel mark), and one context per parallel mark helper thread.
     MarkContext parallelMarkContext1;
-    MarkContext parallelMarkContext2;
-    MarkContext parallelMarkContext3;
 
     // Page pools for above markContexts
     PagePool markPagePool;
     PagePool parallelMarkPagePool1;
-    PagePool parallelMarkPagePool2;
-    PagePool parallelMarkPagePool3;
 
     bool IsMarkStackEmpty();
-    bool HasPendingMarkObjects() const { return markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects() || parallelMarkContext2.HasPendingMarkObjects() || parallelMarkContext3.HasPendingMarkObjects(); }
-    bool HasPendingTrackObjects() const { return markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects() || parallelMarkContext2.HasPendingTrackObjects() || parallelMarkContext3.HasPendingTrackObjects(); }
+    bool HasPendingMarkObjects() const;
+    bool HasPendingTrackObjects() const;
+
+    template <class Fn>
+    void ForEachParallelMarkContext(Fn fn)
+    {
+        fn(&parallelMarkContext1);
+#if ENABLE_CONCURRENT_GC
+        for (uint i = 0; i < parallelMarkHelperCount; i++)
+        {
+            fn(&parallelMarkHelpers[i]->markContext);
+        }
+#endif
+    }
 
     RecyclerCollectionWrapper * collectionWrapper;
 
@@ -1033,6 +1066,10 @@ class Recycler
 
     uint maxParallelism;        // Max # of total threads to run in parallel
 
+    static const uint MaxParallelism = PageStack<void *>::MaxSplitTargets + 1;
+    static const uint DefaultMaxParallelism = 4;
+    static const uint MaxParallelMarkHelpers = MaxParallelism - 2;  // Not counting the calling thread and the concurrent thread
+
     byte backgroundRescanCount;             // for ETW events and stats
     byte backgroundFinishMarkCount;
     size_t backgroundRescanRootBytes;
@@ -1040,11 +1077,46 @@ class Recycler
     HANDLE concurrentWorkDoneEvent; // concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
 
-    template <uint parallelId>
-    void ParallelWorkFunc();
+    void ParallelWorkFunc(uint parallelId);
+
+    void CreateParallelMarkHelpers();
+    void ShutdownParallelMarkHelpers(uint helperCount);
+    void DeleteParallelMarkHelpers();
+
+    void StartParallelMarkWorkQueue(uint workerCount);
+    void StartParallelMarkHelpers(uint helperCount, __out_ecount(helperCount) bool * parallelSuccess);
+    void WaitForParallelMarkHelpers(bool background, uint helperCount, __in_ecount(helperCount) bool * parallelSuccess);
+
+    bool CanParallelSweepPendingObjects();
+    bool ParallelSweepPendingObjects(HeapInfo * heapInfo, RecyclerSweep& recyclerSweep);
+    void ProcessParallelSweep(uint workerIndex);
+
+    // Helpers (maxParallelism - 2 of them) are allocated when concurrent GC is enabled; their threads start on demand.
+    // The work queue lets the threads taking part in a parallel mark rebalance their mark stacks as they drain.
+    RecyclerParallelMarkHelper * parallelMarkHelpers[MaxParallelMarkHelpers];
+    uint parallelMarkHelperCount;
+    ParallelMarkWorkQueue parallelMarkWorkQueue;
+    bool parallelMarkWorkQueueEnabled;
+
+    // During a parallel concurrent sweep the helpers join the concurrent thread, each claiming the next bucket index in turn.
+    HeapInfo * parallelSweepHeapInfo;
+    RecyclerSweep * parallelSweepRecyclerSweep;
+    volatile LONG parallelSweepBucketIndex;
 
-    RecyclerParallelThread parallelThread1;
-    RecyclerParallelThread parallelThread2;
+#ifdef RECYCLER_PERF_COUNTERS
+    // The perf counters NotifyFree updates are plain globals. Each parallel sweep worker totals its frees
+    // in its own slot instead, and the concurrent thread adds them to the counters after the join.
+    struct ParallelSweepFreeCounts
+    {
+        size_t smallObjectCount;
+        size_t smallObjectBytes;
+        size_t largeObjectCount;
+        size_t largeObjectBytes;
+    };
+    ParallelSweepFreeCounts parallelSweepFreeCounts[MaxParallelMarkHelpers + 1];
+    THREAD_LOCAL static ParallelSweepFreeCounts * currentParallelSweepFreeCounts;
+    void ReportParallelSweepFreeCounts(uint workerCount);
+#endif
 
 #if DBG
     // Variable indicating if the concurrent thread has exited or not
@@ -1090,6 +1162,12 @@ class Recycler
 
     // Dynamic Heuristics for partial GC
     size_t uncollectedNewPageCountPartialCollect;
+
+    // Partial collections done since the last full one; bounds the run of minor collections in nursery mode
+    uint nurseryMinorCollectCount;
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    bool nurseryMinorCollectTraced;
+#endif
 #endif
 
     uint tickCountNextCollection;
@@ -1304,6 +1382,9 @@ class Recycler
 #ifdef RECYCLER_TEST_SUPPORT
     void SetCheckFn(BOOL(*checkFn)(char* addr, size_t size));
 #endif
+#if ENABLE_CONCURRENT_GC
+    void SetMaxParallelism(uint parallelism);
+#endif
 
     void SetCollectionWrapper(RecyclerCollectionWrapper * wrapper);
     static size_t GetAlignedSize(size_t size) { return HeapInfo::GetAlignedSize(size); }
@@ -26,6 +26,26 @@ bool RecyclerPageAllocator::IsMemProtectMode()
     return heapInfo->GetRecycler()->IsMemProtectMode();
 }
 
+void
+RecyclerPageAllocator::EnableHugePages()
+{
+    Assert(segments.Empty());
+    Assert(fullSegments.Empty());
+    Assert(emptySegments.Empty());
+    Assert(decommitSegments.Empty());
+    Assert(largeSegments.Empty());
+
+#if ENABLE_RECYCLER_HUGE_PAGES
+    // One page segment per huge page
+    const size_t hugePageCount = HugePageSize / AutoSystemInfo::PageSize;
+    if (secondaryAllocPageCount == 0 && hugePageCount <= PageSegment::MaxDataPageCount)
+    {
+        maxAllocPageCount = (uint)hugePageCount;
+        hugePages = true;
+    }
+#endif
+}
+
 #if ENABLE_CONCURRENT_GC
 #ifdef RECYCLER_WRITE_WATCH
 void
@@ -18,6 +18,8 @@ class RecyclerPageAllocator : public IdleDecommitPageAllocator
 #endif
 #endif
 
+    void EnableHugePages();
+
     static uint const DefaultPrimePageCount = 0x1000; // 16MB
 
 #if ENABLE_CONCURRENT_GC
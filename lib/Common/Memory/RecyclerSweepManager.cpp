@@ -416,6 +416,11 @@ RecyclerSweepManager::AdjustPartialHeuristics()
     Assert(this->adjustPartialHeuristics);
     Assert(this->InPartialCollect() || recycler->autoHeap.unusedPartialCollectFreeBytes == 0);
 
+    if (recycler->GetRecyclerFlagsTable().RecyclerNurseryCollect)
+    {
+        return this->AdjustNurseryHeuristics();
+    }
+
     // DoPartialCollectMode should have rejected these already
     Assert(this->rescanRootBytes <= (size_t)MaxPartialCollectRescanRootBytes);
     Assert(recycler->autoHeap.unusedPartialCollectFreeBytes <= MaxUnusedPartialCollectFreeBytes);
@@ -525,6 +530,71 @@ RecyclerSweepManager::AdjustPartialHeuristics()
     return true;
 }
 
+/*--------------------------------------------------------------------------------------------
+* Nursery mode: keep doing partial (minor) collections on a fixed budget of new pages, regardless
+* of the cost/efficacy ratio, until we have done too many in a row or the old generation has
+* accumulated too much uncollected or unusable memory.
+*--------------------------------------------------------------------------------------------*/
+bool
+RecyclerSweepManager::AdjustNurseryHeuristics()
+{
+    Assert(recycler->GetRecyclerFlagsTable().RecyclerNurseryCollect);
+
+    if (recycler->nurseryMinorCollectCount >= (uint)recycler->GetRecyclerFlagsTable().RecyclerNurseryMaxMinorCollects)
+    {
+        return false;
+    }
+
+    if (this->InPartialCollect() && this->nextPartialUncollectedAllocBytes > RecyclerHeuristic::Instance.MaxUncollectedAllocBytesPartialCollect)
+    {
+        return false;
+    }
+
+    // Survivors of the nursery stay where they were allocated and become part of the old generation.
+    // Old blocks are only handed back to the allocator if they are at least as free as the collection was effective,
+    // so that new objects mostly land on new pages instead of dirtying old ones that the next minor collection would rescan.
+    double collectEfficacy = 1.0;
+    const size_t allocBytes = this->GetNewObjectAllocBytes();
+    if (allocBytes != 0)
+    {
+        const size_t freedBytes = this->GetNewObjectFreeBytes();
+        Assert(freedBytes <= allocBytes);
+        collectEfficacy = (double)freedBytes / (double)allocBytes;
+    }
+    this->partialCollectSmallHeapBlockReuseMinFreeBytes = allocBytes == 0 ? 0 : (size_t)(AutoSystemInfo::PageSize * collectEfficacy);
+
+#ifdef RECYCLER_STATS
+    recycler->collectionStats.collectEfficacy = collectEfficacy;
+    recycler->collectionStats.partialCollectSmallHeapBlockReuseMinFreeBytes = this->partialCollectSmallHeapBlockReuseMinFreeBytes;
+#endif
+
+    size_t nurseryPageCount = (size_t)recycler->GetRecyclerFlagsTable().RecyclerNurserySize * (1 MEGABYTES / AutoSystemInfo::PageSize);
+    if (nurseryPageCount < MinPartialUncollectedNewPageCount)
+    {
+        nurseryPageCount = MinPartialUncollectedNewPageCount;
+    }
+    else if (nurseryPageCount > RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount)
+    {
+        nurseryPageCount = RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount;
+    }
+
+    // Same guard as the partial heuristics: if filling the nursery would trigger a full GC anyway, don't bother.
+    const size_t estimatedReusedFreeByteCount = (size_t)((double)this->reuseByteCount * (1.0 - collectEfficacy));
+    if (nurseryPageCount * AutoSystemInfo::PageSize + this->nextPartialUncollectedAllocBytes + estimatedReusedFreeByteCount
+        >= RecyclerHeuristic::Instance.MaxUncollectedAllocBytesPartialCollect)
+    {
+        return false;
+    }
+
+    recycler->uncollectedNewPageCountPartialCollect = nurseryPageCount;
+
+#if ENABLE_CONCURRENT_GC
+    // Minor collections are meant to be short; do them in thread unless the phase flags say otherwise.
+    recycler->partialConcurrentNextCollection = RecyclerHeuristic::PartialConcurrentNextCollection(0.0, recycler->GetRecyclerFlagsTable());
+#endif
+    return true;
+}
+
 size_t
 RecyclerSweepManager::GetNewObjectAllocBytes() const
 {
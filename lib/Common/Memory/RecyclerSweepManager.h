@@ -41,6 +41,7 @@ class RecyclerSweepManager
     bool DoPartialCollectMode();
     bool DoAdjustPartialHeuristics() const;
     bool AdjustPartialHeuristics();
+    bool AdjustNurseryHeuristics();
     void SubtractSweepNewObjectAllocBytes(size_t newObjectExpectSweepByteCount);
     size_t GetNewObjectAllocBytes() const;
     size_t GetNewObjectFreeBytes() const;
@@ -384,6 +384,9 @@ class HeapBucketGroup
     uint Rescan(Recycler * recycler, RescanFlags flags);
 #if ENABLE_CONCURRENT_GC
     void SweepPendingObjects(RecyclerSweep& recyclerSweep);
+#ifdef RECYCLER_STATS
+    size_t GetPendingSweepBlockCount(RecyclerSweep& recyclerSweep);
+#endif
 #endif
 #if ENABLE_PARTIAL_GC
     void SweepPartialReusePages(RecyclerSweep& recyclerSweep);
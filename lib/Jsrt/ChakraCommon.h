@@ -239,6 +239,10 @@ typedef unsigned short uint16_t;
         ///     Module was not yet evaluated when JsGetModuleNamespace was called.
         /// </summary>
         JsErrorModuleNotEvaluated,
+        /// <summary>
+        ///     A host callback asked the API to stop before the operation was complete.
+        /// </summary>
+        JsErrorOperationCancelled,
 
         /// <summary>
         ///     Category of errors that relates to errors occurring within the engine itself.
@@ -482,6 +486,12 @@ typedef unsigned short uint16_t;
         //      disabled as well
         /// </summary>
         JsRuntimeAttributeDisableExecutablePageAllocation = 0x00000100,
+        /// <summary>
+        ///     Runtime will collect the dynamic profiles of scripts run with a source context, so
+        ///     that hosts can persist them with <c>JsSerializeScriptProfile</c> and
+        ///     <c>JsLoadScriptProfile</c>. This costs a small amount of memory per profiled function.
+        /// </summary>
+        JsRuntimeAttributeEnableProfilePersistence = 0x00000200,
 
     } JsRuntimeAttributes;
 
@@ -822,6 +822,165 @@ CHAKRA_API
         _In_ JsValueRef sourceUrl,
         _Out_ JsValueRef *result);
 
+/// <summary>
+///     Creates an ArrayBuffer backed by a memory mapping of a serialized script file.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Requires an active script context.
+///     </para>
+///     <para>
+///     The file is expected to hold the contents of a buffer produced by <c>JsSerialize</c>.
+///     It is mapped copy-on-write and its pages are faulted in lazily, so processes that map
+///     the same file share the physical pages. The result can be passed to
+///     <c>JsParseSerialized</c> or <c>JsRunSerialized</c>, which read the string table and
+///     byte code directly from the mapping. The mapping is released when the buffer (or the
+///     functions deserialized from it) are garbage collected.
+///     </para>
+///     <para>
+///     The file must not be modified or truncated while it is mapped. Copy-on-write only
+///     protects the pages the engine writes to: clean pages still show later changes to the
+///     file, so the byte code can change under running functions. Truncating the file makes
+///     reads of the pages past its new end fault (SIGBUS on Linux and macOS). Write a new
+///     file and rename it over the old one instead of rewriting it in place.
+///     </para>
+/// </remarks>
+/// <param name="path">The path of the serialized script file, as a null-terminated UTF8 string.</param>
+/// <param name="buffer">The ExternalArrayBuffer mapping the file.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+///     <c>JsErrorInvalidArgument</c> is returned if the file cannot be opened or is empty.
+/// </returns>
+CHAKRA_API
+    JsCreateSerializedFileBuffer(
+        _In_z_ const char *path,
+        _Out_ JsValueRef *buffer);
+
+/// <summary>
+///     Sets the directory of the runtime's on-disk code cache.
+/// </summary>
+/// <remarks>
+///     <para>
+///     While a code cache directory is set, <c>JsRun</c> and <c>JsParse</c> look up the
+///     serialized byte code of each script in the directory. A script found there is run with
+///     <c>JsRunSerialized</c> from a mapping of the entry instead of being parsed. Other scripts
+///     are compiled as usual, and their entries are written by a background thread.
+///     </para>
+///     <para>
+///     Entries are keyed by a hash of the script's source and by the byte code version of the
+///     engine, so edited scripts and engine updates never pick up stale byte code. Running an
+///     entry updates its last write time. After each write, the least recently used entries are
+///     deleted until the directory fits in maxSizeInBytes.
+///     </para>
+///     <para>
+///     Security: entries are trusted as they are. Before an entry is run, only its size and the
+///     byte code header are checked, and the byte code deserializer does not validate the rest
+///     of its input. Anyone who can write to the directory can make the engine run arbitrary
+///     code in the host process. The directory must only be writable by the host's own user,
+///     for example a per-user location that is not shared with other users or with less
+///     trusted processes.
+///     </para>
+///     <para>
+///     Only UTF8 ArrayBuffers and strings run without <c>JsParseScriptAttributeLibraryCode</c> or
+///     <c>JsParseScriptAttributeStrictMode</c> are cached. Script contexts being debugged or
+///     recorded for time travel do not use the cache. Several runtimes and processes can share
+///     a directory.
+///     </para>
+///     <para>
+///     <c>JsRun</c> and <c>JsParse</c> never wait for a write. While many writes are pending,
+///     scripts that miss the cache are run without queueing another one. Disposing the runtime,
+///     or setting another directory, waits for the pending writes.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime whose code cache to set.</param>
+/// <param name="directory">
+///     The cache directory, as a null-terminated UTF8 string. It is created if it doesn't exist.
+///     Pass null to disable the code cache.
+/// </param>
+/// <param name="maxSizeInBytes">The size the entries in the directory are trimmed to.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+///     <c>JsErrorInvalidArgument</c> is returned if the directory cannot be created.
+///     <c>JsErrorNotImplemented</c> is returned if background parsing is disabled.
+/// </returns>
+CHAKRA_API
+    JsSetRuntimeCodeCacheDirectory(
+        _In_ JsRuntimeHandle runtime,
+        _In_opt_z_ const char *directory,
+        _In_ size_t maxSizeInBytes);
+
+/// <summary>
+///     Serializes the dynamic profile collected for a script in the current context.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Requires an active script context created in a runtime with
+///     <c>JsRuntimeAttributeEnableProfilePersistence</c>.
+///     </para>
+///     <para>
+///     The profile holds the type and call information recorded by the functions of the script
+///     that have run, and which of them ran. Hosts can store it and pass it to
+///     <c>JsLoadScriptProfile</c> in a later process, where the functions that ran can be compiled by
+///     the background JIT as soon as their byte code is generated instead of after warming up in
+///     the interpreter, and start with the types and call targets seen in the earlier process.
+///     The buffer is keyed by a hash of the script and is only valid for the same script and the
+///     same build of the engine.
+///     </para>
+/// </remarks>
+/// <param name="script">The script, as passed to <c>JsRun</c> or <c>JsParse</c>.</param>
+/// <param name="sourceContext">The cookie the script was run with.</param>
+/// <param name="profileBuffer">An ArrayBuffer holding the serialized profile.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+///     <c>JsErrorInvalidArgument</c> is returned if no script was run with sourceContext, if none
+///     of its functions have run, or if the runtime doesn't collect profiles.
+///     <c>JsErrorNotImplemented</c> is returned if the engine is built without the JIT.
+/// </returns>
+CHAKRA_API
+    JsSerializeScriptProfile(
+        _In_ JsValueRef script,
+        _In_ JsSourceContext sourceContext,
+        _Out_ JsValueRef *profileBuffer);
+
+/// <summary>
+///     Loads a dynamic profile serialized by <c>JsSerializeScriptProfile</c> for a script that is
+///     about to run in the current context.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Requires an active script context created in a runtime with
+///     <c>JsRuntimeAttributeEnableProfilePersistence</c>.
+///     </para>
+///     <para>
+///     Must be called before the script is first run with sourceContext in the current context.
+///     Functions whose shape changed since the profile was collected ignore their part of it.
+///     Calls between scripts are only profiled across processes when the hosts give each script
+///     the same source context every time.
+///     </para>
+///     <para>
+///     A truncated profile is rejected, but the values inside a profile are not validated: the
+///     CRC in its header only detects accidental corruption. The JIT uses the profile to choose
+///     how to compile the script, so only load profiles from storage that the host controls.
+///     </para>
+/// </remarks>
+/// <param name="script">The script that will be passed to <c>JsRun</c> or <c>JsParse</c>.</param>
+/// <param name="sourceContext">The cookie the script will be run with.</param>
+/// <param name="sourceUrl">The location the script will be run with.</param>
+/// <param name="profileBuffer">The ArrayBuffer returned by <c>JsSerializeScriptProfile</c>.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+///     <c>JsErrorInvalidArgument</c> is returned if the profile was serialized for another script
+///     or by another build of the engine, if it is corrupt, if a script already ran with
+///     sourceContext, or if the runtime doesn't collect profiles.
+///     <c>JsErrorNotImplemented</c> is returned if the engine is built without the JIT.
+/// </returns>
+CHAKRA_API
+    JsLoadScriptProfile(
+        _In_ JsValueRef script,
+        _In_ JsSourceContext sourceContext,
+        _In_ JsValueRef sourceUrl,
+        _In_ JsValueRef profileBuffer);
+
 /// <summary>
 ///     Gets the state of a given Promise object.
 /// </summary>
@@ -1037,6 +1196,93 @@ JsCopyStringOneByte(
     _Out_opt_ char* buffer,
     _Out_opt_ size_t* written);
 
+/// <summary>
+///     Parses JSON text encoded as UTF-8, as JSON.parse would.
+/// </summary>
+/// <remarks>
+///     <para>
+///         Requires an active script context.
+///     </para>
+///     <para>
+///         The bytes are tokenized directly, without first creating a JavaScript string from them.
+///         Invalid UTF-8 sequences inside JSON strings are replaced with U+FFFD. The content does not
+///         need to be null terminated.
+///     </para>
+///     <para>
+///         If the content is not valid JSON, a SyntaxError is thrown and the function returns
+///         <c>JsErrorScriptException</c>.
+///     </para>
+/// </remarks>
+/// <param name="content">Pointer to the UTF-8 encoded JSON text.</param>
+/// <param name="length">Number of bytes within the content.</param>
+/// <param name="result">The parsed value.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+JsParseJsonUtf8(
+    _In_ const char* content,
+    _In_ size_t length,
+    _Out_ JsValueRef* result);
+
+/// <summary>
+///     Receives one chunk of the output of JsStringifyJsonUtf8.
+/// </summary>
+/// <remarks>
+///     The chunk is only valid for the duration of the callback. The callback must not call back into
+///     the runtime.
+/// </remarks>
+/// <param name="chunk">Pointer to the next UTF-8 encoded bytes of the JSON text.</param>
+/// <param name="length">Number of bytes within the chunk.</param>
+/// <param name="callbackState">The state passed to JsStringifyJsonUtf8.</param>
+/// <returns>
+///     true to continue; false to stop the conversion.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK * JsJsonWriteCallback)(_In_reads_(length) const char* chunk, _In_ size_t length, _In_opt_ void* callbackState);
+
+/// <summary>
+///     Converts a value to JSON text, as JSON.stringify(value) would, and hands the text to the host as
+///     UTF-8 encoded chunks while it is produced.
+/// </summary>
+/// <remarks>
+///     <para>
+///         Requires an active script context.
+///     </para>
+///     <para>
+///         Unlike calling JSON.stringify and then JsCopyStringUtf8, the complete text is never held in
+///         memory at once; only a buffer of about chunkSize bytes is used. toJSON methods and getters are
+///         still run before the first chunk is written, and may throw, in which case the function returns
+///         <c>JsErrorScriptException</c> without calling writeCallback.
+///     </para>
+///     <para>
+///         If writeCallback returns false, the conversion stops and the function returns
+///         <c>JsErrorOperationCancelled</c>; length receives the number of bytes passed to writeCallback.
+///     </para>
+///     <para>
+///         If the value does not convert to JSON text (undefined, a function or a symbol), writeCallback is
+///         not called and length receives 0.
+///     </para>
+/// </remarks>
+/// <param name="value">The value to convert.</param>
+/// <param name="writeCallback">The callback that receives the chunks.</param>
+/// <param name="callbackState">State passed to writeCallback.</param>
+/// <param name="chunkSize">
+///     The largest number of bytes passed to one call of writeCallback. Must be 0 to use a default size,
+///     or at least 16.
+/// </param>
+/// <param name="length">Number of bytes passed to writeCallback (optional).</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorOperationCancelled</c> if
+///     writeCallback stopped it, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+JsStringifyJsonUtf8(
+    _In_ JsValueRef value,
+    _In_ JsJsonWriteCallback writeCallback,
+    _In_opt_ void* callbackState,
+    _In_ size_t chunkSize,
+    _Out_opt_ size_t* length);
+
 /// <summary>
 ///     Obtains frequently used properties of a data view.
 /// </summary>
@@ -1677,6 +1923,99 @@ CHAKRA_API
         _In_ JsValueRef parserState,
         _Out_ JsValueRef* result);
 
+/// <summary>
+///     Identifies a script queued with <c>JsQueueBackgroundParse</c>. 0 is never a valid cookie.
+/// </summary>
+typedef unsigned int JsBackgroundParseCookie;
+
+/// <summary>
+///     Queues a UTF-8 script to be parsed, and its global code compiled to bytecode, on a
+///     background thread.
+/// </summary>
+/// <remarks>
+///     <para>
+///         Does not require a runtime or an active script context, and may be called from any
+///         thread, for example as soon as a script has been read from disk or the network. The
+///         script is copied, so the buffer may be freed when this function returns.
+///     </para>
+///     <para>
+///         The result is adopted into a script context with <c>JsRunBackgroundParseResult</c>,
+///         or dropped with <c>JsDiscardBackgroundParse</c>. One of the two must be called for
+///         every cookie.
+///     </para>
+///     <para>
+///         Returns <c>JsErrorNotImplemented</c> if background parsing is not available, in which
+///         case the script should be run with <c>JsRun</c>.
+///     </para>
+///     <para>
+///         Besides the global code, the background thread also compiles nested functions, up to
+///         -BgParseUndeferBudget bytes of their source. Functions are picked breadth first from the
+///         global code, in source order. No profile data is used, because the dynamic profile
+///         information persisted for the script (SourceDynamicProfileManager) belongs to the UI
+///         thread's script context. So the functions compiled ahead of time may not be the ones the
+///         script calls first.
+///     </para>
+/// </remarks>
+/// <param name="script">The UTF-8 encoded script.</param>
+/// <param name="length">Number of bytes within the script. Must not be 0.</param>
+/// <param name="sourceUrl">The location the script came from, null terminated.</param>
+/// <param name="cookie">Identifies the queued parse.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsQueueBackgroundParse(
+        _In_reads_(length) const char* script,
+        _In_ size_t length,
+        _In_z_ const char* sourceUrl,
+        _Out_ JsBackgroundParseCookie* cookie);
+
+/// <summary>
+///     Runs a script queued with <c>JsQueueBackgroundParse</c> in the current script context.
+/// </summary>
+/// <remarks>
+///     <para>
+///         Requires an active script context.
+///     </para>
+///     <para>
+///         Waits for the background parse to finish if it has not yet, then loads its bytecode
+///         instead of parsing the script again. A syntax error in the script is reported as
+///         <c>JsErrorScriptCompile</c>, as with <c>JsRun</c>.
+///     </para>
+///     <para>
+///         The cookie can't be used again after this call, whatever its outcome, unless it was
+///         not recognized (<c>JsErrorInvalidArgument</c>).
+///     </para>
+/// </remarks>
+/// <param name="cookie">The cookie returned by <c>JsQueueBackgroundParse</c>.</param>
+/// <param name="sourceContext">
+///     A cookie identifying the script that can be used by debuggable script contexts.
+/// </param>
+/// <param name="result">The result of the script, if any. This parameter can be null.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsRunBackgroundParseResult(
+        _In_ JsBackgroundParseCookie cookie,
+        _In_ JsSourceContext sourceContext,
+        _Out_opt_ JsValueRef* result);
+
+/// <summary>
+///     Drops a script queued with <c>JsQueueBackgroundParse</c> that will not be run.
+/// </summary>
+/// <remarks>
+///     May be called from any thread. A parse that is already running on a background thread
+///     finishes, and its result is then freed.
+/// </remarks>
+/// <param name="cookie">The cookie returned by <c>JsQueueBackgroundParse</c>.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsDiscardBackgroundParse(
+        _In_ JsBackgroundParseCookie cookie);
+
 typedef void (CHAKRA_CALLBACK *JsBeforeSweepCallback)(_In_opt_ void *callbackState);
 
 CHAKRA_API
@@ -781,6 +781,74 @@ typedef unsigned __int32 uint32_t;
         _In_ bool useRuntimeTTDMode,
         _Out_ JsContextRef *newContext);
 
+    /// <summary>
+    ///     Note: Experimental API
+    ///     TTD API -- may change in future versions:
+    ///     Write a startup snapshot of the current (record mode) runtime, which must hold exactly one context, to the given uri.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The snapshot holds the heap reachable from the context along with the property records and the sources
+    ///     of the scripts that were loaded into it. Inflating it skips re-running a bootstrap script, not parsing it.
+    ///     </para>
+    ///     <para>
+    ///     This is not a startup optimization. It is only available in builds with <c>ENABLE_TTD</c> and only
+    ///     works on record runtimes. Inflating re-parses every source in the snapshot, and the inflated context
+    ///     keeps paying the TTD recording overhead for as long as it lives.
+    ///     </para>
+    /// </remarks>
+    /// <param name="uri">The URI that the startup snapshot should be written into.</param>
+    /// <param name="uriLength">The length of the uri array that the host passed in.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorInvalidArgument</c> if the runtime does not
+    ///     hold exactly one record mode context or the host failed to open or write the snapshot, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsTTDWriteStartupSnapshot_Experimental(
+            _In_reads_(uriLength) const char* uri,
+            _In_ size_t uriLength);
+
+    /// <summary>
+    ///     Note: Experimental API
+    ///     TTD API -- may change in future versions:
+    ///     Creates a script context by inflating a startup snapshot written by <c>JsTTDWriteStartupSnapshot_Experimental</c>.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The runtime must be a record runtime (see <c>JsTTDCreateRecordRuntime</c>) that has no contexts yet and
+    ///     has not started recording. The snapshot's scripts are re-parsed (but not re-run) and the heap is rebuilt
+    ///     on top of them. Recording started later with <c>JsTTDStart</c> begins from the inflated state.
+    ///     </para>
+    ///     <para>
+    ///     Like <c>JsTTDWriteStartupSnapshot_Experimental</c>, this needs a build with <c>ENABLE_TTD</c> and is
+    ///     not a startup optimization: every source is re-parsed and the context carries the TTD recording overhead.
+    ///     </para>
+    ///     <para>
+    ///     The new context is not set as the current context.
+    ///     </para>
+    ///     <para>
+    ///     Every resource of the snapshot is checked against the checksums written with it before anything is
+    ///     parsed. The checksums catch truncated or damaged snapshots. They are not a defense against a snapshot
+    ///     that was crafted on purpose, so only inflate snapshots from locations that untrusted code cannot write.
+    ///     </para>
+    /// </remarks>
+    /// <param name="runtime">The runtime the script context is being created in.</param>
+    /// <param name="uri">The URI that the startup snapshot should be read from.</param>
+    /// <param name="uriLength">The length of the uri array that the host passed in.</param>
+    /// <param name="readBytesFromStream">The <c>JsTTDReadBytesFromStreamCallback</c> function for reading the snapshot (record runtimes are created without one).</param>
+    /// <param name="newContext">The created script context.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorBadSerializedScript</c> if the snapshot
+    ///     is missing, damaged, or does not hold exactly one context, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsTTDCreateContextFromStartupSnapshot_Experimental(
+            _In_ JsRuntimeHandle runtime,
+            _In_reads_(uriLength) const char* uri,
+            _In_ size_t uriLength,
+            _In_ JsTTDReadBytesFromStreamCallback readBytesFromStream,
+            _Out_ JsContextRef *newContext);
+
     /// <summary>
     ///     TTD API -- may change in future versions:
     ///     Notify the time-travel system that a context has been identified as dead by the gc (and is being de-allocated).
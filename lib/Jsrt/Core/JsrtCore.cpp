@@ -16,6 +16,7 @@
 #include "Library/JavascriptExceptionMetadata.h"
 #include "Base/ThreadContextTlsEntry.h"
 #include "Library/JavascriptPromise.h"
+#include "Library/JSON.h"
 #include "Codex/Utf8Helper.h"
 
 CHAKRA_API
@@ -889,8 +890,16 @@ CHAKRA_API JsCreateString(
 
     return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
 
-        Js::JavascriptString *stringValue = Js::LiteralStringWithPropertyStringPtr::
-            NewFromCString(content, (CharCount)length, scriptContext->GetLibrary());
+        Js::JavascriptString *stringValue = nullptr;
+        if (CONFIG_FLAG(OneByteStrings))
+        {
+            stringValue = Js::OneByteString::TryNewFromUtf8(content, length, scriptContext->GetLibrary());
+        }
+        if (stringValue == nullptr)
+        {
+            stringValue = Js::LiteralStringWithPropertyStringPtr::
+                NewFromCString(content, (CharCount)length, scriptContext->GetLibrary());
+        }
 
         PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTCreateString, stringValue->GetSz(), stringValue->GetLength());
 
@@ -937,6 +946,74 @@ CHAKRA_API JsCreateStringUtf16(
 }
 
 
+CHAKRA_API JsParseJsonUtf8(
+    _In_ const char* content,
+    _In_ size_t length,
+    _Out_ JsValueRef* result)
+{
+    PARAM_NOT_NULL(content);
+    PARAM_NOT_NULL(result);
+    *result = JS_INVALID_REFERENCE;
+
+    return ContextAPIWrapper<JSRT_MAYBE_TRUE>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        *result = JSON::ParseUtf8(reinterpret_cast<const utf8char_t*>(content), length, scriptContext);
+        return JsNoError;
+    });
+}
+
+struct JsonWriteCallbackState
+{
+    JsJsonWriteCallback callback;
+    void* callbackState;
+};
+
+static bool WriteJsonChunk(_In_reads_(length) const utf8char_t* chunk, size_t length, void* writerState)
+{
+    JsonWriteCallbackState* state = static_cast<JsonWriteCallbackState*>(writerState);
+    return state->callback(reinterpret_cast<const char*>(chunk), length, state->callbackState);
+}
+
+CHAKRA_API JsStringifyJsonUtf8(
+    _In_ JsValueRef value,
+    _In_ JsJsonWriteCallback writeCallback,
+    _In_opt_ void* callbackState,
+    _In_ size_t chunkSize,
+    _Out_opt_ size_t* length)
+{
+    const size_t defaultChunkSize = 64 * 1024;
+
+    PARAM_NOT_NULL(writeCallback);
+    if (chunkSize == 0)
+    {
+        chunkSize = defaultChunkSize;
+    }
+    else if (chunkSize < JSON::MinUtf8ChunkSize)
+    {
+        return JsErrorInvalidArgument;
+    }
+    if (length != nullptr)
+    {
+        *length = 0;
+    }
+
+    return ContextAPIWrapper<JSRT_MAYBE_TRUE>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+
+        JsonWriteCallbackState state = { writeCallback, callbackState };
+        size_t writtenLength = 0;
+        const bool completed = JSON::StringifyUtf8(value, WriteJsonChunk, &state, chunkSize, scriptContext, &writtenLength);
+        if (length != nullptr)
+        {
+            *length = writtenLength;
+        }
+        return completed ? JsNoError : JsErrorOperationCancelled;
+    });
+}
+
 CHAKRA_API JsCreatePropertyString(
     _In_z_ const char *name,
     _In_ size_t length,
@@ -1493,7 +1570,7 @@ JsQueueBackgroundParse_Experimental(
         // SourceContext not needed for BGParse
         && contents->sourceContext == 0)
     {
-        hr = BGParseManager::GetBGParseManager()->QueueBackgroundParse((LPUTF8)contents->container, contents->contentLengthInBytes, (char16*)contents->fullPath, dwBgParseCookie);
+        hr = BGParseManager::GetBGParseManager()->QueueBackgroundParse((LPUTF8)contents->container, contents->contentLengthInBytes, (char16*)contents->fullPath, false /*copySource*/, dwBgParseCookie);
     }
     else
     {
@@ -1515,6 +1592,72 @@ JsDiscardBackgroundParse_Experimental(
     return JsNoError;
 }
 
+CHAKRA_API
+JsQueueBackgroundParse(
+    _In_reads_(length) const char* script,
+    _In_ size_t length,
+    _In_z_ const char* sourceUrl,
+    _Out_ JsBackgroundParseCookie* cookie)
+{
+    PARAM_NOT_NULL(cookie);
+    *cookie = 0;
+    PARAM_NOT_NULL(script);
+    PARAM_NOT_NULL(sourceUrl);
+
+    if (length == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
+    if (!Js::Configuration::Global.flags.BgParse || CONFIG_FLAG(ForceDiagnosticsMode))
+    {
+        return JsErrorNotImplemented;
+    }
+
+    utf8::NarrowToWide url(sourceUrl);
+    if (!url)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        // The script is copied so that the caller doesn't have to keep it alive until the parse is run
+        DWORD bgParseCookie = 0;
+        HRESULT hr = BGParseManager::GetBGParseManager()->QueueBackgroundParse((LPCUTF8)script, length, url, true /*copySource*/, &bgParseCookie);
+        if (hr != S_OK)
+        {
+            return JsErrorFatal;
+        }
+
+        *cookie = bgParseCookie;
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
+CHAKRA_API
+JsDiscardBackgroundParse(
+    _In_ JsBackgroundParseCookie cookie)
+{
+    if (cookie == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    LPCUTF8 script = nullptr;
+    BGParseManager* bgParseManager = BGParseManager::GetBGParseManager();
+    if (bgParseManager->GetInputFromCookie(cookie, &script, nullptr, nullptr) != S_OK)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    bgParseManager->DiscardParseResults(cookie, (void*)script);
+    return JsNoError;
+}
+
 #ifdef _WIN32
 CHAKRA_API
 JsEnableOOPJIT()
@@ -9,7 +9,10 @@
 #include "jsrtHelper.h"
 
 #include "JsrtSourceHolder.h"
+#include "JsrtCodeCache.h"
 #include "ByteCode/ByteCodeSerializer.h"
+#include "ByteCode/ByteCodeCacheReleaseFileVersion.h"
+#include "Core/CRC.h"
 #include "Common/ByteSwap.h"
 #include "Library/DataView.h"
 #include "Base/ThreadContextTlsEntry.h"
@@ -256,6 +259,22 @@ void CALLBACK CreateJsRTContext_TTDCallback(void* runtimeHandle, Js::ScriptConte
     JsrtContext::TrySetCurrent(static_cast<JsrtContext*>(newContext));
 }
 
+void CALLBACK CreateJsRTContextForStartupSnapshot_TTDCallback(void* runtimeHandle, Js::ScriptContext** result)
+{
+    JsContextRef newContext = nullptr;
+    *result = nullptr;
+
+    //The host owns this context (just like one from JsCreateContext) so create it in record mode and don't pin it
+    TTDRecorder dummyActionEntryPopper;
+    JsErrorCode err = CreateContextCore(static_cast<JsRuntimeHandle>(runtimeHandle), dummyActionEntryPopper, true /*inRecordMode*/, false /*activelyRecording*/, false /*inReplayMode*/, &newContext);
+    TTDAssert(err == JsNoError, "Shouldn't fail on us!!!");
+
+    *result = static_cast<JsrtContext*>(newContext)->GetScriptContext();
+
+    //To ensure we have a valid context active (when we next try and inflate into this context) set this as active by convention
+    JsrtContext::TrySetCurrent(static_cast<JsrtContext*>(newContext));
+}
+
 void CALLBACK ReleaseJsRTContext_TTDCallback(FinalizableObject* jsrtCtx)
 {
     static_cast<JsrtContext*>(jsrtCtx)->GetScriptContext()->GetThreadContext()->GetRecycler()->RootRelease(jsrtCtx);
@@ -297,7 +316,8 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes,
             JsRuntimeAttributeDisableExecutablePageAllocation |
             JsRuntimeAttributeEnableExperimentalFeatures |
             JsRuntimeAttributeDispatchSetExceptionsToDebugger |
-            JsRuntimeAttributeDisableFatalOnOOM
+            JsRuntimeAttributeDisableFatalOnOOM |
+            JsRuntimeAttributeEnableProfilePersistence
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             | JsRuntimeAttributeSerializeLibraryByteCode
 #endif
@@ -360,6 +380,11 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes,
             threadContext->SetThreadContextFlag(ThreadContextFlagDisableFatalOnOOM);
         }
 
+        if (attributes & JsRuntimeAttributeEnableProfilePersistence)
+        {
+            threadContext->SetThreadContextFlag(ThreadContextFlagPersistDynamicProfiles);
+        }
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
         if (Js::Configuration::Global.flags.PrimeRecycler)
         {
@@ -4211,6 +4236,80 @@ CHAKRA_API JsTTDCreateContext(_In_ JsRuntimeHandle runtimeHandle, _In_ bool useR
 #endif
 }
 
+CHAKRA_API JsTTDWriteStartupSnapshot_Experimental(_In_reads_(uriLength) const char* uri, _In_ size_t uriLength)
+{
+#if !ENABLE_TTD
+    return JsErrorCategoryUsage;
+#else
+    return ContextAPIWrapper_NoRecord<true>([&](Js::ScriptContext * scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(uri);
+
+        ThreadContext* threadContext = scriptContext->GetThreadContext();
+        if(!scriptContext->IsTTDRecordModeEnabled() || threadContext->TTDContext->GetTTDContexts().Count() != 1)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        if(!threadContext->TTDLog->EmitStartupSnapshot(uri, uriLength))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        return JsNoError;
+    });
+#endif
+}
+
+CHAKRA_API JsTTDCreateContextFromStartupSnapshot_Experimental(_In_ JsRuntimeHandle runtimeHandle, _In_reads_(uriLength) const char* uri, _In_ size_t uriLength,
+    _In_ JsTTDReadBytesFromStreamCallback readBytesFromStream, _Out_ JsContextRef *newContext)
+{
+#if !ENABLE_TTD
+    return JsErrorCategoryUsage;
+#else
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        PARAM_NOT_NULL(uri);
+        PARAM_NOT_NULL(readBytesFromStream);
+        PARAM_NOT_NULL(newContext);
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        *newContext = JS_INVALID_REFERENCE;
+
+        JsrtRuntime * runtime = JsrtRuntime::FromHandle(runtimeHandle);
+        ThreadContext * threadContext = runtime->GetThreadContext();
+        if(!threadContext->IsRuntimeInTTDMode())
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        //The snapshot has to be the first thing in the runtime (and before recording starts) so the ids it carries don't collide with live ones
+        bool inRecord = false;
+        bool activelyRecording = false;
+        bool inReplay = false;
+        threadContext->TTDLog->GetModesForExplicitContextCreate(inRecord, activelyRecording, inReplay);
+        if(!inRecord || activelyRecording || !threadContext->TTDLog->IsFreshForStartupSnapshot())
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        ThreadContextScope scope(threadContext);
+        if(!scope.IsValid())
+        {
+            return JsErrorWrongThread;
+        }
+
+        Js::ScriptContext* scriptContext = threadContext->TTDLog->InflateStartupSnapshot(uri, uriLength, readBytesFromStream, &CreateJsRTContextForStartupSnapshot_TTDCallback);
+        if(scriptContext == nullptr)
+        {
+            return JsErrorBadSerializedScript;
+        }
+
+        *newContext = (JsContextRef)scriptContext->GetLibrary()->GetJsrtContext();
+
+        return JsNoError;
+    });
+#endif
+}
+
 CHAKRA_API JsTTDNotifyContextDestroy(_In_ JsContextRef context)
 {
 #if !ENABLE_TTD
@@ -4857,27 +4956,15 @@ CHAKRA_API JsTTDDiagSetAutoTraceStatus(_In_ bool status)
 #ifdef _CHAKRACOREBUILD
 
 
-template <class CopyFunc>
-JsErrorCode WriteStringCopy(
-    JsValueRef value,
+template <class CharType, class CopyFunc>
+JsErrorCode WriteStringCopyRange(
+    const CharType* str,
+    size_t strLength,
     int start,
     int length,
     _Out_opt_ size_t* written,
     const CopyFunc& copyFunc)
 {
-    if (written)
-    {
-        *written = 0;  // init to 0 for default
-    }
-
-    const char16* str = nullptr;
-    size_t strLength = 0;
-    JsErrorCode errorCode = JsStringToPointer(value, &str, &strLength);
-    if (errorCode != JsNoError)
-    {
-        return errorCode;
-    }
-
     if (start < 0 || (size_t)start > strLength)
     {
         return JsErrorInvalidArgument;  // start out of range, no chars written
@@ -4903,6 +4990,30 @@ JsErrorCode WriteStringCopy(
     return JsNoError;
 }
 
+template <class CopyFunc>
+JsErrorCode WriteStringCopy(
+    JsValueRef value,
+    int start,
+    int length,
+    _Out_opt_ size_t* written,
+    const CopyFunc& copyFunc)
+{
+    if (written)
+    {
+        *written = 0;  // init to 0 for default
+    }
+
+    const char16* str = nullptr;
+    size_t strLength = 0;
+    JsErrorCode errorCode = JsStringToPointer(value, &str, &strLength);
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    return WriteStringCopyRange(str, strLength, start, length, written, copyFunc);
+}
+
 CHAKRA_API JsCopyStringUtf16(
     _In_ JsValueRef value,
     _In_ int start,
@@ -4950,6 +5061,143 @@ CHAKRA_API JsCopyString(
     return JsNoError;
 }
 
+static void CALLBACK UnmapSerializedFileCallback(_In_opt_ void *data)
+{
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+}
+
+static JsErrorCode CreateSerializedFileBuffer(_In_z_ const WCHAR *path, _Out_ JsValueRef *buffer)
+{
+    *buffer = JS_INVALID_REFERENCE;
+
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    DWORD sizeHigh = 0;
+    DWORD size = GetFileSize(file, &sizeHigh);
+    if (size == INVALID_FILE_SIZE || size == 0 || sizeHigh != 0)
+    {
+        CloseHandle(file);
+        return JsErrorInvalidArgument;
+    }
+
+    // Map the file copy-on-write: pages are faulted in on first touch and stay backed by the
+    // page cache, so every process mapping the same cache file shares them. The deserializer
+    // reads the string table and the function bodies' byte code in place, so only the pages
+    // that are actually executed ever become resident.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    JsErrorCode errorCode = JsCreateExternalArrayBuffer(view, size, UnmapSerializedFileCallback, view, buffer);
+    if (errorCode != JsNoError)
+    {
+        UnmapViewOfFile(view);
+    }
+
+    return errorCode;
+}
+
+static bool CHAKRA_CALLBACK CodeCacheLoadScriptCallback(_In_ JsSourceContext sourceContext,
+    _Out_ JsValueRef *value, _Out_ JsParseScriptAttributes *parseAttributes)
+{
+    // sourceContext is the script that was looked up in the code cache
+    *value = reinterpret_cast<JsValueRef>(sourceContext);
+    *parseAttributes = Js::VarIs<Js::JavascriptString>(*value) ?
+        JsParseScriptAttributeArrayBufferIsUtf16Encoded : JsParseScriptAttributeNone;
+    return true;
+}
+
+// Returns the code cache of the current runtime, unless the current context compiles scripts
+// for the debugger or for time travel, which need them parsed from source.
+static JsrtCodeCache * GetCurrentCodeCache()
+{
+    JsrtContext *context = JsrtContext::GetCurrent();
+    if (context == nullptr || context->GetRuntime()->GetCodeCache() == nullptr)
+    {
+        return nullptr;
+    }
+
+    Js::ScriptContext *scriptContext = context->GetScriptContext();
+    if (scriptContext->IsScriptContextInDebugMode())
+    {
+        return nullptr;
+    }
+#if ENABLE_TTD
+    if (scriptContext->IsTTDRecordOrReplayModeEnabled())
+    {
+        return nullptr;
+    }
+#endif
+
+    return context->GetRuntime()->GetCodeCache();
+}
+
+// Runs the script from its code cache entry when there is a valid one. Otherwise the script is
+// compiled from source and an entry is queued to be written for the next run.
+static JsErrorCode RunScriptWithCodeCache(JsrtCodeCache *codeCache, JsValueRef scriptVal,
+    const byte *script, size_t cb, bool isUtf16, LoadScriptFlag scriptFlag,
+    JsSourceContext sourceContext, const WCHAR *url, bool parseOnly,
+    JsParseScriptAttributes parseAttributes, JsValueRef *result)
+{
+    WCHAR entryPath[MAX_PATH];
+    if (!codeCache->GetEntryPath(script, cb, isUtf16, entryPath, _countof(entryPath)))
+    {
+        return RunScriptCore(scriptVal, script, cb, scriptFlag,
+            sourceContext, url, parseOnly, parseAttributes, false, result);
+    }
+
+    JsValueRef entryBuffer = JS_INVALID_REFERENCE;
+    if (CreateSerializedFileBuffer(entryPath, &entryBuffer) == JsNoError)
+    {
+        Js::ArrayBuffer *arrayBuffer = Js::VarTo<Js::ArrayBuffer>(entryBuffer);
+
+        // A truncated or foreign file is ignored and overwritten below
+        if (Js::ByteCodeSerializer::IsCompleteBuffer(arrayBuffer->GetBuffer(), arrayBuffer->GetByteLength()))
+        {
+            JsSerializedLoadScriptCallback loadCallback = CodeCacheLoadScriptCallback;
+            JsErrorCode errorCode = RunSerializedScriptCore(
+                loadCallback, DummyScriptUnloadCallback,
+                reinterpret_cast<JsSourceContext>(scriptVal), // use the script as scriptLoadSourceContext
+                arrayBuffer->GetBuffer(), arrayBuffer, sourceContext, url, 0, parseOnly, false, result,
+                Js::Constants::InvalidSourceIndex);
+
+            // Byte code from another engine version fails to deserialize; any other result is the script's
+            if (errorCode != JsErrorBadSerializedScript)
+            {
+                codeCache->TouchEntry(entryPath);
+                return errorCode;
+            }
+        }
+    }
+
+    // The entry is best effort, the script runs whether or not it could be queued
+    GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        codeCache->QueueWrite(script, cb, isUtf16, url, entryPath);
+        return JsNoError;
+    });
+
+    return RunScriptCore(scriptVal, script, cb, scriptFlag,
+        sourceContext, url, parseOnly, parseAttributes, false, result);
+}
+
 _ALWAYSINLINE JsErrorCode CompileRun(
     JsValueRef scriptVal,
     JsSourceContext sourceContext,
@@ -4970,6 +5218,7 @@ _ALWAYSINLINE JsErrorCode CompileRun(
     const byte* script;
     size_t cb;
     const WCHAR *url;
+    JsrtCodeCache *codeCache = nullptr;
 
     if (isExternalArray)
     {
@@ -5007,6 +5256,15 @@ _ALWAYSINLINE JsErrorCode CompileRun(
 
         url = Js::VarTo<Js::JavascriptString>(sourceUrl)->GetSz();
 
+        // The cache holds UTF8 and UTF16 scripts compiled with the default attributes. A string is
+        // reloaded up to its first null character, so strings with embedded nulls are not cached.
+        if ((isString || isUtf8) &&
+            (parseAttributes & (JsParseScriptAttributeLibraryCode | JsParseScriptAttributeStrictMode)) == 0 &&
+            (!isString || wcslen((const WCHAR*)script) * sizeof(WCHAR) == cb))
+        {
+            codeCache = GetCurrentCodeCache();
+        }
+
         return JsNoError;
 
     });
@@ -5016,6 +5274,12 @@ _ALWAYSINLINE JsErrorCode CompileRun(
         return error;
     }
 
+    if (codeCache != nullptr)
+    {
+        return RunScriptWithCodeCache(codeCache, scriptVal, script, cb, isString, scriptFlag,
+            sourceContext, url, parseOnly, parseAttributes, result);
+    }
+
     return RunScriptCore(scriptVal, script, cb, scriptFlag,
         sourceContext, url, parseOnly, parseAttributes, false, result);
 }
@@ -5218,6 +5482,242 @@ CHAKRA_API JsRunSerialized(
         buffer, arrayBuffer, sourceContext, url, 0, false, false, result, Js::Constants::InvalidSourceIndex);
 }
 
+CHAKRA_API JsCreateSerializedFileBuffer(
+    _In_z_ const char *path,
+    _Out_ JsValueRef *buffer)
+{
+    PARAM_NOT_NULL(path);
+    PARAM_NOT_NULL(buffer);
+    *buffer = JS_INVALID_REFERENCE;
+
+    utf8::NarrowToWide wpath(path);
+    if (!wpath)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    return CreateSerializedFileBuffer(wpath, buffer);
+}
+
+CHAKRA_API JsSetRuntimeCodeCacheDirectory(
+    _In_ JsRuntimeHandle runtimeHandle,
+    _In_opt_z_ const char *directory,
+    _In_ size_t maxSizeInBytes)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    JsrtRuntime * runtime = JsrtRuntime::FromHandle(runtimeHandle);
+
+    if (directory == nullptr)
+    {
+        runtime->SetCodeCache(nullptr);
+        return JsNoError;
+    }
+
+    if (directory[0] == '\0' || maxSizeInBytes == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
+    // Entries are written by the background parser
+    if (!Js::Configuration::Global.flags.BgParse || CONFIG_FLAG(ForceDiagnosticsMode))
+    {
+        return JsErrorNotImplemented;
+    }
+
+    utf8::NarrowToWide wdirectory(directory);
+    if (!wdirectory)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    CreateDirectoryW(wdirectory, nullptr);
+    DWORD attributes = GetFileAttributesW(wdirectory);
+    if (attributes == INVALID_FILE_ATTRIBUTES || (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        runtime->SetCodeCache(HeapNew(JsrtCodeCache, wdirectory, maxSizeInBytes));
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
+// Header of the buffers returned by JsSerializeScriptProfile; the serialized profile manager follows it
+struct ScriptProfileHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 sourceCrc;
+    uint32 profileCrc;
+    uint64 sourceSize;
+    uint64 profileSize;
+};
+
+static const uint32 ScriptProfileMagic = 0x464f5250; // "PROF"
+
+static uint32 GetScriptProfileVersion()
+{
+    // Profiles are copies of engine structures, only valid for the build and architecture that wrote them
+    uint32 crc = CalculateCRC(0, sizeof(byteCodeCacheReleaseFileVersion), (void*)&byteCodeCacheReleaseFileVersion);
+    return CalculateCRC(crc, sizeof(void*));
+}
+
+static JsErrorCode GetScriptProfileKey(JsValueRef script, _Out_ uint32 *sourceCrc, _Out_ uint64 *sourceSize)
+{
+    const byte *bytes;
+    size_t cb;
+    LoadScriptFlag scriptFlag;
+    JsErrorCode errorCode = GetScriptBufferDetails(script, JsParseScriptAttributeNone, &scriptFlag, &cb, &bytes);
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    *sourceCrc = CalculateCRC(0, cb, (void*)bytes);
+    *sourceSize = cb;
+    return JsNoError;
+}
+#endif
+
+CHAKRA_API JsSerializeScriptProfile(
+    _In_ JsValueRef script,
+    _In_ JsSourceContext sourceContext,
+    _Out_ JsValueRef *profileBuffer)
+{
+    PARAM_NOT_NULL(script);
+    VALIDATE_JSREF(script);
+    PARAM_NOT_NULL(profileBuffer);
+    *profileBuffer = JS_INVALID_REFERENCE;
+
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        // Without the profile list there is nothing to gather the profiles from
+        if (!scriptContext->GetThreadContext()->PersistsDynamicProfiles() || sourceContext == JS_SOURCE_CONTEXT_NONE)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        SourceContextInfo *sourceContextInfo = scriptContext->GetSourceContextInfo(sourceContext, nullptr);
+        if (sourceContextInfo == nullptr || sourceContextInfo->sourceDynamicProfileManager == nullptr)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        ScriptProfileHeader header;
+        JsErrorCode errorCode = GetScriptProfileKey(script, &header.sourceCrc, &header.sourceSize);
+        if (errorCode != JsNoError)
+        {
+            return errorCode;
+        }
+
+        Js::SourceDynamicProfileManager *profileManager = sourceContextInfo->sourceDynamicProfileManager;
+        size_t profileSize = 0;
+        if (!profileManager->GetSerializedSize(scriptContext, &profileSize) ||
+            profileSize > UINT_MAX - sizeof(ScriptProfileHeader))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        Js::ArrayBuffer *buffer = scriptContext->GetLibrary()->CreateArrayBuffer((uint32)(sizeof(ScriptProfileHeader) + profileSize));
+        char *profile = (char*)buffer->GetBuffer() + sizeof(ScriptProfileHeader);
+        if (!profileManager->SaveToBuffer(profile, profileSize))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        header.magic = ScriptProfileMagic;
+        header.version = GetScriptProfileVersion();
+        header.profileCrc = CalculateCRC(0, profileSize, profile);
+        header.profileSize = profileSize;
+        memcpy_s(buffer->GetBuffer(), sizeof(ScriptProfileHeader), &header, sizeof(ScriptProfileHeader));
+
+        *profileBuffer = buffer;
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
+CHAKRA_API JsLoadScriptProfile(
+    _In_ JsValueRef script,
+    _In_ JsSourceContext sourceContext,
+    _In_ JsValueRef sourceUrl,
+    _In_ JsValueRef profileBuffer)
+{
+    PARAM_NOT_NULL(script);
+    VALIDATE_JSREF(script);
+    PARAM_NOT_NULL(sourceUrl);
+    PARAM_NOT_NULL(profileBuffer);
+    VALIDATE_JSREF(profileBuffer);
+
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        if (!scriptContext->GetThreadContext()->PersistsDynamicProfiles() || sourceContext == JS_SOURCE_CONTEXT_NONE ||
+            !Js::VarIs<Js::JavascriptString>(sourceUrl) || !Js::VarIs<Js::ArrayBuffer>(profileBuffer))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        // The profile is only picked up by the byte code generated after it is attached to the source context
+        if (scriptContext->GetSourceContextInfo(sourceContext, nullptr) != nullptr)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        ScriptProfileHeader key;
+        JsErrorCode errorCode = GetScriptProfileKey(script, &key.sourceCrc, &key.sourceSize);
+        if (errorCode != JsNoError)
+        {
+            return errorCode;
+        }
+
+        Js::ArrayBuffer *buffer = Js::VarTo<Js::ArrayBuffer>(profileBuffer);
+        const byte *bytes = buffer->GetBuffer();
+        size_t cb = buffer->GetByteLength();
+        ScriptProfileHeader header;
+        if (bytes == nullptr || cb < sizeof(ScriptProfileHeader))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        // The CRCs only catch a profile of another script and accidental corruption; a crafted profile can carry a
+        // matching CRC. Its length is checked by the reader, its contents are taken as they are.
+        memcpy_s(&header, sizeof(ScriptProfileHeader), bytes, sizeof(ScriptProfileHeader));
+        const char *profile = (const char*)bytes + sizeof(ScriptProfileHeader);
+        if (header.magic != ScriptProfileMagic ||
+            header.version != GetScriptProfileVersion() ||
+            header.sourceCrc != key.sourceCrc ||
+            header.sourceSize != key.sourceSize ||
+            header.profileSize != cb - sizeof(ScriptProfileHeader) ||
+            header.profileCrc != CalculateCRC(0, cb - sizeof(ScriptProfileHeader), (void*)profile))
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        Js::SourceDynamicProfileManager *profileManager =
+            Js::SourceDynamicProfileManager::LoadFromBuffer(scriptContext->GetRecycler(), profile, cb - sizeof(ScriptProfileHeader));
+        if (profileManager == nullptr)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        const WCHAR *url = Js::VarTo<Js::JavascriptString>(sourceUrl)->GetSz();
+        SourceContextInfo *sourceContextInfo = scriptContext->CreateSourceContextInfo(sourceContext, url, wcslen(url), nullptr);
+        sourceContextInfo->sourceDynamicProfileManager = profileManager;
+        return JsNoError;
+    });
+#else
+    return JsErrorNotImplemented;
+#endif
+}
+
 
 CHAKRA_API JsCopyStringOneByte(
     _In_ JsValueRef value,
@@ -5228,6 +5728,31 @@ CHAKRA_API JsCopyStringOneByte(
 {
     PARAM_NOT_NULL(value);
     VALIDATE_JSREF(value);
+
+    // One-byte strings that haven't been widened yet are copied straight from their narrow buffer
+    if (Js::VarIs<Js::OneByteString>(value))
+    {
+        const Js::OneByteString* oneByteString = Js::UnsafeVarTo<Js::OneByteString>(value);
+        const char* str = oneByteString->GetOneByteBuffer();
+        if (str != nullptr)
+        {
+            if (written)
+            {
+                *written = 0;  // init to 0 for default
+            }
+
+            return WriteStringCopyRange(str, oneByteString->GetLength(), start, length, written,
+                [buffer](const char* src, size_t count, size_t *needed)
+            {
+                if (buffer)
+                {
+                    memmove(buffer, src, count);
+                }
+                return JsNoError;
+            });
+        }
+    }
+
     return WriteStringCopy(value, start, length, written,
         [buffer](const char16* src, size_t count, size_t *needed)
     {
@@ -5553,4 +6078,102 @@ JsExecuteBackgroundParse_Experimental(
         return JsErrorFatal;
     }
 }
+
+CHAKRA_API
+JsRunBackgroundParseResult(
+    _In_ JsBackgroundParseCookie cookie,
+    _In_ JsSourceContext sourceContext,
+    _Out_opt_ JsValueRef *result)
+{
+    if (cookie == 0)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    BGParseManager* bgParseManager = BGParseManager::GetBGParseManager();
+    LPCUTF8 script = nullptr;
+    WCHAR* url = nullptr;
+    if (bgParseManager->GetInputFromCookie(cookie, &script, nullptr, &url) != S_OK)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    Js::JavascriptFunction *function = nullptr;
+    CompileScriptException se;
+    JsErrorCode errorCode = ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        if (result != nullptr)
+        {
+            *result = nullptr;
+        }
+
+        SourceContextInfo *sourceContextInfo = scriptContext->GetSourceContextInfo(sourceContext, nullptr);
+        if (sourceContextInfo == nullptr)
+        {
+            sourceContextInfo = scriptContext->CreateSourceContextInfo(sourceContext, url, wcslen(url), nullptr);
+        }
+
+        SRCINFO si = {
+            /* sourceContextInfo   */ sourceContextInfo,
+            /* dlnHost             */ 0,
+            /* ulColumnHost        */ 0,
+            /* lnMinHost           */ 0,
+            /* ichMinHost          */ 0,
+            /* ichLimHost          */ 0,
+            /* ulCharOffset        */ 0,
+            /* mod                 */ kmodGlobal,
+            /* grfsi               */ 0
+        };
+
+        size_t srcLength = 0;
+        uint sourceIndex = Js::Constants::InvalidSourceIndex;
+        Js::FunctionBody* functionBody = nullptr;
+        HRESULT hr = bgParseManager->GetParseResults(
+            scriptContext,
+            cookie,
+            nullptr, // pszSrc
+            scriptContext->AddHostSrcInfo(&si),
+            &functionBody,
+            &se,
+            srcLength,
+            nullptr, // utf8sourceinfo
+            sourceIndex
+        );
+
+        if (hr != S_OK)
+        {
+            // A syntax error is reported like any other compile error below; anything else means the
+            // background results could not be used
+            return FAILED(se.ei.scode) ? JsNoError : JsErrorBadSerializedScript;
+        }
+
+        function = scriptContext->GetLibrary()->CreateScriptFunction(functionBody);
+
+        JsrtContext * context = JsrtContext::GetCurrent();
+        context->OnScriptLoad(function, functionBody->GetUtf8SourceInfo(), nullptr);
+
+        return JsNoError;
+    });
+
+    if (errorCode == JsNoError)
+    {
+        errorCode = ContextAPIWrapper_NoRecord<false>([&](Js::ScriptContext* scriptContext) -> JsErrorCode {
+            if (function == nullptr)
+            {
+                HandleScriptCompileError(scriptContext, &se, url);
+                return JsErrorScriptCompile;
+            }
+
+            Js::Var varResult = function->CallRootFunction(Js::Arguments(0, nullptr), scriptContext, true);
+            if (result != nullptr)
+            {
+                *result = varResult;
+            }
+            return JsNoError;
+        });
+    }
+
+    // The source and url belong to the background parse, which is no longer needed once it has been run
+    bgParseManager->DiscardParseResults(cookie, (void*)script);
+    return errorCode;
+}
 #endif
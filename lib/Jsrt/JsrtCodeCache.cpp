@@ -0,0 +1,316 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "JsrtCodeCache.h"
+#include "Core/CRC.h"
+#include "ByteCodeCacheReleaseFileVersion.h"
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+// Entries are the only files in the directory with this extension; eviction ignores everything else
+#define CODE_CACHE_ENTRY_EXTENSION ".jsc"
+#define CODE_CACHE_ENTRY_EXTENSION_W _u(".jsc")
+
+JsrtCodeCache::JsrtCodeCache(_In_z_ const char16 *directory, size_t maxSizeInBytes) :
+    directory(nullptr),
+    directoryLength(wcslen(directory)),
+    maxSizeInBytes(maxSizeInBytes),
+    pendingWrites(&HeapAllocator::Instance)
+{
+    this->directory = HeapNewArray(char16, this->directoryLength + 1);
+    js_wmemcpy_s(this->directory, this->directoryLength + 1, directory, this->directoryLength + 1);
+}
+
+JsrtCodeCache::~JsrtCodeCache()
+{
+    while (this->pendingWrites.Count() > 0)
+    {
+        CompleteWrite(this->pendingWrites.Item(0));
+        this->pendingWrites.RemoveAt(0);
+    }
+
+    HeapDeleteArray(this->directoryLength + 1, this->directory);
+}
+
+bool JsrtCodeCache::GetEntryPath(_In_reads_bytes_(cb) const byte *script, size_t cb, bool isUtf16,
+    _Out_writes_z_(pathLength) char16 *path, size_t pathLength) const
+{
+    // Seeding the CRC with the byte code version keeps entries written by other engine builds from being found
+    uint crc = CalculateCRC(0, sizeof(byteCodeCacheReleaseFileVersion), (void*)&byteCodeCacheReleaseFileVersion);
+    crc = CalculateCRC(crc, cb, (void*)script);
+    hash_t hash = JsUtil::CharacterBuffer<char>::StaticGetHashCode((const char*)script, (charcount_t)cb);
+
+    return _snwprintf_s(path, pathLength, _TRUNCATE, _u("%ls/%08x%08x-%llx-%d") CODE_CACHE_ENTRY_EXTENSION_W,
+        this->directory, crc, (uint)hash, (unsigned long long)cb, isUtf16 ? 16 : 8) >= 0;
+}
+
+bool JsrtCodeCache::FormatEntryPath(_Out_writes_z_(MAX_PATH) char16 *path, _In_z_ const char16 *fileName) const
+{
+    return _snwprintf_s(path, MAX_PATH, _TRUNCATE, _u("%ls/%ls"), this->directory, fileName) >= 0;
+}
+
+bool JsrtCodeCache::HasPendingWrite(_In_z_ const char16 *entryPath) const
+{
+    for (int i = 0; i < this->pendingWrites.Count(); i++)
+    {
+        if (wcscmp(this->pendingWrites.Item(i)->entryPath, entryPath) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JsrtCodeCache::QueueWrite(_In_reads_bytes_(cb) const byte *script, size_t cb, bool isUtf16,
+    _In_z_ const char16 *sourceUrl, _In_z_ const char16 *entryPath)
+{
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
+    if (HasPendingWrite(entryPath))
+    {
+        // The same script ran again before its entry was written
+        return;
+    }
+
+    ReapCompletedWrites();
+    if (this->pendingWrites.Count() >= MaxPendingWrites)
+    {
+        // Rather than wait for the background thread here, leave this script for a later run to write
+        return;
+    }
+
+    PendingWrite *write = HeapNew(PendingWrite);
+    write->cache = this;
+    write->cookie = 0;
+    if (_snwprintf_s(write->entryPath, MAX_PATH, _TRUNCATE, _u("%ls"), entryPath) < 0)
+    {
+        HeapDelete(write);
+        return;
+    }
+
+    utf8char_t *utf8Script = nullptr;
+    size_t utf8Length = cb;
+    size_t utf8AllocLength = 0;
+    if (isUtf16)
+    {
+        // Same encoding as the source holder that maps the script for JsRunSerialized
+        charcount_t cch = (charcount_t)(cb / sizeof(char16));
+        utf8AllocLength = UInt32Math::Add(UInt32Math::Mul(cch, 3), 1);
+        utf8Script = HeapNewArray(utf8char_t, utf8AllocLength);
+        utf8Length = utf8::EncodeIntoAndNullTerminate<utf8::Utf8EncodingKind::TrueUtf8>(utf8Script, utf8AllocLength, (const char16*)script, cch);
+    }
+
+    HRESULT hr = BGParseManager::GetBGParseManager()->QueueBackgroundSerialize(
+        isUtf16 ? utf8Script : (LPCUTF8)script, utf8Length, sourceUrl, WriteEntryCallback, write, &write->cookie);
+
+    if (utf8Script != nullptr)
+    {
+        HeapDeleteArray(utf8AllocLength, utf8Script);
+    }
+
+    if (hr != S_OK || write->cookie == 0)
+    {
+        HeapDelete(write);
+        return;
+    }
+
+    this->pendingWrites.Add(write);
+#endif
+}
+
+void JsrtCodeCache::ReapCompletedWrites()
+{
+    BGParseManager *bgParseManager = BGParseManager::GetBGParseManager();
+    for (int i = this->pendingWrites.Count() - 1; i >= 0; i--)
+    {
+        PendingWrite *write = this->pendingWrites.Item(i);
+        if (bgParseManager->IsParseComplete(write->cookie))
+        {
+            CompleteWrite(write);
+            this->pendingWrites.RemoveAt(i);
+        }
+    }
+}
+
+void JsrtCodeCache::CompleteWrite(PendingWrite *write)
+{
+    BGParseManager *bgParseManager = BGParseManager::GetBGParseManager();
+    bgParseManager->WaitForParse(write->cookie);
+
+    LPCUTF8 script = nullptr;
+    if (bgParseManager->GetInputFromCookie(write->cookie, &script, nullptr, nullptr) == S_OK)
+    {
+        bgParseManager->DiscardParseResults(write->cookie, (void*)script);
+    }
+
+    HeapDelete(write);
+}
+
+// Note: runs on the background parse thread
+void JsrtCodeCache::WriteEntryCallback(void *callbackState, const byte *buffer, DWORD bufferBytes)
+{
+    PendingWrite *write = (PendingWrite*)callbackState;
+    write->cache->WriteEntry(write->entryPath, buffer, bufferBytes);
+}
+
+// Note: runs on the background parse thread
+void JsrtCodeCache::WriteEntry(_In_z_ const char16 *entryPath, _In_reads_bytes_(bufferBytes) const byte *buffer, DWORD bufferBytes)
+{
+    // Write to a file of our own and rename it over the entry, so that other runtimes and processes never
+    // map a partially written entry
+    char16 tempPath[MAX_PATH];
+    if (_snwprintf_s(tempPath, MAX_PATH, _TRUNCATE, _u("%ls.%u-%u.tmp"), entryPath,
+        (uint)GetCurrentProcessId(), (uint)GetCurrentThreadId()) < 0)
+    {
+        return;
+    }
+
+    HANDLE file = CreateFileW(tempPath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    DWORD bytesWritten = 0;
+    BOOL written = WriteFile(file, buffer, bufferBytes, &bytesWritten, nullptr) && bytesWritten == bufferBytes;
+    CloseHandle(file);
+
+    if (!written || !MoveFileExW(tempPath, entryPath, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileW(tempPath);
+        return;
+    }
+
+    Evict();
+}
+
+template <typename Fn>
+void JsrtCodeCache::ForEachEntry(Fn fn) const
+{
+    char16 path[MAX_PATH];
+#ifdef _WIN32
+    char16 pattern[MAX_PATH];
+    if (!FormatEntryPath(pattern, _u("*") CODE_CACHE_ENTRY_EXTENSION_W))
+    {
+        return;
+    }
+
+    WIN32_FIND_DATAW findData;
+    HANDLE find = FindFirstFileW(pattern, &findData);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    do
+    {
+        if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0 && FormatEntryPath(path, findData.cFileName))
+        {
+            ULONGLONG size = ((ULONGLONG)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
+            fn(path, size, findData.ftLastWriteTime);
+        }
+    } while (FindNextFileW(find, &findData));
+
+    FindClose(find);
+#else
+    // The PAL has no FindFirstFile; list the directory with readdir and stat the entries through the PAL
+    utf8::WideToNarrow narrowDirectory(this->directory);
+    if (!narrowDirectory)
+    {
+        return;
+    }
+
+    DIR *dir = opendir(narrowDirectory);
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    const size_t extensionLength = strlen(CODE_CACHE_ENTRY_EXTENSION);
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        size_t nameLength = strlen(entry->d_name);
+        if (nameLength <= extensionLength ||
+            strcmp(entry->d_name + nameLength - extensionLength, CODE_CACHE_ENTRY_EXTENSION) != 0)
+        {
+            continue;
+        }
+
+        utf8::NarrowToWide fileName(entry->d_name);
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (fileName && FormatEntryPath(path, fileName) &&
+            GetFileAttributesExW(path, GetFileExInfoStandard, &data) &&
+            (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        {
+            ULONGLONG size = ((ULONGLONG)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+            fn(path, size, data.ftLastWriteTime);
+        }
+    }
+
+    closedir(dir);
+#endif
+}
+
+void JsrtCodeCache::TouchEntry(_In_z_ const char16 *entryPath)
+{
+    // The PAL only opens files for reading and/or writing; neither changes the entry's contents
+#ifdef _WIN32
+    const DWORD access = FILE_WRITE_ATTRIBUTES;
+#else
+    const DWORD access = GENERIC_WRITE;
+#endif
+    HANDLE file = CreateFileW(entryPath, access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    SetFileTime(file, nullptr, nullptr, &now);
+    CloseHandle(file);
+}
+
+int __cdecl JsrtCodeCache::CompareEntryTimes(void *, const void *a, const void *b)
+{
+    return CompareFileTime(&((const Entry *)a)->lastWriteTime, &((const Entry *)b)->lastWriteTime);
+}
+
+// Deletes the least recently used entries until the directory fits in maxSizeInBytes.
+// Note: runs on the background parse thread
+void JsrtCodeCache::Evict()
+{
+    AutoCriticalSection autoLock(&this->evictLock);
+
+    ULONGLONG totalSize = 0;
+    JsUtil::List<Entry, HeapAllocator> entries(&HeapAllocator::Instance);
+    ForEachEntry([&](const char16 *path, ULONGLONG size, const FILETIME& lastWriteTime)
+    {
+        Entry entry;
+        js_wmemcpy_s(entry.path, MAX_PATH, path, wcslen(path) + 1);
+        entry.size = size;
+        entry.lastWriteTime = lastWriteTime;
+        entries.Add(entry);
+        totalSize += size;
+    });
+
+    if (totalSize <= this->maxSizeInBytes)
+    {
+        return;
+    }
+
+    entries.Sort(CompareEntryTimes, nullptr);
+    for (int i = 0; i < entries.Count() && totalSize > this->maxSizeInBytes; i++)
+    {
+        // Another process may hold or have already deleted the entry; the next write trims again
+        if (DeleteFileW(entries.Item(i).path))
+        {
+            totalSize -= entries.Item(i).size;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// On-disk cache of the serialized byte code of scripts run with JsRun and JsParse, set up per runtime by
+// JsSetRuntimeCodeCacheDirectory.
+//
+// An entry is named after a CRC and a hash of the script's source, seeded with the byte code release version, so
+// a changed script or a different engine build never looks up a stale entry. Missing entries are compiled and
+// written by the background parse job processor; after every write the least recently used entries are deleted
+// until the directory fits in its size limit. An entry's last write time doubles as its last use time.
+class JsrtCodeCache
+{
+public:
+    JsrtCodeCache(_In_z_ const char16 *directory, size_t maxSizeInBytes);
+    ~JsrtCodeCache();
+
+    // Formats the path of the entry for the given source. Returns false if the path doesn't fit in pathLength.
+    bool GetEntryPath(_In_reads_bytes_(cb) const byte *script, size_t cb, bool isUtf16,
+        _Out_writes_z_(pathLength) char16 *path, size_t pathLength) const;
+
+    // Queues a background job that compiles the script and writes its byte code to entryPath. The script is
+    // copied, UTF16 sources are written for their UTF8 encoding, which is what JsRunSerialized parses. Never
+    // waits for the background thread; nothing is queued while MaxPendingWrites writes are still pending.
+    void QueueWrite(_In_reads_bytes_(cb) const byte *script, size_t cb, bool isUtf16,
+        _In_z_ const char16 *sourceUrl, _In_z_ const char16 *entryPath);
+
+    // Marks the entry as just used, so that eviction keeps it over entries that were not run since
+    void TouchEntry(_In_z_ const char16 *entryPath);
+
+private:
+    struct PendingWrite
+    {
+        JsrtCodeCache *cache;
+        DWORD cookie;
+        char16 entryPath[MAX_PATH];
+    };
+
+    struct Entry
+    {
+        char16 path[MAX_PATH];
+        ULONGLONG size;
+        FILETIME lastWriteTime;
+    };
+
+    // At most this many writes are pending; scripts run while the queue is full are not written
+    static const int MaxPendingWrites = 16;
+
+    static void WriteEntryCallback(void *callbackState, const byte *buffer, DWORD bufferBytes);
+    void WriteEntry(_In_z_ const char16 *entryPath, _In_reads_bytes_(bufferBytes) const byte *buffer, DWORD bufferBytes);
+    void CompleteWrite(PendingWrite *write);
+    void ReapCompletedWrites();
+    bool HasPendingWrite(_In_z_ const char16 *entryPath) const;
+
+    void Evict();
+    static int __cdecl CompareEntryTimes(void *context, const void *a, const void *b);
+    template <typename Fn> void ForEachEntry(Fn fn) const;
+    bool FormatEntryPath(_Out_writes_z_(MAX_PATH) char16 *path, _In_z_ const char16 *fileName) const;
+
+    char16 *directory;
+    size_t directoryLength;
+    size_t maxSizeInBytes;
+    JsUtil::List<PendingWrite *, HeapAllocator> pendingWrites;
+    CriticalSection evictLock;
+};
@@ -4,6 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 #include <JsrtPch.h>
 #include "JsrtRuntime.h"
+#include "JsrtCodeCache.h"
 #include "jsrtHelper.h"
 #include "Base/ThreadContextTlsEntry.h"
 #include "Base/ThreadBoundThreadContextManager.h"
@@ -22,6 +23,7 @@ JsrtRuntime::JsrtRuntime(ThreadContext * threadContext, bool useIdle, bool dispa
     this->allocationPolicyManager = threadContext->GetAllocationPolicyManager();
     this->useIdle = useIdle;
     this->dispatchExceptions = dispatchExceptions;
+    this->codeCache = nullptr;
     if (useIdle)
     {
         this->threadService.Initialize(threadContext);
@@ -39,6 +41,7 @@ JsrtRuntime::JsrtRuntime(ThreadContext * threadContext, bool useIdle, bool dispa
 JsrtRuntime::~JsrtRuntime()
 {
     HeapDelete(allocationPolicyManager);
+    SetCodeCache(nullptr);
 #ifdef ENABLE_SCRIPT_DEBUGGING
     if (this->jsrtDebugManager != nullptr)
     {
@@ -188,6 +191,15 @@ unsigned int JsrtRuntime::Idle()
     return this->threadService.Idle();
 }
 
+void JsrtRuntime::SetCodeCache(JsrtCodeCache * codeCache)
+{
+    if (this->codeCache != nullptr)
+    {
+        HeapDelete(this->codeCache);
+    }
+    this->codeCache = codeCache;
+}
+
 #ifdef ENABLE_SCRIPT_DEBUGGING
 void JsrtRuntime::EnsureJsrtDebugManager()
 {
@@ -11,6 +11,7 @@
 #endif
 
 class JsrtContext;
+class JsrtCodeCache;
 
 class JsrtRuntime
 {
@@ -47,6 +48,10 @@ class JsrtRuntime
     bool IsSerializeByteCodeForLibrary() const { return serializeByteCodeForLibrary; }
 #endif
 
+    // Takes ownership of the cache; a previously set cache is deleted once its pending writes are done
+    void SetCodeCache(JsrtCodeCache * codeCache);
+    JsrtCodeCache * GetCodeCache() const { return codeCache; }
+
 #ifdef ENABLE_SCRIPT_DEBUGGING
     void EnsureJsrtDebugManager();
     void DeleteJsrtDebugManager();
@@ -76,6 +81,7 @@ class JsrtRuntime
     void * beforeCollectCallbackContext;
     bool useIdle;
     bool dispatchExceptions;
+    JsrtCodeCache * codeCache;
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     bool serializeByteCodeForLibrary;
 #endif
@@ -16,6 +16,10 @@
 
 #define BGPARSE_FLAGS (fscrGlobalCode | fscrWillDeferFncParse | fscrCanDeferFncParse | fscrCreateParserState)
 
+// Scripts queued with QueueBackgroundSerialize are compiled the way JsSerialize compiles them: nothing is deferred and
+// the global function returns the script's completion value
+#define BGSERIALIZE_FLAGS (fscrGlobalCode | fscrReturnExpression)
+
 // Global, process singleton
 BGParseManager* BGParseManager::s_BGParseManager = nullptr;
 DWORD           BGParseManager::s_lastCookie = 0;
@@ -171,9 +175,26 @@ BGParseWorkItem* BGParseManager::FindJob(DWORD dwCookie, bool waitForResults, bo
     return matchedWorkitem;
 }
 
-// Creates a new job to parse the provided script on a background thread
+// Creates a new job to parse the provided script on a background thread. When copySource is true, the
+// job parses a copy of the script and the caller may free its buffer as soon as this returns.
 // Note: runs on any thread
-HRESULT BGParseManager::QueueBackgroundParse(LPCUTF8 pszSrc, size_t cbLength, char16 *fullPath, DWORD* dwBgParseCookie)
+HRESULT BGParseManager::QueueBackgroundParse(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, bool copySource, DWORD* dwBgParseCookie)
+{
+    return QueueWorkItem(pszSrc, cbLength, fullPath, copySource, nullptr, nullptr, dwBgParseCookie);
+}
+
+// Creates a new job to compile a copy of the provided script on a background thread and pass its serialized
+// bytecode to callback, also on that thread. The results can't be deserialized with GetParseResults; the job is
+// freed with DiscardParseResults once it has been processed.
+// Note: runs on any thread
+HRESULT BGParseManager::QueueBackgroundSerialize(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, BGParseSerializedCallback callback, void* callbackState, DWORD* dwBgParseCookie)
+{
+    Assert(callback != nullptr);
+    return QueueWorkItem(pszSrc, cbLength, fullPath, true /*copySource*/, callback, callbackState, dwBgParseCookie);
+}
+
+// Note: runs on any thread
+HRESULT BGParseManager::QueueWorkItem(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, bool copySource, BGParseSerializedCallback callback, void* callbackState, DWORD* dwBgParseCookie)
 {
     HRESULT hr = S_OK;
     if (cbLength > 0)
@@ -181,7 +202,7 @@ HRESULT BGParseManager::QueueBackgroundParse(LPCUTF8 pszSrc, size_t cbLength, ch
         BGParseWorkItem* workitem;
         {
             AUTO_NESTED_HANDLED_EXCEPTION_TYPE(ExceptionType_DisableCheck);
-            workitem = HeapNew(BGParseWorkItem, this, (const byte *)pszSrc, cbLength, fullPath);
+            workitem = HeapNew(BGParseWorkItem, this, (const byte *)pszSrc, cbLength, fullPath, copySource, callback, callbackState);
         }
 
         // Add the job to the processor
@@ -241,6 +262,35 @@ HRESULT BGParseManager::GetInputFromCookie(DWORD cookie, LPCUTF8* ppszSrc, size_
     return hr;
 }
 
+// Blocks until the job associated with the cookie has been processed. The job is kept until its results are
+// taken or discarded.
+// Note: runs on any thread
+void BGParseManager::WaitForParse(DWORD cookie)
+{
+    BGParseWorkItem* workitem = FindJob(cookie, true /*waitForResults*/, false /*removeJob*/);
+    if (workitem != nullptr)
+    {
+        workitem->WaitForCompletion();
+    }
+}
+
+// Returns true if the job associated with the cookie has been processed, so that WaitForParse would not block
+// Note: runs on any thread
+bool BGParseManager::IsParseComplete(DWORD cookie)
+{
+    Assert(cookie != 0);
+
+    AutoOptionalCriticalSection autoLock(Processor()->GetCriticalSection());
+    for (BGParseWorkItem *item = this->workitemsProcessed.Head(); item != nullptr; item = (BGParseWorkItem*)item->Next())
+    {
+        if (item->GetCookie() == cookie)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Deserializes the background parse results into this thread
 // Note: *must* run on a UI/Execution thread with an available ScriptContext
 HRESULT BGParseManager::GetParseResults(
@@ -438,12 +488,18 @@ BGParseWorkItem::BGParseWorkItem(
     BGParseManager* manager,
     const byte* pszScript,
     size_t cbScript,
-    char16 *fullPath
+    const char16 *fullPath,
+    bool copySource,
+    BGParseSerializedCallback serializedCallback,
+    void* serializedCallbackState
     )
     : JsUtil::Job(manager),
     script(pszScript),
     cb(cbScript),
     path(nullptr),
+    ownsScript(false),
+    serializedCallback(serializedCallback),
+    serializedCallbackState(serializedCallbackState),
     parseHR(S_OK),
     parseSourceLength(0),
     bufferReturn(nullptr),
@@ -453,6 +509,16 @@ BGParseWorkItem::BGParseWorkItem(
 {
     this->cookie = BGParseManager::GetNextCookie();
 
+    if (copySource)
+    {
+        // The parser expects the source to be null terminated, which the caller's buffer may not be
+        byte* copy = HeapNewArray(byte, cbScript + 1);
+        js_memcpy_s(copy, cbScript, pszScript, cbScript);
+        copy[cbScript] = 0;
+        this->script = copy;
+        this->ownsScript = true;
+    }
+
     Assert(fullPath != nullptr);
     this->path = SysAllocString(fullPath);
 }
@@ -470,7 +536,11 @@ BGParseWorkItem::~BGParseWorkItem()
         ::CoTaskMemFree(this->bufferReturn);
     }
 
-    if (this->discarded)
+    if (this->ownsScript)
+    {
+        HeapDeleteArray(this->cb + 1, const_cast<byte*>(this->script));
+    }
+    else if (this->discarded)
     {
         // When this workitem has been discarded, this is the last reference
         // to the script source, so free it now during destruction.
@@ -534,7 +604,7 @@ void BGParseWorkItem::ParseUTF8Core(Js::ScriptContext* scriptContext)
         true, // fOriginalUtf8Code
         this->script,
         this->cb,
-        BGPARSE_FLAGS,
+        this->serializedCallback != nullptr ? BGSERIALIZE_FLAGS : BGPARSE_FLAGS,
         &this->cse,
         cchLength,
         this->parseSourceLength,
@@ -548,6 +618,10 @@ void BGParseWorkItem::ParseUTF8Core(Js::ScriptContext* scriptContext)
     {
         BEGIN_TEMP_ALLOCATOR(tempAllocator, scriptContext, _u("BGParseWorkItem"));
         Js::FunctionBody *functionBody = func->GetFunctionBody();
+        if (this->serializedCallback == nullptr)
+        {
+            UndeferFunctions(scriptContext, tempAllocator, functionBody);
+        }
         this->parseHR = Js::ByteCodeSerializer::SerializeToBuffer(
             scriptContext,
             tempAllocator,
@@ -557,10 +631,20 @@ void BGParseWorkItem::ParseUTF8Core(Js::ScriptContext* scriptContext)
             functionBody->GetHostSrcInfo(),
             &this->bufferReturn,
             &this->bufferReturnBytes,
-            GENERATE_BYTE_CODE_PARSER_STATE | GENERATE_BYTE_CODE_COTASKMEMALLOC
+            this->serializedCallback != nullptr ?
+                GENERATE_BYTE_CODE_COTASKMEMALLOC :
+                GENERATE_BYTE_CODE_PARSER_STATE | GENERATE_BYTE_CODE_COTASKMEMALLOC
         );
         END_TEMP_ALLOCATOR(tempAllocator, scriptContext);
         Assert(this->parseHR == S_OK);
+
+        if (this->serializedCallback != nullptr && this->parseHR == S_OK)
+        {
+            this->serializedCallback(this->serializedCallbackState, this->bufferReturn, this->bufferReturnBytes);
+            ::CoTaskMemFree(this->bufferReturn);
+            this->bufferReturn = nullptr;
+            this->bufferReturnBytes = 0;
+        }
     }
     else
     {
@@ -571,6 +655,81 @@ void BGParseWorkItem::ParseUTF8Core(Js::ScriptContext* scriptContext)
     LEAVE_PINNED_SCOPE();
 }
 
+// Compiles deferred functions of the script that are likely to be called soon after it runs, so that their
+// bytecode is serialized with the global function's and the UI thread doesn't have to parse them on first
+// call. There is no profile data on this thread to predict which functions those are; the ones nearest the
+// global code are taken first, in source order, until BgParseUndeferBudget bytes of source are compiled.
+// Note: runs on BackgroundJobProcessor thread
+void BGParseWorkItem::UndeferFunctions(Js::ScriptContext* scriptContext, ArenaAllocator* alloc, Js::FunctionBody* globalBody)
+{
+    uint budget = CONFIG_FLAG(BgParseUndeferBudget);
+    if (budget == 0)
+    {
+        return;
+    }
+
+    // Breadth first, so that module bodies in a bundle are compiled before the functions nested in them
+    JsUtil::List<Js::FunctionInfo*, ArenaAllocator> worklist(alloc);
+    auto addNestedFunctions = [&](Js::FunctionBody* functionBody)
+    {
+        functionBody->ForEachNestedFunc([&](Js::FunctionProxy* nestedFunc, uint32 index)
+        {
+            if (nestedFunc != nullptr && nestedFunc->GetFunctionInfo()->HasParseableInfo())
+            {
+                worklist.Add(nestedFunc->GetFunctionInfo());
+            }
+            return true;
+        });
+    };
+    addNestedFunctions(globalBody);
+
+    uint undeferredCount = 0;
+    for (int i = 0; i < worklist.Count() && budget > 0; i++)
+    {
+        Js::FunctionInfo* functionInfo = worklist.Item(i);
+        Js::ParseableFunctionInfo* func = functionInfo->GetParseableFunctionInfo();
+        if (func->IsDeferredParseFunction())
+        {
+            uint length = func->LengthInBytes();
+            if (length > budget || func->GetIsAsmjsMode())
+            {
+                continue;
+            }
+
+            HRESULT hr = S_OK;
+            BEGIN_JS_RUNTIME_CALL_EX_AND_TRANSLATE_EXCEPTION_AND_ERROROBJECT_TO_HRESULT_NESTED(scriptContext, false)
+            {
+                func->Parse();
+            }
+            END_JS_RUNTIME_CALL_AND_TRANSLATE_EXCEPTION_AND_ERROROBJECT_TO_HRESULT(hr);
+
+            if (FAILED(hr))
+            {
+                // The function is left deferred, and so is everything after it. The UI thread will report
+                // any error when the function is called.
+                break;
+            }
+
+            budget -= length;
+            undeferredCount++;
+        }
+
+        addNestedFunctions(functionInfo->GetFunctionBody());
+    }
+
+    if (PHASE_TRACE1(Js::BgParsePhase))
+    {
+        Js::Tick now = Js::Tick::Now();
+        Output::Print(
+            _u("[BgParse: Undefer -- cookie: %04d on thread 0x%X at %.2f ms -- functions: %u]\n"),
+            GetCookie(),
+            ::GetCurrentThreadId(),
+            now.ToMilliseconds(),
+            undeferredCount
+        );
+    }
+}
+
 // Deserializes the background parse results into this thread
 // Note: *must* run on a UI/Execution thread with an available ScriptContext
 HRESULT BGParseWorkItem::DeserializeParseResults(
@@ -616,6 +775,23 @@ HRESULT BGParseWorkItem::DeserializeParseResults(
 
         if (hr == S_OK)
         {
+            if (PHASE_TESTTRACE1(Js::BgParsePhase))
+            {
+                // Which of the global code's functions arrived with bytecode, without thread ids or times, for baselines
+                uint compiledCount = 0;
+                uint deferredCount = 0;
+                functionBody->ForEachNestedFunc([&](Js::FunctionProxy* nestedFunc, uint32 index)
+                {
+                    if (nestedFunc != nullptr)
+                    {
+                        nestedFunc->IsDeferredParseFunction() ? deferredCount++ : compiledCount++;
+                    }
+                    return true;
+                });
+                Output::Print(_u("[BgParse: Deserialize -- nested functions compiled: %u, deferred: %u]\n"), compiledCount, deferredCount);
+                Output::Flush();
+            }
+
             // The buffer is now owned by the output of DeserializeFromBuffer
             (*functionBodyReturn) = functionBody;
             this->bufferReturn = nullptr;
@@ -639,13 +815,16 @@ void BGParseWorkItem::JobProcessed(const bool succeeded)
 
     if (IsDiscarded())
     {
-        Js::Tick now = Js::Tick::Now();
-        Output::Print(
-            _u("[BgParse: Discard Before GetResults -- cookie: %04d on thread 0x%X at %.2f ms]\n"),
-            GetCookie(),
-            ::GetCurrentThreadId(),
-            now.ToMilliseconds()
-        );
+        if (PHASE_TRACE1(Js::BgParsePhase))
+        {
+            Js::Tick now = Js::Tick::Now();
+            Output::Print(
+                _u("[BgParse: Discard Before GetResults -- cookie: %04d on thread 0x%X at %.2f ms]\n"),
+                GetCookie(),
+                ::GetCurrentThreadId(),
+                now.ToMilliseconds()
+            );
+        }
 
         // When a workitem has been discarded while processing, there are now other
         // references to it, so free it now
@@ -36,6 +36,9 @@ namespace Js
     class JavascriptFunction;
 }
 
+// Receives the serialized bytecode of a script queued with BGParseManager::QueueBackgroundSerialize. Called on the
+// background thread; the buffer is freed when the callback returns.
+typedef void (*BGParseSerializedCallback)(void* callbackState, const byte* buffer, DWORD bufferBytes);
 
 // BGParseManager is the primary interface for background parsing. It uses a cookie to publicly track the data
 // involved per parse request.
@@ -51,7 +54,10 @@ class BGParseManager sealed : public JsUtil::WaitableJobManager
     static DWORD IncCompleted();
     static DWORD IncFailed();
 
-    HRESULT QueueBackgroundParse(LPCUTF8 pszSrc, size_t cbLength, char16 *fullPath, DWORD* dwBgParseCookie);
+    HRESULT QueueBackgroundParse(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, bool copySource, DWORD* dwBgParseCookie);
+    HRESULT QueueBackgroundSerialize(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, BGParseSerializedCallback callback, void* callbackState, DWORD* dwBgParseCookie);
+    void WaitForParse(DWORD cookie);
+    bool IsParseComplete(DWORD cookie);
     HRESULT GetInputFromCookie(DWORD cookie, LPCUTF8* ppszSrc, size_t* pcbLength, WCHAR** sourceUrl);
     HRESULT GetParseResults(
         Js::ScriptContext* scriptContextUI,
@@ -75,6 +81,7 @@ class BGParseManager sealed : public JsUtil::WaitableJobManager
     bool WasAddedToJobProcessor(JsUtil::Job *const job) const;
 
 private:
+    HRESULT QueueWorkItem(LPCUTF8 pszSrc, size_t cbLength, const char16 *fullPath, bool copySource, BGParseSerializedCallback callback, void* callbackState, DWORD* dwBgParseCookie);
     BGParseWorkItem * FindJob(DWORD dwCookie, bool waitForResults, bool removeJob);
 
     // BGParseWorkItem job can be in one of 3 states, based on which linked list it is in:
@@ -101,7 +108,10 @@ class BGParseWorkItem sealed : public JsUtil::Job
         BGParseManager* manager,
         const byte* script,
         size_t cb,
-        char16 *fullPath
+        const char16 *fullPath,
+        bool copySource,
+        BGParseSerializedCallback serializedCallback,
+        void* serializedCallbackState
     );
     ~BGParseWorkItem();
 
@@ -130,6 +140,8 @@ class BGParseWorkItem sealed : public JsUtil::Job
     WCHAR* GetScriptPath() const { return path; }
 
 private:
+    void UndeferFunctions(Js::ScriptContext* scriptContext, ArenaAllocator* alloc, Js::FunctionBody* globalBody);
+
     // This cookie is the public identifier for this parser work
     DWORD cookie;
 
@@ -138,6 +150,15 @@ class BGParseWorkItem sealed : public JsUtil::Job
     size_t cb;
     BSTR path;
 
+    // True when script is a copy of the caller's buffer, made when the parse was queued, that this
+    // instance frees
+    bool ownsScript;
+
+    // When set, the whole script is compiled and its bytecode is handed to this callback instead of being kept
+    // for GetParseResults
+    BGParseSerializedCallback serializedCallback;
+    void* serializedCallbackState;
+
     // Parse state
     CompileScriptException cse;
     HRESULT parseHR;
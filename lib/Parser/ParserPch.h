@@ -14,6 +14,7 @@
 #include "RegexStats.h"
 #include "StandardChars.h"
 #include "OctoquadIdentifier.h"
+#include "RegexNfa.h"
 #include "RegexCompileTime.h"
 #include "RegexParser.h"
 #include "RegexPattern.h"
@@ -612,6 +612,27 @@ namespace UnifiedRegex
         return cont->BuildCharTrie(compiler, trie, 0, isAcceptFirst);
     }
 
+    bool SimpleNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        const bool isMultiline = (compiler.program->flags & MultilineRegexFlag) != 0;
+        switch (tag)
+        {
+        case Empty:
+            // Nothing
+            break;
+        case BOL:
+            builder.EmitTest(isMultiline ? NfaInst::NfaTag::BOLTest : NfaInst::NfaTag::BOITest);
+            break;
+        case EOL:
+            builder.EmitTest(isMultiline ? NfaInst::NfaTag::EOLTest : NfaInst::NfaTag::EOITest);
+            break;
+        default:
+            Assert(false);
+            return false;
+        }
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void SimpleNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -779,6 +800,12 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool WordBoundaryNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        builder.EmitTest(isNegation ? NfaInst::NfaTag::NegatedWordBoundaryTest : NfaInst::NfaTag::WordBoundaryTest);
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void WordBoundaryNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -1156,6 +1183,30 @@ namespace UnifiedRegex
         return true;
     }
 
+    bool MatchLiteralNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        if (length > NfaBuilder::MaxNumInsts)
+        {
+            return false;
+        }
+
+        const Char* litbuf = compiler.program->rep.insts.litbuf;
+        for (CharCount i = 0; i < length; i++)
+        {
+            if (isEquivClass)
+            {
+                builder.EmitMatchChar(litbuf + offset + i * CaseInsensitive::EquivClassSize);
+            }
+            else
+            {
+                const Char c = litbuf[offset + i];
+                const Char cs[CaseInsensitive::EquivClassSize] = { c, c, c, c };
+                builder.EmitMatchChar(cs);
+            }
+        }
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void MatchLiteralNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -1492,6 +1543,20 @@ namespace UnifiedRegex
         return true;
     }
 
+    bool MatchCharNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        if (isEquivClass)
+        {
+            builder.EmitMatchChar(cs);
+        }
+        else
+        {
+            const Char equivs[CaseInsensitive::EquivClassSize] = { cs[0], cs[0], cs[0], cs[0] };
+            builder.EmitMatchChar(equivs);
+        }
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void MatchCharNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -1770,6 +1835,12 @@ namespace UnifiedRegex
         return true;
     }
 
+    bool MatchSetNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        builder.EmitMatchSet(&set, isNegation);
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void MatchSetNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -2097,6 +2168,18 @@ namespace UnifiedRegex
         return head->BuildCharTrie(compiler, trie, tail, isAcceptFirst);
     }
 
+    bool ConcatNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        PROBE_STACK_NO_DISPOSE(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        for (const ConcatNode* curr = this; curr != 0; curr = curr->tail)
+        {
+            if (!curr->head->BuildNfa(compiler, builder))
+                return false;
+        }
+        return true;
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void ConcatNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -3078,6 +3161,45 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool AltNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        PROBE_STACK_NO_DISPOSE(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        //
+        // NFA scheme:
+        //
+        //          Fork L1, Lnext1
+        //   L1:    <item 1>
+        //          Jump Lexit
+        //   Lnext1:Fork L2, Lnext2
+        //          ...
+        //          <item n>
+        //   Lexit:
+        //
+        JsUtil::List<NfaLabel, ArenaAllocator> jumpFixups(compiler.ctAllocator);
+        for (const AltNode* curr = this; curr != 0; curr = curr->tail)
+        {
+            if (curr->tail == 0)
+            {
+                if (!curr->head->BuildNfa(compiler, builder))
+                    return false;
+            }
+            else
+            {
+                NfaLabel fork = builder.EmitFork();
+                NfaLabel itemLabel = builder.CurrentLabel();
+                if (!curr->head->BuildNfa(compiler, builder))
+                    return false;
+                jumpFixups.Add(builder.EmitJump());
+                builder.FixupFork(fork, itemLabel, builder.CurrentLabel());
+            }
+        }
+
+        for (int i = 0; i < jumpFixups.Count(); i++)
+            builder.FixupJump(jumpFixups.Item(i), builder.CurrentLabel());
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void AltNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -3361,6 +3483,17 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool DefineGroupNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        PROBE_STACK_NO_DISPOSE(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        builder.EmitGroup(NfaInst::NfaTag::BeginGroup, groupId);
+        if (!body->BuildNfa(compiler, builder))
+            return false;
+        builder.EmitGroup(NfaInst::NfaTag::EndGroup, groupId);
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void DefineGroupNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -3505,6 +3638,12 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool MatchGroupNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        // Backreferences need backtracking
+        return false;
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void MatchGroupNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -4239,6 +4378,95 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool LoopNode::BuildNfaIteration(Compiler& compiler, NfaBuilder& builder, int minBodyGroupId, int maxBodyGroupId, bool isOptional) const
+    {
+        // Groups in the body are undefined at the start of each iteration, and an iteration beyond the lower bound
+        // fails if it makes no progress. Only a body which could match empty needs that checked.
+        const bool needsProgressCheck = isOptional && body->thisConsumes.CouldMatchEmpty();
+        if (maxBodyGroupId >= minBodyGroupId)
+            builder.EmitResetGroups(minBodyGroupId, maxBodyGroupId);
+        if (needsProgressCheck)
+            builder.EmitIteration(NfaInst::NfaTag::BeginIteration);
+        if (!body->BuildNfa(compiler, builder))
+            return false;
+        if (needsProgressCheck)
+            builder.EmitIteration(NfaInst::NfaTag::EndIteration);
+        return !builder.IsFull();
+    }
+
+    bool LoopNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        PROBE_STACK_NO_DISPOSE(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        //
+        // NFA scheme, with the body expanded once per iteration:
+        //
+        //          <iteration>                 -- lower times
+        //   Lloop: Fork Lbody, Lexit           -- preferences reversed if non-greedy
+        //   Lbody: <optional iteration>
+        //          Jump Lloop
+        //   Lexit:
+        //
+        // or, if bounded:
+        //
+        //          <iteration>                 -- lower times
+        //          Fork Lbody1, Lexit
+        //   Lbody1:<optional iteration>
+        //          ...                         -- upper - lower times
+        //   Lexit:
+        //
+        if (repeats.lower > NfaBuilder::MaxNumInsts ||
+            (!repeats.IsUnbounded() && (CharCount)repeats.upper > NfaBuilder::MaxNumInsts))
+        {
+            return false;
+        }
+
+        int minBodyGroupId = compiler.program->numGroups;
+        int maxBodyGroupId = -1;
+        body->AccumDefineGroups(compiler.scriptContext, minBodyGroupId, maxBodyGroupId);
+
+        for (CharCount i = 0; i < repeats.lower; i++)
+        {
+            if (!BuildNfaIteration(compiler, builder, minBodyGroupId, maxBodyGroupId, false))
+                return false;
+        }
+
+        if (repeats.IsUnbounded())
+        {
+            NfaLabel loopLabel = builder.EmitFork();
+            NfaLabel bodyLabel = builder.CurrentLabel();
+            if (!BuildNfaIteration(compiler, builder, minBodyGroupId, maxBodyGroupId, true))
+                return false;
+            builder.FixupJump(builder.EmitJump(), loopLabel);
+            NfaLabel exitLabel = builder.CurrentLabel();
+            if (isGreedy)
+                builder.FixupFork(loopLabel, bodyLabel, exitLabel);
+            else
+                builder.FixupFork(loopLabel, exitLabel, bodyLabel);
+        }
+        else if (repeats.upper > repeats.lower)
+        {
+            JsUtil::List<NfaLabel, ArenaAllocator> forkFixups(compiler.ctAllocator);
+            for (CharCount i = repeats.lower; i < (CharCount)repeats.upper; i++)
+            {
+                forkFixups.Add(builder.EmitFork());
+                if (!BuildNfaIteration(compiler, builder, minBodyGroupId, maxBodyGroupId, true))
+                    return false;
+            }
+            NfaLabel exitLabel = builder.CurrentLabel();
+            for (int i = 0; i < forkFixups.Count(); i++)
+            {
+                NfaLabel fork = forkFixups.Item(i);
+                if (isGreedy)
+                    builder.FixupFork(fork, fork + 1, exitLabel);
+                else
+                    builder.FixupFork(fork, exitLabel, fork + 1);
+            }
+        }
+
+        return !builder.IsFull();
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void LoopNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -4488,6 +4716,12 @@ namespace UnifiedRegex
         return false;
     }
 
+    bool AssertionNode::BuildNfa(Compiler& compiler, NfaBuilder& builder) const
+    {
+        // Lookaround needs backtracking
+        return false;
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     void AssertionNode::Print(DebugWriter* w, const Char* litbuf) const
     {
@@ -4569,6 +4803,149 @@ namespace UnifiedRegex
         program->numLoops = nextLoopId;
     }
 
+    void Compiler::Annotate(Node* root)
+    {
+        root->AnnotatePass0(*this);
+        root->AnnotatePass1(*this, true, true, true, true);
+        // Nothing comes before or after overall pattern
+        CountDomain consumes(0);
+        // Match could progress from lhs (since we try successive start positions), but can never regress
+        root->AnnotatePass2(*this, consumes, false, true);
+        // Anything could follow an end of pattern match
+        CharSet<Char>* follow = standardChars->GetFullSet();
+        root->AnnotatePass3(*this, consumes, follow, true, false);
+        root->AnnotatePass4(*this);
+    }
+
+    bool Compiler::IsNfaCandidate(Node* root) const
+    {
+        // Deterministic patterns never backtrack, and backreferences and lookaround can't be expressed in the NFA
+        return !root->isDeterministic && !root->ContainsMatchGroup() && (root->features & Node::HasAssertion) == 0;
+    }
+
+    void Compiler::CaptureNfa(Node* root)
+    {
+        if (!IsNfaCandidate(root))
+        {
+            return;
+        }
+
+        NfaBuilder builder(ctAllocator);
+        if (!root->BuildNfa(*this, builder))
+        {
+            return;
+        }
+        builder.EmitSucc();
+        if (builder.IsFull() || builder.CurrentLabel() * 2 * (uint)program->numGroups > NfaBuilder::MaxNumThreadSlots)
+        {
+            return;
+        }
+
+        program->rep.insts.nfa = NfaProgram::New(scriptContext->GetRecycler(), rtAllocator, builder);
+    }
+
+    NfaProgram* Compiler::CompileNfa(Program* program, RegexPattern* pattern)
+    {
+        // Called the first time a match of the program runs out of backtrack budget. The AST is long gone by then, so
+        // parse and annotate the source again into a scratch program which only lends the NFA its literals and groups.
+        // A pattern whose NFA turns out too large keeps backtracking without a budget from then on.
+        Assert(program->rep.insts.isNfaPending);
+        Assert(program->rep.insts.nfa == nullptr);
+        program->rep.insts.isNfaPending = false;
+
+        Js::ScriptContext* scriptContext = pattern->GetScriptContext();
+        PROBE_STACK_NO_DISPOSE(scriptContext, Js::Constants::MinStackRegex);
+
+        // Only these flags change what the parser produces
+        const CharCount OPT_BUF_SIZE = 4;
+        Char opts[OPT_BUF_SIZE];
+        CharCount numOpts = 0;
+        if ((program->flags & IgnoreCaseRegexFlag) != 0)
+        {
+            opts[numOpts++] = _u('i');
+        }
+        if ((program->flags & DotAllRegexFlag) != 0)
+        {
+            opts[numOpts++] = _u('s');
+        }
+        if ((program->flags & UnicodeRegexFlag) != 0)
+        {
+            opts[numOpts++] = _u('u');
+        }
+        Assert(numOpts < OPT_BUF_SIZE);
+        opts[numOpts] = 0;
+
+        NfaProgram* nfa = nullptr;
+        Recycler* recycler = scriptContext->GetRecycler();
+
+        BEGIN_TEMP_ALLOCATOR(ctAllocator, scriptContext, _u("UnifiedRegexCompileNfa"));
+        StandardChars<Char>* standardChars = scriptContext->GetThreadContext()->GetStandardChars((char16*)0);
+        Parser<NullTerminatedUnicodeEncodingPolicy, false> parser
+            ( scriptContext
+            , ctAllocator
+            , standardChars
+            , standardChars
+            , false
+#if ENABLE_REGEX_CONFIG_OPTIONS
+            , nullptr
+#endif
+            );
+
+        Node* root = nullptr;
+        try
+        {
+            RegexFlags flags = NoRegexFlags;
+            root = parser.ParseDynamic(program->source, program->source + program->sourceLen, opts, opts + numOpts, flags);
+        }
+        catch (ParseError)
+        {
+            // The source parsed when the pattern was compiled
+            Assert(false);
+        }
+
+        if (root != nullptr)
+        {
+            Program* scratch = Program::New(recycler, program->flags);
+            scratch->source = program->source;
+            scratch->sourceLen = program->sourceLen;
+            scratch->numGroups = program->numGroups;
+
+            Compiler compiler
+                ( scriptContext
+                , ctAllocator
+                , scriptContext->RegexAllocator()
+                , standardChars
+                , scratch
+#if ENABLE_REGEX_CONFIG_OPTIONS
+                , nullptr
+                , nullptr
+#endif
+                );
+            compiler.CaptureLiterals(root, parser.GetLitbuf());
+            compiler.Annotate(root);
+            compiler.CaptureNfa(root);
+
+            nfa = scratch->rep.insts.nfa;
+            scratch->rep.insts.nfa = nullptr;
+        }
+
+        END_TEMP_ALLOCATOR(ctAllocator, scriptContext);
+
+        program->rep.insts.nfa = nfa;
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        if (REGEX_CONFIG_FLAG(RegexDebug) && nfa != nullptr)
+        {
+            DebugWriter* w = scriptContext->GetRegexDebugWriter();
+            w->PrintEOL(_u("REGEX NFA /%s/"), PointerValue(program->source));
+            nfa->Print(w);
+            w->Flush();
+        }
+#endif
+
+        return nfa;
+    }
+
     void Compiler::FreeBody()
     {
         if (instBuf != 0)
@@ -4710,17 +5087,7 @@ namespace UnifiedRegex
                 {
                     program->tag = Program::ProgramTag::InstructionsTag;
                     compiler.CaptureLiterals(root, litbuf);
-
-                    root->AnnotatePass0(compiler);
-                    root->AnnotatePass1(compiler, true, true, true, true);
-                    // Nothing comes before or after overall pattern
-                    CountDomain consumes(0);
-                    // Match could progress from lhs (since we try successive start positions), but can never regress
-                    root->AnnotatePass2(compiler, consumes, false, true);
-                    // Anything could follow an end of pattern match
-                    CharSet<Char>* follow = standardChars->GetFullSet();
-                    root->AnnotatePass3(compiler, consumes, follow, true, false);
-                    root->AnnotatePass4(compiler);
+                    compiler.Annotate(root);
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
                     if (w != 0 && REGEX_CONFIG_FLAG(RegexDebugAST) && REGEX_CONFIG_FLAG(RegexDebugAnnotatedAST))
@@ -4782,6 +5149,9 @@ namespace UnifiedRegex
 
                     compiler.Emit<SuccInst>();
                     compiler.CaptureInsts();
+
+                    // The NFA itself is only built once a match runs out of backtrack budget (see CompileNfa)
+                    program->rep.insts.isNfaPending = CONFIG_FLAG(RegexLinearMatcher) && compiler.IsNfaCandidate(root);
                 }
             }
             else
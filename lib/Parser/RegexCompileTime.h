@@ -282,6 +282,10 @@ namespace UnifiedRegex
         //  - Otherwise, return false if any literal is a proper prefix of any other literal, irrespective of order.
         virtual bool BuildCharTrie(Compiler& compiler, CharTrie* trie, Node* cont, bool isAcceptFirst) const = 0;
 
+        // Append a Thompson NFA equivalent to this regex to 'builder'. Return false if the regex needs backtracking
+        // (it has backreferences or assertions) or the NFA would be too large.
+        virtual bool BuildNfa(Compiler& compiler, NfaBuilder& builder) const = 0;
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         virtual void Print(DebugWriter* w, const Char* litbuf) const = 0;
         void PrintAnnotations(DebugWriter* w) const;
@@ -315,6 +319,7 @@ namespace UnifiedRegex
                   bool IsOctoquad(Compiler& compiler, OctoquadIdentifier* oi) override; \
                   bool IsCharTrieArm(Compiler& compiler, uint& accNumAlts) const override; \
                   bool BuildCharTrie(Compiler& compiler, CharTrie* trie, Node* cont, bool isAcceptFirst) const override; \
+                  bool BuildNfa(Compiler& compiler, NfaBuilder& builder) const override; \
                   NODE_PRINT
 
     struct SimpleNode : Node
@@ -545,6 +550,9 @@ namespace UnifiedRegex
         }
 
         NODE_DECL
+
+    private:
+        bool BuildNfaIteration(Compiler& compiler, NfaBuilder& builder, int minBodyGroupId, int maxBodyGroupId, bool isOptional) const;
     };
 
     struct AssertionNode : Node
@@ -684,6 +692,9 @@ namespace UnifiedRegex
         void CaptureLiterals(Node* root, const Char *litbuf);
         static void EmitAndCaptureSuccInst(Recycler* recycler, Program* program);
         void CaptureInsts();
+        void Annotate(Node* root);
+        bool IsNfaCandidate(Node* root) const;
+        void CaptureNfa(Node* root);
         void FreeBody();
 
         Compiler
@@ -722,5 +733,9 @@ namespace UnifiedRegex
             , RegexStats* stats
 #endif
             );
+
+        // Build the linear-time NFA of a program compiled with isNfaPending set. Returns null if the pattern turns out
+        // not to fit in an NFA; either way the program is no longer pending.
+        static NfaProgram* CompileNfa(Program* program, RegexPattern* pattern);
     };
 }
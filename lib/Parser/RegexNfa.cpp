@@ -0,0 +1,345 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // NfaBuilder
+    // ----------------------------------------------------------------------
+
+    NfaBuilder::NfaBuilder(ArenaAllocator* ctAllocator)
+        : insts(ctAllocator)
+        , sets(ctAllocator)
+        , isFull(false)
+    {
+    }
+
+    NfaInst* NfaBuilder::Emit(NfaInst::NfaTag tag)
+    {
+        if (!isFull && (uint)insts.Count() >= MaxNumInsts)
+        {
+            isFull = true;
+        }
+        if (isFull)
+        {
+            return nullptr;
+        }
+
+        NfaInst inst;
+        memset(&inst, 0, sizeof(inst));
+        inst.tag = tag;
+        return &insts.Item(insts.Add(inst));
+    }
+
+    void NfaBuilder::EmitMatchChar(__in_ecount(4) const Char* cs)
+    {
+        NfaInst* inst = Emit(NfaInst::NfaTag::MatchChar);
+        if (inst != nullptr)
+        {
+            for (int i = 0; i < CaseInsensitive::EquivClassSize; i++)
+            {
+                inst->cs[i] = cs[i];
+            }
+        }
+    }
+
+    void NfaBuilder::EmitMatchSet(const CharSet<Char>* set, bool isNegation)
+    {
+        NfaInst* inst = Emit(isNegation ? NfaInst::NfaTag::MatchNegatedSet : NfaInst::NfaTag::MatchSet);
+        if (inst != nullptr)
+        {
+            inst->setIndex = (uint)sets.Add(set);
+        }
+    }
+
+    void NfaBuilder::EmitTest(NfaInst::NfaTag tag)
+    {
+        Assert(tag >= NfaInst::NfaTag::BOITest && tag <= NfaInst::NfaTag::NegatedWordBoundaryTest);
+        Emit(tag);
+    }
+
+    void NfaBuilder::EmitGroup(NfaInst::NfaTag tag, int groupId)
+    {
+        Assert(tag == NfaInst::NfaTag::BeginGroup || tag == NfaInst::NfaTag::EndGroup);
+        NfaInst* inst = Emit(tag);
+        if (inst != nullptr)
+        {
+            inst->groupId = groupId;
+        }
+    }
+
+    void NfaBuilder::EmitResetGroups(int minGroupId, int maxGroupId)
+    {
+        Assert(minGroupId > 0 && minGroupId <= maxGroupId);
+        NfaInst* inst = Emit(NfaInst::NfaTag::ResetGroups);
+        if (inst != nullptr)
+        {
+            inst->groups.minGroupId = minGroupId;
+            inst->groups.maxGroupId = maxGroupId;
+        }
+    }
+
+    void NfaBuilder::EmitIteration(NfaInst::NfaTag tag)
+    {
+        Assert(tag == NfaInst::NfaTag::BeginIteration || tag == NfaInst::NfaTag::EndIteration);
+        Emit(tag);
+    }
+
+    void NfaBuilder::EmitSucc()
+    {
+        Emit(NfaInst::NfaTag::Succ);
+    }
+
+    NfaLabel NfaBuilder::EmitFork()
+    {
+        NfaLabel label = CurrentLabel();
+        Emit(NfaInst::NfaTag::Fork);
+        return label;
+    }
+
+    void NfaBuilder::FixupFork(NfaLabel fork, NfaLabel preferred, NfaLabel other)
+    {
+        if (isFull)
+        {
+            return;
+        }
+        NfaInst& inst = insts.Item(fork);
+        Assert(inst.tag == NfaInst::NfaTag::Fork);
+        Assert(preferred <= CurrentLabel() && other <= CurrentLabel());
+        inst.fork.preferred = preferred;
+        inst.fork.other = other;
+    }
+
+    NfaLabel NfaBuilder::EmitJump()
+    {
+        NfaLabel label = CurrentLabel();
+        Emit(NfaInst::NfaTag::Jump);
+        return label;
+    }
+
+    void NfaBuilder::FixupJump(NfaLabel jump, NfaLabel target)
+    {
+        if (isFull)
+        {
+            return;
+        }
+        NfaInst& inst = insts.Item(jump);
+        Assert(inst.tag == NfaInst::NfaTag::Jump);
+        Assert(target <= CurrentLabel());
+        inst.target = target;
+    }
+
+    // ----------------------------------------------------------------------
+    // NfaProgram
+    // ----------------------------------------------------------------------
+
+    NfaProgram::NfaProgram()
+        : insts(nullptr)
+        , numInsts(0)
+        , sets(nullptr)
+        , numSets(0)
+        , maxThreads(0)
+        , maxFrames(0)
+    {
+    }
+
+    NfaProgram* NfaProgram::New(Recycler* recycler, ArenaAllocator* rtAllocator, const NfaBuilder& builder)
+    {
+        Assert(!builder.IsFull());
+        const uint numInsts = (uint)builder.insts.Count();
+        Assert(numInsts > 0 && builder.insts.Item(numInsts - 1).tag == NfaInst::NfaTag::Succ);
+
+        NfaProgram* nfa = RecyclerNew(recycler, NfaProgram);
+        nfa->insts = RecyclerNewArrayLeaf(recycler, NfaInst, numInsts);
+        js_memcpy_s(nfa->insts, numInsts * sizeof(NfaInst), builder.insts.GetBuffer(), numInsts * sizeof(NfaInst));
+        nfa->numInsts = numInsts;
+
+        const uint numSets = (uint)builder.sets.Count();
+        if (numSets > 0)
+        {
+            nfa->sets = RecyclerNewArrayLeaf(recycler, RuntimeCharSet<Char>, numSets);
+            for (uint i = 0; i < numSets; i++)
+            {
+                nfa->sets[i].CloneFrom(rtAllocator, *builder.sets.Item(i));
+            }
+        }
+        nfa->numSets = numSets;
+
+        // A thread parks only at a consuming instruction or at Succ, and at most one thread parks at each per input
+        // position. Following the non-consuming instructions reaches each (instruction, consumed) state at most once per
+        // input position, so the frame stack can't grow beyond the frames pushed by two visits of every instruction.
+        uint maxThreads = 0;
+        uint maxFrames = 1;
+        for (uint i = 0; i < numInsts; i++)
+        {
+            const NfaInst& inst = nfa->insts[i];
+            uint numPushes;
+            switch (inst.tag)
+            {
+            case NfaInst::NfaTag::MatchChar:
+            case NfaInst::NfaTag::MatchSet:
+            case NfaInst::NfaTag::MatchNegatedSet:
+            case NfaInst::NfaTag::Succ:
+                maxThreads++;
+                numPushes = 0;
+                break;
+            case NfaInst::NfaTag::Fork:
+                numPushes = 2;
+                break;
+            case NfaInst::NfaTag::BeginGroup:
+            case NfaInst::NfaTag::EndGroup:
+                // restore frame + continuation
+                numPushes = 2;
+                break;
+            case NfaInst::NfaTag::ResetGroups:
+                // restore frames for both slots of each group + continuation
+                numPushes = 1 + 2 * (uint)(inst.groups.maxGroupId - inst.groups.minGroupId + 1);
+                break;
+            default:
+                numPushes = 1;
+                break;
+            }
+            maxFrames += 2 * numPushes;
+        }
+        nfa->maxThreads = maxThreads;
+        nfa->maxFrames = maxFrames;
+
+        return nfa;
+    }
+
+    void NfaProgram::FreeBody(ArenaAllocator* rtAllocator)
+    {
+        for (uint i = 0; i < numSets; i++)
+        {
+            sets[i].FreeBody(rtAllocator);
+        }
+    }
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+    void NfaProgram::Print(DebugWriter* w) const
+    {
+        w->PrintEOL(_u("nfa: {"));
+        w->Indent();
+        for (uint i = 0; i < numInsts; i++)
+        {
+            const NfaInst& inst = insts[i];
+            w->Print(_u("L%04u: "), i);
+            switch (inst.tag)
+            {
+            case NfaInst::NfaTag::MatchChar:
+                w->Print(_u("MatchChar("));
+                w->PrintQuotedChar(inst.cs[0]);
+                if (inst.cs[1] != inst.cs[0] || inst.cs[2] != inst.cs[0] || inst.cs[3] != inst.cs[0])
+                {
+                    for (int j = 1; j < CaseInsensitive::EquivClassSize; j++)
+                    {
+                        w->Print(_u(", "));
+                        w->PrintQuotedChar(inst.cs[j]);
+                    }
+                }
+                w->PrintEOL(_u(")"));
+                break;
+            case NfaInst::NfaTag::MatchSet:
+            case NfaInst::NfaTag::MatchNegatedSet:
+                w->Print(inst.tag == NfaInst::NfaTag::MatchSet ? _u("MatchSet(") : _u("MatchNegatedSet("));
+                sets[inst.setIndex].Print(w);
+                w->PrintEOL(_u(")"));
+                break;
+            case NfaInst::NfaTag::BOITest:
+                w->PrintEOL(_u("BOITest"));
+                break;
+            case NfaInst::NfaTag::EOITest:
+                w->PrintEOL(_u("EOITest"));
+                break;
+            case NfaInst::NfaTag::BOLTest:
+                w->PrintEOL(_u("BOLTest"));
+                break;
+            case NfaInst::NfaTag::EOLTest:
+                w->PrintEOL(_u("EOLTest"));
+                break;
+            case NfaInst::NfaTag::WordBoundaryTest:
+                w->PrintEOL(_u("WordBoundaryTest"));
+                break;
+            case NfaInst::NfaTag::NegatedWordBoundaryTest:
+                w->PrintEOL(_u("NegatedWordBoundaryTest"));
+                break;
+            case NfaInst::NfaTag::Fork:
+                w->PrintEOL(_u("Fork(preferred: L%04u, other: L%04u)"), inst.fork.preferred, inst.fork.other);
+                break;
+            case NfaInst::NfaTag::Jump:
+                w->PrintEOL(_u("Jump(L%04u)"), inst.target);
+                break;
+            case NfaInst::NfaTag::BeginGroup:
+                w->PrintEOL(_u("BeginGroup(%d)"), inst.groupId);
+                break;
+            case NfaInst::NfaTag::EndGroup:
+                w->PrintEOL(_u("EndGroup(%d)"), inst.groupId);
+                break;
+            case NfaInst::NfaTag::ResetGroups:
+                w->PrintEOL(_u("ResetGroups(%d-%d)"), inst.groups.minGroupId, inst.groups.maxGroupId);
+                break;
+            case NfaInst::NfaTag::BeginIteration:
+                w->PrintEOL(_u("BeginIteration"));
+                break;
+            case NfaInst::NfaTag::EndIteration:
+                w->PrintEOL(_u("EndIteration"));
+                break;
+            case NfaInst::NfaTag::Succ:
+                w->PrintEOL(_u("Succ"));
+                break;
+            default:
+                Assert(false);
+                __assume(false);
+            }
+        }
+        w->Unindent();
+        w->PrintEOL(_u("}"));
+    }
+#endif
+
+    // ----------------------------------------------------------------------
+    // NfaThreads
+    // ----------------------------------------------------------------------
+
+    NfaThreads* NfaThreads::New(Recycler* recycler, const NfaProgram* nfa, uint16 numGroups)
+    {
+        const uint numSlots = 2 * (uint)numGroups;
+        const uint maxThreads = nfa->maxThreads;
+        Assert(maxThreads * numSlots <= NfaBuilder::MaxNumThreadSlots);
+
+        const size_t framesSize = nfa->maxFrames * sizeof(Frame);
+        const size_t labelsSize = maxThreads * sizeof(NfaLabel);
+        const size_t slotsSize = maxThreads * numSlots * sizeof(CharCount);
+        const size_t workingSlotsSize = numSlots * sizeof(CharCount);
+        const size_t visitedSize = 2 * nfa->numInsts * sizeof(uint);
+
+        NfaThreads* threads = RecyclerNewPlusLeaf(
+            recycler,
+            framesSize + 2 * labelsSize + 2 * slotsSize + 2 * workingSlotsSize + visitedSize,
+            NfaThreads);
+
+        uint8* next = (uint8*)(threads + 1);
+        threads->frames = (Frame*)next;
+        next += framesSize;
+        for (int i = 0; i < 2; i++)
+        {
+            threads->labels[i] = (NfaLabel*)next;
+            next += labelsSize;
+            threads->slots[i] = (CharCount*)next;
+            next += slotsSize;
+            threads->numThreads[i] = 0;
+        }
+        threads->workingSlots = (CharCount*)next;
+        next += workingSlotsSize;
+        threads->bestSlots = (CharCount*)next;
+        next += workingSlotsSize;
+        threads->visited = (uint*)next;
+
+        threads->numSlots = numSlots;
+        threads->maxThreads = maxThreads;
+        return threads;
+    }
+}
@@ -0,0 +1,189 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+//
+// Thompson NFA for regexes without backreferences or lookaround, executed by a Pike VM in time linear
+// in the input length. Built and used by the matcher in place of backtracking once a match has exhausted
+// its backtrack budget (see -RegexBacktrackLimit).
+//
+// Threads are kept in priority order, and the highest priority thread to reach a state wins it, so
+// the captures reported are those which the backtracking matcher would have reported.
+//
+#pragma once
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // NfaInst
+    // ----------------------------------------------------------------------
+
+    struct NfaInst : private Chars<char16>
+    {
+        enum class NfaTag : uint8
+        {
+            // Consuming
+            MatchChar,               // match any of cs
+            MatchSet,                // match any char in set
+            MatchNegatedSet,         // match any char not in set
+            // Assertions
+            BOITest,
+            EOITest,
+            BOLTest,
+            EOLTest,
+            WordBoundaryTest,
+            NegatedWordBoundaryTest,
+            // Control
+            Fork,                    // continue at fork.preferred, then at fork.other with lower priority
+            Jump,                    // continue at target
+            BeginGroup,              // record start of groupId
+            EndGroup,                // record end of groupId
+            ResetGroups,             // undefine groups.minGroupId..groups.maxGroupId
+            BeginIteration,          // start of an optional loop iteration
+            EndIteration,            // end of an optional loop iteration, which must have consumed input
+            Succ
+        };
+
+        struct ForkTargets
+        {
+            NfaLabel preferred;
+            NfaLabel other;
+        };
+
+        struct GroupRange
+        {
+            int minGroupId;
+            int maxGroupId;
+        };
+
+        NfaTag tag;
+        union
+        {
+            Char cs[CaseInsensitive::EquivClassSize]; // MatchChar
+            uint setIndex;                            // MatchSet, MatchNegatedSet
+            ForkTargets fork;                         // Fork
+            NfaLabel target;                          // Jump
+            int groupId;                              // BeginGroup, EndGroup
+            GroupRange groups;                        // ResetGroups
+        };
+
+        inline bool IsConsuming() const
+        {
+            return tag <= NfaTag::MatchNegatedSet;
+        }
+    };
+
+    // ----------------------------------------------------------------------
+    // NfaBuilder
+    // ----------------------------------------------------------------------
+
+    // Accumulates the NFA for a pattern while walking its AST. Once the instruction limit is exceeded the builder
+    // stops recording and IsFull() reports the pattern as ineligible.
+    class NfaBuilder : private Chars<char16>
+    {
+        friend class NfaProgram;
+
+    public:
+        static const uint MaxNumInsts = 4096;
+        // Limit on threads * capture slots, which bounds the matcher's scratch space
+        static const uint MaxNumThreadSlots = 1 << 16;
+
+    private:
+        JsUtil::List<NfaInst, ArenaAllocator> insts;
+        JsUtil::List<const CharSet<Char>*, ArenaAllocator> sets;
+        bool isFull;
+
+        // Returns null once full
+        NfaInst* Emit(NfaInst::NfaTag tag);
+
+    public:
+        NfaBuilder(ArenaAllocator* ctAllocator);
+
+        inline bool IsFull() const
+        {
+            return isFull;
+        }
+
+        inline NfaLabel CurrentLabel() const
+        {
+            return (NfaLabel)insts.Count();
+        }
+
+        void EmitMatchChar(__in_ecount(4) const Char* cs);
+        void EmitMatchSet(const CharSet<Char>* set, bool isNegation);
+        void EmitTest(NfaInst::NfaTag tag);
+        void EmitGroup(NfaInst::NfaTag tag, int groupId);
+        void EmitResetGroups(int minGroupId, int maxGroupId);
+        void EmitIteration(NfaInst::NfaTag tag);
+        void EmitSucc();
+
+        // Forks and forward jumps are emitted with unresolved targets which are fixed up once known
+        NfaLabel EmitFork();
+        void FixupFork(NfaLabel fork, NfaLabel preferred, NfaLabel other);
+        NfaLabel EmitJump();
+        void FixupJump(NfaLabel jump, NfaLabel target);
+    };
+
+    // ----------------------------------------------------------------------
+    // NfaProgram
+    // ----------------------------------------------------------------------
+
+    class NfaProgram : private Chars<char16>
+    {
+        friend class Matcher;
+        friend struct NfaThreads;
+
+    private:
+        // In run-time allocator (recycler), owned by program
+        Field(NfaInst*) insts;
+        Field(uint) numInsts;
+        // Set bodies are in the regex run-time allocator
+        Field(RuntimeCharSet<Char>*) sets;
+        Field(uint) numSets;
+        // Upper bound on the number of threads which may be alive at one input position
+        Field(uint) maxThreads;
+        // Upper bound on the depth of the explicit stack used to follow non-consuming instructions
+        Field(uint) maxFrames;
+
+        NfaProgram();
+
+    public:
+        static NfaProgram* New(Recycler* recycler, ArenaAllocator* rtAllocator, const NfaBuilder& builder);
+        void FreeBody(ArenaAllocator* rtAllocator);
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        void Print(DebugWriter* w) const;
+#endif
+    };
+
+    // ----------------------------------------------------------------------
+    // NfaThreads
+    // ----------------------------------------------------------------------
+
+    // Per-matcher scratch space for the Pike VM, sized for one program and allocated on first use.
+    struct NfaThreads
+    {
+        // Pseudo-label of a frame which restores a capture slot when popped
+        static const NfaLabel RestoreFrameLabel = (NfaLabel)-1;
+
+        struct Frame
+        {
+            NfaLabel label;
+            bool consumed;  // has input been consumed since the innermost BeginIteration
+            uint slot;      // restore frames only
+            CharCount value;
+        };
+
+        uint numSlots;      // 2 * numGroups: start and end offset of each group
+        uint maxThreads;
+        uint numThreads[2];
+        NfaLabel* labels[2];
+        CharCount* slots[2];        // maxThreads rows of numSlots
+        CharCount* workingSlots;    // numSlots
+        CharCount* bestSlots;       // numSlots
+        uint* visited;              // generation at which each (label, consumed) state was last reached
+        Frame* frames;              // maxFrames
+
+        static NfaThreads* New(Recycler* recycler, const NfaProgram* nfa, uint16 numGroups);
+    };
+}
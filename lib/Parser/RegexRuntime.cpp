@@ -28,6 +28,99 @@ namespace UnifiedRegex
     }
 #endif
 
+    // ----------------------------------------------------------------------
+    // Vectorized character scans
+    // ----------------------------------------------------------------------
+
+    // The scans below return the offset of the first candidate position at or after offset, or inputLength if there is
+    // none. On x64 they compare eight char16's at a time with SSE2 and finish the tail with the scalar loop.
+
+#if ENABLE_SSE2_FAST_PATHS
+    static const CharCount SimdScanChars = sizeof(__m128i) / sizeof(char16);
+
+    static inline CharCount FirstSimdMatch(const CharCount offset, const int mask)
+    {
+        DWORD index;
+        _BitScanForward(&index, (DWORD)mask);
+        return offset + (CharCount)(index / sizeof(char16));
+    }
+#endif
+
+    static inline CharCount FindChar(const char16* const input, const CharCount inputLength, CharCount offset, const char16 c)
+    {
+#if ENABLE_SSE2_FAST_PATHS
+        const __m128i pattern = _mm_set1_epi16((short)c);
+        while (inputLength - offset >= SimdScanChars)
+        {
+            const __m128i chars = _mm_loadu_si128((const __m128i*)(input + offset));
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chars, pattern));
+            if (mask != 0)
+            {
+                return FirstSimdMatch(offset, mask);
+            }
+            offset += SimdScanChars;
+        }
+#endif
+        while (offset < inputLength && input[offset] != c)
+        {
+            offset++;
+        }
+        return offset;
+    }
+
+    static inline CharCount FindChar2Set(const char16* const input, const CharCount inputLength, CharCount offset, const char16 c0, const char16 c1)
+    {
+#if ENABLE_SSE2_FAST_PATHS
+        const __m128i pattern0 = _mm_set1_epi16((short)c0);
+        const __m128i pattern1 = _mm_set1_epi16((short)c1);
+        while (inputLength - offset >= SimdScanChars)
+        {
+            const __m128i chars = _mm_loadu_si128((const __m128i*)(input + offset));
+            const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(chars, pattern0), _mm_cmpeq_epi16(chars, pattern1)));
+            if (mask != 0)
+            {
+                return FirstSimdMatch(offset, mask);
+            }
+            offset += SimdScanChars;
+        }
+#endif
+        while (offset < inputLength && input[offset] != c0 && input[offset] != c1)
+        {
+            offset++;
+        }
+        return offset;
+    }
+
+    // Finds the first offset at which the two character literal c0 c1 starts
+    static inline CharCount FindChar2Literal(const char16* const input, const CharCount inputLength, CharCount offset, const char16 c0, const char16 c1)
+    {
+        if (inputLength < 2)
+        {
+            return inputLength;
+        }
+        const CharCount endOffset = inputLength - 1;
+#if ENABLE_SSE2_FAST_PATHS
+        const __m128i pattern0 = _mm_set1_epi16((short)c0);
+        const __m128i pattern1 = _mm_set1_epi16((short)c1);
+        while (offset < endOffset && endOffset - offset >= SimdScanChars)
+        {
+            const __m128i first = _mm_loadu_si128((const __m128i*)(input + offset));
+            const __m128i second = _mm_loadu_si128((const __m128i*)(input + offset + 1));
+            const int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(first, pattern0), _mm_cmpeq_epi16(second, pattern1)));
+            if (mask != 0)
+            {
+                return FirstSimdMatch(offset, mask);
+            }
+            offset += SimdScanChars;
+        }
+#endif
+        while (offset < endOffset && (input[offset] != c0 || input[offset + 1] != c1))
+        {
+            offset++;
+        }
+        return offset < endOffset ? offset : inputLength;
+    }
+
     // ----------------------------------------------------------------------
     // Matcher (inlined, called from instruction Exec methods)
     // ----------------------------------------------------------------------
@@ -550,82 +643,17 @@ namespace UnifiedRegex
 
     bool Char2LiteralScannerMixin::Match(Matcher& matcher, const char16* const input, const CharCount inputLength, CharCount& inputOffset) const
     {
-        if (inputLength == 0)
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        matcher.CompStats();
+#endif
+        const CharCount offset = FindChar2Literal(input, inputLength, inputOffset, cs[0], cs[1]);
+        if (offset >= inputLength)
         {
             return false;
         }
 
-        const uint matchC0 = Chars<char16>::CTU(cs[0]);
-        const uint matchC1 = Chars<char16>::CTU(cs[1]);
-
-        const char16 * currentInput = input + inputOffset;
-        const char16 * endInput = input + inputLength - 1;
-
-        while (currentInput < endInput)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            while (true)
-            {
-                const uint c1 = Chars<char16>::CTU(currentInput[1]);
-                if (c1 != matchC1)
-                {
-                    if (c1 == matchC0)
-                    {
-                        break;
-                    }
-                    currentInput += 2;
-                    if (currentInput >= endInput)
-                    {
-                        return false;
-                    }
-                    continue;
-                }
-#if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
-#endif
-                // Check the first character
-                const uint c0 = Chars<char16>::CTU(*currentInput);
-                if (c0 == matchC0)
-                {
-                    inputOffset = (CharCount)(currentInput - input);
-                    return true;
-                }
-                if (matchC0 == matchC1)
-                {
-                    break;
-                }
-                currentInput +=2;
-                if (currentInput >= endInput)
-                {
-                    return false;
-                }
-            }
-
-            // If the second character in the buffer matches the first in the pattern, continue
-            // to see if the next character has the second in the pattern
-            currentInput++;
-            while (currentInput < endInput)
-            {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-                matcher.CompStats();
-#endif
-                const uint c1 = Chars<char16>::CTU(currentInput[1]);
-                if (c1 == matchC1)
-                {
-                    inputOffset = (CharCount)(currentInput - input);
-                    return true;
-                }
-                if (c1 != matchC0)
-                {
-                    currentInput += 2;
-                    break;
-                }
-                currentInput++;
-            }
-        }
-        return false;
+        inputOffset = offset;
+        return true;
     }
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
@@ -1818,13 +1846,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        inputOffset = FindChar(input, inputLength, inputOffset, matchC);
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -1853,13 +1875,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC0 && input[inputOffset] != matchC1)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        inputOffset = FindChar2Set(input, inputLength, inputOffset, matchC0, matchC1);
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -2017,13 +2033,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        inputOffset = FindChar(input, inputLength, inputOffset, matchC);
 
         if (inputOffset >= inputLength)
         {
@@ -2057,13 +2067,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && (input[inputOffset] != matchC0 && input[inputOffset] != matchC1))
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        inputOffset = FindChar2Set(input, inputLength, inputOffset, matchC0, matchC1);
 
         if (inputOffset >= inputLength)
         {
@@ -2248,13 +2252,7 @@ namespace UnifiedRegex
         }
 
         const Char matchC = c;
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        inputOffset = FindChar(input, inputLength, inputOffset, matchC);
 
         if (inputOffset >= inputLength)
         {
@@ -4923,6 +4921,8 @@ namespace UnifiedRegex
         , literalNextSyncInputOffsets(nullptr)
         , recycler(scriptContext->GetRecycler())
         , previousQcTime(0)
+        , backtrackBudget(0)
+        , nfaThreads(nullptr)
 #if ENABLE_REGEX_CONFIG_OPTIONS
         , stats(0)
         , w(0)
@@ -5072,6 +5072,14 @@ namespace UnifiedRegex
                 break;
             }
 
+            if (backtrackBudget != 0 && --backtrackBudget == 0)
+            {
+                // Give up on this match attempt, Match will continue with the program's NFA
+                contStack.Clear();
+                assertionStack.Clear();
+                break;
+            }
+
             Assert(cont->tag >= minContTag && cont->tag <= maxContTag);
             // All these cases RESUME EXECUTION if backtracking finds a stop point
             const Cont::ContTag tag = cont->tag;
@@ -5247,19 +5255,16 @@ namespace UnifiedRegex
             }
         }
 
-        while (offset < inputLength)
-        {
 #if ENABLE_REGEX_CONFIG_OPTIONS
-            CompStats();
+        CompStats();
 #endif
-            if (input[offset] == c)
-            {
-                GroupInfo* const info = GroupIdToGroupInfo(0);
-                info->offset = offset;
-                info->length = 1;
-                return true;
-            }
-            offset++;
+        offset = FindChar(input, inputLength, offset, c);
+        if (offset < inputLength)
+        {
+            GroupInfo* const info = GroupIdToGroupInfo(0);
+            info->offset = offset;
+            info->length = 1;
+            return true;
         }
 
         ResetGroup(0);
@@ -5453,6 +5458,297 @@ namespace UnifiedRegex
         return false;
     }
 
+    void Matcher::AddLinearThread(const Char* const input, const CharCount inputLength, NfaLabel label, bool consumed, CharCount inputOffset, int list)
+    {
+        // Follow the non-consuming instructions reachable from label, in priority order, parking a thread at each
+        // consuming instruction (or Succ) reached for the first time at this input offset. The captures of the thread
+        // are in workingSlots; every update to them pushes a frame which restores the previous value once the
+        // instructions following the update have been explored.
+        const NfaProgram* const nfa = program->rep.insts.nfa;
+        NfaThreads* const threads = nfaThreads;
+        CharCount* const slots = threads->workingSlots;
+        NfaThreads::Frame* const frames = threads->frames;
+        const uint generation = inputOffset + 1;
+        uint numFrames = 0;
+
+        frames[numFrames].label = label;
+        frames[numFrames].consumed = consumed;
+        numFrames++;
+
+        while (numFrames > 0)
+        {
+            const NfaThreads::Frame frame = frames[--numFrames];
+            if (frame.label == NfaThreads::RestoreFrameLabel)
+            {
+                slots[frame.slot] = frame.value;
+                continue;
+            }
+
+            Assert(frame.label < nfa->numInsts);
+            const NfaInst& inst = nfa->insts[frame.label];
+            const bool isParked = inst.IsConsuming() || inst.tag == NfaInst::NfaTag::Succ;
+            // Whether input has been consumed only matters until the thread reaches a consuming instruction
+            const uint state = 2 * frame.label + (!isParked && frame.consumed ? 1 : 0);
+            if (threads->visited[state] == generation)
+            {
+                // A higher priority thread has already been here
+                continue;
+            }
+            threads->visited[state] = generation;
+
+#define PUSH_FRAME(l, c) \
+            { \
+                Assert(numFrames < nfa->maxFrames); \
+                frames[numFrames].label = (l); \
+                frames[numFrames].consumed = (c); \
+                numFrames++; \
+            }
+#define PUSH_RESTORE_FRAME(s) \
+            { \
+                Assert(numFrames < nfa->maxFrames); \
+                frames[numFrames].label = NfaThreads::RestoreFrameLabel; \
+                frames[numFrames].slot = (s); \
+                frames[numFrames].value = slots[(s)]; \
+                numFrames++; \
+            }
+
+            switch (inst.tag)
+            {
+            case NfaInst::NfaTag::MatchChar:
+            case NfaInst::NfaTag::MatchSet:
+            case NfaInst::NfaTag::MatchNegatedSet:
+            case NfaInst::NfaTag::Succ:
+                {
+                    const uint n = threads->numThreads[list]++;
+                    Assert(n < threads->maxThreads);
+                    threads->labels[list][n] = frame.label;
+                    js_memcpy_s(threads->slots[list] + n * threads->numSlots, threads->numSlots * sizeof(CharCount), slots, threads->numSlots * sizeof(CharCount));
+                    break;
+                }
+            case NfaInst::NfaTag::BOITest:
+                if (inputOffset == 0)
+                {
+                    PUSH_FRAME(frame.label + 1, frame.consumed);
+                }
+                break;
+            case NfaInst::NfaTag::EOITest:
+                if (inputOffset == inputLength)
+                {
+                    PUSH_FRAME(frame.label + 1, frame.consumed);
+                }
+                break;
+            case NfaInst::NfaTag::BOLTest:
+                if (inputOffset == 0 || standardChars->IsNewline(input[inputOffset - 1]))
+                {
+                    PUSH_FRAME(frame.label + 1, frame.consumed);
+                }
+                break;
+            case NfaInst::NfaTag::EOLTest:
+                if (inputOffset == inputLength || standardChars->IsNewline(input[inputOffset]))
+                {
+                    PUSH_FRAME(frame.label + 1, frame.consumed);
+                }
+                break;
+            case NfaInst::NfaTag::WordBoundaryTest:
+            case NfaInst::NfaTag::NegatedWordBoundaryTest:
+                {
+                    const bool isNegation = inst.tag == NfaInst::NfaTag::NegatedWordBoundaryTest;
+                    const bool prev = inputOffset > 0 && standardChars->IsWord(input[inputOffset - 1]);
+                    const bool curr = inputOffset < inputLength && standardChars->IsWord(input[inputOffset]);
+                    if (isNegation != (prev != curr))
+                    {
+                        PUSH_FRAME(frame.label + 1, frame.consumed);
+                    }
+                    break;
+                }
+            case NfaInst::NfaTag::Fork:
+                // Pushed last, so explored first
+                PUSH_FRAME(inst.fork.other, frame.consumed);
+                PUSH_FRAME(inst.fork.preferred, frame.consumed);
+                break;
+            case NfaInst::NfaTag::Jump:
+                PUSH_FRAME(inst.target, frame.consumed);
+                break;
+            case NfaInst::NfaTag::BeginGroup:
+            case NfaInst::NfaTag::EndGroup:
+                {
+                    const uint slot = 2 * inst.groupId + (inst.tag == NfaInst::NfaTag::EndGroup ? 1 : 0);
+                    PUSH_RESTORE_FRAME(slot);
+                    slots[slot] = inputOffset;
+                    PUSH_FRAME(frame.label + 1, frame.consumed);
+                    break;
+                }
+            case NfaInst::NfaTag::ResetGroups:
+                for (int groupId = inst.groups.minGroupId; groupId <= inst.groups.maxGroupId; groupId++)
+                {
+                    PUSH_RESTORE_FRAME(2 * groupId);
+                    PUSH_RESTORE_FRAME(2 * groupId + 1);
+                    slots[2 * groupId] = CharCountFlag;
+                    slots[2 * groupId + 1] = CharCountFlag;
+                }
+                PUSH_FRAME(frame.label + 1, frame.consumed);
+                break;
+            case NfaInst::NfaTag::BeginIteration:
+                PUSH_FRAME(frame.label + 1, false);
+                break;
+            case NfaInst::NfaTag::EndIteration:
+                // An optional iteration which matched empty fails
+                if (frame.consumed)
+                {
+                    PUSH_FRAME(frame.label + 1, true);
+                }
+                break;
+            default:
+                Assert(false);
+                __assume(false);
+            }
+#undef PUSH_FRAME
+#undef PUSH_RESTORE_FRAME
+        }
+    }
+
+    bool Matcher::EnsureNfa()
+    {
+        if (program->rep.insts.nfa == nullptr && program->rep.insts.isNfaPending)
+        {
+            Compiler::CompileNfa(const_cast<Program*>(PointerValue(program)), pattern);
+        }
+        return program->rep.insts.nfa != nullptr;
+    }
+
+    bool Matcher::MatchLinear(const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, uint &qcTicks)
+    {
+        // Pike VM: advance all threads one input character at a time, so the work per character is bounded by the
+        // size of the NFA, and cut threads of lower priority than the first to succeed.
+        const NfaProgram* const nfa = program->rep.insts.nfa;
+        Assert(nfa != nullptr);
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        if (stats != 0)
+        {
+            stats->numLinearMatches++;
+        }
+#endif
+
+        if (nfaThreads == nullptr)
+        {
+            nfaThreads = NfaThreads::New(recycler, nfa, program->numGroups);
+        }
+        NfaThreads* const threads = nfaThreads;
+        const uint numSlots = threads->numSlots;
+
+        memset(threads->visited, 0, 2 * nfa->numInsts * sizeof(uint));
+        threads->numThreads[0] = 0;
+        threads->numThreads[1] = 0;
+
+        int curr = 0;
+        bool matched = false;
+        CharCount inputOffset = offset;
+        while (true)
+        {
+            if (!matched && (!isAnchored || inputOffset == offset))
+            {
+                // Start a new match attempt here, with lower priority than the attempts which started earlier
+                for (uint i = 0; i < numSlots; i++)
+                {
+                    threads->workingSlots[i] = CharCountFlag;
+                }
+                threads->workingSlots[0] = inputOffset;
+                AddLinearThread(input, inputLength, 0, false, inputOffset, curr);
+            }
+
+            if (threads->numThreads[curr] == 0 && (matched || isAnchored))
+            {
+                break;
+            }
+
+            const int next = 1 - curr;
+            threads->numThreads[next] = 0;
+            for (uint i = 0; i < threads->numThreads[curr]; i++)
+            {
+                const NfaInst& inst = nfa->insts[threads->labels[curr][i]];
+                const CharCount* const threadSlots = threads->slots[curr] + i * numSlots;
+#if ENABLE_REGEX_CONFIG_OPTIONS
+                CompStats();
+#endif
+                bool isMatch;
+                switch (inst.tag)
+                {
+                case NfaInst::NfaTag::MatchChar:
+                    {
+                        if (inputOffset >= inputLength)
+                        {
+                            isMatch = false;
+                            break;
+                        }
+                        const Char c = input[inputOffset];
+                        isMatch = c == inst.cs[0] || c == inst.cs[1] || c == inst.cs[2] || c == inst.cs[3];
+                        break;
+                    }
+                case NfaInst::NfaTag::MatchSet:
+                    isMatch = inputOffset < inputLength && nfa->sets[inst.setIndex].Get(input[inputOffset]);
+                    break;
+                case NfaInst::NfaTag::MatchNegatedSet:
+                    isMatch = inputOffset < inputLength && !nfa->sets[inst.setIndex].Get(input[inputOffset]);
+                    break;
+                case NfaInst::NfaTag::Succ:
+                    js_memcpy_s(threads->bestSlots, numSlots * sizeof(CharCount), threadSlots, numSlots * sizeof(CharCount));
+                    threads->bestSlots[1] = inputOffset;
+                    matched = true;
+                    isMatch = false;
+                    break;
+                default:
+                    Assert(false);
+                    __assume(false);
+                }
+
+                if (inst.tag == NfaInst::NfaTag::Succ)
+                {
+                    // All remaining threads have lower priority
+                    break;
+                }
+
+                if (isMatch)
+                {
+                    js_memcpy_s(threads->workingSlots, numSlots * sizeof(CharCount), threadSlots, numSlots * sizeof(CharCount));
+                    AddLinearThread(input, inputLength, threads->labels[curr][i] + 1, true, inputOffset + 1, next);
+                }
+            }
+
+            if (inputOffset >= inputLength)
+            {
+                break;
+            }
+            curr = next;
+            inputOffset++;
+            QueryContinue(qcTicks);
+        }
+
+        if (!matched)
+        {
+            groupInfos[0].Reset();
+            return false;
+        }
+
+        for (int groupId = 0; groupId < program->numGroups; groupId++)
+        {
+            GroupInfo* const info = GroupIdToGroupInfo(groupId);
+            const CharCount start = threads->bestSlots[2 * groupId];
+            const CharCount end = threads->bestSlots[2 * groupId + 1];
+            if (end == CharCountFlag)
+            {
+                info->Reset();
+            }
+            else
+            {
+                Assert(start != CharCountFlag && start <= end);
+                info->offset = start;
+                info->length = end - start;
+            }
+        }
+        return true;
+    }
+
     bool Matcher::Match
         ( const Char* const input
         , const CharCount inputLength
@@ -5498,6 +5794,17 @@ namespace UnifiedRegex
                 previousQcTime = 0;
                 uint qcTicks = 0;
 
+                if (CONFIG_FLAG(RegexBacktrackLimit) == 0 && EnsureNfa())
+                {
+                    res = MatchLinear(input, inputLength, offset, !loopMatchHere, qcTicks);
+                    break;
+                }
+
+                // The budget is shared by all the start offsets this match tries, so a search that backtracks a little at
+                // each of many offsets also ends up on the NFA
+                bool hasBudget = prog->rep.insts.nfa != nullptr || prog->rep.insts.isNfaPending;
+                backtrackBudget = hasBudget ? (uint)CONFIG_FLAG(RegexBacktrackLimit) : 0;
+
                 // This is the next offset in the input from where we will try to sync. For sync instructions that back up, this
                 // is used to avoid trying to sync when we have not yet reached the offset in the input we last synced to before
                 // backing up.
@@ -5508,13 +5815,45 @@ namespace UnifiedRegex
                 // Need to continue matching even if matchStart == inputLim since some patterns may match an empty string at the end
                 // of the input. For instance: /a*$/.exec("b")
                 bool firstIteration = true;
-                do
+                while (true)
                 {
                     // Let there be only one call to MatchHere(), as that call expands the interpreter loop in-place. Having
                     // multiple calls to MatchHere() would bloat the code.
                     res = MatchHere(input, inputLength, offset, nextSyncInputOffset, regexStacks->contStack, regexStacks->assertionStack, qcTicks, firstIteration);
                     firstIteration = false;
-                } while(!res && loopMatchHere && ++offset <= inputLength);
+                    if (res)
+                    {
+                        break;
+                    }
+
+                    if (hasBudget && backtrackBudget == 0)
+                    {
+                        // Backtracking ran out of budget while trying to match at offset, having ruled out all earlier start
+                        // offsets. Finish the search in linear time.
+                        if (EnsureNfa())
+                        {
+#if ENABLE_REGEX_CONFIG_OPTIONS
+                            if (stats != 0)
+                            {
+                                stats->numLinearFallbacks++;
+                            }
+#endif
+                            res = MatchLinear(input, inputLength, offset, !loopMatchHere, qcTicks);
+                            break;
+                        }
+
+                        // The pattern doesn't fit in an NFA after all. Start over at offset without a budget.
+                        hasBudget = false;
+                        nextSyncInputOffset = offset;
+                        firstIteration = true;
+                        continue;
+                    }
+
+                    if (!loopMatchHere || ++offset > inputLength)
+                    {
+                        break;
+                    }
+                }
 
                 break;
             }
@@ -5668,6 +6007,8 @@ namespace UnifiedRegex
         rep.insts.litbuf = nullptr;
         rep.insts.litbufLen = 0;
         rep.insts.scannersForSyncToLiterals = nullptr;
+        rep.insts.nfa = nullptr;
+        rep.insts.isNfaPending = false;
     }
 
     Program *Program::New(Recycler *recycler, RegexFlags flags)
@@ -5707,6 +6048,12 @@ namespace UnifiedRegex
 
     void Program::FreeBody(ArenaAllocator* rtAllocator)
     {
+        if ((tag == ProgramTag::InstructionsTag || tag == ProgramTag::BOIInstructionsTag || tag == ProgramTag::BOIInstructionsForStickyFlagTag)
+            && rep.insts.nfa)
+        {
+            rep.insts.nfa->FreeBody(rtAllocator);
+        }
+
         if (tag != ProgramTag::InstructionsTag || !rep.insts.insts)
         {
             return;
@@ -5822,6 +6169,10 @@ namespace UnifiedRegex
                 }
                 w->Unindent();
                 w->PrintEOL(_u("}"));
+                if (rep.insts.nfa)
+                {
+                    rep.insts.nfa->Print(w);
+                }
             }
             break;
         case ProgramTag::SingleCharTag:
@@ -11,12 +11,15 @@
 namespace UnifiedRegex
 {
     typedef CharCount Label;
+    typedef uint32 NfaLabel;
 
     // FORWARD
     struct ScannerInfo;
     class ContStack;
     class AssertionStack;
     class OctoquadMatcher;
+    class NfaProgram;
+    struct NfaThreads;
 
     enum class ChompMode : uint8
     {
@@ -93,6 +96,12 @@ namespace UnifiedRegex
             // ever be only one of those instructions per program. Since scanners are large (> 1 KB), for that instruction they
             // are allocated on the recycler with pointers stored here to reference them.
             Field(Field(ScannerInfo *)*) scannersForSyncToLiterals;
+
+            // Linear-time equivalent of the instructions, used once backtracking exceeds its budget. In run-time
+            // allocator, owned by program, null until first needed or if the pattern isn't eligible.
+            Field(NfaProgram*) nfa;
+            // The pattern is eligible for an NFA which hasn't been built yet
+            Field(bool) isNfaPending;
         };
 
         struct SingleChar
@@ -145,7 +154,9 @@ namespace UnifiedRegex
         static size_t GetOffsetOfTag() { return offsetof(Program, tag); }
         static size_t GetOffsetOfRep() { return offsetof(Program, rep); }
         static size_t GetOffsetOfBOILiteral2Literal() { return offsetof(BOILiteral2, literal); }
+        static size_t GetOffsetOfInstructionsInsts() { return offsetof(Instructions, insts); }
         static ProgramTag GetBOILiteral2Tag() { return ProgramTag::BOILiteral2Tag; }
+        static ProgramTag GetInstructionsTag() { return ProgramTag::InstructionsTag; }
 
         Field(ScannerInfo *)*CreateScannerArrayForSyncToLiterals(Recycler *const recycler);
         ScannerInfo *AddScannerForSyncToLiterals(
@@ -713,6 +724,8 @@ namespace UnifiedRegex
         inline Inst(InstTag tag) : tag(tag) {}
         void FreeBody(ArenaAllocator* rtAllocator) {}
 
+        static size_t GetOffsetOfTag() { return offsetof(Inst, tag); }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         static bool IsBaselineMode();
         static Label GetPrintLabel(Label label);
@@ -1046,6 +1059,8 @@ namespace UnifiedRegex
     {
         inline SyncToCharAndConsumeInst(Char c) : Inst(InstTag::SyncToCharAndConsume), CharMixin(c) {}
 
+        static size_t GetOffsetOfChar() { return offsetof(SyncToCharAndConsumeInst, c); }
+
         INST_BODY
     };
 
@@ -1121,6 +1136,9 @@ namespace UnifiedRegex
     {
         inline SyncToCharAndBackupInst(Char c, const CountDomain& backup) : Inst(InstTag::SyncToCharAndBackup), CharMixin(c), BackupMixin(backup) {}
 
+        static size_t GetOffsetOfChar() { return offsetof(SyncToCharAndBackupInst, c); }
+        static size_t GetOffsetOfBackupUpper() { return offsetof(SyncToCharAndBackupInst, backup) + offsetof(CountDomain, upper); }
+
         INST_BODY
     };
 
@@ -1822,6 +1840,12 @@ namespace UnifiedRegex
 
         Field(uint) previousQcTime;
 
+        // Continuation pops left, across all the start offsets the current match tries, before it gives up on
+        // backtracking and switches to the program's NFA. Zero if there is no limit.
+        Field(uint) backtrackBudget;
+        // Scratch space for matching with the program's NFA, allocated on first use
+        Field(NfaThreads*) nfaThreads;
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         FieldNoBarrier(RegexStats*) stats;
         FieldNoBarrier(DebugWriter*) w;
@@ -1948,6 +1972,12 @@ namespace UnifiedRegex
         // Specialized matcher for regex ^literal
         inline bool MatchBOILiteral2(const Char * const input, const CharCount inputLength, CharCount offset, DWORD literal2);
 
+        // Build the program's NFA the first time it is needed. Returns false if the program has none.
+        bool EnsureNfa();
+        // Linear-time matcher using the program's NFA. If isAnchored, only try a match starting at offset.
+        bool MatchLinear(const Char* const input, const CharCount inputLength, CharCount offset, bool isAnchored, uint &qcTicks);
+        void AddLinearThread(const Char* const input, const CharCount inputLength, NfaLabel label, bool consumed, CharCount inputOffset, int list);
+
         void SaveInnerGroups(const int fromGroupId, const int toGroupId, const bool reset, const Char *const input, ContStack &contStack);
         void DoSaveInnerGroups(const int fromGroupId, const int toGroupId, const bool reset, const Char *const input, ContStack &contStack);
         void SaveInnerGroups_AllUndefined(const int fromGroupId, const int toGroupId, const Char *const input, ContStack &contStack);
@@ -19,6 +19,8 @@ namespace UnifiedRegex
         , numPops(0)
         , stackHWM(0)
         , numInsts(0)
+        , numLinearMatches(0)
+        , numLinearFallbacks(0)
     {
         for (int i = 0; i < NumPhases; i++)
             phaseTicks[i] = 0;
@@ -113,6 +115,25 @@ namespace UnifiedRegex
             w->PrintEOL(_u("numInsts    : %10I64u   (%10.4f%%)"), numInsts, pc);
         }
 
+        if (numLinearMatches > 0)
+        {
+            if (totals == 0 || totals->numLinearMatches == 0)
+                w->PrintEOL(_u("numLinear   : %10I64u"), numLinearMatches);
+            else
+            {
+                double pc = (double)numLinearMatches * 100.0 / (double)totals->numLinearMatches;
+                w->PrintEOL(_u("numLinear   : %10I64u   (%10.4f%%)"), numLinearMatches, pc);
+            }
+
+            if (totals == 0 || totals->numLinearFallbacks == 0)
+                w->PrintEOL(_u("numFallbacks: %10I64u"), numLinearFallbacks);
+            else
+            {
+                double pc = (double)numLinearFallbacks * 100.0 / (double)totals->numLinearFallbacks;
+                w->PrintEOL(_u("numFallbacks: %10I64u   (%10.4f%%)"), numLinearFallbacks, pc);
+            }
+        }
+
         w->Unindent();
     }
 
@@ -129,6 +150,8 @@ namespace UnifiedRegex
         if (other->stackHWM > stackHWM)
             stackHWM = other->stackHWM;
         numInsts += other->numInsts;
+        numLinearMatches += other->numLinearMatches;
+        numLinearFallbacks += other->numLinearFallbacks;
     }
 
     RegexStats::Ticks RegexStatsDatabase::Now()
@@ -52,6 +52,10 @@ namespace UnifiedRegex
         uint64 stackHWM;
         // Number of instructions executed
         uint64 numInsts;
+        // Number of match attempts run by the linear-time NFA matcher
+        uint64 numLinearMatches;
+        // Number of those attempts which fell back from the backtracking matcher after exceeding the backtrack limit
+        uint64 numLinearFallbacks;
 
         RegexStats(RegexPattern* pattern);
 
@@ -67,6 +67,115 @@ IdentPtr Token::CreateIdentifier(HashTbl * hashTbl)
     return pid;
 }
 
+#if ENABLE_SSE2_FAST_PATHS
+// Skip loops for the longest runs the scanner sees: identifier characters, string and comment bodies, and
+// whitespace. Each one returns the first position at or after p that the scalar scanner has to look at,
+// checking sixteen bytes at a time with SSE2. They stop before the last sixteen
+// bytes of the source, which keeps every load within the buffer and leaves the tail to the scalar loops.
+// Non-ASCII bytes always stop a run, so none of them changes the scanner's multi-unit count.
+static const ptrdiff_t ScannerSimdBytes = sizeof(__m128i);
+
+static inline LPCUTF8 FirstSimdStop(LPCUTF8 p, int mask)
+{
+    DWORD index;
+    _BitScanForward(&index, (DWORD)mask);
+    return p + index;
+}
+
+// [A-Za-z0-9_$]. Bytes above 0x7F are negative as signed chars, so they fail every range check.
+static LPCUTF8 SkipAsciiIdentifierRun(LPCUTF8 p, LPCUTF8 last)
+{
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i beforeLowerA = _mm_set1_epi8('a' - 1);
+    const __m128i afterLowerZ = _mm_set1_epi8('z' + 1);
+    const __m128i beforeZero = _mm_set1_epi8('0' - 1);
+    const __m128i afterNine = _mm_set1_epi8('9' + 1);
+    const __m128i underscore = _mm_set1_epi8('_');
+    const __m128i dollar = _mm_set1_epi8('$');
+    while (last - p >= ScannerSimdBytes)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i lower = _mm_or_si128(bytes, caseBit);
+        const __m128i idChars = _mm_or_si128(
+            _mm_or_si128(
+                _mm_and_si128(_mm_cmpgt_epi8(lower, beforeLowerA), _mm_cmplt_epi8(lower, afterLowerZ)),
+                _mm_and_si128(_mm_cmpgt_epi8(bytes, beforeZero), _mm_cmplt_epi8(bytes, afterNine))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, underscore), _mm_cmpeq_epi8(bytes, dollar)));
+        const int mask = ~_mm_movemask_epi8(idChars) & 0xFFFF;
+        if (mask != 0)
+        {
+            return FirstSimdStop(p, mask);
+        }
+        p += ScannerSimdBytes;
+    }
+    return p;
+}
+
+// String literal bodies stop at the delimiter, a backslash, a control character (line breaks and the
+// terminating null among them) or a non-ASCII byte. Template literals also stop at '$'.
+static LPCUTF8 SkipStringRun(LPCUTF8 p, LPCUTF8 last, char delim, bool stopAtDollar)
+{
+    const __m128i quote = _mm_set1_epi8(delim);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i dollar = _mm_set1_epi8(stopAtDollar ? '$' : delim);
+    const __m128i firstPrintable = _mm_set1_epi8(0x20);
+    while (last - p >= ScannerSimdBytes)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, dollar), _mm_cmplt_epi8(bytes, firstPrintable))));
+        if (mask != 0)
+        {
+            return FirstSimdStop(p, mask);
+        }
+        p += ScannerSimdBytes;
+    }
+    return p;
+}
+
+// Comment bodies stop at a line break, a null or a non-ASCII byte (which may be LS or PS). Block comments
+// also stop at '*'.
+static LPCUTF8 SkipCommentRun(LPCUTF8 p, LPCUTF8 last, bool stopAtStar)
+{
+    const __m128i lineFeed = _mm_set1_epi8(0x0A);
+    const __m128i carriageReturn = _mm_set1_epi8(0x0D);
+    const __m128i star = _mm_set1_epi8(stopAtStar ? '*' : 0x0A);
+    const __m128i zero = _mm_setzero_si128();
+    while (last - p >= ScannerSimdBytes)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, lineFeed), _mm_cmpeq_epi8(bytes, carriageReturn)),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, star), _mm_cmpeq_epi8(bytes, zero)))) | _mm_movemask_epi8(bytes);
+        if (mask != 0)
+        {
+            return FirstSimdStop(p, mask);
+        }
+        p += ScannerSimdBytes;
+    }
+    return p;
+}
+
+// Spaces and tabs, as in indentation
+static LPCUTF8 SkipWhitespaceRun(LPCUTF8 p, LPCUTF8 last)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8(0x09);
+    while (last - p >= ScannerSimdBytes)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = ~_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, space), _mm_cmpeq_epi8(bytes, tab))) & 0xFFFF;
+        if (mask != 0)
+        {
+            return FirstSimdStop(p, mask);
+        }
+        p += ScannerSimdBytes;
+    }
+    return p;
+}
+#endif
+
 template <typename EncodingPolicy>
 Scanner<EncodingPolicy>::Scanner(Parser* parser, Token *ptoken, Js::ScriptContext* scriptContext)
 {
@@ -435,6 +544,9 @@ BOOL Scanner<EncodingPolicy>::FastIdentifierContinue(EncodedCharPtr&p, EncodedCh
 {
     if (EncodingPolicy::MultiUnitEncoding)
     {
+#if ENABLE_SSE2_FAST_PATHS
+        p = SkipAsciiIdentifierRun(p, last);
+#endif
         while (p < last)
         {
             EncodedChar currentChar = *p;
@@ -1051,6 +1163,19 @@ tokens Scanner<EncodingPolicy>::ScanStringConstant(OLECHAR delim, EncodedCharPtr
 
     for (;;)
     {
+#if ENABLE_SSE2_FAST_PATHS
+        if (EncodingPolicy::MultiUnitEncoding)
+        {
+            EncodedCharPtr runEnd = SkipStringRun(p, last, (char)delim, stringTemplateMode);
+            if (runEnd != p)
+            {
+                m_tempChBuf.AppendAsciiRun(p, (uint32)(runEnd - p));
+                m_tempChBufSecondary.template AppendAsciiRun<createRawString>(p, (uint32)(runEnd - p));
+                p = runEnd;
+            }
+        }
+#endif
+
         switch ((rawch = ch = this->ReadFirst(p, last)))
         {
         case kchRET:
@@ -1453,6 +1578,13 @@ tokens Scanner<EncodingPolicy>::SkipComment(EncodedCharPtr *pp, /* out */ bool*
 
     for (;;)
     {
+#if ENABLE_SSE2_FAST_PATHS
+        if (EncodingPolicy::MultiUnitEncoding)
+        {
+            p = SkipCommentRun(p, last, true /*stopAtStar*/);
+        }
+#endif
+
         switch((ch = this->ReadFirst(p, last)))
         {
         case '*':
@@ -1702,6 +1834,12 @@ tokens Scanner<EncodingPolicy>::ScanCore(bool identifyKwds)
         case 0x000C:
         case 0x0020:
             Assert(chType == _C_WSP);
+#if ENABLE_SSE2_FAST_PATHS
+            if (EncodingPolicy::MultiUnitEncoding)
+            {
+                p = SkipWhitespaceRun(p, last);
+            }
+#endif
             continue;
 
         case '.':
@@ -1986,6 +2124,13 @@ tokens Scanner<EncodingPolicy>::ScanCore(bool identifyKwds)
                 pchT = NULL;
                 for (;;)
                 {
+#if ENABLE_SSE2_FAST_PATHS
+                    if (EncodingPolicy::MultiUnitEncoding)
+                    {
+                        p = SkipCommentRun(p, last, false /*stopAtStar*/);
+                    }
+#endif
+
                     switch ((ch = this->ReadFirst(p, last)))
                     {
                     case kchLS:         // 0x2028, classifies as new line
@@ -676,6 +676,31 @@ class Scanner : public IScanner, public EncodingPolicy
             }
         }
 
+        // Appends cch ASCII characters, which need no decoding
+        void AppendAsciiRun(LPCUTF8 pch, uint32 cch)
+        {
+            return AppendAsciiRun<true>(pch, cch);
+        }
+
+        template<bool performAppend> void AppendAsciiRun(LPCUTF8 pch, uint32 cch)
+        {
+            if (performAppend)
+            {
+                while (m_cchMax - m_ichCur < cch)
+                {
+                    Grow();
+                }
+
+                OLECHAR* dst = m_prgch + m_ichCur;
+                for (uint32 i = 0; i < cch; i++)
+                {
+                    Assert(pch[i] < 0x80);
+                    dst[i] = static_cast<OLECHAR>(pch[i]);
+                }
+                m_ichCur += cch;
+            }
+        }
+
     private:
         void Grow()
         {
@@ -5195,7 +5195,7 @@ namespace Js
                 sourceContextInfo->sourceDynamicProfileManager->RemoveDynamicProfileInfo(GetFunctionInfo()->GetLocalFunctionId());
             }
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
             DynamicProfileInfoList * profileInfoList = GetScriptContext()->GetProfileInfoList();
             if (profileInfoList)
             {
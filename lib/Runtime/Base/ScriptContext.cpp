@@ -1277,8 +1277,8 @@ namespace Js
     {
 
 #if ENABLE_PROFILE_INFO
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
-        if (DynamicProfileInfo::NeedProfileInfoList())
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
+        if (DynamicProfileInfo::NeedProfileInfoList(this))
         {
             this->Cache()->profileInfoList = RecyclerNew(this->GetRecycler(), DynamicProfileInfoList);
         }
@@ -1457,7 +1457,10 @@ namespace Js
                     DynamicProfileInfo::Save(this);
                 }
                 END_TRANSLATE_OOM_TO_HRESULT(hr);
+#endif
 
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
+                // The saving maps are heap allocated and the profile managers are never finalized
                 if (this->Cache()->sourceContextInfoMap)
                 {
                     this->Cache()->sourceContextInfoMap->Map([&](DWORD_PTR dwHostSourceContext, SourceContextInfo * sourceContextInfo)
@@ -1470,7 +1473,7 @@ namespace Js
                 }
 #endif
 
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
                 this->ClearDynamicProfileList();
 #endif
 #endif
@@ -3949,7 +3952,7 @@ namespace Js
         }
 
 #if ENABLE_PROFILE_INFO
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         // Reset the dynamic profile list
         if (this->Cache()->profileInfoList)
         {
@@ -5746,7 +5749,7 @@ ScriptContext::GetJitFuncRangeCache()
                 dynamicProfileInfo = newDynamicProfileInfo;
             }
             Assert(functionBody->GetInterpretedCount() == 0);
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
 
             if (this->Cache()->profileInfoList)
             {
@@ -1146,7 +1146,7 @@ namespace Js
 #endif
 
 #if ENABLE_PROFILE_INFO
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         void ClearDynamicProfileList()
         {
             if (this->Cache()->profileInfoList)
@@ -530,7 +530,10 @@ ThreadContext::~ThreadContext()
 
 #if ENABLE_CONCURRENT_GC && defined(_WIN32)
         AssertOrFailFastMsg(recycler->concurrentThread == NULL, "Recycler background thread should have been shutdown before destroying Recycler.");
-        AssertOrFailFastMsg((recycler->parallelThread1.concurrentThread == NULL) && (recycler->parallelThread2.concurrentThread == NULL), "Recycler parallelThread(s) should have been shutdown before destroying Recycler.");
+        for (uint i = 0; i < recycler->parallelMarkHelperCount; i++)
+        {
+            AssertOrFailFastMsg(recycler->parallelMarkHelpers[i]->parallelThread.concurrentThread == NULL, "Recycler parallelThread(s) should have been shutdown before destroying Recycler.");
+        }
 #endif
 
         HeapDelete(recycler);
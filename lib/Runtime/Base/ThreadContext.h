@@ -46,6 +46,7 @@ enum ThreadContextFlags
     ThreadContextFlagNoJIT                         = 0x00000004,
     ThreadContextFlagDisableFatalOnOOM             = 0x00000008,
     ThreadContextFlagNoDynamicThunks               = 0x00000010,
+    ThreadContextFlagPersistDynamicProfiles        = 0x00000020,
 };
 
 const int LS_MAX_STACK_SIZE_KB = 300;
@@ -1005,6 +1006,11 @@ class ThreadContext sealed :
         return this->TestThreadContextFlag(ThreadContextFlagNoDynamicThunks);
     }
 
+    bool PersistsDynamicProfiles() const
+    {
+        return this->TestThreadContextFlag(ThreadContextFlagPersistDynamicProfiles);
+    }
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     Js::Var GetMemoryStat(Js::ScriptContext* scriptContext);
     void SetAutoProxyName(LPCWSTR objectName);
@@ -1071,6 +1077,9 @@ class ThreadContext sealed :
         TTD::TTDWriteBytesToStreamCallback writeBytesToStreamfp, TTD::TTDFlushAndCloseStreamCallback flushAndCloseStreamfp,
         TTD::TTDCreateExternalObjectCallback createExternalObjectfp,
         TTD::TTDCreateJsRTContextCallback createJsRTContextCallbackfp, TTD::TTDReleaseJsRTContextCallback releaseJsRTContextCallbackfp, TTD::TTDSetActiveJsRTContext fpSetActiveJsRTContext);
+
+    //A startup snapshot brings its sources (and their ids) along so new sources need to be numbered after them
+    void SetSourceInfoCountForStartupSnapshot_TTD(uint count) { this->sourceInfoCount = max(this->sourceInfoCount, count); }
 #endif
 
     BOOL ReserveStaticTypeIds(__in int first, __in int last);
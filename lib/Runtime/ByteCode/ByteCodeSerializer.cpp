@@ -4451,6 +4451,11 @@ class ByteCodeBufferReader
             }
 #endif
 
+#if ENABLE_PROFILE_INFO
+            // Pick up the profile the host loaded for this script, as the byte code writer does
+            (*functionBody)->LoadDynamicProfileInfo();
+#endif
+
 #if ENABLE_NATIVE_CODEGEN
             if ((!PHASE_OFF(Js::BackEndPhase, *functionBody))
                 && !this->scriptContext->GetConfig()->IsNoNative()
@@ -4998,6 +5003,20 @@ HRESULT ByteCodeSerializer::SerializeToBuffer(ScriptContext * scriptContext, Are
     return hr;
 }
 
+bool ByteCodeSerializer::IsCompleteBuffer(const byte * buffer, size_t bufferBytes)
+{
+    int magic;
+    int totalSize;
+    if (buffer == nullptr || bufferBytes < sizeof(magic) + sizeof(totalSize))
+    {
+        return false;
+    }
+
+    js_memcpy_s(&magic, sizeof(magic), buffer, sizeof(magic));
+    js_memcpy_s(&totalSize, sizeof(totalSize), buffer + sizeof(magic), sizeof(totalSize));
+    return magic == magicConstant && totalSize >= 0 && (size_t)totalSize == bufferBytes;
+}
+
 HRESULT ByteCodeSerializer::DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, LPCUTF8 utf8Source, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, Field(FunctionBody*)* function, uint sourceIndex)
 {
     return ByteCodeSerializer::DeserializeFromBufferInternal(scriptContext, scriptFlags, utf8Source, /* sourceHolder */ nullptr, srcInfo, buffer, nativeModule, function, sourceIndex);
@@ -181,6 +181,10 @@ namespace Js
         static HRESULT DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, LPCUTF8 utf8Source, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, Field(FunctionBody*)* function, uint sourceIndex = Js::Constants::InvalidSourceIndex);
         static HRESULT DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, ISourceHolder* sourceHolder, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, Field(FunctionBody*)* function, uint sourceIndex = Js::Constants::InvalidSourceIndex);
 
+        // Returns true if the buffer starts with a byte code header and is exactly as long as the header says. Used to
+        // reject truncated or foreign files before handing them to DeserializeFromBuffer.
+        static bool IsCompleteBuffer(const byte * buffer, size_t bufferBytes);
+
         static FunctionBody* DeserializeFunction(ScriptContext* scriptContext, DeferDeserializeFunctionInfo* deferredFunction);
 
         // Deserialize a string from the string table based on the stringId.
@@ -647,7 +647,11 @@ namespace TTD
         }
 
         this->ParseLogInto(iofp, parseUri, parseUriLength);
+        this->InflateParsedPropertyRecords();
+    }
 
+    void EventLog::InflateParsedPropertyRecords()
+    {
         Js::PropertyId maxPid = TotalNumberOfBuiltInProperties + 1;
         JsUtil::BaseDictionary<Js::PropertyId, NSSnapType::SnapPropertyRecord*, HeapAllocator> pidMap(&HeapAllocator::Instance);
 
@@ -1485,6 +1489,36 @@ namespace TTD
         return -1;
     }
 
+    uint32 EventLog::InitializeTopLevelScriptMaps(TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo*>& topLevelLoadScriptMap,
+        TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelNewFunctionBodyResolveInfo*>& topLevelNewScriptMap,
+        TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelEvalFunctionBodyResolveInfo*>& topLevelEvalScriptMap) const
+    {
+        uint32 dbgScopeCount = 0;
+
+        topLevelLoadScriptMap.Initialize(this->m_loadedTopLevelScripts.Count());
+        for(auto iter = this->m_loadedTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            topLevelLoadScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
+            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
+        }
+
+        topLevelNewScriptMap.Initialize(this->m_newFunctionTopLevelScripts.Count());
+        for(auto iter = this->m_newFunctionTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            topLevelNewScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
+            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
+        }
+
+        topLevelEvalScriptMap.Initialize(this->m_evalTopLevelScripts.Count());
+        for(auto iter = this->m_evalTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            topLevelEvalScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
+            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
+        }
+
+        return dbgScopeCount;
+    }
+
     void EventLog::DoSnapshotInflate(int64 etime)
     {
         this->PushMode(TTDMode::ExcludedExecutionTTAction);
@@ -1522,32 +1556,11 @@ namespace TTD
         }
         TTDAssert(snap != nullptr, "Log should start with a snapshot!!!");
 
-        uint32 dbgScopeCount = snap->GetDbgScopeCountNonTopLevel();
-
         TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo*> topLevelLoadScriptMap;
-        topLevelLoadScriptMap.Initialize(this->m_loadedTopLevelScripts.Count());
-        for(auto iter = this->m_loadedTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            topLevelLoadScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
-            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
-        }
-
         TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelNewFunctionBodyResolveInfo*> topLevelNewScriptMap;
-        topLevelNewScriptMap.Initialize(this->m_newFunctionTopLevelScripts.Count());
-        for(auto iter = this->m_newFunctionTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            topLevelNewScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
-            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
-        }
-
         TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelEvalFunctionBodyResolveInfo*> topLevelEvalScriptMap;
-        topLevelEvalScriptMap.Initialize(this->m_evalTopLevelScripts.Count());
-        for(auto iter = this->m_evalTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            topLevelEvalScriptMap.AddItem(iter.Current()->TopLevelBase.TopLevelBodyCtr, iter.Current());
-            dbgScopeCount += iter.Current()->TopLevelBase.ScopeChainInfo.ScopeCount;
-        }
 
+        uint32 dbgScopeCount = snap->GetDbgScopeCountNonTopLevel() + this->InitializeTopLevelScriptMaps(topLevelLoadScriptMap, topLevelNewScriptMap, topLevelEvalScriptMap);
         uint32 topFunctionCount = topLevelLoadScriptMap.Count() + topLevelNewScriptMap.Count() + topLevelEvalScriptMap.Count();
 
         ThreadContextTTD* threadCtx = this->m_threadContext->TTDContext;
@@ -2582,6 +2595,113 @@ namespace TTD
         return this->m_autoTracesEnabled;
     }
 
+    void EventLog::EmitPropertyAndTopLevelScriptInfo(FileWriter* writer)
+    {
+        //emit the properties
+        writer->WriteLengthValue(this->m_propertyRecordPinSet->Count(), NSTokens::Separator::CommaSeparator);
+
+        writer->WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
+        writer->AdjustIndent(1);
+        bool firstProperty = true;
+        for(auto iter = this->m_propertyRecordPinSet->GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            NSTokens::Separator sep = (!firstProperty) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
+            NSSnapType::EmitPropertyRecordAsSnapPropertyRecord(iter.CurrentValue(), writer, sep);
+
+            firstProperty = false;
+        }
+        writer->AdjustIndent(-1);
+        writer->WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
+
+        //do top level script processing here
+        writer->WriteUInt32(NSTokens::Key::u32Val, this->m_sourceInfoCount, NSTokens::Separator::CommaSeparator);
+
+        writer->WriteLengthValue(this->m_loadedTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
+        writer->WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
+        writer->AdjustIndent(1);
+        bool firstLoadScript = true;
+        for(auto iter = this->m_loadedTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            NSTokens::Separator sep = (!firstLoadScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
+            NSSnapValues::EmitTopLevelLoadedFunctionBodyInfo(iter.Current(), this->m_threadContext, writer, sep);
+
+            firstLoadScript = false;
+        }
+        writer->AdjustIndent(-1);
+        writer->WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
+
+        writer->WriteLengthValue(this->m_newFunctionTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
+        writer->WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
+        writer->AdjustIndent(1);
+        bool firstNewScript = true;
+        for(auto iter = this->m_newFunctionTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            NSTokens::Separator sep = (!firstNewScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
+            NSSnapValues::EmitTopLevelNewFunctionBodyInfo(iter.Current(), this->m_threadContext, writer, sep);
+
+            firstNewScript = false;
+        }
+        writer->AdjustIndent(-1);
+        writer->WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
+
+        writer->WriteLengthValue(this->m_evalTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
+        writer->WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
+        writer->AdjustIndent(1);
+        bool firstEvalScript = true;
+        for(auto iter = this->m_evalTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
+        {
+            NSTokens::Separator sep = (!firstEvalScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
+            NSSnapValues::EmitTopLevelEvalFunctionBodyInfo(iter.Current(), this->m_threadContext, writer, sep);
+
+            firstEvalScript = false;
+        }
+        writer->AdjustIndent(-1);
+        writer->WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
+    }
+
+    void EventLog::ParsePropertyAndTopLevelScriptInfo(FileReader* reader)
+    {
+        //parse the properties
+        uint32 propertyCount = reader->ReadLengthValue(true);
+        reader->ReadSequenceStart_WDefaultKey(true);
+        for(uint32 i = 0; i < propertyCount; ++i)
+        {
+            NSSnapType::SnapPropertyRecord* sRecord = this->m_propertyRecordList.NextOpenEntry();
+            NSSnapType::ParseSnapPropertyRecord(sRecord, i != 0, reader, this->m_miscSlabAllocator);
+        }
+        reader->ReadSequenceEnd();
+
+        //do top level script processing here
+        this->m_sourceInfoCount = reader->ReadUInt32(NSTokens::Key::u32Val, true);
+
+        uint32 loadedScriptCount = reader->ReadLengthValue(true);
+        reader->ReadSequenceStart_WDefaultKey(true);
+        for(uint32 i = 0; i < loadedScriptCount; ++i)
+        {
+            NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo* fbInfo = this->m_loadedTopLevelScripts.NextOpenEntry();
+            NSSnapValues::ParseTopLevelLoadedFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, reader, this->m_miscSlabAllocator);
+        }
+        reader->ReadSequenceEnd();
+
+        uint32 newScriptCount = reader->ReadLengthValue(true);
+        reader->ReadSequenceStart_WDefaultKey(true);
+        for(uint32 i = 0; i < newScriptCount; ++i)
+        {
+            NSSnapValues::TopLevelNewFunctionBodyResolveInfo* fbInfo = this->m_newFunctionTopLevelScripts.NextOpenEntry();
+            NSSnapValues::ParseTopLevelNewFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, reader, this->m_miscSlabAllocator);
+        }
+        reader->ReadSequenceEnd();
+
+        uint32 evalScriptCount = reader->ReadLengthValue(true);
+        reader->ReadSequenceStart_WDefaultKey(true);
+        for(uint32 i = 0; i < evalScriptCount; ++i)
+        {
+            NSSnapValues::TopLevelEvalFunctionBodyResolveInfo* fbInfo = this->m_evalTopLevelScripts.NextOpenEntry();
+            NSSnapValues::ParseTopLevelEvalFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, reader, this->m_miscSlabAllocator);
+        }
+        reader->ReadSequenceEnd();
+    }
+
     void EventLog::EmitLog(const char* emitUri, size_t emitUriLength, NSLogEvents::EventLogEntry* optInnerLoopEvent)
     {
 #if ENABLE_BASIC_TRACE || ENABLE_FULL_BC_TRACE
@@ -2725,67 +2845,7 @@ namespace TTD
         writer.AdjustIndent(-1);
         writer.WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
 
-        //emit the properties
-        writer.WriteLengthValue(this->m_propertyRecordPinSet->Count(), NSTokens::Separator::CommaSeparator);
-
-        writer.WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
-        writer.AdjustIndent(1);
-        bool firstProperty = true;
-        for(auto iter = this->m_propertyRecordPinSet->GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            NSTokens::Separator sep = (!firstProperty) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
-            NSSnapType::EmitPropertyRecordAsSnapPropertyRecord(iter.CurrentValue(), &writer, sep);
-
-            firstProperty = false;
-        }
-        writer.AdjustIndent(-1);
-        writer.WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
-
-        //do top level script processing here
-        writer.WriteUInt32(NSTokens::Key::u32Val, this->m_sourceInfoCount, NSTokens::Separator::CommaSeparator);
-
-        writer.WriteLengthValue(this->m_loadedTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
-        writer.WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
-        writer.AdjustIndent(1);
-        bool firstLoadScript = true;
-        for(auto iter = this->m_loadedTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            NSTokens::Separator sep = (!firstLoadScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
-            NSSnapValues::EmitTopLevelLoadedFunctionBodyInfo(iter.Current(), this->m_threadContext, &writer, sep);
-
-            firstLoadScript = false;
-        }
-        writer.AdjustIndent(-1);
-        writer.WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
-
-        writer.WriteLengthValue(this->m_newFunctionTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
-        writer.WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
-        writer.AdjustIndent(1);
-        bool firstNewScript = true;
-        for(auto iter = this->m_newFunctionTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            NSTokens::Separator sep = (!firstNewScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
-            NSSnapValues::EmitTopLevelNewFunctionBodyInfo(iter.Current(), this->m_threadContext, &writer, sep);
-
-            firstNewScript = false;
-        }
-        writer.AdjustIndent(-1);
-        writer.WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
-
-        writer.WriteLengthValue(this->m_evalTopLevelScripts.Count(), NSTokens::Separator::CommaSeparator);
-        writer.WriteSequenceStart_DefaultKey(NSTokens::Separator::CommaSeparator);
-        writer.AdjustIndent(1);
-        bool firstEvalScript = true;
-        for(auto iter = this->m_evalTopLevelScripts.GetIterator(); iter.IsValid(); iter.MoveNext())
-        {
-            NSTokens::Separator sep = (!firstEvalScript) ? NSTokens::Separator::CommaAndBigSpaceSeparator : NSTokens::Separator::BigSpaceSeparator;
-            NSSnapValues::EmitTopLevelEvalFunctionBodyInfo(iter.Current(), this->m_threadContext, &writer, sep);
-
-            firstEvalScript = false;
-        }
-        writer.AdjustIndent(-1);
-        writer.WriteSequenceEnd(NSTokens::Separator::BigSpaceSeparator);
-        //
+        this->EmitPropertyAndTopLevelScriptInfo(&writer);
 
         writer.AdjustIndent(-1);
         writer.WriteRecordEnd(NSTokens::Separator::BigSpaceSeparator);
@@ -2889,51 +2949,511 @@ namespace TTD
         }
         reader.ReadSequenceEnd();
 
-        //parse the properties
-        uint32 propertyCount = reader.ReadLengthValue(true);
-        reader.ReadSequenceStart_WDefaultKey(true);
-        for(uint32 i = 0; i < propertyCount; ++i)
+        this->ParsePropertyAndTopLevelScriptInfo(&reader);
+
+        reader.ReadRecordEnd();
+
+        //After reading setup the previous event map
+        this->m_eventList.InitializePreviousEventMap();
+    }
+
+    //Startup snapshots come back from the host and the TTD parsers abort on malformed input
+    //So every resource is checksummed as it is written and the checksums are checked before anything is parsed
+    namespace NSStartupSnapshotDigest
+    {
+        static const char* const DigestResourceName = "ttdstartup.dig";
+        static const uint32 DigestMagic = 0x44545453;
+        static const uint32 DigestVersion = 1;
+        static const uint32 MaxResourceCount = 0x10000;
+        static const size_t MaxResourceNameLength = 63;
+        static const size_t DigestHeaderSize = 3 * sizeof(uint32);
+        static const size_t MaxDigestEntrySize = sizeof(uint32) + MaxResourceNameLength + sizeof(uint64) + sizeof(uint32);
+
+        struct ResourceEntry
         {
-            NSSnapType::SnapPropertyRecord* sRecord = this->m_propertyRecordList.NextOpenEntry();
-            NSSnapType::ParseSnapPropertyRecord(sRecord, i != 0, &reader, this->m_miscSlabAllocator);
+            char Name[MaxResourceNameLength + 1];
+            size_t NameLength;
+            JsTTDStreamHandle Handle;
+            uint64 Length;
+            uint32 Crc;
+        };
+
+        struct EmitState
+        {
+            TTDataIOInfo HostIO;
+            JsUtil::List<ResourceEntry, HeapAllocator> Resources;
+            bool Failed;
+
+            EmitState(const TTDataIOInfo& hostIO)
+                : HostIO(hostIO), Resources(&HeapAllocator::Instance), Failed(false)
+            {
+                ;
+            }
+
+            ResourceEntry* FindOpenResource(JsTTDStreamHandle handle)
+            {
+                for(int i = this->Resources.Count() - 1; i >= 0; --i)
+                {
+                    ResourceEntry& entry = this->Resources.Item(i);
+                    if(entry.Handle == handle)
+                    {
+                        return &entry;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        //The stream callbacks carry no state of their own so the emit in progress on this thread is kept here
+        static THREAD_LOCAL EmitState* s_activeEmit = nullptr;
+
+        //Handed to the TTD writers (which abort on a null stream) in place of a stream the host failed to open
+        static byte s_failedStream = 0;
+
+        static JsTTDStreamHandle CALLBACK OpenResourceStream_Emit(size_t uriLength, const char* uri, size_t nameLength, const char* name, bool read, bool write)
+        {
+            EmitState* state = s_activeEmit;
+
+            JsTTDStreamHandle handle = nullptr;
+            if(nameLength <= MaxResourceNameLength)
+            {
+                handle = state->HostIO.pfOpenResourceStream(uriLength, uri, nameLength, name, read, write);
+            }
+
+            if(handle == nullptr)
+            {
+                state->Failed = true;
+                return &s_failedStream;
+            }
+
+            ResourceEntry entry;
+            memcpy(entry.Name, name, nameLength);
+            entry.Name[nameLength] = '\0';
+            entry.NameLength = nameLength;
+            entry.Handle = handle;
+            entry.Length = 0;
+            entry.Crc = 0;
+            state->Resources.Add(entry);
+
+            return handle;
         }
-        reader.ReadSequenceEnd();
 
-        //do top level script processing here
-        this->m_sourceInfoCount = reader.ReadUInt32(NSTokens::Key::u32Val, true);
+        static bool CALLBACK WriteBytesToStream_Emit(JsTTDStreamHandle handle, const byte* buff, size_t size, size_t* writtenCount)
+        {
+            EmitState* state = s_activeEmit;
 
-        uint32 loadedScriptCount = reader.ReadLengthValue(true);
-        reader.ReadSequenceStart_WDefaultKey(true);
-        for(uint32 i = 0; i < loadedScriptCount; ++i)
+            //Failures are reported once the emit is done so the writers never see them
+            *writtenCount = size;
+            if(handle == &s_failedStream)
+            {
+                return true;
+            }
+
+            size_t hostWrittenCount = 0;
+            bool ok = state->HostIO.pfWriteBytesToStream(handle, buff, size, &hostWrittenCount);
+            if(!ok || hostWrittenCount != size)
+            {
+                state->Failed = true;
+                return true;
+            }
+
+            ResourceEntry* entry = state->FindOpenResource(handle);
+            TTDAssert(entry != nullptr, "Writing to a stream we never opened?");
+
+            entry->Crc = CalculateCRC(entry->Crc, size, (void*)buff);
+            entry->Length += size;
+
+            return true;
+        }
+
+        static void CALLBACK FlushAndCloseStream_Emit(JsTTDStreamHandle handle, bool read, bool write)
         {
-            NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo* fbInfo = this->m_loadedTopLevelScripts.NextOpenEntry();
-            NSSnapValues::ParseTopLevelLoadedFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, &reader, this->m_miscSlabAllocator);
+            EmitState* state = s_activeEmit;
+            if(handle == &s_failedStream)
+            {
+                return;
+            }
+
+            state->HostIO.pfFlushAndCloseStream(handle, read, write);
+
+            //The host may hand the same handle out again for the next resource
+            ResourceEntry* entry = state->FindOpenResource(handle);
+            if(entry != nullptr)
+            {
+                entry->Handle = nullptr;
+            }
         }
-        reader.ReadSequenceEnd();
 
-        uint32 newScriptCount = reader.ReadLengthValue(true);
-        reader.ReadSequenceStart_WDefaultKey(true);
-        for(uint32 i = 0; i < newScriptCount; ++i)
+        template <typename T>
+        static void AppendValue(byte* buff, size_t& cursor, T value)
         {
-            NSSnapValues::TopLevelNewFunctionBodyResolveInfo* fbInfo = this->m_newFunctionTopLevelScripts.NextOpenEntry();
-            NSSnapValues::ParseTopLevelNewFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, &reader, this->m_miscSlabAllocator);
+            memcpy(buff + cursor, &value, sizeof(T));
+            cursor += sizeof(T);
         }
-        reader.ReadSequenceEnd();
 
-        uint32 evalScriptCount = reader.ReadLengthValue(true);
-        reader.ReadSequenceStart_WDefaultKey(true);
-        for(uint32 i = 0; i < evalScriptCount; ++i)
+        template <typename T>
+        static bool ReadValue(const byte* buff, size_t buffLength, size_t& cursor, T* value)
         {
-            NSSnapValues::TopLevelEvalFunctionBodyResolveInfo* fbInfo = this->m_evalTopLevelScripts.NextOpenEntry();
-            NSSnapValues::ParseTopLevelEvalFunctionBodyInfo(fbInfo, i != 0, this->m_threadContext, &reader, this->m_miscSlabAllocator);
+            if(buffLength - cursor < sizeof(T))
+            {
+                return false;
+            }
+
+            memcpy(value, buff + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return true;
         }
-        reader.ReadSequenceEnd();
-        //
 
-        reader.ReadRecordEnd();
+        static bool WriteDigest(const EmitState& state)
+        {
+            const TTDataIOInfo& iofp = state.HostIO;
+            if((uint32)state.Resources.Count() > MaxResourceCount)
+            {
+                return false;
+            }
 
-        //After reading setup the previous event map
-        this->m_eventList.InitializePreviousEventMap();
+            size_t digestSize = DigestHeaderSize + (state.Resources.Count() * MaxDigestEntrySize) + sizeof(uint32);
+            byte* digest = TT_HEAP_ALLOC_ARRAY_ZERO(byte, digestSize);
+            size_t cursor = 0;
+
+            AppendValue<uint32>(digest, cursor, DigestMagic);
+            AppendValue<uint32>(digest, cursor, DigestVersion);
+            AppendValue<uint32>(digest, cursor, (uint32)state.Resources.Count());
+            for(int i = 0; i < state.Resources.Count(); ++i)
+            {
+                const ResourceEntry& entry = state.Resources.Item(i);
+                AppendValue<uint32>(digest, cursor, (uint32)entry.NameLength);
+                memcpy(digest + cursor, entry.Name, entry.NameLength);
+                cursor += entry.NameLength;
+                AppendValue<uint64>(digest, cursor, entry.Length);
+                AppendValue<uint32>(digest, cursor, entry.Crc);
+            }
+            AppendValue<uint32>(digest, cursor, CalculateCRC(0, cursor, digest));
+
+            bool ok = false;
+            JsTTDStreamHandle digestHandle = iofp.pfOpenResourceStream(iofp.ActiveTTUriLength, iofp.ActiveTTUri, strlen(DigestResourceName), DigestResourceName, false, true);
+            if(digestHandle != nullptr)
+            {
+                size_t writtenCount = 0;
+                ok = iofp.pfWriteBytesToStream(digestHandle, digest, cursor, &writtenCount) && writtenCount == cursor;
+                iofp.pfFlushAndCloseStream(digestHandle, false, true);
+            }
+
+            TT_HEAP_FREE_ARRAY(byte, digest, digestSize);
+            return ok;
+        }
+
+        static bool CheckResource(const TTDataIOInfo& iofp, const char* name, size_t nameLength, uint64 expectedLength, uint32 expectedCrc)
+        {
+            JsTTDStreamHandle handle = iofp.pfOpenResourceStream(iofp.ActiveTTUriLength, iofp.ActiveTTUri, nameLength, name, true, false);
+            if(handle == nullptr)
+            {
+                return false;
+            }
+
+            byte* buff = TT_HEAP_ALLOC_ARRAY(byte, TTD_SERIALIZATION_BUFFER_SIZE);
+            uint64 length = 0;
+            uint32 crc = 0;
+            while(length <= expectedLength)
+            {
+                size_t readCount = 0;
+                bool ok = iofp.pfReadBytesFromStream(handle, buff, TTD_SERIALIZATION_BUFFER_SIZE, &readCount);
+                if(!ok || readCount == 0)
+                {
+                    break;
+                }
+
+                crc = CalculateCRC(crc, readCount, buff);
+                length += readCount;
+            }
+
+            TT_HEAP_FREE_ARRAY(byte, buff, TTD_SERIALIZATION_BUFFER_SIZE);
+            iofp.pfFlushAndCloseStream(handle, true, false);
+
+            return length == expectedLength && crc == expectedCrc;
+        }
+
+        static size_t ReadUpTo(const TTDataIOInfo& iofp, JsTTDStreamHandle handle, byte* buff, size_t size)
+        {
+            size_t totalCount = 0;
+            while(totalCount < size)
+            {
+                size_t readCount = 0;
+                bool ok = iofp.pfReadBytesFromStream(handle, buff + totalCount, size - totalCount, &readCount);
+                if(!ok || readCount == 0)
+                {
+                    break;
+                }
+                totalCount += readCount;
+            }
+            return totalCount;
+        }
+
+        static bool CheckDigest(const TTDataIOInfo& iofp, const char* logResourceName, const char* snapResourceName)
+        {
+            JsTTDStreamHandle digestHandle = iofp.pfOpenResourceStream(iofp.ActiveTTUriLength, iofp.ActiveTTUri, strlen(DigestResourceName), DigestResourceName, true, false);
+            if(digestHandle == nullptr)
+            {
+                return false;
+            }
+
+            byte header[DigestHeaderSize];
+            size_t cursor = 0;
+            uint32 magic = 0;
+            uint32 version = 0;
+            uint32 count = 0;
+            bool ok = ReadUpTo(iofp, digestHandle, header, DigestHeaderSize) == DigestHeaderSize
+                && ReadValue<uint32>(header, DigestHeaderSize, cursor, &magic) && magic == DigestMagic
+                && ReadValue<uint32>(header, DigestHeaderSize, cursor, &version) && version == DigestVersion
+                && ReadValue<uint32>(header, DigestHeaderSize, cursor, &count) && count <= MaxResourceCount;
+
+            if(!ok)
+            {
+                iofp.pfFlushAndCloseStream(digestHandle, true, false);
+                return false;
+            }
+
+            //Read one byte past the largest digest with this many entries so we can tell if there is trailing data
+            size_t maxDigestSize = DigestHeaderSize + (count * MaxDigestEntrySize) + sizeof(uint32) + 1;
+            byte* digest = TT_HEAP_ALLOC_ARRAY(byte, maxDigestSize);
+            memcpy(digest, header, DigestHeaderSize);
+            size_t digestLength = DigestHeaderSize + ReadUpTo(iofp, digestHandle, digest + DigestHeaderSize, maxDigestSize - DigestHeaderSize);
+            iofp.pfFlushAndCloseStream(digestHandle, true, false);
+
+            ok = digestLength < maxDigestSize && digestLength >= DigestHeaderSize + sizeof(uint32);
+
+            size_t bodyLength = digestLength - sizeof(uint32);
+            if(ok)
+            {
+                uint32 digestCrc = 0;
+                memcpy(&digestCrc, digest + bodyLength, sizeof(uint32));
+                ok = (digestCrc == CalculateCRC(0, bodyLength, digest));
+            }
+
+            bool sawLog = false;
+            bool sawSnap = false;
+            for(uint32 i = 0; ok && i < count; ++i)
+            {
+                uint32 nameLength = 0;
+                uint64 length = 0;
+                uint32 crc = 0;
+                char name[MaxResourceNameLength + 1];
+
+                ok = ReadValue<uint32>(digest, bodyLength, cursor, &nameLength) && nameLength != 0 && nameLength <= MaxResourceNameLength && bodyLength - cursor >= nameLength;
+                if(ok)
+                {
+                    memcpy(name, digest + cursor, nameLength);
+                    name[nameLength] = '\0';
+                    cursor += nameLength;
+
+                    ok = ReadValue<uint64>(digest, bodyLength, cursor, &length)
+                        && ReadValue<uint32>(digest, bodyLength, cursor, &crc)
+                        && CheckResource(iofp, name, nameLength, length, crc);
+
+                    sawLog |= (strcmp(name, logResourceName) == 0);
+                    sawSnap |= (strcmp(name, snapResourceName) == 0);
+                }
+            }
+
+            ok = ok && cursor == bodyLength && sawLog && sawSnap;
+
+            TT_HEAP_FREE_ARRAY(byte, digest, maxDigestSize);
+            return ok;
+        }
+    }
+
+    bool EventLog::IsFreshForStartupSnapshot() const
+    {
+        return this->m_threadContext->TTDContext->GetTTDContexts().Count() == 0 && this->m_eventList.IsEmpty()
+            && this->m_loadedTopLevelScripts.Count() == 0 && this->m_newFunctionTopLevelScripts.Count() == 0 && this->m_evalTopLevelScripts.Count() == 0;
+    }
+
+    bool EventLog::EmitStartupSnapshot(const char* emitUri, size_t emitUriLength)
+    {
+        ThreadContextTTD* threadCtx = this->m_threadContext->TTDContext;
+        TTDAssert((this->m_currentMode & TTDMode::RecordMode) == TTDMode::RecordMode, "Startup snapshots are only taken from record mode runtimes.");
+        TTDAssert(threadCtx->GetTTDContexts().Count() == 1, "Startup snapshots hold exactly one context.");
+
+        //force a GC to get weak containers in a consistent state (just like a regular snapshot)
+        this->m_threadContext->GetRecycler()->CollectNow<CollectNowForceInThread>();
+        threadCtx->SyncRootsBeforeSnapshot_Record();
+
+        this->SetSnapshotOrInflateInProgress(true);
+        this->PushMode(TTDMode::ExcludedExecutionTTAction);
+
+        //The snapshot is not part of the event log so we own it here
+        JsUtil::BaseHashSet<Js::FunctionBody*, HeapAllocator> liveTopLevelBodies(&HeapAllocator::Instance);
+        SnapShot* snap = this->DoSnapshotExtract_Helper(0.0, liveTopLevelBodies);
+
+        TTDataIOInfo& iofp = threadCtx->TTDataIOInfo;
+        iofp.ActiveTTUriLength = emitUriLength;
+        iofp.ActiveTTUri = emitUri;
+
+        //Route the writes through the digest so host stream failures come back to us instead of aborting
+        NSStartupSnapshotDigest::EmitState emitState(iofp);
+        NSStartupSnapshotDigest::s_activeEmit = &emitState;
+        iofp.pfOpenResourceStream = &NSStartupSnapshotDigest::OpenResourceStream_Emit;
+        iofp.pfWriteBytesToStream = &NSStartupSnapshotDigest::WriteBytesToStream_Emit;
+        iofp.pfFlushAndCloseStream = &NSStartupSnapshotDigest::FlushAndCloseStream_Emit;
+
+        const char* startupfilename = "ttdstartup.log";
+        JsTTDStreamHandle startupHandle = iofp.pfOpenResourceStream(iofp.ActiveTTUriLength, iofp.ActiveTTUri, strlen(startupfilename), startupfilename, false, true);
+
+        {
+            TTD_LOG_WRITER writer(startupHandle, iofp.pfWriteBytesToStream, iofp.pfFlushAndCloseStream);
+
+            writer.WriteRecordStart();
+            writer.AdjustIndent(1);
+
+#if ENABLE_TTD_INTERNAL_DIAGNOSTICS
+            bool diagEnabled = true;
+#else
+            bool diagEnabled = false;
+#endif
+
+            writer.WriteBool(NSTokens::Key::diagEnabled, diagEnabled);
+            this->EmitPropertyAndTopLevelScriptInfo(&writer);
+
+            writer.AdjustIndent(-1);
+            writer.WriteRecordEnd(NSTokens::Separator::BigSpaceSeparator);
+
+            writer.FlushAndClose();
+        }
+
+        snap->EmitSnapshot(0, this->m_threadContext);
+        TT_HEAP_DELETE(SnapShot, snap);
+
+        iofp.pfOpenResourceStream = emitState.HostIO.pfOpenResourceStream;
+        iofp.pfWriteBytesToStream = emitState.HostIO.pfWriteBytesToStream;
+        iofp.pfFlushAndCloseStream = emitState.HostIO.pfFlushAndCloseStream;
+        NSStartupSnapshotDigest::s_activeEmit = nullptr;
+
+        //The digest goes last so a snapshot that was only partly written is never accepted
+        bool ok = !emitState.Failed && NSStartupSnapshotDigest::WriteDigest(emitState);
+
+        iofp.ActiveTTUriLength = 0;
+        iofp.ActiveTTUri = nullptr;
+
+        this->PopMode(TTDMode::ExcludedExecutionTTAction);
+        this->SetSnapshotOrInflateInProgress(false);
+
+        return ok;
+    }
+
+    Js::ScriptContext* EventLog::InflateStartupSnapshot(const char* parseUri, size_t parseUriLength, TTDReadBytesFromStreamCallback readfp, TTDCreateJsRTContextCallback createContextfp)
+    {
+        ThreadContextTTD* threadCtx = this->m_threadContext->TTDContext;
+        TTDAssert((this->m_currentMode & TTDMode::RecordMode) == TTDMode::RecordMode, "Startup snapshots are only inflated into record mode runtimes.");
+
+        //The top-level body ids in the snapshot index into the script lists we parse below so they must start out empty
+        TTDAssert(this->IsFreshForStartupSnapshot(), "Startup snapshots must be inflated into a fresh runtime.");
+
+        //Record runtimes are created without a read callback so the host passes one in for the inflate
+        TTDataIOInfo& iofp = threadCtx->TTDataIOInfo;
+        TTDReadBytesFromStreamCallback recordReadfp = iofp.pfReadBytesFromStream;
+        iofp.pfReadBytesFromStream = readfp;
+        iofp.ActiveTTUriLength = parseUriLength;
+        iofp.ActiveTTUri = parseUri;
+
+        const char* startupfilename = "ttdstartup.log";
+        const char* snapfilename = "snap_0.snp";
+
+        //Nothing is parsed (or changed in this runtime) until we know the snapshot is the one that was written and holds a single context
+        SnapShot* snap = nullptr;
+        bool ok = NSStartupSnapshotDigest::CheckDigest(iofp, startupfilename, snapfilename);
+        if(ok)
+        {
+            snap = SnapShot::Parse(0, this->m_threadContext);
+            ok = (snap->ContextCount() == 1);
+        }
+
+        JsTTDStreamHandle startupHandle = nullptr;
+        if(ok)
+        {
+            startupHandle = iofp.pfOpenResourceStream(iofp.ActiveTTUriLength, iofp.ActiveTTUri, strlen(startupfilename), startupfilename, true, false);
+            ok = (startupHandle != nullptr);
+        }
+
+        if(ok)
+        {
+            TTD_LOG_READER reader(startupHandle, iofp.pfReadBytesFromStream, iofp.pfFlushAndCloseStream);
+
+            reader.ReadRecordStart();
+
+#if ENABLE_TTD_INTERNAL_DIAGNOSTICS
+            ok = reader.ReadBool(NSTokens::Key::diagEnabled);
+#else
+            ok = !reader.ReadBool(NSTokens::Key::diagEnabled);
+#endif
+
+            if(ok)
+            {
+                this->ParsePropertyAndTopLevelScriptInfo(&reader);
+                reader.ReadRecordEnd();
+            }
+        }
+
+        if(!ok)
+        {
+            if(snap != nullptr)
+            {
+                TT_HEAP_DELETE(SnapShot, snap);
+            }
+
+            iofp.pfReadBytesFromStream = recordReadfp;
+            iofp.ActiveTTUriLength = 0;
+            iofp.ActiveTTUri = nullptr;
+
+            return nullptr;
+        }
+
+        //The snapshot refers to properties by id so they must line up with the ones in the writing runtime
+        this->InflateParsedPropertyRecords();
+        this->m_threadContext->SetSourceInfoCountForStartupSnapshot_TTD(this->m_sourceInfoCount);
+
+        this->PushMode(TTDMode::ExcludedExecutionTTAction);
+
+        TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo*> topLevelLoadScriptMap;
+        TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelNewFunctionBodyResolveInfo*> topLevelNewScriptMap;
+        TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelEvalFunctionBodyResolveInfo*> topLevelEvalScriptMap;
+
+        uint32 dbgScopeCount = snap->GetDbgScopeCountNonTopLevel() + this->InitializeTopLevelScriptMaps(topLevelLoadScriptMap, topLevelNewScriptMap, topLevelEvalScriptMap);
+        uint32 topFunctionCount = topLevelLoadScriptMap.Count() + topLevelNewScriptMap.Count() + topLevelEvalScriptMap.Count();
+
+        InflateMap* inflator = TT_HEAP_NEW(InflateMap);
+        inflator->PrepForInitialInflate(this->m_threadContext, snap->ContextCount(), snap->HandlerCount(), snap->TypeCount(), snap->PrimitiveCount() + snap->ObjectCount(), snap->BodyCount() + topFunctionCount, dbgScopeCount, snap->EnvCount(), snap->SlotArrayCount());
+
+        //Sources are re-parsed into the new context (bytecode is not part of the snapshot) and then the heap is rebuilt on top of them
+        const NSSnapValues::SnapContext* sCtx = snap->GetContextList().GetIterator().Current();
+
+        Js::ScriptContext* vCtx = nullptr;
+        createContextfp(threadCtx->GetRuntimeHandle(), &vCtx);
+
+        NSSnapValues::InflateScriptContext(sCtx, vCtx, inflator, topLevelLoadScriptMap, topLevelNewScriptMap, topLevelEvalScriptMap);
+
+        this->SetSnapshotOrInflateInProgress(true); //make sure we don't do any un-intended CrossSite conversions
+
+        snap->Inflate(inflator, threadCtx);
+        inflator->CleanupAfterInflate();
+
+        this->SetSnapshotOrInflateInProgress(false); //re-enable CrossSite conversions
+
+        threadCtx->ClearForeignRootsAfterStartupInflate_Record();
+
+        TT_HEAP_DELETE(InflateMap, inflator);
+        TT_HEAP_DELETE(SnapShot, snap);
+
+        this->PopMode(TTDMode::ExcludedExecutionTTAction);
+
+        iofp.pfReadBytesFromStream = recordReadfp;
+        iofp.ActiveTTUriLength = 0;
+        iofp.ActiveTTUri = nullptr;
+
+#if ENABLE_BASIC_TRACE || ENABLE_FULL_BC_TRACE
+        this->m_threadContext->TTDExecutionInfo->GetTraceLogger()->WriteLiteralMsg("---INFLATED STARTUP SNAPSHOT---\n");
+#endif
+
+        return vCtx;
     }
 }
 
@@ -328,6 +328,18 @@ namespace TTD
         //Initialize the vtable for the event list data
         void InitializeEventListVTable();
 
+        //Build the top-level body maps used to re-resolve function bodies on inflate and return the number of debugger scopes they add
+        uint32 InitializeTopLevelScriptMaps(TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelScriptLoadFunctionBodyResolveInfo*>& topLevelLoadScriptMap,
+            TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelNewFunctionBodyResolveInfo*>& topLevelNewScriptMap,
+            TTDIdentifierDictionary<uint64, NSSnapValues::TopLevelEvalFunctionBodyResolveInfo*>& topLevelEvalScriptMap) const;
+
+        //Emit/parse the property records and top-level script info shared by the log and startup snapshots
+        void EmitPropertyAndTopLevelScriptInfo(FileWriter* writer);
+        void ParsePropertyAndTopLevelScriptInfo(FileReader* reader);
+
+        //Make sure all of the parsed property records exist (with the same ids) in the thread context and pin them
+        void InflateParsedPropertyRecords();
+
     public:
         EventLog(ThreadContext* threadContext);
         ~EventLog();
@@ -617,6 +629,20 @@ namespace TTD
 
         void EmitLog(const char* emitUri, size_t emitUriLength, NSLogEvents::EventLogEntry* optInnerLoopEvent = nullptr);
         void ParseLogInto(TTDataIOInfo& iofp, const char* parseUri, size_t parseUriLength);
+
+        ////////////////////////////////
+        //Startup snapshot support
+
+        //True if nothing has been loaded into this runtime yet (so a startup snapshot can be inflated into it)
+        bool IsFreshForStartupSnapshot() const;
+
+        //Write a snapshot of the single (bootstrapped) context in this record mode runtime, along with the property records and sources it depends on, to the given uri
+        //Returns false if the host failed to open or write any of the resources
+        bool EmitStartupSnapshot(const char* emitUri, size_t emitUriLength);
+
+        //Inflate a startup snapshot into a new context of this (fresh) record mode runtime -- the context is created with createContextfp and made active
+        //Returns nullptr (and leaves the runtime untouched) if the snapshot is missing, damaged, or does not hold exactly one context
+        Js::ScriptContext* InflateStartupSnapshot(const char* parseUri, size_t parseUriLength, TTDReadBytesFromStreamCallback readfp, TTDCreateJsRTContextCallback createContextfp);
     };
 
     //In cases where we may have many exits where we need to pop something we pushed earlier (i.e. exceptions)
@@ -241,6 +241,21 @@ namespace TTD
         });
     }
 
+    void ThreadContextTTD::ClearForeignRootsAfterStartupInflate_Record()
+    {
+        this->m_ttdReplayRootPinSet->Clear();
+
+        this->m_ttdRootTagToObjectMap.MapAndRemoveIf([&](JsUtil::SimpleDictionaryEntry<TTD_LOG_PTR_ID, Js::RecyclableObject*>& entry) -> bool
+        {
+            return entry.Key() != TTD_CONVERT_OBJ_TO_LOG_PTR_ID(entry.Value()) || !this->m_ttdRecordRootWeakMap->Lookup(entry.Value(), false);
+        });
+
+        this->m_ttdMayBeLongLivedRoot.MapAndRemoveIf([&](JsUtil::SimpleDictionaryEntry<TTD_LOG_PTR_ID, bool>& entry) -> bool
+        {
+            return !this->m_ttdRootTagToObjectMap.ContainsKey(entry.Key());
+        });
+    }
+
     void ThreadContextTTD::SyncCtxtsAndRootsWithSnapshot_Replay(uint32 liveContextCount, TTD_LOG_PTR_ID* liveContextIdArray, uint32 liveRootCount, TTD_LOG_PTR_ID* liveRootIdArray)
     {
         //First sync up the context list -- releasing any contexts that are not also there in our initial recording
@@ -126,6 +126,9 @@ namespace TTD
         //Sync up the root set information before we do a snapshot in record mode
         void SyncRootsBeforeSnapshot_Record();
 
+        //Inflating a startup snapshot restores the roots of the runtime that wrote it (under its ids) so drop them and keep the roots this record mode runtime created
+        void ClearForeignRootsAfterStartupInflate_Record();
+
         //When we are replaying and hit a snapshot we need to sync up with the live script contexts and roots as in replay (so do that here)
         void SyncCtxtsAndRootsWithSnapshot_Replay(uint32 liveContextCount, TTD_LOG_PTR_ID* liveContextIdArray, uint32 liveRootCount, TTD_LOG_PTR_ID* liveRootIdArray);
 
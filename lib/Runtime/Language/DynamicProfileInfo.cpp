@@ -7,7 +7,7 @@
 #if ENABLE_NATIVE_CODEGEN
 namespace Js
 {
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
     DynamicProfileInfo::DynamicProfileInfo()
     {
         hasFunctionBody = false;
@@ -20,11 +20,14 @@ namespace Js
         size_t size;
     };
 
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
-    bool DynamicProfileInfo::NeedProfileInfoList()
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
+    bool DynamicProfileInfo::NeedProfileInfoList(const ScriptContext *const scriptContext)
     {
 #pragma prefast(suppress: 6235 6286, "(<non-zero constant> || <expression>) is always a non-zero constant. - This is wrong, DBG_DUMP is not set in some build variants")
         return DBG_DUMP
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
+            || scriptContext->GetThreadContext()->PersistsDynamicProfiles()
+#endif
 #ifdef DYNAMIC_PROFILE_STORAGE
             || DynamicProfileStorage::IsEnabled()
 #endif
@@ -98,8 +101,8 @@ namespace Js
         }
         else
         {
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
-            if (DynamicProfileInfo::NeedProfileInfoList())
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
+            if (DynamicProfileInfo::NeedProfileInfoList(functionBody->GetScriptContext()))
             {
                 info = RecyclerNewPlusZ(recycler, totalAlloc, DynamicProfileInfo, functionBody);
             }
@@ -127,8 +130,8 @@ namespace Js
     }
 
     DynamicProfileInfo::DynamicProfileInfo(FunctionBody * functionBody)
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
-        : functionBody(DynamicProfileInfo::NeedProfileInfoList() ? functionBody : nullptr)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
+        : functionBody(DynamicProfileInfo::NeedProfileInfoList(functionBody->GetScriptContext()) ? functionBody : nullptr)
 #endif
     {
         hasFunctionBody = true;
@@ -422,10 +425,10 @@ namespace Js
 
     void DynamicProfileInfo::RecordParameterAtCallSite(FunctionBody * functionBody, ProfileId callSiteId, Var arg, int argNum, Js::RegSlot regSlot)
     {
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         // If we persistsAcrossScriptContext, the dynamic profile info may be referred to by multiple function body from
         // different script context
-        Assert(!DynamicProfileInfo::NeedProfileInfoList() || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
+        Assert(!DynamicProfileInfo::NeedProfileInfoList(functionBody->GetScriptContext()) || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
 #endif
 
         Assert(argNum < Js::InlineeCallInfo::MaxInlineeArgoutCount);
@@ -557,10 +560,10 @@ namespace Js
             return;
         }
 
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         // If we persistsAcrossScriptContext, the dynamic profile info may be referred to by multiple function body from
         // different script context
-        Assert(!DynamicProfileInfo::NeedProfileInfoList() || this->persistsAcrossScriptContexts || this->functionBody == callerBody);
+        Assert(!DynamicProfileInfo::NeedProfileInfoList(callerBody->GetScriptContext()) || this->persistsAcrossScriptContexts || this->functionBody == callerBody);
 #endif
 
         bool doInline = true;
@@ -700,10 +703,10 @@ namespace Js
     {
         AutoCriticalSection cs(&this->callSiteInfoCS);
 
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         // If we persistsAcrossScriptContext, the dynamic profile info may be referred to by multiple function body from
         // different script context
-        Assert(!DynamicProfileInfo::NeedProfileInfoList() || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
+        Assert(!DynamicProfileInfo::NeedProfileInfoList(functionBody->GetScriptContext()) || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
 #endif
         bool doInline = true;
         // This is a hard limit as we only use 4 bits to encode the actual count in the InlineeCallInfo
@@ -771,10 +774,10 @@ namespace Js
     {
         AutoCriticalSection cs(&this->callSiteInfoCS);
 
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         // If we persistsAcrossScriptContext, the dynamic profile info may be referred to by multiple function body from
         // different script context
-        Assert(!DynamicProfileInfo::NeedProfileInfoList() || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
+        Assert(!DynamicProfileInfo::NeedProfileInfoList(functionBody->GetScriptContext()) || this->persistsAcrossScriptContexts || this->functionBody == functionBody);
 #endif
         Assert(callApplyCallSiteNum < functionBody->GetProfiledCallApplyCallSiteCount());
         Js::SourceId oldSourceId = callApplyTargetInfo[callApplyCallSiteNum].u.functionData.sourceId;
@@ -1529,7 +1532,7 @@ namespace Js
             return false;
         }
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         this->functionBody = functionBody;
 #endif
 
@@ -2144,7 +2147,7 @@ namespace Js
     }
 #endif
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
 #if DBG_DUMP
     void BufferWriter::Log(DynamicProfileInfo* info)
     {
@@ -2243,18 +2246,20 @@ namespace Js
 
             if (!reader->Read(functionId))
             {
-                AssertOrFailFast(false);
-                return nullptr;
+                goto Error;
             }
 
             if (!reader->Read(&paramInfoCount))
             {
-                AssertOrFailFast(false);
-                return nullptr;
+                goto Error;
             }
 
             if (paramInfoCount != 0)
             {
+                if (!reader->template CanReadArray<ValueType>(paramInfoCount))
+                {
+                    goto Error;
+                }
                 paramInfo = RecyclerNewArrayLeaf(recycler, ValueType, paramInfoCount);
                 if (!reader->ReadArray(paramInfo, paramInfoCount))
                 {
@@ -2269,6 +2274,10 @@ namespace Js
 
             if (ldLenInfoCount != 0)
             {
+                if (!reader->template CanReadArray<LdLenInfo>(ldLenInfoCount))
+                {
+                    goto Error;
+                }
                 ldLenInfo = RecyclerNewArrayLeaf(recycler, LdLenInfo, ldLenInfoCount);
                 if (!reader->ReadArray(ldLenInfo, ldLenInfoCount))
                 {
@@ -2283,6 +2292,10 @@ namespace Js
 
             if (ldElemInfoCount != 0)
             {
+                if (!reader->template CanReadArray<LdElemInfo>(ldElemInfoCount))
+                {
+                    goto Error;
+                }
                 ldElemInfo = RecyclerNewArrayLeaf(recycler, LdElemInfo, ldElemInfoCount);
                 if (!reader->ReadArray(ldElemInfo, ldElemInfoCount))
                 {
@@ -2297,6 +2310,10 @@ namespace Js
 
             if (stElemInfoCount != 0)
             {
+                if (!reader->template CanReadArray<StElemInfo>(stElemInfoCount))
+                {
+                    goto Error;
+                }
                 stElemInfo = RecyclerNewArrayLeaf(recycler, StElemInfo, stElemInfoCount);
                 if (!reader->ReadArray(stElemInfo, stElemInfoCount))
                 {
@@ -2311,6 +2328,10 @@ namespace Js
 
             if (arrayCallSiteCount != 0)
             {
+                if (!reader->template CanReadArray<ArrayCallSiteInfo>(arrayCallSiteCount))
+                {
+                    goto Error;
+                }
                 arrayCallSiteInfo = RecyclerNewArrayLeaf(recycler, ArrayCallSiteInfo, arrayCallSiteCount);
                 if (!reader->ReadArray(arrayCallSiteInfo, arrayCallSiteCount))
                 {
@@ -2325,6 +2346,10 @@ namespace Js
 
             if (fldInfoCount != 0)
             {
+                if (!reader->template CanReadArray<FldInfo>(fldInfoCount))
+                {
+                    goto Error;
+                }
                 fldInfo = RecyclerNewArrayLeaf(recycler, FldInfo, fldInfoCount);
                 if (!reader->ReadArray(fldInfo, fldInfoCount))
                 {
@@ -2339,6 +2364,10 @@ namespace Js
 
             if (slotInfoCount != 0)
             {
+                if (!reader->template CanReadArray<ValueType>(slotInfoCount))
+                {
+                    goto Error;
+                }
                 slotInfo = RecyclerNewArrayLeaf(recycler, ValueType, slotInfoCount);
                 if (!reader->ReadArray(slotInfo, slotInfoCount))
                 {
@@ -2356,6 +2385,10 @@ namespace Js
                 // CallSiteInfo contains pointer "polymorphicCallSiteInfo", but
                 // we explicitly save that pointer in FunctionBody. Safe to
                 // allocate CallSiteInfo[] as Leaf here.
+                if (!reader->template CanReadArray<CallSiteInfo>(callSiteInfoCount))
+                {
+                    goto Error;
+                }
                 callSiteInfo = RecyclerNewArrayLeaf(recycler, CallSiteInfo, callSiteInfoCount);
                 if (!reader->ReadArray(callSiteInfo, callSiteInfoCount))
                 {
@@ -2373,6 +2406,10 @@ namespace Js
                 // CallSiteInfo contains pointer "polymorphicCallSiteInfo", but
                 // we explicitly save that pointer in FunctionBody. Safe to
                 // allocate CallSiteInfo[] as Leaf here.
+                if (!reader->template CanReadArray<CallSiteInfo>(callApplyTargetInfoCount))
+                {
+                    goto Error;
+                }
                 callApplyTargetInfo = RecyclerNewArrayLeaf(recycler, CallSiteInfo, callApplyTargetInfoCount);
                 if (!reader->ReadArray(callApplyTargetInfo, callApplyTargetInfoCount))
                 {
@@ -2387,6 +2424,10 @@ namespace Js
 
             if (divCount != 0)
             {
+                if (!reader->template CanReadArray<ValueType>(divCount))
+                {
+                    goto Error;
+                }
                 divTypeInfo = RecyclerNewArrayLeaf(recycler, ValueType, divCount);
                 if (!reader->ReadArray(divTypeInfo, divCount))
                 {
@@ -2401,6 +2442,10 @@ namespace Js
 
             if (switchCount != 0)
             {
+                if (!reader->template CanReadArray<ValueType>(switchCount))
+                {
+                    goto Error;
+                }
                 switchTypeInfo = RecyclerNewArrayLeaf(recycler, ValueType, switchCount);
                 if (!reader->ReadArray(switchTypeInfo, switchCount))
                 {
@@ -2415,6 +2460,10 @@ namespace Js
 
             if (returnTypeInfoCount != 0)
             {
+                if (!reader->template CanReadArray<ValueType>(returnTypeInfoCount))
+                {
+                    goto Error;
+                }
                 returnTypeInfo = RecyclerNewArrayLeaf(recycler, ValueType, returnTypeInfoCount);
                 if (!reader->ReadArray(returnTypeInfo, returnTypeInfoCount))
                 {
@@ -2429,6 +2478,10 @@ namespace Js
 
             if (loopCount != 0)
             {
+                if (!reader->template CanReadArray<ImplicitCallFlags>(loopCount))
+                {
+                    goto Error;
+                }
                 loopImplicitCallFlags = RecyclerNewArrayLeaf(recycler, ImplicitCallFlags, loopCount);
                 if (!reader->ReadArray(loopImplicitCallFlags, loopCount))
                 {
@@ -2446,7 +2499,12 @@ namespace Js
 
             if (loopCount != 0)
             {
-                loopFlags = BVFixed::New(loopCount * LoopFlags::COUNT, recycler);
+                const BVIndex loopFlagCount = UInt32Math::Mul<LoopFlags::COUNT>(loopCount);
+                if (!reader->template CanReadArray<char>(BVFixed::GetAllocSize(loopFlagCount) - sizeof(BVFixed)))
+                {
+                    goto Error;
+                }
+                loopFlags = BVFixed::New(loopFlagCount, recycler);
                 if (!reader->ReadArray(loopFlags->GetData(), loopFlags->WordCount()))
                 {
                     goto Error;
@@ -2499,7 +2557,7 @@ namespace Js
         }
 
     Error:
-        AssertOrFailFast(false);
+        AssertOrFailFast(!reader->IsTrusted());
         return nullptr;
     }
 
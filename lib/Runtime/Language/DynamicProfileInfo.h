@@ -412,7 +412,7 @@ namespace Js
 
         static Var EnsureDynamicProfileInfoThunk(RecyclableObject * function, CallInfo callInfo, ...);
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         bool HasFunctionBody() const { return hasFunctionBody; }
         FunctionBody * GetFunctionBody() const { Assert(hasFunctionBody); return functionBody; }
 #endif
@@ -521,8 +521,8 @@ namespace Js
 #ifdef RUNTIME_DATA_COLLECTION
         static void DumpScriptContextToFile(ScriptContext * scriptContext);
 #endif
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
-        static bool NeedProfileInfoList();
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
+        static bool NeedProfileInfoList(const ScriptContext *const scriptContext);
 #endif
 #ifdef DYNAMIC_PROFILE_MUTATOR
         friend class DynamicProfileMutatorImpl;
@@ -653,10 +653,10 @@ namespace Js
         template <typename T>
         static void WriteArray(uint count, WriteBarrierPtr<T> arr, FILE * file);
 #endif
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         Field(FunctionBody *) functionBody; // This will only be populated if NeedProfileInfoList is true
 #endif
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         // Used by de-serialize
         DynamicProfileInfo();
 
@@ -942,18 +942,22 @@ namespace Js
         }
     };
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
     class BufferReader
     {
     public:
-        BufferReader(__in_ecount(length) char const * buffer, size_t length) : current(buffer), lengthLeft(length) {}
+        // Buffers the engine wrote itself are trusted, and a short read fails fast. Buffers from the host are not:
+        // a short read returns false and the caller rejects the buffer.
+        BufferReader(__in_ecount(length) char const * buffer, size_t length, bool isTrusted = true) : current(buffer), lengthLeft(length), isTrusted(isTrusted) {}
+
+        bool IsTrusted() const { return isTrusted; }
 
         template <typename T>
         bool Read(T * data)
         {
             if (lengthLeft < sizeof(T))
             {
-                AssertOrFailFast(false);
+                AssertOrFailFast(!isTrusted);
                 return false;
             }
             *data = *(T *)current;
@@ -973,13 +977,25 @@ namespace Js
             return true;
         }
 
+        // Checked before allocating room for len elements, so that a count read from a short buffer can't
+        // request more memory than the rest of the buffer could fill
+        template <typename T>
+        bool CanReadArray(size_t len)
+        {
+            if (len > lengthLeft / sizeof(T))
+            {
+                AssertOrFailFast(!isTrusted);
+                return false;
+            }
+            return true;
+        }
+
         template <typename T>
         bool ReadArray(__inout_ecount(len) T * data, size_t len)
         {
             size_t size = sizeof(T) * len;
-            if (lengthLeft < size)
+            if (!CanReadArray<T>(len))
             {
-                AssertOrFailFast(false);
                 return false;
             }
             memcpy_s(data, size, current, size);
@@ -990,6 +1006,7 @@ namespace Js
     private:
         char const * current;
         size_t lengthLeft;
+        bool isTrusted;
     };
 
     class BufferSizeCounter
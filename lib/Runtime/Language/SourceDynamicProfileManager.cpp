@@ -52,7 +52,7 @@ namespace Js
     void SourceDynamicProfileManager::RemoveDynamicProfileInfo(LocalFunctionId functionId)
     {
         dynamicProfileInfoMap.Remove(functionId);
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         dynamicProfileInfoMapSaving.Remove(functionId);
 #endif
     }
@@ -288,7 +288,7 @@ namespace Js
         return manager;
     }
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
     void SourceDynamicProfileManager::ClearSavingData()
     {
         dynamicProfileInfoMapSaving.Reset();
@@ -320,9 +320,10 @@ namespace Js
     SourceDynamicProfileManager::Deserialize(T * reader, Recycler* recycler)
     {
         uint functionCount;
-        if (!reader->Peek(&functionCount))
+        if (!reader->Peek(&functionCount) || functionCount == 0 ||
+            !reader->template CanReadArray<char>(BVFixed::GetAllocSize(functionCount)))
         {
-            Assert(false);
+            Assert(!reader->IsTrusted());
             return nullptr;
         }
 
@@ -330,7 +331,7 @@ namespace Js
         if (!reader->ReadArray(((char *)startupFunctions),
             BVFixed::GetAllocSize(functionCount)))
         {
-            Assert(false);
+            Assert(!reader->IsTrusted());
             return nullptr;
         }
 
@@ -338,7 +339,7 @@ namespace Js
 
         if (!reader->Read(&profileCount))
         {
-            Assert(false);
+            Assert(!reader->IsTrusted());
             return nullptr;
         }
 
@@ -360,9 +361,10 @@ namespace Js
         {
             Js::LocalFunctionId functionId;
             DynamicProfileInfo * dynamicProfileInfo = DynamicProfileInfo::Deserialize(reader, recycler, &functionId);
-            if (dynamicProfileInfo == nullptr || functionId >= functionCount)
+            if (dynamicProfileInfo == nullptr || functionId >= functionCount ||
+                sourceDynamicProfileManager->dynamicProfileInfoMap.ContainsKey(functionId))
             {
-                Assert(false);
+                Assert(!reader->IsTrusted());
                 return nullptr;
             }
             sourceDynamicProfileManager->dynamicProfileInfoMap.Add(functionId, dynamicProfileInfo);
@@ -396,13 +398,29 @@ namespace Js
             }
 #endif
 
+            // Profiles loaded for functions that never ran have no function body and are not written
+            uint profileCount = 0;
+            for (int i = 0; i < this->dynamicProfileInfoMapSaving.Count(); i++)
+            {
+                DynamicProfileInfo * dynamicProfileInfo = this->dynamicProfileInfoMapSaving.GetValueAt(i);
+                if (dynamicProfileInfo != nullptr && dynamicProfileInfo->HasFunctionBody())
+                {
+                    profileCount++;
+                }
+            }
+
             size_t bvSize = BVFixed::GetAllocSize(this->startupFunctions->Length()) ;
             if (!writer->WriteArray((char *)static_cast<BVFixed*>(this->startupFunctions), bvSize)
-                || !writer->Write(this->dynamicProfileInfoMapSaving.Count()))
+                || !writer->Write(profileCount))
             {
                 return false;
             }
         }
+        else
+        {
+            // Nothing has run; there is no profile to write
+            return false;
+        }
 
         for (int i = 0; i < this->dynamicProfileInfoMapSaving.Count(); i++)
         {
@@ -420,6 +438,39 @@ namespace Js
         return true;
     }
 
+    SourceDynamicProfileManager *
+    SourceDynamicProfileManager::LoadFromBuffer(Recycler* recycler, __in_ecount(length) char const * buffer, size_t length)
+    {
+        BufferReader reader(buffer, length, false /* isTrusted */);
+        return SourceDynamicProfileManager::Deserialize(&reader, recycler);
+    }
+
+    //
+    // Gathers the profiles collected in the script context and returns the number of bytes SaveToBuffer writes
+    //
+    bool
+    SourceDynamicProfileManager::GetSerializedSize(ScriptContext * scriptContext, size_t * byteCount)
+    {
+        DynamicProfileInfo::UpdateSourceDynamicProfileManagers(scriptContext);
+
+        BufferSizeCounter counter;
+        if (!this->Serialize(&counter))
+        {
+            return false;
+        }
+
+        *byteCount = counter.GetByteCount();
+        return true;
+    }
+
+    bool
+    SourceDynamicProfileManager::SaveToBuffer(__out_ecount(length) char * buffer, size_t length)
+    {
+        BufferWriter writer(buffer, length);
+        return this->Serialize(&writer);
+    }
+
+#ifdef DYNAMIC_PROFILE_STORAGE
     void
     SourceDynamicProfileManager::SaveToDynamicProfileStorage(char16 const * url)
     {
@@ -453,6 +504,7 @@ namespace Js
 
         DynamicProfileStorage::SaveRecord(url, record);
     }
+#endif
 
 #endif
 };
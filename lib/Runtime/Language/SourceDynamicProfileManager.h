@@ -17,12 +17,13 @@ namespace Js
     //
     // For every source file, an instance of SourceDynamicProfileManager is used to save/load data.
     // It uses the WININET cache to save/load profile data.
+    // Hosts can persist the profile info themselves with JsSerializeScriptProfile/JsLoadScriptProfile (DYNAMIC_PROFILE_PERSISTENCE).
     // For testing scenarios enabled using DYNAMIC_PROFILE_STORAGE macro, this can persist the profile info into a file as well.
     class SourceDynamicProfileManager
     {
     public:
         SourceDynamicProfileManager(Recycler* allocator) : isNonCachableScript(false), cachedStartupFunctions(nullptr), recycler(allocator),
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
             dynamicProfileInfoMapSaving(&HeapAllocator::Instance),
 #endif
             dynamicProfileInfoMap(allocator), startupFunctions(nullptr), dataCacheWrapper(nullptr) 
@@ -44,27 +45,32 @@ namespace Js
         bool LoadFromProfileCache(SimpleDataCacheWrapper* dataCacheWrapper, LPCWSTR url);
         SimpleDataCacheWrapper* GetProfileCache() { return dataCacheWrapper; }
         uint GetStartupFunctionsLength() { return (this->startupFunctions ? this->startupFunctions->Length() : 0); }
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         void ClearSavingData();
+        static SourceDynamicProfileManager * LoadFromBuffer(Recycler* recycler, __in_ecount(length) char const * buffer, size_t length);
+        bool GetSerializedSize(ScriptContext * scriptContext, size_t * byteCount);
+        bool SaveToBuffer(__out_ecount(length) char * buffer, size_t length);
 #endif
 
     private:
         friend class DynamicProfileInfo;
         FieldNoBarrier(Recycler*) recycler;
 
-#ifdef DYNAMIC_PROFILE_STORAGE
+#ifdef DYNAMIC_PROFILE_PERSISTENCE
         // while Finalizing Javascript library we can't allocate memory from recycler, 
         // dynamicProfileInfoMapSaving is heap allocated and used for serializing dynamic profile cache
         typedef JsUtil::BaseDictionary<LocalFunctionId, DynamicProfileInfo *, HeapAllocator> DynamicProfileInfoMapSavingType;
         FieldNoBarrier(DynamicProfileInfoMapSavingType) dynamicProfileInfoMapSaving;
         
         void SaveDynamicProfileInfo(LocalFunctionId functionId, DynamicProfileInfo * dynamicProfileInfo);
-        void SaveToDynamicProfileStorage(char16 const * url);
         void AddSavingItem(LocalFunctionId functionId, DynamicProfileInfo *info);
         template <typename T>
         static SourceDynamicProfileManager * Deserialize(T * reader, Recycler* allocator);
         template <typename T>
         bool Serialize(T * writer);
+#endif
+#ifdef DYNAMIC_PROFILE_STORAGE
+        void SaveToDynamicProfileStorage(char16 const * url);
 #endif
         uint SaveToProfileCache();
         bool ShouldSaveToProfileCache(SourceContextInfo* info) const;
@@ -97,6 +97,179 @@ namespace JSON
         return result;
     }
 
+    Js::Var ParseUtf8(const utf8char_t* input, size_t length, Js::ScriptContext* scriptContext)
+    {
+        // alignment required because of the union in JSONParser::m_token
+        __declspec (align(8)) JSONParser parser(scriptContext, nullptr);
+        Js::Var result = NULL;
+
+        TryFinally([&]()
+        {
+            result = parser.Parse(input, length);
+
+    #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+            if (CONFIG_FLAG(ForceGCAfterJSONParse))
+            {
+                Recycler* recycler = scriptContext->GetRecycler();
+                recycler->CollectNow<CollectNowForceInThread>();
+            }
+    #endif
+        },
+            [&](bool/*hasException*/)
+        {
+            parser.Finalizer();
+        });
+
+        return result;
+    }
+
+    void ParseDeferredObject(Js::DynamicObject* object, Js::JavascriptString* source, charcount_t sourceOffset, Js::ScriptContext* scriptContext)
+    {
+        // alignment required because of the union in JSONParser::m_token
+        __declspec (align(8)) JSONParser parser(scriptContext, nullptr);
+
+        TryFinally([&]()
+        {
+            parser.ParseDeferredObject(object, source, sourceOffset);
+        },
+            [&](bool/*hasException*/)
+        {
+            parser.Finalizer();
+        });
+    }
+
+    // Encodes the pieces of a streamed JSON string as UTF-8 and passes them on in bounded chunks. A surrogate
+    // pair split between two pieces is held back until its second half arrives; unpaired surrogates (which
+    // JSONStringBuilder escapes, except in the gap) become U+FFFD, as in JsCopyStringUtf8.
+    class Utf8ChunkSink : public Js::JSONStringSink
+    {
+    public:
+        Utf8ChunkSink(Utf8ChunkWriter writer, void* writerState, _In_ utf8char_t* chunk, size_t chunkSize) :
+            writer(writer), writerState(writerState), chunk(chunk), chunkSize(chunkSize),
+            totalLength(0), pendingHighSurrogate(0)
+        {
+        }
+
+        // A piece of n characters encodes to at most 3 * n bytes, plus 3 for a pending surrogate that turns
+        // out to be unpaired
+        static charcount_t GetMaxPieceLength(size_t chunkSize)
+        {
+            const size_t pieceLength = chunkSize / 3 - 1;
+            return pieceLength < MaxCharCount ? static_cast<charcount_t>(pieceLength) : MaxCharCount;
+        }
+
+        void Write(_In_reads_(length) const char16* buffer, charcount_t length) override
+        {
+            Assert(length <= GetMaxPieceLength(this->chunkSize));
+            if (length == 0)
+            {
+                return;
+            }
+
+            utf8char_t* current = this->chunk;
+            if (this->pendingHighSurrogate != 0)
+            {
+                if (utf8::IsLowSurrogateChar(buffer[0]))
+                {
+                    current = utf8::EncodeSurrogatePair<false>(this->pendingHighSurrogate, buffer[0], current);
+                    ++buffer;
+                    --length;
+                }
+                else
+                {
+                    current = EncodeReplacementCharacter(current);
+                }
+                this->pendingHighSurrogate = 0;
+            }
+
+            if (length != 0 && utf8::IsHighSurrogateChar(buffer[length - 1]))
+            {
+                this->pendingHighSurrogate = buffer[length - 1];
+                --length;
+            }
+
+            const size_t available = this->chunkSize - (current - this->chunk);
+            current += utf8::EncodeInto<utf8::Utf8EncodingKind::TrueUtf8>(current, available, buffer, length);
+            this->WriteChunk(current - this->chunk);
+        }
+
+        void Finish()
+        {
+            if (this->pendingHighSurrogate != 0)
+            {
+                this->pendingHighSurrogate = 0;
+                this->WriteChunk(EncodeReplacementCharacter(this->chunk) - this->chunk);
+            }
+        }
+
+        size_t GetTotalLength() const { return this->totalLength; }
+
+    private:
+        Utf8ChunkWriter writer;
+        void* writerState;
+        utf8char_t* chunk;
+        size_t chunkSize;
+        size_t totalLength;
+        char16 pendingHighSurrogate;
+
+        static utf8char_t* EncodeReplacementCharacter(_Out_writes_(3) utf8char_t* ptr)
+        {
+            // U+FFFD
+            *ptr++ = 0xEF;
+            *ptr++ = 0xBF;
+            *ptr++ = 0xBD;
+            return ptr;
+        }
+
+        void WriteChunk(size_t length)
+        {
+            AssertOrFailFast(length <= this->chunkSize);
+            if (length == 0)
+            {
+                return;
+            }
+            this->totalLength += length;
+            if (!this->writer(this->chunk, length, this->writerState))
+            {
+                // Unwinds out of the builder to StringifyUtf8. Nothing else needs undoing, as the value graph was
+                // read before the first chunk.
+                throw Js::OperationAbortedException();
+            }
+        }
+    };
+
+    bool StringifyUtf8(Js::Var value, Utf8ChunkWriter writer, void* writerState, size_t chunkSize, Js::ScriptContext* scriptContext, _Out_ size_t* length)
+    {
+        Assert(chunkSize >= MinUtf8ChunkSize);
+        *length = 0;
+
+        // The value graph is read up front, as for JSON.stringify; only the text is produced piece by piece
+        LazyJSONString* lazy = JSONStringifier::Stringify(scriptContext, value, nullptr, nullptr);
+        if (lazy == nullptr)
+        {
+            return true;
+        }
+
+        Recycler* recycler = scriptContext->GetRecycler();
+        const charcount_t pieceLength = Utf8ChunkSink::GetMaxPieceLength(chunkSize);
+        char16* piece = RecyclerNewArrayLeaf(recycler, char16, pieceLength);
+        utf8char_t* chunk = RecyclerNewArrayLeaf(recycler, utf8char_t, chunkSize);
+
+        Utf8ChunkSink sink(writer, writerState, chunk, chunkSize);
+        try
+        {
+            lazy->WriteTo(&sink, piece, pieceLength);
+            sink.Finish();
+        }
+        catch (Js::OperationAbortedException)
+        {
+            *length = sink.GetTotalLength();
+            return false;
+        }
+        *length = sink.GetTotalLength();
+        return true;
+    }
+
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -15,4 +15,20 @@ namespace JSON
 
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
     Js::Var Parse(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
+
+    // Parses JSON text given as UTF-8 bytes, without creating a string for it first
+    Js::Var ParseUtf8(const utf8char_t* input, size_t length, Js::ScriptContext* scriptContext);
+
+    // Parses the members of the deferred JSON object whose '{' is at sourceOffset into object, which has no properties yet
+    void ParseDeferredObject(Js::DynamicObject* object, Js::JavascriptString* source, charcount_t sourceOffset, Js::ScriptContext* scriptContext);
+
+    // Receives one chunk of StringifyUtf8 output; returning false stops StringifyUtf8
+    typedef bool (*Utf8ChunkWriter)(_In_reads_(length) const utf8char_t* chunk, size_t length, void* writerState);
+
+    // Stringifies value as JSON.stringify(value) would, handing the text to writer as UTF-8 in chunks of at most
+    // chunkSize bytes (at least MinUtf8ChunkSize) as it is produced. length receives the number of bytes handed
+    // to writer, which is 0 if value does not stringify (undefined, a function or a symbol). Returns false if
+    // writer stopped the output before the end of the text.
+    static const size_t MinUtf8ChunkSize = 16;
+    bool StringifyUtf8(Js::Var value, Utf8ChunkWriter writer, void* writerState, size_t chunkSize, Js::ScriptContext* scriptContext, _Out_ size_t* length);
 } // namespace JSON
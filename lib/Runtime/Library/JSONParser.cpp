@@ -15,25 +15,31 @@ namespace JSON
     void JSONParser::Finalizer()
     {
         m_scanner.Finalizer();
+        m_utf8Scanner.Finalizer();
         if(arenaAllocatorObject)
         {
             this->scriptContext->ReleaseTemporaryGuestAllocator(arenaAllocatorObject);
         }
     }
 
+    void JSONParser::EnsureArenaAllocator()
+    {
+        if (!this->arenaAllocatorObject)
+        {
+            this->arenaAllocatorObject = scriptContext->GetTemporaryGuestAllocator(_u("JSONParse"));
+            this->arenaAllocator = arenaAllocatorObject->GetAllocator();
+        }
+    }
+
     Js::Var JSONParser::Parse(LPCWSTR str, uint length)
     {
         if (length > MIN_CACHE_LENGTH)
         {
-            if (!this->arenaAllocatorObject)
-            {
-                this->arenaAllocatorObject = scriptContext->GetTemporaryGuestAllocator(_u("JSONParse"));
-                this->arenaAllocator = arenaAllocatorObject->GetAllocator();
-            }
+            EnsureArenaAllocator();
         }
         m_scanner.Init(str, length, &m_token, scriptContext, str, this->arenaAllocator);
-        Scan();
-        Js::Var ret = ParseObject();
+        m_scanner.Scan();
+        Js::Var ret = ParseObject(m_scanner);
         if (m_token.tk != tkEOF)
         {
             m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
@@ -41,11 +47,59 @@ namespace JSON
         return ret;
     }
 
+    Js::Var JSONParser::Parse(const utf8char_t* str, size_t length)
+    {
+        if (length > MIN_CACHE_LENGTH)
+        {
+            EnsureArenaAllocator();
+        }
+        m_utf8Scanner.Init(str, length, &m_token, scriptContext, this->arenaAllocator);
+        m_utf8Scanner.Scan();
+        Js::Var ret = ParseObject(m_utf8Scanner);
+        if (m_token.tk != tkEOF)
+        {
+            m_utf8Scanner.ThrowSyntaxError(JSERR_JsonSyntax);
+        }
+        return ret;
+    }
+
     Js::Var JSONParser::Parse(Js::JavascriptString* input)
     {
+        // Nested objects of a large input are only validated here and materialized on first use. The reviver
+        // walk would touch every object right away, and TTD needs to see the whole result being created.
+        if (CONFIG_FLAG(LazyJSONParse) && reviver == nullptr &&
+            input->GetLength() >= (charcount_t)CONFIG_FLAG(LazyJSONParseThreshold)
+#if ENABLE_TTD
+            && !scriptContext->IsTTDRecordOrReplayModeEnabled()
+#endif
+            )
+        {
+            deferredSource = input;
+        }
         return Parse(input->GetSz(), input->GetLength());
     }
 
+    void JSONParser::ParseDeferredObject(Js::DynamicObject* object, Js::JavascriptString* input, charcount_t offset)
+    {
+        LPCWSTR str = input->GetSz();
+        charcount_t length = input->GetLength();
+        Assert(offset < length && str[offset] == _u('{'));
+
+        if (length - offset > MIN_CACHE_LENGTH)
+        {
+            EnsureArenaAllocator();
+        }
+
+        // Objects nested in this one are deferred in turn
+        deferredSource = input;
+        nestingDepth = 1;
+
+        m_scanner.Init(str, length, &m_token, scriptContext, str + offset, this->arenaAllocator);
+        m_scanner.Scan();
+        Assert(m_token.tk == tkLCurly);
+        ParseObjectMembers(m_scanner, object);
+    }
+
     Js::Var JSONParser::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
     {
         AssertMsg(reviver, "JSON post parse walk with null reviver");
@@ -191,7 +245,8 @@ namespace JSON
         return value;
     }
 
-    Js::Var JSONParser::ParseObject()
+    template <class Scanner>
+    Js::Var JSONParser::ParseObject(Scanner& scanner)
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
 
@@ -202,44 +257,44 @@ namespace JSON
 
         case tkFltCon:
             retVal = Js::JavascriptNumber::ToVarIntCheck(m_token.GetDouble(), scriptContext);
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkStrCon:
             {
                 // will auto-null-terminate the string (as length=len+1)
-                uint len = m_scanner.GetCurrentStringLen();
-                retVal = Js::JavascriptString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
-                Scan();
+                uint len = scanner.GetCurrentStringLen();
+                retVal = Js::JavascriptString::NewCopyBuffer(scanner.GetCurrentString(), len, scriptContext);
+                scanner.Scan();
                 return retVal;
             }
 
         case tkTRUE:
             retVal = scriptContext->GetLibrary()->GetTrue();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkFALSE:
             retVal = scriptContext->GetLibrary()->GetFalse();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkNULL:
             retVal = scriptContext->GetLibrary()->GetNull();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkSub:  // unary minus
 
-            if (Scan() == tkFltCon)
+            if (scanner.Scan() == tkFltCon)
             {
                 retVal = Js::JavascriptNumber::ToVarIntCheck(-m_token.GetDouble(), scriptContext);
-                Scan();
+                scanner.Scan();
                 return retVal;
             }
             else
             {
-                m_scanner.ThrowSyntaxError(JSERR_JsonBadNumber);
+                scanner.ThrowSyntaxError(JSERR_JsonBadNumber);
             }
 
         case tkLBrack:
@@ -248,44 +303,41 @@ namespace JSON
                 Js::JavascriptArray* arrayObj = scriptContext->GetLibrary()->CreateArray(0);
 
                 //skip '['
-                Scan();
+                scanner.Scan();
 
                 //iterate over the array members, get JSON objects and add them in the pArrayMemberList
                 uint k = 0;
+                nestingDepth++;
                 while (true)
                 {
                     if(tkRBrack == m_token.tk)
                     {
                         break;
                     }
-                    Js::Var value = ParseObject();
+                    Js::Var value = ParseObject(scanner);
                     arrayObj->SetItem(k++, value, Js::PropertyOperation_None);
 
                     // if next token is not a comma consider the end of the array member list.
                     if (tkComma != m_token.tk)
                         break;
-                    Scan();
+                    scanner.Scan();
                     if(tkRBrack == m_token.tk)
                     {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+                        scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
                     }
                 }
+                nestingDepth--;
                 //check and consume the ending ']'
-                CheckCurrentToken(tkRBrack, JSERR_JsonNoRbrack);
+                CheckCurrentToken(scanner, tkRBrack, JSERR_JsonNoRbrack);
                 return arrayObj;
 
             }
 
         case tkLCurly:
             {
-
-                // Parse an object, "{"name1" : ObjMember1, "name2" : ObjMember2, ...} "
-                if(IsCaching())
+                if (deferredSource != nullptr && nestingDepth > 0)
                 {
-                    if(!typeCacheList)
-                    {
-                        typeCacheList = Anew(this->arenaAllocator, JsonTypeCacheList, this->arenaAllocator, 8);
-                    }
+                    return DeferObject(scanner);
                 }
 
                 // first, create the object
@@ -298,125 +350,232 @@ namespace JSON
                 }
 #endif
 
-                //next token after '{'
-                Scan();
+                nestingDepth++;
+                ParseObjectMembers(scanner, object);
+                nestingDepth--;
+                return object;
+            }
 
-                //if empty object "{}" return;
-                if(tkRCurly == m_token.tk)
-                {
-                    Scan();
-                    return object;
-                }
-                JsonTypeCache* previousCache = nullptr;
-                JsonTypeCache* currentCache = nullptr;
-                //parse the list of members
-                while(true)
-                {
-                    // parse a list member:  "name" : ObjMember
-                    // and add it to the object.
+        default:
+            scanner.ThrowSyntaxError(JSERR_JsonSyntax);
+        }
+    }
 
-                    //pick "name"
-                    if(tkStrCon != m_token.tk)
-                    {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
-                    }
+    template <class Scanner>
+    void JSONParser::ParseObjectMembers(Scanner& scanner, Js::DynamicObject* object)
+    {
+        // Parse the members, "{"name1" : ObjMember1, "name2" : ObjMember2, ...} "
+        if(IsCaching())
+        {
+            if(!typeCacheList)
+            {
+                typeCacheList = Anew(this->arenaAllocator, JsonTypeCacheList, this->arenaAllocator, 8);
+            }
+        }
 
-                    // currentStrLength = length w/o null-termination
-                    WCHAR* currentStr = m_scanner.GetCurrentString();
-                    uint currentStrLength = m_scanner.GetCurrentStringLen();
+        //next token after '{'
+        scanner.Scan();
 
-                    DynamicType* typeWithoutProperty = object->GetDynamicType();
-                    if(IsCaching())
-                    {
-                        if(!previousCache)
-                        {
-                            // This is the first property in the list - see if we have an existing cache for it.
-                            currentCache = typeCacheList->LookupWithKey(Js::HashedCharacterBuffer<WCHAR>(currentStr, currentStrLength), nullptr);
-                        }
-                        if(currentCache && currentCache->typeWithoutProperty == typeWithoutProperty &&
-                            currentCache->propertyRecord->Equals(JsUtil::CharacterBuffer<WCHAR>(currentStr, currentStrLength)))
-                        {
-                            //check and consume ":"
-                            if(Scan() != tkColon )
-                            {
-                                m_scanner.ThrowSyntaxError(JSERR_JsonNoColon);
-                            }
-                            Scan();
-
-                            // Cache all values from currentCache as there is a chance that ParseObject might change the cache
-                            DynamicType* typeWithProperty = currentCache->typeWithProperty;
-                            PropertyId propertyId = currentCache->propertyRecord->GetPropertyId();
-                            PropertyIndex propertyIndex = currentCache->propertyIndex;
-                            previousCache = currentCache;
-                            currentCache = currentCache->next;
-
-                            // fast path for type transition and property set
-                            object->EnsureSlots(typeWithoutProperty->GetTypeHandler()->GetSlotCapacity(),
-                                typeWithProperty->GetTypeHandler()->GetSlotCapacity(), scriptContext, typeWithProperty->GetTypeHandler());
-                            object->ReplaceType(typeWithProperty);
-                            Js::Var value = ParseObject();
-                            object->SetSlot(SetSlotArguments(propertyId, propertyIndex, value));
-
-                            // if the next token is not a comma consider the list of members done.
-                            if (tkComma != m_token.tk)
-                                break;
-                            Scan();
-                            continue;
-                        }
-                    }
+        //if empty object "{}" return;
+        if(tkRCurly == m_token.tk)
+        {
+            scanner.Scan();
+            return;
+        }
+        JsonTypeCache* previousCache = nullptr;
+        JsonTypeCache* currentCache = nullptr;
+        //parse the list of members
+        while(true)
+        {
+            // parse a list member:  "name" : ObjMember
+            // and add it to the object.
 
-                    // slow path
-                    Js::PropertyRecord const * propertyRecord;
-                    scriptContext->GetOrAddPropertyRecord(currentStr, currentStrLength, &propertyRecord);
+            //pick "name"
+            if(tkStrCon != m_token.tk)
+            {
+                scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+            }
 
-                    //check and consume ":"
-                    if(Scan() != tkColon )
-                    {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonNoColon);
-                    }
-                    Scan();
-                    Js::Var value = ParseObject();
-                    PropertyValueInfo info;
-                    object->SetProperty(propertyRecord->GetPropertyId(), value, PropertyOperation_None, &info);
+            // currentStrLength = length w/o null-termination
+            WCHAR* currentStr = scanner.GetCurrentString();
+            uint currentStrLength = scanner.GetCurrentStringLen();
 
-                    DynamicType* typeWithProperty = object->GetDynamicType();
-                    if(IsCaching() && !propertyRecord->IsNumeric() && !info.IsNoCache() && typeWithProperty->GetIsShared() && typeWithProperty->GetTypeHandler()->IsPathTypeHandler())
+            DynamicType* typeWithoutProperty = object->GetDynamicType();
+            if(IsCaching())
+            {
+                if(!previousCache)
+                {
+                    // This is the first property in the list - see if we have an existing cache for it.
+                    currentCache = typeCacheList->LookupWithKey(Js::HashedCharacterBuffer<WCHAR>(currentStr, currentStrLength), nullptr);
+                }
+                if(currentCache && currentCache->typeWithoutProperty == typeWithoutProperty &&
+                    currentCache->propertyRecord->Equals(JsUtil::CharacterBuffer<WCHAR>(currentStr, currentStrLength)))
+                {
+                    //check and consume ":"
+                    if(scanner.Scan() != tkColon )
                     {
-                        PropertyIndex propertyIndex = info.GetPropertyIndex();
-
-                        if(!previousCache)
-                        {
-                            // This is the first property in the set add it to the dictionary.
-                            currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
-                            typeCacheList->AddNew(propertyRecord, currentCache);
-                        }
-                        else if(!currentCache)
-                        {
-                            currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
-                            previousCache->next = currentCache;
-                        }
-                        else
-                        {
-                            // cache miss!!
-                            currentCache->Update(propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
-                        }
-                        previousCache = currentCache;
-                        currentCache = currentCache->next;
+                        scanner.ThrowSyntaxError(JSERR_JsonNoColon);
                     }
+                    scanner.Scan();
+
+                    // Cache all values from currentCache as there is a chance that ParseObject might change the cache
+                    DynamicType* typeWithProperty = currentCache->typeWithProperty;
+                    PropertyId propertyId = currentCache->propertyRecord->GetPropertyId();
+                    PropertyIndex propertyIndex = currentCache->propertyIndex;
+                    previousCache = currentCache;
+                    currentCache = currentCache->next;
+
+                    // fast path for type transition and property set
+                    object->EnsureSlots(typeWithoutProperty->GetTypeHandler()->GetSlotCapacity(),
+                        typeWithProperty->GetTypeHandler()->GetSlotCapacity(), scriptContext, typeWithProperty->GetTypeHandler());
+                    object->ReplaceType(typeWithProperty);
+                    Js::Var value = ParseObject(scanner);
+                    object->SetSlot(SetSlotArguments(propertyId, propertyIndex, value));
 
                     // if the next token is not a comma consider the list of members done.
                     if (tkComma != m_token.tk)
                         break;
-                    Scan();
+                    scanner.Scan();
+                    continue;
                 }
+            }
 
-                // check  and consume the ending '}"
-                CheckCurrentToken(tkRCurly, JSERR_JsonNoRcurly);
-                return object;
+            // slow path
+            Js::PropertyRecord const * propertyRecord;
+            scriptContext->GetOrAddPropertyRecord(currentStr, currentStrLength, &propertyRecord);
+
+            //check and consume ":"
+            if(scanner.Scan() != tkColon )
+            {
+                scanner.ThrowSyntaxError(JSERR_JsonNoColon);
+            }
+            scanner.Scan();
+            Js::Var value = ParseObject(scanner);
+            PropertyValueInfo info;
+            object->SetProperty(propertyRecord->GetPropertyId(), value, PropertyOperation_None, &info);
+
+            DynamicType* typeWithProperty = object->GetDynamicType();
+            if(IsCaching() && !propertyRecord->IsNumeric() && !info.IsNoCache() && typeWithProperty->GetIsShared() && typeWithProperty->GetTypeHandler()->IsPathTypeHandler())
+            {
+                PropertyIndex propertyIndex = info.GetPropertyIndex();
+
+                if(!previousCache)
+                {
+                    // This is the first property in the set add it to the dictionary.
+                    currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                    typeCacheList->AddNew(propertyRecord, currentCache);
+                }
+                else if(!currentCache)
+                {
+                    currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                    previousCache->next = currentCache;
+                }
+                else
+                {
+                    // cache miss!!
+                    currentCache->Update(propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                }
+                previousCache = currentCache;
+                currentCache = currentCache->next;
+            }
+
+            // if the next token is not a comma consider the list of members done.
+            if (tkComma != m_token.tk)
+                break;
+            scanner.Scan();
+        }
+
+        // check  and consume the ending '}"
+        CheckCurrentToken(scanner, tkRCurly, JSERR_JsonNoRcurly);
+    }
+
+    template <class Scanner>
+    Js::Var JSONParser::DeferObject(Scanner& scanner)
+    {
+        Assert(m_token.tk == tkLCurly && deferredSource != nullptr);
+
+        // The scanner is just past the '{'
+        charcount_t offset = (charcount_t)scanner.GetScanPosition() - 1;
+        SkipValue(scanner);
+
+        if (deferredObjectType == nullptr)
+        {
+            deferredObjectType = Js::LazyJSONObject::CreateDeferredType(scriptContext);
+        }
+        Js::DynamicObject* object = Js::LazyJSONObject::New(deferredSource, offset, deferredObjectType);
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(object));
+        return object;
+    }
+
+    template <class Scanner>
+    void JSONParser::SkipValue(Scanner& scanner)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
+
+        switch (m_token.tk)
+        {
+        case tkFltCon:
+        case tkStrCon:
+        case tkTRUE:
+        case tkFALSE:
+        case tkNULL:
+            scanner.Scan();
+            return;
+
+        case tkSub:  // unary minus
+            if (scanner.Scan() != tkFltCon)
+            {
+                scanner.ThrowSyntaxError(JSERR_JsonBadNumber);
             }
+            scanner.Scan();
+            return;
+
+        case tkLBrack:
+            //skip '['
+            scanner.Scan();
+            while (tkRBrack != m_token.tk)
+            {
+                SkipValue(scanner);
+                if (tkComma != m_token.tk)
+                    break;
+                scanner.Scan();
+                if (tkRBrack == m_token.tk)
+                {
+                    scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+                }
+            }
+            CheckCurrentToken(scanner, tkRBrack, JSERR_JsonNoRbrack);
+            return;
+
+        case tkLCurly:
+            //skip '{'
+            scanner.Scan();
+            if (tkRCurly == m_token.tk)
+            {
+                scanner.Scan();
+                return;
+            }
+            while (true)
+            {
+                if (tkStrCon != m_token.tk)
+                {
+                    scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+                }
+                if (scanner.Scan() != tkColon)
+                {
+                    scanner.ThrowSyntaxError(JSERR_JsonNoColon);
+                }
+                scanner.Scan();
+                SkipValue(scanner);
+                if (tkComma != m_token.tk)
+                    break;
+                scanner.Scan();
+            }
+            CheckCurrentToken(scanner, tkRCurly, JSERR_JsonNoRcurly);
+            return;
 
         default:
-            m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
+            scanner.ThrowSyntaxError(JSERR_JsonSyntax);
         }
     }
 } // namespace JSON
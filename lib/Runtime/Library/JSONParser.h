@@ -4,6 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 #pragma once
 #include "JSONScanner.h"
+#include "JSONUtf8Scanner.h"
 
 namespace JSON
 {
@@ -50,28 +51,43 @@ namespace JSON
     {
     public:
         JSONParser(Js::ScriptContext* sc, Js::RecyclableObject* rv) : scriptContext(sc),
-            reviver(rv),  arenaAllocatorObject(nullptr), arenaAllocator(nullptr), typeCacheList(nullptr)
+            reviver(rv),  arenaAllocatorObject(nullptr), arenaAllocator(nullptr), typeCacheList(nullptr),
+            deferredSource(nullptr), deferredObjectType(nullptr), nestingDepth(0)
         {
         };
         void Finalizer();
 
         Js::Var Parse(LPCWSTR str, uint length);
+        Js::Var Parse(const utf8char_t* str, size_t length);
         Js::Var Parse(Js::JavascriptString* input);
+        void ParseDeferredObject(Js::DynamicObject* object, Js::JavascriptString* input, charcount_t offset);
         Js::Var Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index = Js::JavascriptArray::InvalidIndex);
 
     private:
-        tokens Scan()
-        {
-            return m_scanner.Scan();
-        }
+        // ParseObject is shared by the char16 and UTF-8 inputs; both scanners produce the same tokens into m_token
+        template <class Scanner>
+        Js::Var ParseObject(Scanner& scanner);
+
+        // Parses the members of an object into it, from its '{' token through the closing '}'
+        template <class Scanner>
+        void ParseObjectMembers(Scanner& scanner, Js::DynamicObject* object);
 
-        Js::Var ParseObject();
+        // Validates the object at the current '{' token and returns a Js::LazyJSONObject for it
+        template <class Scanner>
+        Js::Var DeferObject(Scanner& scanner);
 
-        void CheckCurrentToken(int tk, int wErr)
+        // Consumes one value, reporting the same syntax errors as ParseObject, without creating anything
+        template <class Scanner>
+        void SkipValue(Scanner& scanner);
+
+        void EnsureArenaAllocator();
+
+        template <class Scanner>
+        void CheckCurrentToken(Scanner& scanner, int tk, int wErr)
         {
             if (m_token.tk != tk)
-                m_scanner.ThrowSyntaxError(wErr);
-            Scan();
+                scanner.ThrowSyntaxError(wErr);
+            scanner.Scan();
         }
 
         bool IsCaching()
@@ -81,12 +97,18 @@ namespace JSON
 
         Token m_token;
         JSONScanner m_scanner;
+        JSONUtf8Scanner m_utf8Scanner;
         Js::ScriptContext* scriptContext;
         Js::RecyclableObject* reviver;
         Js::TempGuestArenaAllocatorObject* arenaAllocatorObject;
         ArenaAllocator* arenaAllocator;
         typedef JsUtil::BaseDictionary<const Js::PropertyRecord *, JsonTypeCache*, ArenaAllocator, PowerOf2SizePolicy, Js::PropertyRecordStringHashComparer>  JsonTypeCacheList;
         JsonTypeCacheList* typeCacheList;
+
+        // Source of a lazy parse (see -LazyJSONParse); objects nested in another object or array are deferred
+        Js::JavascriptString* deferredSource;
+        Js::DynamicType* deferredObjectType;
+        uint nestingDepth;
         static const uint MIN_CACHE_LENGTH = 50; // Use Json type cache only if the JSON string is larger than this constant.
     };
 } // namespace JSON
@@ -8,10 +8,25 @@
 namespace Js
 {
 
+void
+JSONStringBuilder::Flush()
+{
+    // Only a builder with a sink runs out of room; otherwise the buffer was sized by JSONStringifier
+    AssertOrFailFast(this->sink != nullptr);
+    if (this->currentLocation != this->bufferStart)
+    {
+        this->sink->Write(this->bufferStart, static_cast<charcount_t>(this->currentLocation - this->bufferStart));
+        this->currentLocation = this->bufferStart;
+    }
+}
+
 void
 JSONStringBuilder::AppendCharacter(char16 character)
 {
-    AssertOrFailFast(this->currentLocation < endLocation);
+    if (this->currentLocation >= endLocation)
+    {
+        this->Flush();
+    }
     *this->currentLocation = character;
     ++this->currentLocation;
 }
@@ -19,7 +34,16 @@ JSONStringBuilder::AppendCharacter(char16 character)
 void
 JSONStringBuilder::AppendBuffer(_In_ const char16* buffer, charcount_t length)
 {
-    AssertOrFailFast(this->currentLocation + length <= endLocation);
+    while (this->currentLocation + length > endLocation)
+    {
+        AssertOrFailFast(this->sink != nullptr);
+        const charcount_t available = static_cast<charcount_t>(endLocation - this->currentLocation);
+        wmemcpy_s(this->currentLocation, available, buffer, available);
+        this->currentLocation += available;
+        buffer += available;
+        length -= available;
+        this->Flush();
+    }
     wmemcpy_s(this->currentLocation, length, buffer, length);
     this->currentLocation += length;
 }
@@ -286,6 +310,11 @@ void
 JSONStringBuilder::Build()
 {
     this->AppendJSONPropertyString(this->jsonContent);
+    if (this->sink != nullptr)
+    {
+        this->Flush();
+        return;
+    }
     // Null terminate the string
     AssertOrFailFast(this->currentLocation == endLocation);
     *this->currentLocation = _u('\0');
@@ -299,6 +328,8 @@ JSONStringBuilder::JSONStringBuilder(
     _In_opt_ const char16* gap,
     charcount_t gapLength) :
         scriptContext(scriptContext),
+        sink(nullptr),
+        bufferStart(buffer),
         endLocation(buffer + bufferLength - 1),
         currentLocation(buffer),
         jsonContent(jsonContent),
@@ -308,4 +339,26 @@ JSONStringBuilder::JSONStringBuilder(
 {
 }
 
+JSONStringBuilder::JSONStringBuilder(
+    _In_ ScriptContext* scriptContext,
+    _In_ JSONProperty* jsonContent,
+    _In_ JSONStringSink* sink,
+    _In_ char16* buffer,
+    charcount_t bufferLength,
+    _In_opt_ const char16* gap,
+    charcount_t gapLength) :
+        scriptContext(scriptContext),
+        sink(sink),
+        bufferStart(buffer),
+        // No terminator is written, so the whole buffer is used
+        endLocation(buffer + bufferLength),
+        currentLocation(buffer),
+        jsonContent(jsonContent),
+        gap(gap),
+        gapLength(gapLength),
+        indentLevel(0)
+{
+    Assert(bufferLength != 0);
+}
+
 } //namespace Js
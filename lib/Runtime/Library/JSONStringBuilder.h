@@ -8,10 +8,20 @@
 namespace Js
 {
 
+// Receives the output of a JSONStringBuilder that writes through a fixed-size buffer instead of building
+// the whole string; each call gets the next piece of the string, in order
+class JSONStringSink
+{
+public:
+    virtual void Write(_In_reads_(length) const char16* buffer, charcount_t length) = 0;
+};
+
 class JSONStringBuilder
 {
 private:
     ScriptContext* scriptContext;
+    JSONStringSink* sink;
+    char16* bufferStart;
     const char16* endLocation;
     char16* currentLocation;
     JSONProperty* jsonContent;
@@ -19,6 +29,7 @@ class JSONStringBuilder
     charcount_t gapLength;
     uint32 indentLevel;
 
+    void Flush();
     void AppendGap(uint32 count);
     void AppendCharacter(char16 character);
     void AppendBuffer(_In_ const char16* buffer, charcount_t length);
@@ -36,6 +47,14 @@ class JSONStringBuilder
         charcount_t bufferLength,
         _In_opt_ const char16* gap,
         charcount_t gapLength);
+    JSONStringBuilder(
+        _In_ ScriptContext* scriptContext,
+        _In_ JSONProperty* jsonContent,
+        _In_ JSONStringSink* sink,
+        _In_ char16* buffer,
+        charcount_t bufferLength,
+        _In_opt_ const char16* gap,
+        charcount_t gapLength);
     void Build();
 };
 
@@ -434,18 +434,29 @@ JSONStringifier::AppendObjectElement(
     // Undefined result is not concatenated
     if (prop->propertyValue.type != JSONContentType::Undefined)
     {
-        // Increase length for the name of the property
-        this->totalStringLength = UInt32Math::Add(this->totalStringLength, CalculateStringElementLength(propertyName));
-        // Increment length for concatenation of ":"
-        UInt32Math::Inc(this->totalStringLength);
-        if (this->gapLength != 0)
-        {
-            // If gap is specified, a space is appended
-            UInt32Math::Inc(this->totalStringLength);
-        }
+        this->PushObjectElement(CalculateStringElementLength(propertyName), jsonObject, prop);
+    }
+}
 
-        jsonObject->Push(*prop);
+void
+JSONStringifier::PushObjectElement(
+    charcount_t propertyNameLength,
+    _In_ JSONObject* jsonObject,
+    _In_ JSONObjectProperty* prop)
+{
+    Assert(prop->propertyValue.type != JSONContentType::Undefined);
+
+    // Increase length for the name of the property
+    this->totalStringLength = UInt32Math::Add(this->totalStringLength, propertyNameLength);
+    // Increment length for concatenation of ":"
+    UInt32Math::Inc(this->totalStringLength);
+    if (this->gapLength != 0)
+    {
+        // If gap is specified, a space is appended
+        UInt32Math::Inc(this->totalStringLength);
     }
+
+    jsonObject->Push(*prop);
 }
 
 void
@@ -582,10 +593,15 @@ JSONStringifier::ReadObject(_In_ RecyclableObject* obj, _In_ JSONObjectStack* ob
     {
         // Enumerating proxies is different than normal objects, so enumerate them separately
         JavascriptProxy* proxyObject = JavascriptOperators::TryFromVar<JavascriptProxy>(obj);
+        ObjectPlan* plan = nullptr;
         if (proxyObject != nullptr)
         {
             this->ReadProxy(proxyObject, jsonObject, &stack);
         }
+        else if ((plan = this->GetObjectPlan(obj)) != nullptr)
+        {
+            this->ReadObjectWithPlan(UnsafeVarTo<DynamicObject>(obj), plan, jsonObject, &stack);
+        }
         else
         {
             JavascriptStaticEnumerator enumerator;
@@ -627,6 +643,116 @@ JSONStringifier::ReadObject(_In_ RecyclableObject* obj, _In_ JSONObjectStack* ob
     return jsonObject;
 }
 
+JSONStringifier::ObjectPlan*
+JSONStringifier::GetObjectPlan(_In_ RecyclableObject* obj)
+{
+    // Plans read values straight out of the slots, so only ordinary objects of this context qualify. Cross-site
+    // objects need their values marshalled, and objects with indexed properties enumerate those first.
+    if (!CONFIG_FLAG(JSONStringifyPlans) ||
+        !VirtualTableInfo<DynamicObject>::HasVirtualTable(obj) ||
+        obj->GetScriptContext() != this->scriptContext)
+    {
+        return nullptr;
+    }
+#if ENABLE_TTD
+    if (this->scriptContext->GetThreadContext()->IsRuntimeInTTDMode())
+    {
+        return nullptr;
+    }
+#endif
+
+    DynamicObject* dynamicObject = UnsafeVarTo<DynamicObject>(obj);
+    if (dynamicObject->HasObjectArray())
+    {
+        return nullptr;
+    }
+
+    DynamicType* type = dynamicObject->GetDynamicType();
+    EnumeratorCache* cache = this->scriptContext->GetLibrary()->GetStringifyPlanCache(type);
+    if (cache->type != type)
+    {
+        // Types that can't have a plan are cached too, with no data, so they are only examined once
+        cache->data = this->CreateObjectPlan(dynamicObject);
+        cache->type = type;
+    }
+    return static_cast<ObjectPlan*>(cache->data);
+}
+
+JSONStringifier::ObjectPlan*
+JSONStringifier::CreateObjectPlan(_In_ DynamicObject* obj)
+{
+    // A shared path type never changes its properties in place (adding, deleting or reconfiguring one moves the
+    // object to another type), so the property list and slots found here hold for every object of the type.
+    DynamicType* type = obj->GetDynamicType();
+    DynamicTypeHandler* typeHandler = type->GetTypeHandler();
+    if (!type->GetIsShared() || !typeHandler->IsPathTypeHandler())
+    {
+        return nullptr;
+    }
+
+    const uint maxPropertyCount = static_cast<uint>(typeHandler->GetPropertyCount());
+    ObjectPlan* plan = RecyclerNewPlusZ(this->scriptContext->GetRecycler(), AllocSizeMath::Mul(maxPropertyCount, sizeof(ObjectPlanEntry)), ObjectPlan);
+
+    uint propertyCount = 0;
+    for (PropertyIndex index = 0; ; ++index)
+    {
+        JavascriptString* propertyName = nullptr;
+        PropertyId propertyId = Constants::NoProperty;
+        PropertyAttributes attributes = PropertyNone;
+        PropertyValueInfo info;
+        if (!typeHandler->FindNextProperty(this->scriptContext, index, &propertyName, &propertyId, &attributes, type, type, EnumeratorFlags::None, obj, &info))
+        {
+            break;
+        }
+        if (IsInternalPropertyId(propertyId))
+        {
+            continue;
+        }
+
+        // Accessors and read-only properties don't report a slot; those objects take the enumerator path
+        if (info.IsNoCache() || this->scriptContext->GetPropertyName(propertyId)->IsNumeric())
+        {
+            return nullptr;
+        }
+
+        AssertOrFailFast(propertyCount < maxPropertyCount);
+        ObjectPlanEntry* entry = &plan->entries[propertyCount++];
+        entry->propertyName = propertyName;
+        entry->slotIndex = info.GetPropertyIndex();
+        entry->propertyNameLength = CalculateStringElementLength(propertyName);
+    }
+
+    plan->propertyCount = propertyCount;
+    return plan;
+}
+
+void
+JSONStringifier::ReadObjectWithPlan(_In_ DynamicObject* obj, _In_ ObjectPlan* plan, _In_ JSONObject* jsonObject, _In_ JSONObjectStack* objectStack)
+{
+    DynamicType* type = obj->GetDynamicType();
+    for (uint i = 0; i < plan->propertyCount; ++i)
+    {
+        const ObjectPlanEntry* entry = &plan->entries[i];
+
+        JSONObjectProperty prop;
+        prop.propertyName = entry->propertyName;
+
+        // A toJSON method or the replacer function may have reshaped the object; the property list stays the one
+        // taken at the start, as with the enumerator's snapshot, but values are then read the regular way.
+        Var value = (obj->GetDynamicType() == type)
+            ? obj->GetSlot(entry->slotIndex)
+            : this->ReadValue(entry->propertyName, nullptr, obj);
+
+        this->ReadProperty(entry->propertyName, obj, &prop.propertyValue, value, objectStack);
+
+        // Undefined result is not concatenated
+        if (prop.propertyValue.type != JSONContentType::Undefined)
+        {
+            this->PushObjectElement(entry->propertyNameLength, jsonObject, &prop);
+        }
+    }
+}
+
 Var
 JSONStringifier::CallReplacerFunction(_In_opt_ RecyclableObject* holder, _In_ JavascriptString* key, _In_ Var value)
 {
@@ -48,6 +48,22 @@ class JSONStringifier
 
     typedef SList<PropertyListElement, Recycler> PropertyList;
 
+    // Serialization plan for the objects of one shared path type: their enumerable own properties in order, with
+    // the slot that holds each value and the stringified length of each name. Plans are kept per type in the
+    // library's stringify plan cache, which is cleared on every collection like the other enumerator caches.
+    struct ObjectPlanEntry
+    {
+        Field(JavascriptString*) propertyName;
+        Field(PropertyIndex) slotIndex;
+        Field(charcount_t) propertyNameLength;
+    };
+
+    struct ObjectPlan
+    {
+        Field(uint) propertyCount;
+        Field(ObjectPlanEntry) entries[];
+    };
+
     ScriptContext* scriptContext;
     RecyclableObject* replacerFunction;
     PropertyList* propertyList;
@@ -68,6 +84,11 @@ class JSONStringifier
         _In_ JSONObject* jsonObject,
         _In_ JSONObjectProperty* prop);
 
+    void PushObjectElement(
+        charcount_t propertyNameLength,
+        _In_ JSONObject* jsonObject,
+        _In_ JSONObjectProperty* prop);
+
     void ReadObjectElement(
         _In_ JavascriptString* propertyName,
         _In_ uint32 numericIndex,
@@ -91,6 +112,9 @@ class JSONStringifier
     void CalculateStringifiedLength(uint32 propertyCount, charcount_t stepbackLength);
     void ReadProxy(_In_ JavascriptProxy* proxyObject, _In_ JSONObject* jsonObject, _In_ JSONObjectStack* stack);
     JSONObject* ReadObject(_In_ RecyclableObject* obj, _In_ JSONObjectStack* objectStack);
+    ObjectPlan* GetObjectPlan(_In_ RecyclableObject* obj);
+    ObjectPlan* CreateObjectPlan(_In_ DynamicObject* obj);
+    void ReadObjectWithPlan(_In_ DynamicObject* obj, _In_ ObjectPlan* plan, _In_ JSONObject* jsonObject, _In_ JSONObjectStack* objectStack);
     void SetNullProperty(_Out_ JSONProperty* prop);
     void SetNumericProperty(double value, _In_ Var valueVar, _Out_ JSONProperty* prop);
     static charcount_t CalculateStringElementLength(_In_ JavascriptString* str);
@@ -0,0 +1,401 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLibraryPch.h"
+#include "JSONUtf8Scanner.h"
+
+using namespace Js;
+
+namespace JSON
+{
+    JSONUtf8Scanner::JSONUtf8Scanner()
+        : allocatorObject(nullptr), allocator(nullptr), inputText(nullptr), inputEnd(nullptr), currentChar(nullptr),
+        pToken(nullptr), scriptContext(nullptr), currentIndex(0),
+        stringBuffer(inlineStringBuffer), stringBufferLength(InlineStringBufferLength)
+    {
+    }
+
+    void JSONUtf8Scanner::Finalizer()
+    {
+        // As with JSONScanner, only the allocator we created ourselves needs releasing; anything allocated on the
+        // parser's arena goes away with the parser.
+        if (this->allocatorObject != nullptr)
+        {
+            this->scriptContext->ReleaseTemporaryGuestAllocator(allocatorObject);
+        }
+    }
+
+    void JSONUtf8Scanner::Init(const utf8char_t* input, size_t len, Token* pOutToken, Js::ScriptContext* sc, ArenaAllocator* allocator)
+    {
+        // Note that allocator could be nullptr from JSONParser, if we could not reuse an allocator, keep our own
+        inputText = input;
+        inputEnd = input + len;
+        currentChar = input;
+        pToken = pOutToken;
+        scriptContext = sc;
+        this->allocator = allocator;
+    }
+
+    void JSONUtf8Scanner::EnsureStringBuffer(uint count)
+    {
+        if (count <= this->stringBufferLength - this->currentIndex)
+        {
+            return;
+        }
+
+        const uint requiredLength = UInt32Math::Add(this->currentIndex, count);
+        const uint newLength = max(requiredLength, UInt32Math::Mul(this->stringBufferLength, 2u));
+
+        if (this->allocator == nullptr)
+        {
+            this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONUtf8Scanner"));
+            this->allocator = this->allocatorObject->GetAllocator();
+        }
+
+        char16* newBuffer = AnewArray(this->allocator, char16, newLength);
+        js_wmemcpy_s(newBuffer, newLength, this->stringBuffer, this->currentIndex);
+        if (this->stringBuffer != this->inlineStringBuffer)
+        {
+            AdeleteArray(this->allocator, this->stringBufferLength, this->stringBuffer);
+        }
+
+        this->stringBuffer = newBuffer;
+        this->stringBufferLength = newLength;
+    }
+
+    tokens JSONUtf8Scanner::Scan()
+    {
+        while (currentChar < inputEnd)
+        {
+            switch(ReadNextChar())
+            {
+            case 0:
+                //EOF
+                currentChar--;
+                return (pToken->tk = tkEOF);
+
+            case '\t':
+            case '\r':
+            case '\n':
+            case ' ':
+                //WS - keep looping
+                break;
+
+            case '"':
+                //check for string
+                return ScanString();
+
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+                //decimal digit starts a number
+                currentChar--;
+                return ScanNumber();
+
+            case ',':
+                return (pToken->tk = tkComma);
+
+            case ':':
+                return (pToken->tk = tkColon);
+
+            case '[':
+                return (pToken->tk = tkLBrack);
+
+            case ']':
+                return (pToken->tk = tkRBrack);
+
+            case '-':
+                return (pToken->tk = tkSub);
+
+            case 'n':
+                //check for 'null'
+                if (currentChar + 2 < inputEnd && currentChar[0] == 'u' && currentChar[1] == 'l' && currentChar[2] == 'l')
+                {
+                    currentChar += 3;
+                    return (pToken->tk = tkNULL);
+                }
+                ThrowSyntaxError(JSERR_JsonIllegalChar);
+
+            case 't':
+                //check for 'true'
+                if (currentChar + 2 < inputEnd && currentChar[0] == 'r' && currentChar[1] == 'u' && currentChar[2] == 'e')
+                {
+                    currentChar += 3;
+                    return (pToken->tk = tkTRUE);
+                }
+                ThrowSyntaxError(JSERR_JsonIllegalChar);
+
+            case 'f':
+                //check for 'false'
+                if (currentChar + 3 < inputEnd && currentChar[0] == 'a' && currentChar[1] == 'l' && currentChar[2] == 's' && currentChar[3] == 'e')
+                {
+                    currentChar += 4;
+                    return (pToken->tk = tkFALSE);
+                }
+                ThrowSyntaxError(JSERR_JsonIllegalChar);
+
+            case '{':
+                return (pToken->tk = tkLCurly);
+
+            case '}':
+                return (pToken->tk = tkRCurly);
+
+            default:
+                ThrowSyntaxError(JSERR_JsonIllegalChar);
+            }
+        }
+
+        return (pToken->tk = tkEOF);
+    }
+
+    tokens JSONUtf8Scanner::ScanNumber()
+    {
+        // Verify the JSON grammar first; StrToDbl() accepts a larger syntax.
+        const utf8char_t* numberStart = currentChar;
+        if (!IsJSONNumber())
+        {
+            ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        currentChar = numberStart;
+
+        // The input isn't null terminated, so StrToDbl() can't be run over it in place. Widen every character that
+        // could belong to the number into the string buffer, which also keeps the conversion identical to JSONScanner.
+        const utf8char_t* numberEnd = numberStart;
+        while (numberEnd < inputEnd &&
+            (('0' <= *numberEnd && *numberEnd <= '9') || *numberEnd == '.' || *numberEnd == 'e' || *numberEnd == 'E' || *numberEnd == '+' || *numberEnd == '-'))
+        {
+            numberEnd++;
+        }
+
+        const uint numberLength = (uint)(numberEnd - numberStart);
+        this->currentIndex = 0;
+        EnsureStringBuffer(UInt32Math::Add(numberLength, 1));
+        for (uint i = 0; i < numberLength; i++)
+        {
+            this->stringBuffer[i] = (char16)numberStart[i];
+        }
+        this->stringBuffer[numberLength] = _u('\0');
+
+        const char16* end = nullptr;
+        double val = Js::NumberUtilities::StrToDbl(this->stringBuffer, &end, scriptContext);
+        if (end == this->stringBuffer)
+        {
+            ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        AssertMsg(!Js::JavascriptNumber::IsNan(val), "Bad result from string to double conversion");
+        pToken->tk = tkFltCon;
+        pToken->SetDouble(val, false);
+        currentChar = numberStart + (end - this->stringBuffer);
+        return tkFltCon;
+    }
+
+    bool JSONUtf8Scanner::IsJSONNumber()
+    {
+        bool firstDigitIsAZero = false;
+        if (PeekNextChar() == '0')
+        {
+            firstDigitIsAZero = true;
+            currentChar++;
+        }
+
+        //partial verification of number JSON grammar.
+        while (currentChar < inputEnd)
+        {
+            switch(ReadNextChar())
+            {
+            case 0:
+                return false;
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+                if (firstDigitIsAZero)
+                {
+                    return false;
+                }
+                break;
+
+            case '.':
+                {
+                    // at least one digit after '.'
+                    if (currentChar < inputEnd)
+                    {
+                        utf8char_t nch = ReadNextChar();
+                        return '0' <= nch && nch <= '9';
+                    }
+                    return false;
+                }
+            default:
+                return true;
+            }
+
+            firstDigitIsAZero = false;
+        }
+        return true;
+    }
+
+    char16 JSONUtf8Scanner::ScanEscape()
+    {
+        //JSON escape sequence in a string \", \/, \\, \b, \f, \n, \r, \t, unicode seq
+        // unlikely V5.8 regular chars are not escaped, i.e '\g'' in a string is illegal not 'g'
+        if (currentChar >= inputEnd)
+        {
+            ThrowSyntaxError(JSERR_JsonNoStrEnd);
+        }
+
+        utf8char_t ch = ReadNextChar();
+        switch (ch)
+        {
+        case 0:
+            currentChar--;
+            ThrowSyntaxError(JSERR_JsonNoStrEnd);
+
+        case '"':
+        case '/':
+        case '\\':
+            return (char16)ch;
+
+        case 'b':
+            return 0x08;
+
+        case 'f':
+            return 0x0C;
+
+        case 'n':
+            return 0x0A;
+
+        case 'r':
+            return 0x0D;
+
+        case 't':
+            return 0x09;
+
+        case 'u':
+            {
+                // 4 hex digits
+                if (currentChar + 3 >= inputEnd)
+                {
+                    //no room left for 4 hex chars
+                    ThrowSyntaxError(JSERR_JsonNoStrEnd);
+                }
+
+                int chcode = 0;
+                for (int i = 0; i < 4; i++)
+                {
+                    int tempHex;
+                    if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                    {
+                        ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                    }
+                    chcode = chcode * 0x10 + tempHex;
+                }
+                AssertMsg(chcode == (chcode & 0xFFFF), "Bad unicode code");
+                return (char16)chcode;
+            }
+
+        default:
+            // Any other '\o' is an error in JSON
+            ThrowSyntaxError(JSERR_JsonIllegalChar);
+        }
+    }
+
+    tokens JSONUtf8Scanner::ScanString()
+    {
+        this->currentIndex = 0;
+
+        while (currentChar < inputEnd)
+        {
+#if ENABLE_SSE2_FAST_PATHS
+            // Plain ASCII makes up most of a typical string body. Find the next byte that needs a closer look - the
+            // closing quote, a backslash, a control character or the lead/trail byte of a multi-byte sequence - sixteen
+            // bytes at a time, and widen everything before it directly into the string buffer. Bytes at or above 0x80
+            // are negative as signed chars, so a single signed compare against 0x20 catches both of the last two.
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i firstPrintable = _mm_set1_epi8(0x20);
+            const __m128i zero = _mm_setzero_si128();
+            while (inputEnd - currentChar >= (ptrdiff_t)sizeof(__m128i))
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(currentChar));
+                const int mask = _mm_movemask_epi8(_mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+                    _mm_cmplt_epi8(bytes, firstPrintable)));
+
+                EnsureStringBuffer(sizeof(__m128i));
+                char16* dst = this->stringBuffer + this->currentIndex;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpackhi_epi8(bytes, zero));
+
+                if (mask == 0)
+                {
+                    this->currentIndex += sizeof(__m128i);
+                    currentChar += sizeof(__m128i);
+                    continue;
+                }
+
+                // Keep only the characters before the special one; its widened copy is overwritten below
+                DWORD special;
+                _BitScanForward(&special, (DWORD)mask);
+                this->currentIndex += special;
+                currentChar += special;
+                break;
+            }
+
+            if (currentChar >= inputEnd)
+            {
+                break;
+            }
+#endif
+
+            const utf8char_t ch = ReadNextChar();
+            if (ch == '"')
+            {
+                //end of the string
+                OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): decoded UTF-8 string as '%.*s'\n"),
+                    GetCurrentStringLen(), GetCurrentString());
+                return (pToken->tk = tkStrCon);
+            }
+            else if (ch <= 0x1F)
+            {
+                //JSON doesn't accept \u0000 - \u001f range, LS(\u2028) and PS(\u2029) are ok
+                ThrowSyntaxError(JSERR_JsonIllegalChar);
+            }
+            else if (ch == '\\')
+            {
+                AppendChar(ScanEscape());
+            }
+            else if (ch < 0x80)
+            {
+                AppendChar((char16)ch);
+            }
+            else
+            {
+                // Invalid sequences decode to U+FFFD, the same as other UTF-8 input to the engine. Characters outside
+                // the BMP come back from Decode() as two halves of a surrogate pair.
+                currentChar--;
+                utf8::DecodeOptions options = utf8::doDefault;
+                do
+                {
+                    AppendChar(utf8::Decode(currentChar, inputEnd, options));
+                } while ((options & utf8::doSecondSurrogatePair) != 0);
+            }
+        }
+
+        // no ending '"' found
+        ThrowSyntaxError(JSERR_JsonNoStrEnd);
+    }
+} // namespace JSON
@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace JSON
+{
+    // JSON scanner over UTF-8 input, so JSON arriving as bytes (see JsParseJsonUtf8) can be parsed without first
+    // transcoding all of it to char16. Produces the same tokens as JSONScanner. String tokens are always decoded
+    // into the scanner's char16 buffer; on x64, runs of plain ASCII inside strings are found and widened sixteen
+    // bytes at a time.
+    class JSONUtf8Scanner
+    {
+    public:
+        JSONUtf8Scanner();
+        tokens Scan();
+        void Init(const utf8char_t* input, size_t len, Token* pOutToken,
+            ::Js::ScriptContext* sc, ArenaAllocator* allocator);
+
+        void Finalizer();
+        char16* GetCurrentString() { return stringBuffer; }
+        uint GetCurrentStringLen() { return currentIndex; }
+        size_t GetScanPosition() { return size_t(currentChar - inputText); }
+
+        void __declspec(noreturn) ThrowSyntaxError(int wErr)
+        {
+            char16 scanPos[24];
+            ::_i64tow_s((__int64)GetScanPosition(), scanPos, _countof(scanPos), 10);
+            Js::JavascriptError::ThrowSyntaxError(scriptContext, wErr, scanPos);
+        }
+
+    private:
+        // Strings up to this length are decoded into inlineStringBuffer, so small documents never need an allocator
+        static const uint InlineStringBufferLength = 64;
+
+        Js::TempGuestArenaAllocatorObject* allocatorObject;
+        ArenaAllocator* allocator;
+
+        // Makes room for at least count more characters after currentIndex
+        void EnsureStringBuffer(uint count);
+
+        inline utf8char_t ReadNextChar(void)
+        {
+            return *currentChar++;
+        }
+
+        inline utf8char_t PeekNextChar(void)
+        {
+            return *currentChar;
+        }
+
+        inline void AppendChar(char16 ch)
+        {
+            EnsureStringBuffer(1);
+            stringBuffer[currentIndex++] = ch;
+        }
+
+        tokens ScanString();
+        tokens ScanNumber();
+        char16 ScanEscape();
+        bool IsJSONNumber();
+
+        const utf8char_t* inputText;
+        const utf8char_t* inputEnd;
+        const utf8char_t* currentChar;
+
+        Token*   pToken;
+        ::Js::ScriptContext* scriptContext;
+
+        uint     currentIndex;
+        __field_ecount(stringBufferLength) char16* stringBuffer;
+        uint     stringBufferLength;
+        char16   inlineStringBuffer[InlineStringBufferLength];
+
+        friend class JSONParser;
+    };
+} // namespace JSON
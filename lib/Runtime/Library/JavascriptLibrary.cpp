@@ -3491,6 +3491,7 @@ namespace Js
         vtableAddresses[VTableValue::VtableInvalid] = Js::ScriptContextOptimizationOverrideInfo::InvalidVtable;
         VirtualTableRecorder<Js::PropertyString>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtablePropertyString);
         VirtualTableRecorder<Js::LazyJSONString>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtableLazyJSONString);
+        VirtualTableRecorder<Js::OneByteString>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtableOneByteString);
         VirtualTableRecorder<Js::JavascriptBoolean>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtableJavascriptBoolean);
         VirtualTableRecorder<Js::JavascriptArray>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtableJavascriptArray);
         VirtualTableRecorder<Js::Int8Array>::RecordVirtualTableAddress(vtableAddresses, VTableValue::VtableInt8Array);
@@ -6873,6 +6874,11 @@ namespace Js
         return GetEnumeratorCache<Cache::StringifyCacheSize>(type, &this->cache.stringifyCache);
     }
 
+    EnumeratorCache* JavascriptLibrary::GetStringifyPlanCache(Type* type)
+    {
+        return GetEnumeratorCache<Cache::StringifyPlanCacheSize>(type, &this->cache.stringifyPlanCache);
+    }
+
     template<uint cacheSlotCount> EnumeratorCache* JavascriptLibrary::GetEnumeratorCache(Type* type, Field(EnumeratorCache*)* cacheSlots)
     {
         // Size must be power of 2 for cache indexing to work
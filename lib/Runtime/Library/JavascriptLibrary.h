@@ -74,6 +74,7 @@ namespace Js
     {
         static const uint AssignCacheSize = 16;
         static const uint StringifyCacheSize = 16;
+        static const uint StringifyPlanCacheSize = 16;
         static const uint CreateKeysCacheSize = 16;
 
         Field(PropertyStringMap*) propertyStrings[80];
@@ -95,13 +96,14 @@ namespace Js
         Field(ScriptContextPolymorphicInlineCache*) toJSONCache;
         Field(EnumeratorCache*) assignCache;
         Field(EnumeratorCache*) stringifyCache;
+        Field(EnumeratorCache*) stringifyPlanCache;
         Field(EnumeratorCache*) createKeysCache;
 #if ENABLE_PROFILE_INFO
-#if DBG_DUMP || defined(DYNAMIC_PROFILE_STORAGE) || defined(RUNTIME_DATA_COLLECTION)
+#if DBG_DUMP || defined(DYNAMIC_PROFILE_PERSISTENCE) || defined(RUNTIME_DATA_COLLECTION)
         Field(DynamicProfileInfoList*) profileInfoList;
 #endif
 #endif
-        Cache() : toStringTagCache(nullptr), toJSONCache(nullptr), assignCache(nullptr), stringifyCache(nullptr) { }
+        Cache() : toStringTagCache(nullptr), toJSONCache(nullptr), assignCache(nullptr), stringifyCache(nullptr), stringifyPlanCache(nullptr) { }
     };
 
     class MissingPropertyTypeHandler;
@@ -1200,6 +1202,7 @@ namespace Js
         EnumeratorCache* GetObjectAssignCache(Type* type);
         EnumeratorCache* GetCreateKeysCache(Type* type);
         EnumeratorCache* GetStringifyCache(Type* type);
+        EnumeratorCache* GetStringifyPlanCache(Type* type);
 
         bool GetArrayObjectHasUserDefinedSpecies() const { return arrayObjectHasUserDefinedSpecies; }
         void SetArrayObjectHasUserDefinedSpecies(bool val) { arrayObjectHasUserDefinedSpecies = val; }
@@ -1082,12 +1082,11 @@ namespace Js
             const char16* inputStr = pThis->GetString();
             if (searchLen == 1)
             {
-                int i = position;
-                for(; i < len && inputStr[i] != *searchStr ; i++);
-                if (i < len)
-                {
-                    result = i;
-                }
+                result = CharUtilities::IndexOfChar(inputStr, len, *searchStr, position);
+            }
+            else if (CharUtilities::UseSimdSearch(searchLen))
+            {
+                result = CharUtilities::IndexOf(inputStr, len, searchStr, searchLen, position);
             }
             else
             {
@@ -1198,16 +1197,13 @@ namespace Js
         }
         else if (searchLen == 1)
         {
-            char16 const * current = searchUpperBound;
-            while (*current != *searchStr)
-            {
-                current--;
-                if (current < inputStr)
-                {
-                    return JavascriptNumber::ToVar(-1, scriptContext);
-                }
-            }
-            return JavascriptNumber::ToVar(current - inputStr, scriptContext);
+            int result = CharUtilities::LastIndexOfChar(inputStr, *searchStr, (charcount_t)(searchUpperBound - inputStr));
+            return JavascriptNumber::ToVar(result, scriptContext);
+        }
+        else if (CharUtilities::UseSimdSearch(searchLen))
+        {
+            int result = CharUtilities::LastIndexOf(inputStr, searchStr, searchLen, position);
+            return JavascriptNumber::ToVar(result, scriptContext);
         }
 
         // Structure for a partial ASCII Boyer-Moore
@@ -2248,47 +2244,10 @@ namespace Js
         if (useInvariant)
         {
             const char16 *pThisString = pThis->GetString();
-            bool isAscii = true;
-            for (charcount_t i = 0; i < pThisLength; i++)
-            {
-                if (pThisString[i] >= 0x80)
-                {
-                    isAscii = false;
-                    break;
-                }
-            }
-
-            if (isAscii)
+            if (CharUtilities::IsAscii(pThisString, pThisLength))
             {
                 char16 *ret = RecyclerNewArrayLeaf(scriptContext->GetRecycler(), char16, UInt32Math::Add(pThisLength, 1));
-                const char16 diffBetweenCases = 32;
-                for (charcount_t i = 0; i < pThisLength; i++)
-                {
-                    char16 cur = pThisString[i];
-                    if (toUpper)
-                    {
-                        if (cur >= _u('a') && cur <= _u('z'))
-                        {
-                            ret[i] = cur - diffBetweenCases;
-                        }
-                        else
-                        {
-                            ret[i] = cur;
-                        }
-                    }
-                    else
-                    {
-                        if (cur >= _u('A') && cur <= _u('Z'))
-                        {
-                            ret[i] = cur + diffBetweenCases;
-                        }
-                        else
-                        {
-                            ret[i] = cur;
-                        }
-                    }
-                }
-
+                CharUtilities::ToAsciiCase<toUpper>(pThisString, ret, pThisLength);
                 ret[pThisLength] = 0;
 
                 return JavascriptString::NewWithBuffer(ret, pThisLength, scriptContext);
@@ -3527,6 +3486,13 @@ namespace Js
         uint stringLen = stringLenOrig - start;
         uint substringLen = substring->GetLength();
 
+        // Without a Boyer-Moore search to fall back on, the vector search is still the faster one for long needles
+        if (substringLen >= 2 && (useBoyerMoore ? CharUtilities::UseSimdSearch(substringLen) : CharUtilities::UseSimd()))
+        {
+            int result = CharUtilities::IndexOf(stringOrig, stringLenOrig, substringSz, substringLen, start);
+            return result != -1 ? (uint)result : (uint)-1;
+        }
+
         if (useBoyerMoore && substringLen > 2)
         {
             JmpTable jmpTable;
@@ -0,0 +1,100 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLibraryPch.h"
+#include "Types/DeferredTypeHandler.h"
+#include "Library/JSON.h"
+
+namespace Js
+{
+    // Same slot layout as JavascriptLibrary::GetObjectType(), so a materialized object can take that type directly
+    typedef DeferredTypeHandler<LazyJSONObject::InitializeDeferredObject, DefaultDeferredTypeFilter, false, 0, sizeof(DynamicObject)> LazyJSONObjectTypeHandler;
+
+    LazyJSONObject::LazyJSONObject(_In_ JavascriptString* source, charcount_t sourceOffset, _In_ DynamicType* type) :
+        DynamicObject(type),
+        source(source),
+        sourceOffset(sourceOffset)
+    {
+        Assert(type->GetTypeHandler()->IsDeferredTypeHandler());
+    }
+
+    DynamicType* LazyJSONObject::CreateDeferredType(_In_ ScriptContext* scriptContext)
+    {
+        JavascriptLibrary* library = scriptContext->GetLibrary();
+        return DynamicType::New(scriptContext, TypeIds_Object, library->GetObjectPrototype(), nullptr,
+            LazyJSONObjectTypeHandler::GetDefaultInstance(), true, true);
+    }
+
+    LazyJSONObject* LazyJSONObject::New(_In_ JavascriptString* source, charcount_t sourceOffset, _In_ DynamicType* deferredType)
+    {
+        return RecyclerNew(deferredType->GetScriptContext()->GetRecycler(), LazyJSONObject, source, sourceOffset, deferredType);
+    }
+
+    bool __cdecl LazyJSONObject::InitializeDeferredObject(DynamicObject* instance, DeferredTypeHandlerBase* typeHandler, DeferredInitializeMode mode)
+    {
+        LazyJSONObject* lazyObject = UnsafeVarTo<LazyJSONObject>(instance);
+        ScriptContext* scriptContext = instance->GetScriptContext();
+        JavascriptLibrary* library = scriptContext->GetLibrary();
+
+        JavascriptString* source = lazyObject->source;
+        const charcount_t sourceOffset = lazyObject->sourceOffset;
+        Assert(source != nullptr);
+
+        // Parse the members into a scratch object first. If that throws (out of memory or out of stack, as the
+        // source was already validated), this object is left as it was and the next access tries again.
+        DynamicObject* members = DynamicObject::New(library->GetRecycler(), library->GetObjectType());
+        JSON::ParseDeferredObject(members, source, sourceOffset, scriptContext);
+
+        if (PHASE_TESTTRACE1(Js::JSONPhase))
+        {
+            Output::Print(_u("[JSON: materialized deferred object at offset %u]\n"), sourceOffset);
+            Output::Flush();
+        }
+
+        // Commit: turn into an ordinary empty object and take the members over. The regular property paths used from
+        // here on must not come back here. The lazy fields stay behind as unused memory, but the source string is no
+        // longer kept alive by this object.
+        lazyObject->source = nullptr;
+        if (VirtualTableInfo<CrossSiteObject<LazyJSONObject>>::HasVirtualTable(instance))
+        {
+            VirtualTableInfo<CrossSiteObject<DynamicObject>>::SetVirtualTable(instance);
+        }
+        else
+        {
+            VirtualTableInfo<DynamicObject>::SetVirtualTable(instance);
+        }
+
+        bool copied = false;
+        if (instance->GetPrototype() == library->GetObjectPrototype())
+        {
+            // Usually the scratch object can hand over its type and slots
+            instance->ReplaceType(library->GetObjectType());
+            copied = instance->TryCopy(members);
+            if (typeHandler->GetIsPrototype())
+            {
+                instance->SetIsPrototype();
+            }
+        }
+        else
+        {
+            // Someone changed the prototype before touching any property. This is rare enough to not bother with
+            // finding a shared type for it.
+            typeHandler->Convert(instance, mode, 0);
+        }
+
+        if (!copied)
+        {
+            // Members that ended up in a dictionary type, or a changed prototype: parse again straight into this
+            // object. The parse above succeeded from the same stack, so only running out of memory can stop this one.
+            JSON::ParseDeferredObject(instance, source, sourceOffset, scriptContext);
+        }
+        return true;
+    }
+
+    template <> bool VarIsImpl<LazyJSONObject>(RecyclableObject* obj)
+    {
+        return VirtualTableInfo<LazyJSONObject>::HasVirtualTable(obj) ||
+            VirtualTableInfo<CrossSiteObject<LazyJSONObject>>::HasVirtualTable(obj);
+    }
+} // namespace Js
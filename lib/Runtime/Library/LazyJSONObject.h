@@ -0,0 +1,34 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // An object from a large JSON.parse input whose members have not been parsed yet. The parser has already validated
+    // the object's text, so only its offset in the source is kept. The object has a deferred type handler; the first
+    // operation that needs its properties parses them into the object itself, which from then on is an ordinary
+    // DynamicObject with the same type JSONParser would have given it.
+    class LazyJSONObject : public DynamicObject
+    {
+    private:
+        Field(JavascriptString*) source;
+        Field(charcount_t) sourceOffset;
+
+        DEFINE_VTABLE_CTOR(LazyJSONObject, DynamicObject);
+        DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(LazyJSONObject);
+
+    public:
+        LazyJSONObject(_In_ JavascriptString* source, charcount_t sourceOffset, _In_ DynamicType* type);
+
+        // Creates the type shared by the lazy objects of one parse
+        static DynamicType* CreateDeferredType(_In_ ScriptContext* scriptContext);
+        static LazyJSONObject* New(_In_ JavascriptString* source, charcount_t sourceOffset, _In_ DynamicType* deferredType);
+
+        // Deferred type initializer that parses the members
+        static bool __cdecl InitializeDeferredObject(DynamicObject* instance, DeferredTypeHandlerBase* typeHandler, DeferredInitializeMode mode);
+    };
+
+    template <> bool VarIsImpl<LazyJSONObject>(RecyclableObject* obj);
+} // namespace Js
@@ -205,6 +205,32 @@ LazyJSONString::GetSz()
     return target;
 }
 
+void
+LazyJSONString::WriteTo(_In_ JSONStringSink* sink, _Out_writes_(bufferLength) char16* buffer, charcount_t bufferLength) const
+{
+    if (this->IsFinalized())
+    {
+        // Already built by GetSz, and the metadata is gone
+        const char16* str = this->UnsafeGetBuffer();
+        for (charcount_t offset = 0; offset < this->GetLength(); offset += bufferLength)
+        {
+            sink->Write(str + offset, min(bufferLength, this->GetLength() - offset));
+        }
+        return;
+    }
+
+    JSONStringBuilder builder(
+        this->GetScriptContext(),
+        this->jsonContent,
+        sink,
+        buffer,
+        bufferLength,
+        this->gap,
+        this->gapLength);
+
+    builder.Build();
+}
+
 template <> bool VarIsImpl<LazyJSONString>(RecyclableObject* obj)
 {
     return VirtualTableInfo<LazyJSONString>::HasVirtualTable(obj);
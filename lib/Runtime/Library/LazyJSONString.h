@@ -10,6 +10,7 @@ namespace Js
 struct JSONObjectProperty;
 struct JSONProperty;
 struct JSONArray;
+class JSONStringSink;
 
 enum class JSONContentType : uint8
 {
@@ -105,6 +106,9 @@ class LazyJSONString : public JavascriptString
 
     const char16* GetSz() override sealed;
 
+    // Writes the string to sink in pieces of at most bufferLength characters, without building it
+    void WriteTo(_In_ JSONStringSink* sink, _Out_writes_(bufferLength) char16* buffer, charcount_t bufferLength) const;
+
     virtual VTableValue DummyVirtualFunctionToHinderLinkerICF()
     {
         return VTableValue::VtableLazyJSONString;
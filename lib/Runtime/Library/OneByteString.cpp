@@ -0,0 +1,197 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLibraryPch.h"
+
+namespace Js
+{
+    OneByteString::OneByteString(_In_reads_(charLength) const char* content, charcount_t charLength, StaticType* type) :
+        JavascriptString(type),
+        oneByteBuffer(content),
+        propertyRecord(nullptr)
+    {
+        // Use SetLength to ensure length is valid
+        SetLength(charLength);
+    }
+
+    OneByteString* OneByteString::New(_In_reads_(charLength) const char* content, charcount_t charLength, JavascriptLibrary* library)
+    {
+        Recycler* recycler = library->GetRecycler();
+        char* buffer = RecyclerNewArrayLeaf(recycler, char, charLength);
+        js_memcpy_s(buffer, charLength, content, charLength);
+        return RecyclerNew(recycler, OneByteString, buffer, charLength, library->GetStringTypeStatic());
+    }
+
+    OneByteString* OneByteString::TryNewFromUtf8(_In_reads_(byteCount) const char* utf8, size_t byteCount, JavascriptLibrary* library)
+    {
+        // Latin-1 characters are encoded in UTF-8 either as a single byte below 0x80 or as the
+        // two byte sequences C2 80..C3 BF. Anything else needs the general decoder.
+        const uint8* src = reinterpret_cast<const uint8*>(utf8);
+        size_t charCount = 0;
+        bool isAscii = true;
+        for (size_t i = 0; i < byteCount; i++, charCount++)
+        {
+            if (src[i] < 0x80)
+            {
+                continue;
+            }
+            if ((src[i] & 0xFE) != 0xC2 || i + 1 >= byteCount || (src[i + 1] & 0xC0) != 0x80)
+            {
+                return nullptr;
+            }
+            isAscii = false;
+            i++;
+        }
+
+        // Empty and single character strings come from the library's caches
+        if (charCount < 2 || charCount > MaxCharCount)
+        {
+            return nullptr;
+        }
+
+        if (isAscii)
+        {
+            return New(utf8, (charcount_t)charCount, library);
+        }
+
+        Recycler* recycler = library->GetRecycler();
+        char* buffer = RecyclerNewArrayLeaf(recycler, char, charCount);
+        for (size_t i = 0, j = 0; i < byteCount; i++, j++)
+        {
+            if (src[i] < 0x80)
+            {
+                buffer[j] = (char)src[i];
+            }
+            else
+            {
+                buffer[j] = (char)(((src[i] & 0x03) << 6) | (src[i + 1] & 0x3F));
+                i++;
+            }
+        }
+        return RecyclerNew(recycler, OneByteString, buffer, (charcount_t)charCount, library->GetStringTypeStatic());
+    }
+
+    void OneByteString::Widen(_In_reads_(count) const char* src, charcount_t count, _Out_writes_(count) char16* dst)
+    {
+        const uint8* narrow = reinterpret_cast<const uint8*>(src);
+        for (charcount_t i = 0; i < count; i++)
+        {
+            dst[i] = (char16)narrow[i];
+        }
+    }
+
+    const char16* OneByteString::GetSz()
+    {
+        if (this->IsFinalized())
+        {
+            return this->UnsafeGetBuffer();
+        }
+
+        const charcount_t allocSize = this->SafeSzSize();
+        char16* target = RecyclerNewArrayLeaf(GetScriptContext()->GetRecycler(), char16, allocSize);
+        Widen(this->oneByteBuffer, this->GetLength(), target);
+        target[this->GetLength()] = _u('\0');
+
+        this->SetBuffer(target);
+
+        // Consumers of the char16 buffer are likely to keep using it, so don't hold on to both copies
+        this->oneByteBuffer = nullptr;
+        return target;
+    }
+
+    void OneByteString::CopyVirtual(
+        _Out_writes_(m_charLength) char16 *const buffer,
+        StringCopyInfoStack &nestedStringTreeCopyInfos,
+        const byte recursionDepth)
+    {
+        Assert(buffer);
+        Assert(!this->IsFinalized());   // CopyVirtual should only be called for unfinalized buffers
+        Widen(this->oneByteBuffer, this->GetLength(), buffer);
+    }
+
+    void OneByteString::GetPropertyRecord(_Out_ PropertyRecord const** propRecord, bool dontLookupFromDictionary)
+    {
+        if (this->propertyRecord)
+        {
+            *propRecord = this->propertyRecord;
+            return;
+        }
+
+        *propRecord = nullptr;
+        if (dontLookupFromDictionary)
+        {
+            return;
+        }
+
+        const charcount_t length = this->GetLength();
+        if (!this->IsFinalized() && length <= MaxStackWidenLength)
+        {
+            // The property record keeps its own copy of the name, so there is no need to widen into the heap
+            char16 name[MaxStackWidenLength];
+            Widen(this->oneByteBuffer, length, name);
+            GetScriptContext()->GetOrAddPropertyRecord(JsUtil::CharacterBuffer<WCHAR>(name, length), propRecord);
+        }
+        else
+        {
+            __super::GetPropertyRecord(propRecord, dontLookupFromDictionary);
+        }
+
+        if (*propRecord)
+        {
+            CachePropertyRecord(*propRecord);
+        }
+    }
+
+    void OneByteString::CachePropertyRecord(_In_ PropertyRecord const* propertyRecord)
+    {
+        this->propertyRecord = propertyRecord;
+        Assert(this->GetLength() == propertyRecord->GetLength());
+
+        // PropertyRecord has its own copy of the string content, which becomes our char16 buffer.
+        // This is okay because the PropertyRecord pointer will keep the data alive.
+        this->SetBuffer(propertyRecord->GetBuffer());
+        this->oneByteBuffer = nullptr;
+    }
+
+    void const * OneByteString::GetOriginalStringReference()
+    {
+        if (this->propertyRecord != nullptr)
+        {
+            return this->propertyRecord;
+        }
+        return this->IsFinalized() ? static_cast<const void*>(this->UnsafeGetBuffer()) : this->oneByteBuffer;
+    }
+
+    size_t OneByteString::GetAllocatedByteCount() const
+    {
+        if (!this->IsFinalized())
+        {
+            return this->GetLength();
+        }
+        return __super::GetAllocatedByteCount();
+    }
+
+    RecyclableObject* OneByteString::CloneToScriptContext(ScriptContext* requestContext)
+    {
+        if (this->propertyRecord != nullptr)
+        {
+            // Property records are shared among all script contexts on a thread
+            return requestContext->GetPropertyString(this->propertyRecord);
+        }
+
+        if (!this->IsFinalized())
+        {
+            // The narrow buffer is never written to, so the clone can share it
+            return RecyclerNew(requestContext->GetRecycler(), OneByteString, this->oneByteBuffer, this->GetLength(),
+                requestContext->GetLibrary()->GetStringTypeStatic());
+        }
+
+        return __super::CloneToScriptContext(requestContext);
+    }
+
+    template <> bool VarIsImpl<OneByteString>(RecyclableObject* obj)
+    {
+        return VirtualTableInfo<OneByteString>::HasVirtualTable(obj);
+    }
+} // namespace Js
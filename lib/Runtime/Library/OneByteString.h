@@ -0,0 +1,51 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // A string whose characters all fit in Latin-1 (U+0000..U+00FF), stored one byte per character.
+    // The char16 buffer is only materialized when GetSz() or GetString() is called, at which point
+    // the narrow buffer is dropped. Copying the string into a flattened concat tree, interning it as
+    // a property name and JsCopyStringOneByte all read the narrow buffer directly without widening.
+    class OneByteString : public JavascriptString
+    {
+    private:
+        Field(const char*) oneByteBuffer;           // null once widened
+        Field(const PropertyRecord*) propertyRecord;
+
+        // Property names up to this length are widened on the stack when interned
+        static const charcount_t MaxStackWidenLength = 64;
+
+    protected:
+        OneByteString(_In_reads_(charLength) const char* content, charcount_t charLength, StaticType* type);
+        DEFINE_VTABLE_CTOR(OneByteString, JavascriptString);
+
+    public:
+        static OneByteString* New(_In_reads_(charLength) const char* content, charcount_t charLength, JavascriptLibrary* library);
+
+        // Returns null if the UTF-8 input has fewer than two characters, is malformed, or has a character above U+00FF
+        static OneByteString* TryNewFromUtf8(_In_reads_(byteCount) const char* utf8, size_t byteCount, JavascriptLibrary* library);
+
+        static void Widen(_In_reads_(count) const char* src, charcount_t count, _Out_writes_(count) char16* dst);
+
+        const char* GetOneByteBuffer() const { return this->oneByteBuffer; }
+
+        const char16* GetSz() override sealed;
+        virtual void CopyVirtual(_Out_writes_(m_charLength) char16 *const buffer, StringCopyInfoStack &nestedStringTreeCopyInfos, const byte recursionDepth) override;
+        virtual void GetPropertyRecord(_Out_ PropertyRecord const** propRecord, bool dontLookupFromDictionary = false) override;
+        virtual void CachePropertyRecord(_In_ PropertyRecord const* propertyRecord) override;
+        virtual void const * GetOriginalStringReference() override;
+        virtual size_t GetAllocatedByteCount() const override;
+        virtual RecyclableObject* CloneToScriptContext(ScriptContext* requestContext) override;
+
+        virtual VTableValue DummyVirtualFunctionToHinderLinkerICF()
+        {
+            return VTableValue::VtableOneByteString;
+        }
+    };
+
+    template <> bool VarIsImpl<OneByteString>(RecyclableObject* obj);
+}
@@ -599,7 +599,7 @@ namespace Js
     }
 
     // RegExp.prototype.exec (ES5 15.10.6.2)
-    Var RegexHelper::RegexExecImpl(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input, bool noResult, void *const stackAllocationPointer)
+    Var RegexHelper::RegexExecImpl(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input, bool noResult, void *const stackAllocationPointer, CharCount startOffset)
     {
         UnifiedRegex::RegexPattern* pattern = regularExpression->GetPattern();
 
@@ -616,6 +616,13 @@ namespace Js
             return scriptContext->GetLibrary()->GetNull();
         }
 
+        // Jitted code already scanned up to startOffset without finding where a match could start
+        if (!isGlobal && !isSticky)
+        {
+            Assert(startOffset <= inputLength);
+            offset = startOffset;
+        }
+
         UnifiedRegex::GroupInfo match; // initially undefined
         if (offset <= inputLength)
         {
@@ -2251,31 +2258,33 @@ namespace Js
         return RegexHelper::CheckCrossContextAndMarshalResult(result, entryFunctionContext);
     }
 
-    Var RegexHelper::RegexExecResultUsed(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input)
+    Var RegexHelper::RegexExecResultUsed(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input, CharCount startOffset)
     {
-        return RegexHelper::RegexExec(scriptContext, regularExpression, input, false);
+        return RegexHelper::RegexExec(scriptContext, regularExpression, input, false, nullptr, startOffset);
     }
 
-    Var RegexHelper::RegexExecResultUsedAndMayBeTemp(void *const stackAllocationPointer, ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input)
+    Var RegexHelper::RegexExecResultUsedAndMayBeTemp(void *const stackAllocationPointer, ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input, CharCount startOffset)
     {
-        return RegexHelper::RegexExec(scriptContext, regularExpression, input, false, stackAllocationPointer);
+        return RegexHelper::RegexExec(scriptContext, regularExpression, input, false, stackAllocationPointer, startOffset);
     }
 
-    Var RegexHelper::RegexExecResultNotUsed(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input)
+    Var RegexHelper::RegexExecResultNotUsed(ScriptContext* scriptContext, JavascriptRegExp* regularExpression, JavascriptString* input, CharCount startOffset)
     {
         if (!PHASE_OFF1(Js::RegexResultNotUsedPhase))
         {
-            return RegexHelper::RegexExec(scriptContext, regularExpression, input, true);
+            return RegexHelper::RegexExec(scriptContext, regularExpression, input, true, nullptr, startOffset);
         }
         else
         {
-            return RegexHelper::RegexExec(scriptContext, regularExpression, input, false);
+            return RegexHelper::RegexExec(scriptContext, regularExpression, input, false, nullptr, startOffset);
         }
     }
 
-    Var RegexHelper::RegexExec(ScriptContext* entryFunctionContext, JavascriptRegExp* regularExpression, JavascriptString* input, bool noResult, void *const stackAllocationPointer)
+    Var RegexHelper::RegexExec(ScriptContext* entryFunctionContext, JavascriptRegExp* regularExpression, JavascriptString* input, bool noResult, void *const stackAllocationPointer, CharCount startOffset)
     {
-        Var result = RegexHelper::RegexExecImpl(entryFunctionContext, regularExpression, input, noResult, stackAllocationPointer);
+        PHASE_PRINT_TRACE1(Js::ExecSyncToCharPrefilterPhase, _u("ExecSyncToCharPrefilter: matching \"%s\" from offset %u\n"), input->GetString(), startOffset);
+
+        Var result = RegexHelper::RegexExecImpl(entryFunctionContext, regularExpression, input, noResult, stackAllocationPointer, startOffset);
         return RegexHelper::CheckCrossContextAndMarshalResult(result, entryFunctionContext);
     }
 
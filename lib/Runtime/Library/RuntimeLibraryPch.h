@@ -22,6 +22,7 @@
 #include "Library/DataView.h"
 
 #include "Library/LazyJSONString.h"
+#include "Library/LazyJSONObject.h"
 #include "Library/JSONStringBuilder.h"
 #include "Library/JSONStringifier.h"
 #include "Library/ProfileString.h"
@@ -3554,6 +3554,65 @@ VirtualAllocEx(
          IN DWORD flAllocationType,
          IN DWORD flProtect);
 
+/*++
+Function:
+PAL_VirtualReserveAligned
+
+Reserves dwSize bytes at an address aligned to dwAlignment (a power of 2,
+multiple of 64K). Release the region with VirtualFree(MEM_RELEASE).
+
+--*/
+PALIMPORT
+LPVOID
+PALAPI
+PAL_VirtualReserveAligned(
+         IN SIZE_T dwSize,
+         IN SIZE_T dwAlignment);
+
+/*++
+Function:
+PAL_VirtualAdviseHugePages
+
+Asks the OS to back committed pages with transparent huge pages. Committing
+remaps the range, so call this again after each commit.
+
+--*/
+PALIMPORT
+BOOL
+PALAPI
+PAL_VirtualAdviseHugePages(
+         IN LPVOID lpAddress,
+         IN SIZE_T dwSize);
+
+#define NUMA_NO_PREFERRED_NODE ((DWORD) -1)
+
+/*++
+Function:
+PAL_VirtualBindToNumaNode
+
+Sets a preferred NUMA node for committed pages that have not been touched
+yet. Committing remaps the range, so call this again after each commit.
+
+--*/
+PALIMPORT
+BOOL
+PALAPI
+PAL_VirtualBindToNumaNode(
+         IN LPVOID lpAddress,
+         IN SIZE_T dwSize,
+         IN DWORD nndPreferred);
+
+PALIMPORT
+LPVOID
+PALAPI
+VirtualAllocExNuma(
+         IN HANDLE hProcess,
+         IN LPVOID lpAddress,
+         IN SIZE_T dwSize,
+         IN DWORD flAllocationType,
+         IN DWORD flProtect,
+         IN DWORD nndPreferred);
+
 PALIMPORT
 BOOL
 PALAPI
@@ -5749,6 +5808,19 @@ BOOL
 PALAPI
 PAL_HasGetCurrentProcessorNumber();
 
+PALIMPORT
+BOOL
+PALAPI
+GetNumaHighestNodeNumber(
+    OUT PULONG HighestNodeNumber);
+
+PALIMPORT
+BOOL
+PALAPI
+GetNumaProcessorNode(
+    IN UCHAR Processor,
+    OUT PUCHAR NodeNumber);
+
 #define FORMAT_MESSAGE_ALLOCATE_BUFFER 0x00000100
 #define FORMAT_MESSAGE_IGNORE_INSERTS  0x00000200
 #define FORMAT_MESSAGE_FROM_STRING     0x00000400
@@ -36,6 +36,10 @@ Module Name:
 #include <unistd.h>
 #include <limits.h>
 
+#ifdef __LINUX__
+#include <sys/syscall.h>
+#endif
+
 #if HAVE_VM_ALLOCATE
 #include <mach/vm_map.h>
 #include <mach/mach_init.h>
@@ -1685,6 +1689,35 @@ VirtualAllocEx(
     return VirtualAlloc(lpAddress, dwSize, flAllocationType, flProtect);
 }
 
+/*++
+Function:
+  VirtualAllocExNuma
+
+  Same as VirtualAllocEx, but committed pages prefer the physical memory of
+  node nndPreferred (see PAL_VirtualBindToNumaNode). Reservations carry no
+  policy: committing remaps the range and would drop it.
+
+See MSDN doc.
+--*/
+LPVOID
+PALAPI
+VirtualAllocExNuma(
+         IN HANDLE hProcess,
+         IN LPVOID lpAddress,       /* Region to reserve or commit */
+         IN SIZE_T dwSize,          /* Size of Region */
+         IN DWORD flAllocationType, /* Type of allocation */
+         IN DWORD flProtect,        /* Type of access protection */
+         IN DWORD nndPreferred)     /* Preferred NUMA node */
+{
+    LPVOID pRetVal = VirtualAlloc(lpAddress, dwSize, flAllocationType, flProtect);
+    if (pRetVal != NULL && (flAllocationType & MEM_COMMIT) != 0 && nndPreferred != NUMA_NO_PREFERRED_NODE)
+    {
+        // The node is only a preference; failing to apply it is not an allocation failure
+        PAL_VirtualBindToNumaNode(pRetVal, dwSize, nndPreferred);
+    }
+    return pRetVal;
+}
+
 __attribute__((no_instrument_function, noinline))
 static bool PAL_Initialize_Check_Once()
 {
@@ -1997,6 +2030,100 @@ VirtualAlloc(
 #undef KB64
 #undef MB64
 
+LPVOID
+PALAPI
+PAL_VirtualReserveAligned(
+         IN SIZE_T dwSize,          /* Size of Region */
+         IN SIZE_T dwAlignment)     /* Alignment of the returned address */
+{
+    _ASSERTE(dwAlignment != 0 && (dwAlignment & (dwAlignment - 1)) == 0);
+
+    char * address = (char *)VirtualAlloc(nullptr, dwSize, MEM_RESERVE, PAGE_READWRITE);
+    if (address == nullptr || ((ULONG_PTR)address % dwAlignment) == 0)
+    {
+        return address;
+    }
+    VirtualFree(address, 0, MEM_RELEASE);
+
+    // Over-reserve by the alignment, then trim the unaligned ends
+    address = (char *)VirtualAlloc_(nullptr, dwSize + dwAlignment, MEM_RESERVE, PAGE_READWRITE);
+    if (address == nullptr)
+    {
+        return nullptr;
+    }
+
+    SIZE_T diff = ((ULONG_PTR)address % dwAlignment);
+    if (diff == 0)
+    {
+        // Keep the trailing slack reserved; it is never committed and goes away with MEM_RELEASE
+        return address;
+    }
+
+    char * alignedAddress = address + (dwAlignment - diff);
+    if (VirtualFreeEnclosing_(address, dwSize, dwAlignment, alignedAddress) == 0)
+    {
+        ASSERT("Unable to unmap the enclosing memory.\n");
+        return nullptr;
+    }
+    return alignedAddress;
+}
+
+BOOL
+PALAPI
+PAL_VirtualAdviseHugePages(
+         IN LPVOID lpAddress,       /* Committed region */
+         IN SIZE_T dwSize)          /* Size of Region */
+{
+#if defined(__LINUX__) && defined(MADV_HUGEPAGE)
+    UINT_PTR startBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+    SIZE_T memSize = (((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK) - startBoundary;
+    if (madvise((void *)startBoundary, memSize, MADV_HUGEPAGE) == 0)
+    {
+        return TRUE;
+    }
+    WARN("madvise(MADV_HUGEPAGE) failed! Error(%d)=%s\n", errno, strerror(errno));
+#endif
+    return FALSE;
+}
+
+/*++
+Function:
+  PAL_VirtualBindToNumaNode
+
+  Applies an MPOL_PREFERRED mbind to the range, through the raw syscall so
+  that no libnuma is needed. It only affects pages that have not been
+  touched yet, and does not change their protection. Other platforms
+  ignore the node.
+
+--*/
+BOOL
+PALAPI
+PAL_VirtualBindToNumaNode(
+         IN LPVOID lpAddress,       /* Committed region */
+         IN SIZE_T dwSize,          /* Size of Region */
+         IN DWORD nndPreferred)     /* Preferred NUMA node */
+{
+#if defined(__LINUX__) && defined(__NR_mbind)
+    const int mpolPreferred = 1; // MPOL_PREFERRED from <numaif.h>, which is not always installed
+    const unsigned long bitsPerMask = sizeof(unsigned long) * 8;
+    unsigned long nodeMask[4] = { 0 };
+    if (nndPreferred >= sizeof(nodeMask) * 8)
+    {
+        return FALSE;
+    }
+    nodeMask[nndPreferred / bitsPerMask] = 1UL << (nndPreferred % bitsPerMask);
+
+    UINT_PTR startBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+    SIZE_T memSize = (((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK) - startBoundary;
+    if (syscall(__NR_mbind, (void *)startBoundary, memSize, mpolPreferred, nodeMask, sizeof(nodeMask) * 8, 0) == 0)
+    {
+        return TRUE;
+    }
+    WARN("mbind() failed! Error(%d)=%s\n", errno, strerror(errno));
+#endif
+    return FALSE;
+}
+
 BOOL
 PALAPI
 VirtualFreeEx(
@@ -24,6 +24,7 @@ Revision History:
 #include "pal/palinternal.h"
 
 #include <sched.h>
+#include <pthread.h>
 #include <errno.h>
 #include <unistd.h>
 #include <sys/types.h>
@@ -357,6 +358,108 @@ PAL_GetLogicalCpuCountFromOS()
     return numLogicalCores;
 }
 
+// NUMA topology, read from sysfs on first use. Node 0xFF marks a processor with an unknown node.
+static pthread_once_t s_numaTopologyOnce = PTHREAD_ONCE_INIT;
+static ULONG s_highestNumaNode = 0;
+static UCHAR s_processorNumaNode[0x100];
+
+static void InitializeNumaTopology()
+{
+    ULONG highestNode = 0;
+
+#ifdef __LINUX__
+    // Format is a range list such as "0", "0-3" or "0,2-3"; the last number is the highest node
+    FILE * nodeFile = fopen("/sys/devices/system/node/possible", "r");
+    if (nodeFile != NULL)
+    {
+        char line[256];
+        if (fgets(line, sizeof(line), nodeFile) != NULL)
+        {
+            const char * lastNumber = line;
+            for (const char * current = line; *current != '\0'; current++)
+            {
+                if (*current == '-' || *current == ',')
+                {
+                    lastNumber = current + 1;
+                }
+            }
+            highestNode = (ULONG)strtoul(lastNumber, NULL, 10);
+        }
+        fclose(nodeFile);
+    }
+#endif // __LINUX__
+
+    const DWORD cpuCount = PAL_GetLogicalCpuCountFromOS();
+    for (ULONG processor = 0; processor < sizeof(s_processorNumaNode); processor++)
+    {
+        UCHAR processorNode = 0xFF;
+
+#ifdef __LINUX__
+        // sysfs links each cpu to its node as /sys/devices/system/cpu/cpuN/nodeM
+        for (ULONG node = 0; node <= highestNode && node < 0xFF; node++)
+        {
+            char nodePath[64];
+            snprintf(nodePath, sizeof(nodePath), "/sys/devices/system/cpu/cpu%u/node%u", (unsigned)processor, (unsigned)node);
+            if (access(nodePath, F_OK) == 0)
+            {
+                processorNode = (UCHAR)node;
+                break;
+            }
+        }
+#endif // __LINUX__
+
+        if (processorNode == 0xFF && highestNode == 0 && processor < cpuCount)
+        {
+            processorNode = 0;
+        }
+        s_processorNumaNode[processor] = processorNode;
+    }
+
+    s_highestNumaNode = highestNode;
+}
+
+/*++
+Function:
+  GetNumaHighestNodeNumber
+
+  On Linux the node list comes from sysfs. Other platforms, and machines
+  without NUMA support, report a single node 0.
+
+See MSDN doc.
+--*/
+BOOL
+PALAPI
+GetNumaHighestNodeNumber(
+    OUT PULONG HighestNodeNumber)
+{
+    pthread_once(&s_numaTopologyOnce, InitializeNumaTopology);
+    *HighestNodeNumber = s_highestNumaNode;
+    return TRUE;
+}
+
+/*++
+Function:
+  GetNumaProcessorNode
+
+See MSDN doc.
+--*/
+BOOL
+PALAPI
+GetNumaProcessorNode(
+    IN UCHAR Processor,
+    OUT PUCHAR NodeNumber)
+{
+    pthread_once(&s_numaTopologyOnce, InitializeNumaTopology);
+
+    *NodeNumber = s_processorNumaNode[Processor];
+    if (*NodeNumber == 0xFF)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return FALSE;
+    }
+    return TRUE;
+}
+
 size_t
 PALAPI
 PAL_GetLogicalProcessorCacheSizeFromOS()
@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -RecyclerNurseryCollect -testtrace:PartialCollect: allocates well past the nursery size, mostly
+// short-lived arrays, so that after the first full collection the recycler switches to minor collections.
+// The trace line in the baseline is printed by the first minor collection.
+
+var retained = [];
+for (var round = 0; round < 200; round++)
+{
+    for (var i = 0; i < 10000; i++)
+    {
+        var array = [round, i, round + i];
+        if (i % 100 === 0)
+        {
+            retained.push(array);
+        }
+    }
+}
+
+var sum = 0;
+for (var i = 0; i < retained.length; i++)
+{
+    sum += retained[i][2];
+}
+
+WScript.Echo(retained.length === 20000 && sum === 100990000 ? "pass" : "fail");
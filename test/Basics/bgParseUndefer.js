@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// Run with -BackgroundParse -Force:DeferParse: the functions below are compiled on the background thread
+// before their first call, and must behave as if they had been parsed on first call. -testtrace:BgParse
+// reports how many of the ten functions nested directly in this global code arrived with bytecode: all
+// of them by default, none with -BgParseUndeferBudget:0.
+
+var counter = 0;
+
+var modules = [
+  function (exports) {
+    var hidden = 10;
+    function add(x) { return x + hidden + counter; }
+    exports.add = add;
+    exports.bump = function () { hidden++; return hidden; };
+  },
+  function (exports) {
+    class Point {
+      constructor(x, y) { this.x = x; this.y = y; }
+      get length() { return Math.sqrt(this.x * this.x + this.y * this.y); }
+      static origin() { return new Point(0, 0); }
+    }
+    exports.Point = Point;
+  },
+  function (exports) {
+    exports.range = function* (n) { for (var i = 0; i < n; i++) { yield i; } };
+    exports.later = async function (v) { return await v; };
+    exports.defaults = (a, b = a * 2, ...rest) => a + b + rest.length;
+  },
+  function (exports) {
+    var local = "outer";
+    exports.evalLocal = function () { return eval("local"); };
+    exports.withArgs = function () { return arguments.length; };
+  }
+];
+
+function load(index) {
+  var exports = {};
+  modules[index](exports);
+  return exports;
+}
+
+function declaredLater() {
+  return "declared";
+}
+
+var tests = [
+  {
+    name: "Closures over module state",
+    body: function () {
+      var m = load(0);
+      assert.areEqual(11, m.add(1));
+      assert.areEqual(11, m.bump());
+      counter = 5;
+      assert.areEqual(17, m.add(1));
+    }
+  },
+  {
+    name: "Classes, generators, async and arrow functions",
+    body: function () {
+      var p = load(1);
+      assert.areEqual(5, new p.Point(3, 4).length);
+      assert.areEqual(0, p.Point.origin().x);
+
+      var f = load(2);
+      assert.areEqual([0, 1, 2], Array.from(f.range(3)));
+      assert.areEqual(7, f.defaults(2, 4, 0));
+      assert.areEqual(6, f.defaults(2));
+      assert.isTrue(f.later(1) instanceof Promise);
+    }
+  },
+  {
+    name: "eval and arguments in compiled functions",
+    body: function () {
+      var e = load(3);
+      assert.areEqual("outer", e.evalLocal());
+      assert.areEqual(3, e.withArgs(1, 2, 3));
+      assert.areEqual("declared", declaredLater());
+    }
+  },
+  {
+    name: "Function toString is unchanged",
+    body: function () {
+      assert.areEqual('function declaredLater() {\n  return "declared";\n}', declaredLater.toString());
+    }
+  }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -0,0 +1,196 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// Run with -LazyJSONParse -LazyJSONParseThreshold:1 so every input below takes the lazy path: objects nested in the
+// result are only validated by JSON.parse and get their members on first access. The results must be
+// indistinguishable from an eager parse.
+
+var text = JSON.stringify({
+  a: 1,
+  b: { c: "two", d: [3, { e: 4, "f g": null }], g: {} },
+  h: [{ i: true }, { i: false }, { j: -5.5e3 }],
+  "10": { k: "\"quoted\\" },
+  l: { m: { n: { o: { p: "deep" } } } }
+});
+
+function expected() {
+  return {
+    a: 1,
+    b: { c: "two", d: [3, { e: 4, "f g": null }], g: {} },
+    h: [{ i: true }, { i: false }, { j: -5.5e3 }],
+    "10": { k: "\"quoted\\" },
+    l: { m: { n: { o: { p: "deep" } } } }
+  };
+}
+
+var tests = [
+  {
+    name: "Nested property access",
+    body: function () {
+      var o = JSON.parse(text);
+      assert.areEqual(1, o.a);
+      assert.areEqual("two", o.b.c);
+      assert.areEqual(4, o.b.d[1].e);
+      assert.areEqual(null, o.b.d[1]["f g"]);
+      assert.areEqual(false, o.h[1].i);
+      assert.areEqual(-5500, o.h[2].j);
+      assert.areEqual("\"quoted\\", o["10"].k);
+      assert.areEqual("deep", o.l.m.n.o.p);
+      assert.areEqual(undefined, o.b.missing);
+      assert.isTrue("c" in o.b);
+      assert.isFalse("x" in o.b.g);
+    }
+  },
+  {
+    name: "Enumeration and stringify see the members in source order",
+    body: function () {
+      var o = JSON.parse(text);
+      assert.areEqual(["c", "d", "g"], Object.keys(o.b));
+      assert.areEqual(["10", "a", "b", "h", "l"], Object.keys(o));
+      var keys = [];
+      for (var key in o.h[0]) {
+        keys.push(key);
+      }
+      assert.areEqual(["i"], keys);
+      assert.areEqual(["e", "f g"], Object.getOwnPropertyNames(o.b.d[1]));
+      assert.areEqual(JSON.stringify(expected()), JSON.stringify(JSON.parse(text)));
+      assert.areEqual(text, JSON.stringify(JSON.parse(text)));
+    }
+  },
+  {
+    name: "Objects with the same shape behave alike",
+    body: function () {
+      var a = JSON.parse(text);
+      var b = JSON.parse(text);
+      for (var i = 0; i < 2; i++) {
+        assert.areEqual(true, a.h[0].i);
+        assert.areEqual(true, b.h[0].i);
+        assert.areEqual(false, a.h[1].i);
+      }
+    }
+  },
+  {
+    name: "Writes, deletes and defines before the first read",
+    body: function () {
+      var o = JSON.parse(text);
+      o.b.c = "changed";
+      o.b.added = 5;
+      assert.areEqual("changed", o.b.c);
+      assert.areEqual(5, o.b.added);
+      assert.areEqual(["c", "d", "g", "added"], Object.keys(o.b));
+
+      assert.isTrue(delete o.h[0].i);
+      assert.areEqual([], Object.keys(o.h[0]));
+
+      Object.defineProperty(o.h[2], "j", { value: 1, writable: false });
+      assert.areEqual(1, o.h[2].j);
+      assert.isFalse(Object.getOwnPropertyDescriptor(o.h[2], "j").writable);
+      assert.isTrue(Object.getOwnPropertyDescriptor(o.h[2], "j").enumerable);
+    }
+  },
+  {
+    name: "Freeze and prototype changes before the first read",
+    body: function () {
+      var o = JSON.parse(text);
+      Object.freeze(o.b);
+      assert.isTrue(Object.isFrozen(o.b));
+      assert.areEqual("two", o.b.c);
+      o.b.c = "ignored";
+      assert.areEqual("two", o.b.c);
+
+      var proto = { inherited: "yes", e: "shadowed" };
+      Object.setPrototypeOf(o.b.d[1], proto);
+      assert.areEqual(proto, Object.getPrototypeOf(o.b.d[1]));
+      assert.areEqual("yes", o.b.d[1].inherited);
+      assert.areEqual(4, o.b.d[1].e);
+      assert.areEqual(["e", "f g"], Object.keys(o.b.d[1]));
+
+      assert.areEqual(Object.prototype, Object.getPrototypeOf(o.h[0]));
+      assert.isFalse(Object.isExtensible(Object.preventExtensions(o.l)));
+      assert.areEqual("object", typeof o.l.m);
+    }
+  },
+  {
+    name: "Unread objects used as prototypes",
+    body: function () {
+      var o = JSON.parse(text);
+      var derived = Object.create(o.h[2]);
+      assert.areEqual(-5500, derived.j);
+      var other = {};
+      Object.setPrototypeOf(other, o.l);
+      assert.areEqual("deep", other.m.n.o.p);
+    }
+  },
+  {
+    name: "Wide objects and index-like keys",
+    body: function () {
+      var wide = {};
+      for (var i = 0; i < 300; i++) {
+        wide["key" + i] = i;
+      }
+      var indexed = { "0": "zero", "7": "seven", name: "indexed" };
+      var source = JSON.stringify({ wide: wide, indexed: indexed });
+      var o = JSON.parse(source);
+      assert.areEqual(299, o.wide.key299);
+      assert.areEqual(Object.keys(wide), Object.keys(o.wide));
+      assert.areEqual("seven", o.indexed[7]);
+      assert.areEqual(["0", "7", "name"], Object.keys(o.indexed));
+      assert.areEqual(source, JSON.stringify(JSON.parse(source)));
+    }
+  },
+  {
+    name: "Syntax errors anywhere in the input are still reported by JSON.parse",
+    body: function () {
+      var bad = [
+        '{"a": {"b": [1, 2,]}}',
+        '{"a": {"b": {"c" 1}}}',
+        '{"a": {"b": {"c": 1,}}}',
+        '{"a": {"b": {c: 1}}}',
+        '[{"a": {"b": -true}}]',
+        '{"a": {"b": [1 2]}}',
+        '{"a": {"b": {"c": 1}}',
+        '{"a": {"b": {"c": 1}}}}',
+        '{"a": {"b": "unterminated}}',
+        '[{"a": {"b": undefined}}]'
+      ];
+      bad.forEach(function (str) {
+        assert.throws(function () { JSON.parse(str); }, SyntaxError, str);
+      });
+    }
+  },
+  {
+    name: "Revivers see fully parsed objects",
+    body: function () {
+      var seen = [];
+      var o = JSON.parse(text, function (key, value) {
+        seen.push(key);
+        return value;
+      });
+      assert.areEqual("deep", o.l.m.n.o.p);
+      assert.areEqual(["k", "10", "a", "c", "0", "e", "f g", "1", "d", "g", "b"], seen.slice(0, 11));
+      assert.areEqual(["p", "o", "n", "m", "l", ""], seen.slice(-6));
+    }
+  },
+  {
+    name: "Concatenated and large inputs",
+    body: function () {
+      var items = [];
+      for (var i = 0; i < 1000; i++) {
+        items.push('{"id":' + i + ',"tags":["t' + i + '"],"nested":{"value":' + (i * 2) + '}}');
+      }
+      var big = '{"items":[' + items.join(",") + '],"tail":{"done":true}}';
+      var o = JSON.parse(big);
+      assert.areEqual(1000, o.items.length);
+      assert.areEqual(998, o.items[499].nested.value);
+      assert.areEqual("t999", o.items[999].tags[0]);
+      assert.areEqual(true, o.tail.done);
+      assert.areEqual(big, JSON.stringify(o));
+    }
+  }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
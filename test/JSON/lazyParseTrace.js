@@ -0,0 +1,20 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with -LazyJSONParse -LazyJSONParseThreshold:1 -testtrace:JSON. Each nested object prints one line, with the
+// offset of its '{', when its members are first needed. JSON.parse itself prints nothing.
+
+var text = '{"a":{"b":1},"c":[{"d":2}],"e":{"f":{"g":3}}}';
+
+var o = JSON.parse(text);
+WScript.Echo("parsed");
+WScript.Echo(o.a.b);
+WScript.Echo(o.a.b);
+WScript.Echo(o.c[0].d);
+WScript.Echo(o.e.f.g);
+
+var p = JSON.parse(text);
+WScript.Echo("parsed again");
+WScript.Echo(JSON.stringify(p) === text ? "pass" : "fail");
@@ -0,0 +1,129 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// JSON.stringify serializes objects of a shared shape from a per-type property list. These check that
+// objects of one shape still serialize like distinct objects would, including when the shape changes
+// while it is being serialized.
+
+function point(x, y) {
+  return { x: x, y: y };
+}
+
+var tests = [
+  {
+    name: "Objects of one shape",
+    body: function () {
+      var points = [];
+      for (var i = 0; i < 20; i++) {
+        points.push(point(i, "y" + i));
+      }
+      var expected = "[" + points.map(function (p) { return '{"x":' + p.x + ',"y":"' + p.y + '"}'; }).join(",") + "]";
+      assert.areEqual(expected, JSON.stringify(points));
+      assert.areEqual(expected, JSON.stringify(points));
+    }
+  },
+  {
+    name: "Values that are left out or replaced",
+    body: function () {
+      var values = [undefined, function () { }, Symbol("s"), null, NaN, Infinity, -0, true, "a\"b\\c\n", new Number(3), new String("s"), [1, , 3], {}];
+      var expected = [undefined, undefined, undefined, "null", "null", "null", "0", "true", '"a\\"b\\\\c\\n"', "3", '"s"', "[1,null,3]", "{}"];
+      for (var i = 0; i < values.length; i++) {
+        var actual = JSON.stringify([point(1, values[i]), point(2, values[i])]);
+        var member = expected[i] === undefined ? "" : ',"y":' + expected[i];
+        assert.areEqual('[{"x":1' + member + '},{"x":2' + member + '}]', actual, "value " + i);
+      }
+    }
+  },
+  {
+    name: "Names that need escaping",
+    body: function () {
+      var a = { "quote\"": 1, "tab\t": 2, "\u2028": 3, "\ud800": 4 };
+      var b = { "quote\"": 5, "tab\t": 6, "\u2028": 7, "\ud800": 8 };
+      assert.areEqual('[{"quote\\"":1,"tab\\t":2,"\u2028":3,"\\ud800":4},{"quote\\"":5,"tab\\t":6,"\u2028":7,"\\ud800":8}]', JSON.stringify([a, b]));
+    }
+  },
+  {
+    name: "Accessors, non-enumerable, read-only, symbol and indexed properties",
+    body: function () {
+      var withGetter = point(1, 2);
+      Object.defineProperty(withGetter, "z", { get: function () { return 3; }, enumerable: true });
+      var hidden = point(1, 2);
+      Object.defineProperty(hidden, "z", { value: 3, enumerable: false });
+      var frozen = Object.freeze(point(1, 2));
+      var withSymbol = point(1, 2);
+      withSymbol[Symbol("z")] = 3;
+      var indexed = point(1, 2);
+      indexed[0] = "zero";
+      indexed["1"] = "one";
+
+      assert.areEqual('{"x":1,"y":2,"z":3}', JSON.stringify(withGetter));
+      assert.areEqual('{"x":1,"y":2}', JSON.stringify(hidden));
+      assert.areEqual('{"x":1,"y":2}', JSON.stringify(frozen));
+      assert.areEqual('{"x":1,"y":2}', JSON.stringify(withSymbol));
+      assert.areEqual('{"0":"zero","1":"one","x":1,"y":2}', JSON.stringify(indexed));
+      assert.areEqual('[{"x":1,"y":2,"z":3},{"x":1,"y":2},{"x":1,"y":2}]', JSON.stringify([withGetter, hidden, frozen]));
+    }
+  },
+  {
+    name: "toJSON that reshapes the object being serialized",
+    body: function () {
+      var holder = { a: 1, b: null, c: 3, d: 4 };
+      var other = { a: 5, b: 6, c: 7, d: 8 };
+      holder.b = {
+        toJSON: function () {
+          delete holder.c;
+          holder.d = "changed";
+          holder.e = "added";
+          return "b";
+        }
+      };
+      // The property list is taken before any value is read; deleted properties are left out and added ones
+      // are not visited
+      assert.areEqual('[{"a":1,"b":"b","d":"changed"},{"a":5,"b":6,"c":7,"d":8}]', JSON.stringify([holder, other]));
+    }
+  },
+  {
+    name: "Replacer function and property list",
+    body: function () {
+      var list = [point(1, 2), point(3, 4)];
+      var keys = [];
+      var result = JSON.stringify(list, function (key, value) {
+        keys.push(key);
+        if (key === "y") {
+          delete this.x;
+          return value * 10;
+        }
+        return value;
+      });
+      assert.areEqual('[{"x":1,"y":20},{"x":3,"y":40}]', result);
+      assert.areEqual(["", "0", "x", "y", "1", "x", "y"], keys);
+      assert.areEqual('[{"y":2},{"y":4}]', JSON.stringify([point(1, 2), point(3, 4)], ["y"]));
+    }
+  },
+  {
+    name: "Indentation and prototype properties",
+    body: function () {
+      var proto = { inherited: true };
+      var a = Object.create(proto);
+      a.x = 1;
+      var b = Object.create(proto);
+      b.x = 2;
+      assert.areEqual('[\n  {\n    "x": 1\n  },\n  {\n    "x": 2\n  }\n]', JSON.stringify([a, b], null, 2));
+    }
+  },
+  {
+    name: "Cycles are still detected",
+    body: function () {
+      var a = point(1, null);
+      var b = point(2, a);
+      a.y = b;
+      assert.throws(function () { JSON.stringify(a); }, TypeError);
+    }
+  }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
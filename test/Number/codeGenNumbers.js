@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// On 32-bit targets, the JIT boxes double constants stored as Vars at compile time. In-proc background JIT
+// (-oopjit-, without -forceNative, which JITs in the foreground) takes those numbers from the thread's
+// CodeGenNumberThreadAllocator, several per chunk.
+
+function store(o)
+{
+    o.a = 0.5; o.b = 1.25; o.c = 2.75; o.d = 3.125;
+    o.e = 4.375; o.f = 5.625; o.g = 6.875; o.h = 7.0625;
+    o.i = 8.1875; o.j = 9.3125; o.k = 10.4375; o.l = 11.5625;
+    return o;
+}
+
+var expected = 0.5 + 1.25 + 2.75 + 3.125 + 4.375 + 5.625 + 6.875 + 7.0625 + 8.1875 + 9.3125 + 10.4375 + 11.5625;
+var failed = 0;
+
+// Keep calling until well after the background JIT is done, so the jitted code's numbers are used too
+for (var i = 0; i < 100000; i++)
+{
+    var o = store({});
+    var sum = o.a + o.b + o.c + o.d + o.e + o.f + o.g + o.h + o.i + o.j + o.k + o.l;
+    if (sum !== expected)
+    {
+        failed++;
+    }
+}
+
+// Collect while the numbers are still referenced from the jitted code
+CollectGarbage();
+var o = store({});
+if (o.a !== 0.5 || o.l !== 11.5625)
+{
+    failed++;
+}
+
+WScript.Echo(failed === 0 ? "pass" : "fail");
@@ -0,0 +1,92 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Patterns without backreferences or lookaround fall back to a linear-time NFA matcher once backtracking
+// exceeds -RegexBacktrackLimit, which is shared by all the start offsets one match tries. This test is run with the default limit, with the linear matcher used
+// from the start (-RegexBacktrackLimit:0), and with a fallback on the first backtrack
+// (-RegexBacktrackLimit:1). Results, including captures, must be the same in all three.
+
+function show(result) {
+    if (result === null) {
+        return "null";
+    }
+    var parts = [];
+    for (var i = 0; i < result.length; i++) {
+        parts.push(result[i] === undefined ? "undefined" : JSON.stringify(result[i]));
+    }
+    return "[" + parts.join(", ") + "] at " + result.index;
+}
+
+var cases = [
+    // Alternation priority and captures
+    [/(a|ab)(c|bcd)(d*)/, ["abcd", "xabcdx"]],
+    [/a(b|bc)c?/, ["abc", "abcc"]],
+    [/(?:(a)|b)+/, ["ab", "ba", "bab"]],
+    [/(?:(a)|(b))+/, ["ab", "aab", "bba"]],
+    [/(a)|(b)|(c)/, ["c", "xb"]],
+    // Greedy and lazy loops
+    [/(a+)(a*)/, ["aaaa"]],
+    [/(a+?)(a*)/, ["aaaa"]],
+    [/(a*?)b/, ["aaab", "b"]],
+    [/<(.*)>/, ["<a><b>"]],
+    [/<(.*?)>/, ["<a><b>"]],
+    [/a{2,4}/, ["a", "aaaaa"]],
+    [/a{2,4}?/, ["aaaaa"]],
+    [/(ab){1,2}c/, ["ababc", "abc", "abababc"]],
+    [/x(?:y{0,2}z)*w/, ["xyzyyzw", "xyyyzw"]],
+    // Loops whose body can match empty
+    [/(a*)*b/, ["aab", "b", "aac"]],
+    [/(a*)+b/, ["aab", "b"]],
+    [/(a?)*?b/, ["aab"]],
+    [/(?:a|())*b/, ["aab", "b"]],
+    [/(a|)*/, ["aaa", ""]],
+    [/((a)|b)*/, ["ab", "aba"]],
+    [/(z)((a+)?(b+)?(c))*/, ["zaacbbbcac"]],
+    // Anchors and word boundaries
+    [/^(a+)$/, ["aaa", "aab"]],
+    [/^b|c$/m, ["a\nb", "c\nd"]],
+    [/\b(\w+)\b/, ["  foo bar"]],
+    [/\B\w+/, ["foo"]],
+    // Character sets and case folding
+    [/([a-c]+)[^a-c]/, ["xxabcabd"]],
+    [/(AB|c)+/i, ["xabCab"]],
+    [/[^\s]+$/, ["hello world"]],
+    // Sticky and global
+    [/(a|b)+c/y, ["abc", "xabc"]],
+    [/(a|ab)+c/g, ["ababc"]],
+    // Too large for an NFA, so matching carries on backtracking once the budget runs out
+    [/(a|ab){0,1000}c/, ["ababc"]],
+];
+
+for (var i = 0; i < cases.length; i++) {
+    var re = cases[i][0];
+    var inputs = cases[i][1];
+    for (var j = 0; j < inputs.length; j++) {
+        re.lastIndex = 0;
+        WScript.Echo(re + " on " + JSON.stringify(inputs[j]) + ": " + show(re.exec(inputs[j])));
+    }
+}
+
+// Nested quantifiers which backtrack exponentially must still finish quickly on failure.
+var input = "";
+for (var i = 0; i < 40; i++) {
+    input += "a";
+}
+var pathological = [
+    /(a+)+b/,
+    /(a|aa)+b/,
+    /(a|a)+b/,
+    /^(a*)*$/,
+    /(?:a+)+(?:a+)+b/,
+];
+for (var i = 0; i < pathological.length; i++) {
+    WScript.Echo(pathological[i] + " on 40 a's + \"c\": " + show(pathological[i].exec(input + "c")));
+}
+var result = /(a+)+b/.exec(input + "b");
+WScript.Echo(/(a+)+b/ + " on 40 a's + \"b\": lengths " + result[0].length + ", " + result[1].length);
+
+var parts = (input + "c").split(/(a|aa)+b/);
+WScript.Echo("split: " + parts.length);
+WScript.Echo("replace: " + (input + "x").replace(/(a+)+x/, "<$1>").length);
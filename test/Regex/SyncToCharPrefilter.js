@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Non-global patterns whose programs start by syncing to a single character are prefiltered in jitted code:
+// exec scans for the character and returns null without calling into the regex engine when it is absent.
+// Exercise both the "character absent" and "character present" paths, including the effect on lastIndex
+// and RegExp.$1. The same baseline is used with the prefilter turned off.
+
+function exec(re, input) {
+    return re.exec(input);
+}
+
+var cases = [
+    [/a\d+/, "xxxxxxxx"],
+    [/a\d+/, "xxxxa123"],
+    [/a\d+/, "xxxxaxxx"],
+    [/a\d+/, ""],
+    [/x(y)z/, "..xyz.."],
+    [/x(y)z/, "........"],
+    [/a\d+/g, "a1 a2 a3"],
+];
+
+for (var i = 0; i < 3; i++) {
+    for (var j = 0; j < cases.length; j++) {
+        var re = cases[j][0];
+        var input = cases[j][1];
+        re.lastIndex = 0;
+        var result = exec(re, input);
+        if (i == 2) {
+            WScript.Echo(re + " on \"" + input + "\": " + result + ", lastIndex " + re.lastIndex);
+        }
+    }
+}
+
+var re = /x(y)z/;
+exec(re, "xyz");
+exec(re, "abc");
+WScript.Echo("RegExp.$1 after failed match: " + RegExp.$1);
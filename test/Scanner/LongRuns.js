@@ -0,0 +1,109 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// The scanner skips over runs of identifier characters, string and comment bodies and whitespace sixteen bytes at a
+// time. These tests put the character that ends a run at every offset around those blocks.
+
+function repeat(str, count) {
+  var result = "";
+  for (var i = 0; i < count; i++) {
+    result += str;
+  }
+  return result;
+}
+
+function letters(count) {
+  var result = "";
+  for (var i = 0; i < count; i++) {
+    result += "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_$"[i % 64];
+  }
+  return result;
+}
+
+var maxLength = 40;
+
+var tests = [
+  {
+    name: "Identifiers",
+    body: function () {
+      for (var length = 1; length < maxLength; length++) {
+        var id = "_" + letters(length);
+        assert.areEqual(length, eval("var " + id + " = " + length + "; " + id), id);
+
+        // A non-ASCII identifier character, an escape and an operator right after the ASCII run
+        assert.areEqual(1, eval("var " + id + "\u00e9 = 1; " + id + "\u00e9"), id + "\\u00e9");
+        assert.areEqual(2, eval("var " + id + "\\u0061 = 2; " + id + "a"), id + "\\u0061");
+        assert.areEqual(length + 1, eval("var " + id + "=" + length + ";" + id + "+1"), id + "+1");
+      }
+    }
+  },
+  {
+    name: "String literals",
+    body: function () {
+      for (var length = 0; length < maxLength; length++) {
+        var text = letters(length);
+        assert.areEqual(text, eval("'" + text + "'"));
+        assert.areEqual(text + "\"" + text, eval("\"" + text + "\\\"" + text + "\""));
+        assert.areEqual(text + "\"" + text, eval("'" + text + "\"" + text + "'"));
+        assert.areEqual(text + "\n" + text, eval("'" + text + "\\n" + text + "'"));
+        assert.areEqual(text + "\u00e9\u20ac" + text, eval("'" + text + "\u00e9\u20ac" + text + "'"));
+        assert.areEqual(text + "$`" + text, eval("'" + text + "$`" + text + "'"));
+        assert.areEqual(text + "\t" + text, eval("'" + text + "\t" + text + "'"));
+        assert.throws(function () { eval("'" + text + "\n" + text + "'"); }, SyntaxError);
+        assert.throws(function () { eval("'" + text); }, SyntaxError);
+      }
+    }
+  },
+  {
+    name: "Template literals",
+    body: function () {
+      var value = 7;
+      for (var length = 0; length < maxLength; length++) {
+        var text = letters(length);
+        assert.areEqual(text + "7" + text, eval("`" + text + "${value}" + text + "`"));
+        assert.areEqual(text + "$" + text, eval("`" + text + "$" + text + "`"));
+        assert.areEqual(text + "\n" + text, eval("`" + text + "\r\n" + text + "`"));
+        assert.areEqual(text + "\\n" + text, eval("String.raw`" + text + "\\n" + text + "`"));
+        assert.areEqual(text + "'\"" + text, eval("`" + text + "'\"" + text + "`"));
+      }
+    }
+  },
+  {
+    name: "Comments",
+    body: function () {
+      for (var length = 0; length < maxLength; length++) {
+        var text = letters(length);
+
+        // A line break inside a comment ends the return statement
+        assert.areEqual(42, new Function("return /*" + text + "*" + text + "*/ 42")());
+        assert.areEqual(undefined, new Function("return /*" + text + "\n" + text + "*/ 42")());
+        assert.areEqual(undefined, new Function("return /*" + text + "\u2028" + text + "*/ 42")());
+        assert.areEqual(42, new Function("return /*" + text + "\u00e9" + text + "*/ 42")());
+
+        assert.areEqual(1, eval("1 //" + text + "\u00e9" + text + "\n"));
+        assert.areEqual(2, eval("//" + text + "\u2029 2"));
+        assert.areEqual(3, eval("//" + text + "\r3"));
+        assert.areEqual(4, eval("4//" + text));
+        assert.throws(function () { eval("/*" + text); }, SyntaxError);
+      }
+    }
+  },
+  {
+    name: "Whitespace",
+    body: function () {
+      for (var length = 0; length < maxLength; length++) {
+        var spaces = repeat(" ", length);
+        var tabs = repeat("\t", length);
+        assert.areEqual(3, eval(spaces + "1" + tabs + "+" + spaces + tabs + "2" + spaces));
+        assert.areEqual(undefined, new Function("return" + spaces + "\n" + tabs + "42")());
+        assert.areEqual(42, new Function("return" + spaces + "\v\f" + tabs + "42")());
+      }
+    }
+  }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -0,0 +1,119 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// The string search, comparison and case mapping loops handle eight characters at a time, so these
+// place matches and mismatches at every offset around block boundaries and check against simple
+// reference implementations.
+
+function referenceIndexOf(str, search, position) {
+    for (var i = position; i + search.length <= str.length; i++) {
+        if (str.substr(i, search.length) === search) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+function referenceLastIndexOf(str, search, position) {
+    for (var i = Math.min(position, str.length - search.length); i >= 0; i--) {
+        if (str.substr(i, search.length) === search) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+function fill(length, c) {
+    return Array(length + 1).join(c);
+}
+
+// Builds a fresh (non-literal) string so comparisons can't short-circuit on a shared buffer
+function copy(str) {
+    return str.split("").join("");
+}
+
+var tests = [
+  {
+    name: "indexOf and lastIndexOf of a single character at every offset",
+    body: function () {
+      for (var length = 1; length <= 40; length++) {
+        for (var at = 0; at < length; at++) {
+          var str = fill(at, "a") + "Ā" + fill(length - at - 1, "a");
+          assert.areEqual(at, str.indexOf("Ā"), "indexOf in length " + length + " at " + at);
+          assert.areEqual(at, str.lastIndexOf("Ā"), "lastIndexOf in length " + length + " at " + at);
+          assert.areEqual(-1, str.indexOf("Ā", at + 1), "indexOf after the match, length " + length + " at " + at);
+          assert.areEqual(at === 0 ? 0 : -1, str.lastIndexOf("Ā", at - 1), "lastIndexOf before the match, length " + length + " at " + at);
+        }
+      }
+    }
+  },
+  {
+    name: "indexOf, includes and lastIndexOf of substrings near block boundaries",
+    body: function () {
+      // The last three straddle the length above which Boyer-Moore is used instead
+      var needles = ["ab", "abc", "aba", "abcdefgh", "abcdefghi", "aāa", "abcdefghijklmnop", "abcdefghijklmnopq", "zzzzzzzzzzzzzzzzzz"];
+      for (var n = 0; n < needles.length; n++) {
+        var needle = needles[n];
+        for (var length = 0; length <= 40; length++) {
+          for (var at = 0; at + needle.length <= length; at++) {
+            // Surround the needle with near misses that share its first or last character
+            var filler = needle[0] + "x" + needle[needle.length - 1];
+            var str = (fill(length, filler)).substr(0, at) + needle + fill(length, filler).substr(0, length - at - needle.length);
+            for (var position = 0; position <= length; position += 3) {
+              assert.areEqual(referenceIndexOf(str, needle, position), str.indexOf(needle, position),
+                "indexOf(\"" + needle + "\", " + position + ") in \"" + str + "\"");
+              assert.areEqual(referenceLastIndexOf(str, needle, position), str.lastIndexOf(needle, position),
+                "lastIndexOf(\"" + needle + "\", " + position + ") in \"" + str + "\"");
+            }
+            assert.areEqual(referenceIndexOf(str, needle, 0) !== -1, str.includes(needle), "includes(\"" + needle + "\") in \"" + str + "\"");
+          }
+        }
+      }
+    }
+  },
+  {
+    name: "Equality with a difference at every offset",
+    body: function () {
+      for (var length = 1; length <= 40; length++) {
+        var base = fill(length, "q");
+        assert.isTrue(base === copy(base), "equal strings of length " + length);
+        for (var at = 0; at < length; at++) {
+          var other = base.substr(0, at) + "r" + base.substr(at + 1);
+          assert.isFalse(base === other, "length " + length + " differing at " + at);
+          assert.isFalse(other === base, "length " + length + " differing at " + at + " (reversed)");
+        }
+      }
+    }
+  },
+  {
+    name: "ASCII and non-ASCII case mapping",
+    body: function () {
+      var ascii = "@AZaz[`{ Hello, World! 0123456789 The Quick Brown Fox Jumps Over The Lazy Dog";
+      for (var length = 0; length <= ascii.length; length++) {
+        var str = ascii.substr(0, length);
+        var upper = "";
+        var lower = "";
+        for (var i = 0; i < str.length; i++) {
+          var c = str.charCodeAt(i);
+          upper += String.fromCharCode(c >= 0x61 && c <= 0x7A ? c - 32 : c);
+          lower += String.fromCharCode(c >= 0x41 && c <= 0x5A ? c + 32 : c);
+        }
+        assert.areEqual(upper, str.toUpperCase(), "toUpperCase of \"" + str + "\"");
+        assert.areEqual(lower, str.toLowerCase(), "toLowerCase of \"" + str + "\"");
+      }
+
+      // A non-ASCII character anywhere sends the string to the general path
+      for (var at = 0; at < 20; at++) {
+        var mixed = fill(at, "a") + "é" + fill(19 - at, "B");
+        assert.areEqual(fill(at, "A") + "É" + fill(19 - at, "B"), mixed.toUpperCase(), "toUpperCase with é at " + at);
+        assert.areEqual(fill(at, "a") + "é" + fill(19 - at, "b"), mixed.toLowerCase(), "toLowerCase with é at " + at);
+      }
+    }
+  }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
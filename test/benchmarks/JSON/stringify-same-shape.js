@@ -0,0 +1,33 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Serializes batches of response records that all share one shape, with a nested object of a second
+// shape in each, the way a service turns query results into JSON.
+function makeRecord(i) {
+    return {
+        id: i,
+        name: "item-" + i,
+        active: (i & 1) === 0,
+        score: i * 0.25,
+        tags: ["a", "b"],
+        owner: { id: i % 97, login: "user" + (i % 97), admin: false },
+        updated: "2024-01-01T00:00:00Z"
+    };
+}
+
+var records = [];
+for (var i = 0; i < 1000; i++) {
+    records.push(makeRecord(i));
+}
+
+var length = 0;
+var start = new Date();
+for (var iter = 0; iter < 200; iter++) {
+    length += JSON.stringify(records).length;
+}
+var interval = new Date() - start;
+
+if (length !== 200 * JSON.stringify(records).length) throw new Error("unexpected output length " + length);
+WScript.Echo("### TIME:", interval, "ms");
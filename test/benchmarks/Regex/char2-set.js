@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Builds a log-like input of roughly the given size that never contains the characters in "avoid"
+function makeInput(size, avoid) {
+    var words = ["GET", "POST", "/api/v1/users", "200", "404", "user-agent", "Mozilla/5.0", "latency", "ms", "ok",
+                 "request", "id", "session", "path", "cache", "hit", "miss", "upstream", "timeout", "host"];
+    var parts = [];
+    var length = 0;
+    for (var i = 0; length < size; i++) {
+        var word = words[(i * 7) % words.length];
+        for (var j = 0; j < avoid.length; j++) {
+            word = word.split(avoid[j]).join("");
+        }
+        parts.push(word);
+        length += word.length + 1;
+    }
+    return parts.join(" ");
+}
+
+// Patterns whose first character is one of two characters, e.g. a case-insensitive letter, which compile to
+// SyncToChar2Set* instructions.
+var input = makeInput(64 * 1024, "qQzZ");
+var withMatch = input + " Quota";
+var patterns = [/q\w+/i, /[zZ]\d/, /(?:q|Q)uota/];
+var found = 0;
+
+var start = new Date();
+for (var i = 0; i < 400; i++) {
+    for (var j = 0; j < patterns.length; j++) {
+        if (patterns[j].test(input)) found++;
+        if (patterns[j].test(withMatch)) found++;
+    }
+}
+var interval = new Date() - start;
+
+if (found != 800) throw new Error("unexpected match count " + found);
+WScript.Echo("### TIME:", interval, "ms");
@@ -0,0 +1,35 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Builds a log-like input of roughly the given size that never contains the characters in "avoid"
+function makeInput(size, avoid) {
+    var words = ["GET", "POST", "/api/v1/users", "200", "404", "user-agent", "Mozilla/5.0", "latency", "ms", "ok",
+                 "request", "id", "session", "path", "cache", "hit", "miss", "upstream", "timeout", "host"];
+    var parts = [];
+    var length = 0;
+    for (var i = 0; length < size; i++) {
+        var word = words[(i * 7) % words.length];
+        for (var j = 0; j < avoid.length; j++) {
+            word = word.split(avoid[j]).join("");
+        }
+        parts.push(word);
+        length += word.length + 1;
+    }
+    return parts.join(" ");
+}
+
+// Global replace with a sparse single character pattern, as used when scrubbing or escaping text.
+var input = makeInput(64 * 1024, "<>&");
+input = input.split(" ").join(" <b> ");
+var length = 0;
+
+var start = new Date();
+for (var i = 0; i < 50; i++) {
+    length += input.replace(/</g, "&lt;").replace(/>/g, "&gt;").length;
+}
+var interval = new Date() - start;
+
+if (length <= input.length * 50) throw new Error("unexpected length " + length);
+WScript.Echo("### TIME:", interval, "ms");
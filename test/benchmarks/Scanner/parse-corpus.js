@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Scanner throughput: parses the larger benchmark sources without running them. Run from test/benchmarks,
+// with -Force:DeferParse to keep the time spent in the scanner rather than in the byte code generator.
+var corpus = [
+    "Octane/typescript.js",
+    "Octane/pdfjs.js",
+    "Octane/gbemu.js",
+    "Octane/box2d.js",
+    "Octane/code-load.js",
+    "Kraken/json-parse-financial.js",
+    "Kraken/stanford-crypto-aes.js"
+];
+
+var sources = corpus.map(function (file) { return WScript.LoadTextFile(file); });
+
+var start = new Date();
+for (var iter = 0; iter < 20; iter++) {
+    for (var i = 0; i < sources.length; i++) {
+        // Trailing text keeps each parse distinct so that nothing is served from the eval cache
+        new Function(sources[i] + "\n// " + iter);
+    }
+}
+var interval = new Date() - start;
+
+WScript.Echo("### TIME:", interval, "ms");
@@ -0,0 +1,32 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// toLowerCase and toUpperCase of ASCII header names and longer ASCII text, as done when normalizing
+// requests. Fresh strings are built each iteration so no cached result can be reused.
+var headers = ["Content-Type", "Content-Length", "Accept-Encoding", "X-Forwarded-For", "User-Agent",
+               "Cache-Control", "If-None-Match", "Authorization", "Accept-Language", "Connection"];
+var paragraph = [];
+for (var i = 0; i < 200; i++) {
+    paragraph.push("The Quick Brown Fox Jumps Over The Lazy Dog " + i);
+}
+paragraph = paragraph.join(". ");
+
+var total = 0;
+var start = new Date();
+for (var iter = 0; iter < 2000; iter++) {
+    for (var i = 0; i < headers.length; i++) {
+        var header = headers[i] + "-" + (iter & 7);
+        total += header.toLowerCase().length;
+        total += header.toUpperCase().length;
+    }
+    if ((iter & 15) === 0) {
+        var text = paragraph + iter;
+        total += text.toLowerCase().length + text.toUpperCase().length;
+    }
+}
+var interval = new Date() - start;
+
+if (total <= 0) throw new Error("unexpected total " + total);
+WScript.Echo("### TIME:", interval, "ms");
@@ -0,0 +1,34 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Compares route keys built at run time, so equal strings never share a buffer and every comparison
+// has to look at the characters. Keys share long prefixes and differ near the end.
+var prefix = "/api/v1/organizations/contoso/projects/chakra/repositories/core/";
+var routes = [];
+for (var i = 0; i < 64; i++) {
+    routes.push([prefix, "branches/", "feature-", i].join(""));
+}
+var requests = [];
+for (var i = 0; i < 64; i++) {
+    requests.push([prefix, "branches/feature-", (i * 5) % 64].join(""));
+}
+
+var found = 0;
+var start = new Date();
+for (var iter = 0; iter < 300; iter++) {
+    for (var i = 0; i < requests.length; i++) {
+        var request = requests[i];
+        for (var j = 0; j < routes.length; j++) {
+            if (request === routes[j]) {
+                found++;
+                break;
+            }
+        }
+    }
+}
+var interval = new Date() - start;
+
+if (found != 300 * 64) throw new Error("unexpected match count " + found);
+WScript.Echo("### TIME:", interval, "ms");
@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Builds a template-like input of roughly the given size
+function makeInput(size) {
+    var words = ["<div", "class=", "\"row\"", "{{", "user.name", "}}", "</div>", "<span>", "</span>", "items",
+                 "for", "each", "item", "in", "list", "href=", "\"/api/v1/users\"", "id", "value", "text"];
+    var parts = [];
+    var length = 0;
+    for (var i = 0; length < size; i++) {
+        var word = words[(i * 7) % words.length];
+        parts.push(word);
+        length += word.length + 1;
+    }
+    return parts.join(" ");
+}
+
+// indexOf, includes and lastIndexOf over long inputs, for single characters and for needles which
+// are rare or absent, as template engines and routers do when looking for delimiters.
+var input = makeInput(64 * 1024);
+var needles = ["@", "{{#if", "</table>", "user.email", "\"/api/v2/"];
+var withMatch = input + " {{#if user.email}} \"/api/v2/\" </table> @";
+var found = 0;
+
+var start = new Date();
+for (var i = 0; i < 200; i++) {
+    for (var j = 0; j < needles.length; j++) {
+        if (input.indexOf(needles[j]) !== -1) found++;
+        if (withMatch.indexOf(needles[j]) !== -1) found++;
+        if (withMatch.includes(needles[j])) found++;
+        if (input.lastIndexOf(needles[j]) !== -1) found++;
+        if (withMatch.lastIndexOf(needles[j], withMatch.length - 64) !== -1) found++;
+    }
+}
+var interval = new Date() - start;
+
+if (found != 2000) throw new Error("unexpected match count " + found);
+WScript.Echo("### TIME:", interval, "ms");
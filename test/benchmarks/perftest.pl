@@ -587,6 +587,11 @@ sub usage
     print "  -kraken                Run the kraken benchmark\n";
     print "  -octane                Run the Octane 2.0 benchmark\n";
     print "  -jetstream             Run the JetStream benchmark (only non octane and sunspider tests)\n";
+    print "  -regex                 Run the regex scanner microbenchmarks\n";
+    print "  -strings               Run the string primitive microbenchmarks\n";
+    print "                         (compare with a -baseline run using -args:-SimdStringPrimitives-)\n";
+    print "  -json                  Run the JSON microbenchmarks\n";
+    print "                         (compare with a -baseline run using -args:-JSONStringifyPlans-)\n";
     print "  -file:<file>           Run the specified js file\n";
     print "  -args:<other args>     Other arguments to ch.exe\n";
     print "  -score                 Test output scores\n";
@@ -735,6 +740,30 @@ sub parse_args
             $testfile = "perftest$dir.txt";
             $is_dynamicProfileRun = 1;
         }
+        elsif($ARGV[$i] =~ /^[-\/]regex$/i)
+        {
+            @testlist = ("sync-char", "char2-set", "char2-literal", "replace-global");
+            $dir = "Regex";
+            $basefile = "perfbase$dir.txt";
+            $testfile = "perftest$dir.txt";
+            $is_dynamicProfileRun = 1;
+        }
+        elsif($ARGV[$i] =~ /^[-\/]strings$/i)
+        {
+            @testlist = ("index-of", "equals", "case-mapping");
+            $dir = "Strings";
+            $basefile = "perfbase$dir.txt";
+            $testfile = "perftest$dir.txt";
+            $is_dynamicProfileRun = 1;
+        }
+        elsif($ARGV[$i] =~ /^[-\/]json$/i)
+        {
+            @testlist = ("stringify-same-shape");
+            $dir = "JSON";
+            $basefile = "perfbase$dir.txt";
+            $testfile = "perftest$dir.txt";
+            $is_dynamicProfileRun = 1;
+        }
         elsif($ARGV[$i] =~ /[-\/]file:(.*).js$/i)
         {
             # only supports octane, add additional support here for jetstream